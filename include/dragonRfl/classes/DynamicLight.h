@@ -59,6 +59,9 @@ namespace dragonRfl
 
     private:
 
+        void _applyLightColor();
+        void _updateEnableState();
+
         DynamicLightFields mFields;
 
         std::shared_ptr<odPhysics::LightHandle> mLightHandle;
@@ -2,6 +2,8 @@
 #ifndef INCLUDE_RFL_DRAGON_FADER_H_
 #define INCLUDE_RFL_DRAGON_FADER_H_
 
+#include <odCore/TimerWheel.h>
+
 #include <odCore/render/Handle.h>
 
 #include <odCore/rfl/Class.h>
@@ -49,6 +51,7 @@ namespace dragonRfl
         virtual odState::StateBundleBase *getExtraStates() override { return &mStates; }
 
         virtual void onSpawned() override;
+        virtual void onDespawned() override;
         virtual void onUpdate(float relTime) override;
         virtual void onMessageReceived(od::LevelObject &sender, od::Message message) override;
 
@@ -63,11 +66,14 @@ namespace dragonRfl
             FADE_OUT
         };
 
+        void _setPhase(FadePhase phase);
+
         FaderFields mFields;
         FaderStates mStates;
 
         float mTime;
         FadePhase mPhase;
+        od::TimerHandle mFadedTimeout;
     };
 
 
@@ -8,6 +8,8 @@
 #ifndef INCLUDE_RFL_DRAGON_TIMER_H_
 #define INCLUDE_RFL_DRAGON_TIMER_H_
 
+#include <odCore/TimerWheel.h>
+
 #include <odCore/rfl/Class.h>
 #include <odCore/rfl/Field.h>
 #include <odCore/rfl/DummyClass.h>
@@ -43,17 +45,23 @@ namespace dragonRfl
 
         virtual void onLoaded() override;
         virtual void onSpawned() override;
-        virtual void onUpdate(float relTime) override;
+        virtual void onDespawned() override;
         virtual void onMessageReceived(od::LevelObject &sender, od::Message message) override;
 
 
 	private:
 
+        void _start();
+        void _stop();
+        void _onTimeout();
+
         TimerFields mFields;
 
 		bool mGotStartTrigger;
 		bool mTimerRunning;
-		float mTimeElapsed;
+		float mTimeElapsed; // accumulated over previous runs, not counting the current one
+		double mRunStartTime;
+		od::TimerHandle mTimeout;
 
 	};
 
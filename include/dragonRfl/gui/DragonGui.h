@@ -84,6 +84,9 @@ namespace dragonRfl
 
         std::unordered_map<od::RecordId, std::string> mLocalizedStringCache;
 
+        // sharing textures between quads lets them end up in the same batch
+        std::unordered_map<od::RecordId, std::shared_ptr<odRender::Texture>> mGuiTextureCache;
+
         std::shared_ptr<MainMenu> mMainMenu;
     };
 
@@ -0,0 +1,152 @@
+/*
+ * Benchmark.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: zal
+ */
+
+#ifndef INCLUDE_ODBENCH_BENCHMARK_H_
+#define INCLUDE_ODBENCH_BENCHMARK_H_
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace odBench
+{
+
+    /**
+     * @brief Keeps the compiler from optimizing away a value whose computation is being benchmarked.
+     */
+    template <typename T>
+    inline void doNotOptimize(const T &value)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "r,m"(value) : "memory");
+#else
+        static volatile const void *sink;
+        sink = &value;
+        std::atomic_signal_fence(std::memory_order_seq_cst);
+#endif
+    }
+
+
+    /**
+     * @brief Passed to every benchmark function. Times the loop body handed to measure().
+     *
+     * Everything a benchmark function does before calling measure() is setup and does not count towards the result.
+     */
+    class State
+    {
+    public:
+
+        using Clock = std::chrono::steady_clock;
+
+        State(double minSampleTime, size_t sampleCount);
+
+        inline void setBytesPerIteration(size_t bytes) { mBytesPerIteration = bytes; }
+        inline void setItemsPerIteration(size_t items) { mItemsPerIteration = items; }
+
+        inline size_t getBytesPerIteration() const { return mBytesPerIteration; }
+        inline size_t getItemsPerIteration() const { return mItemsPerIteration; }
+        inline size_t getIterations() const { return mIterations; }
+        inline bool hasMeasured() const { return !mSamples.empty(); }
+
+        /**
+         * @brief Seconds per iteration of each sample taken, in the order they were taken.
+         */
+        inline const std::vector<double> &getSamples() const { return mSamples; }
+
+        /**
+         * @brief Runs f repeatedly and records how long a single call takes.
+         *
+         * First, the number of iterations needed to fill the minimum sample time is determined. This also serves as
+         * warmup. Then, the configured number of samples with that iteration count is taken. Must be called exactly
+         * once per benchmark function.
+         */
+        template <typename F>
+        void measure(const F &f)
+        {
+            size_t iterations = 1;
+            while(true)
+            {
+                double time = _time(f, iterations);
+                if(time >= mMinSampleTime || iterations >= MAX_ITERATIONS)
+                {
+                    break;
+                }
+
+                // overshoot the estimate a bit so we don't end up taking many calibration rounds just below the limit
+                double factor = (time > 0.0) ? (1.2 * mMinSampleTime / time) : 10.0;
+                factor = std::min(std::max(factor, 2.0), 10.0);
+                iterations = std::min(static_cast<size_t>(iterations * factor), MAX_ITERATIONS);
+            }
+
+            mIterations = iterations;
+
+            mSamples.clear();
+            mSamples.reserve(mSampleCount);
+            for(size_t i = 0; i < mSampleCount; ++i)
+            {
+                mSamples.push_back(_time(f, iterations) / iterations);
+            }
+        }
+
+
+    private:
+
+        static constexpr size_t MAX_ITERATIONS = 1000000000;
+
+        template <typename F>
+        static double _time(const F &f, size_t iterations)
+        {
+            auto start = Clock::now();
+            for(size_t i = 0; i < iterations; ++i)
+            {
+                f();
+            }
+            auto end = Clock::now();
+
+            return std::chrono::duration<double>(end - start).count();
+        }
+
+        double mMinSampleTime;
+        size_t mSampleCount;
+
+        size_t mBytesPerIteration;
+        size_t mItemsPerIteration;
+        size_t mIterations;
+        std::vector<double> mSamples;
+    };
+
+
+    struct Benchmark
+    {
+        std::string name;
+        void (*function)(State &state);
+    };
+
+
+    struct Result
+    {
+        std::string name;
+        size_t iterations;
+        double medianTime; ///< Seconds per iteration
+        double minTime; ///< Seconds per iteration
+        double bytesPerSecond; ///< Based on the median. 0 if the benchmark doesn't process bytes
+        double itemsPerSecond; ///< Based on the median. 0 if the benchmark doesn't process items
+    };
+
+
+    Result runBenchmark(const Benchmark &benchmark, double minSampleTime, size_t sampleCount);
+
+    void registerDataStreamBenchmarks(std::vector<Benchmark> &benchmarks);
+    void registerAssetBenchmarks(std::vector<Benchmark> &benchmarks);
+    void registerStateBenchmarks(std::vector<Benchmark> &benchmarks);
+    void registerAnimBenchmarks(std::vector<Benchmark> &benchmarks);
+
+}
+
+#endif /* INCLUDE_ODBENCH_BENCHMARK_H_ */
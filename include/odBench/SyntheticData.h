@@ -0,0 +1,112 @@
+/*
+ * SyntheticData.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: zal
+ */
+
+#ifndef INCLUDE_ODBENCH_SYNTHETICDATA_H_
+#define INCLUDE_ODBENCH_SYNTHETICDATA_H_
+
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <odCore/DataStream.h>
+#include <odCore/SrscFile.h>
+
+namespace odBench
+{
+
+    /**
+     * @brief Random number source for synthetic inputs.
+     *
+     * Only uses the raw output of std::mt19937, which is fully specified by the standard. The std distributions are
+     * not, so using them would make inputs (and thus results) differ between standard libraries.
+     */
+    class Random
+    {
+    public:
+
+        explicit Random(uint32_t seed);
+
+        inline uint32_t next() { return mEngine(); }
+        float nextFloat(float min, float max);
+        bool nextBool(float probability);
+
+
+    private:
+
+        std::mt19937 mEngine;
+    };
+
+
+    /**
+     * @brief Calls f with a DataWriter and returns everything it wrote.
+     */
+    template <typename F>
+    std::vector<char> buildRecord(const F &f)
+    {
+        std::vector<char> data;
+
+        {
+            od::VectorOutputBuffer buffer(data);
+            std::ostream out(&buffer);
+            od::DataWriter writer(out);
+            f(writer);
+        }
+
+        return data;
+    }
+
+    /**
+     * @brief Writes a string the way DataReader expects it (16 bit length, no terminator).
+     */
+    void writeString(od::DataWriter &writer, const std::string &s);
+
+    /**
+     * @brief Sets the directory synthetic SRSC files are stored in while they are used. Default is the working directory.
+     */
+    void setScratchDirectory(const std::string &dir);
+
+
+    /**
+     * @brief An SRSC container assembled from records built in memory.
+     *
+     * SrscFile can only read from disk, so the container is written to a scratch file once open() is called. The file
+     * is removed again when this is destroyed. It is small enough to stay in the page cache, so benchmarks reading from
+     * it are not IO bound.
+     */
+    class SyntheticSrscFile
+    {
+    public:
+
+        explicit SyntheticSrscFile(const std::string &name);
+        SyntheticSrscFile(const SyntheticSrscFile &f) = delete;
+        ~SyntheticSrscFile();
+
+        void addRecord(od::SrscRecordType type, od::RecordId id, std::vector<char> data);
+
+        od::SrscFile &open();
+
+
+    private:
+
+        struct Record
+        {
+            od::RecordType type;
+            od::RecordId id;
+            std::vector<char> data;
+        };
+
+        std::string mPath;
+        std::vector<Record> mRecords;
+        std::unique_ptr<od::SrscFile> mFile;
+    };
+
+}
+
+#endif /* INCLUDE_ODBENCH_SYNTHETICDATA_H_ */
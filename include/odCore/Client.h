@@ -63,6 +63,7 @@ namespace odState
 namespace od
 {
     class Level;
+    class LocalDownlinkConnector;
 
     class Client
     {
@@ -97,6 +98,12 @@ namespace od
 
         void loadLevel(const FilePath &lvlPath);
 
+        /**
+         * @brief Runs the client until setIsDone(true) is called.
+         *
+         * Rendering happens on the calling thread, while the simulation (level updates, physics, input, state and event
+         * processing) runs on a separate thread at a fixed rate.
+         */
         void run();
 
         /**
@@ -109,6 +116,9 @@ namespace od
 
         friend class LocalDownlinkConnector;
 
+        void _runSimulation();
+        void _tickSimulation(LocalDownlinkConnector &localDownlinkConnector, double &clientTime, double relTime);
+
         odDb::DbManager &mDbManager;
         odRfl::RflManager &mRflManager;
         odRender::Renderer &mRenderer;
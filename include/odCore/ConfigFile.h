@@ -8,6 +8,9 @@
 #ifndef INCLUDE_ODCORE_CONFIGFILE_H_
 #define INCLUDE_ODCORE_CONFIGFILE_H_
 
+#include <any>
+#include <array>
+#include <cstdint>
 #include <string>
 #include <unordered_map>
 #include <istream>
@@ -23,12 +26,47 @@ namespace od
      * @brief Simple INI-style config file parser.
      *
      * Supports sections, key=value or key:value style, non-associative arguments and typed access via templates.
+     * Lines starting with # are comments.
+     *
+     * Values can be set on multiple layers. A value set on a higher layer overrides the same key on all lower layers, so
+     * defaults, the config file and command line options can be applied in any order.
+     *
+     * Typed accessors parse a value only once and cache the result until the value changes. This makes repeated
+     * lookups cheap, but also means that lookups are not thread-safe.
      */
     class ConfigFile
     {
     public:
 
-        void parse(std::istream &in);
+        enum class Layer
+        {
+            DEFAULTS,
+            FILE,
+            COMMAND_LINE
+        };
+
+        static constexpr size_t LAYER_COUNT = 3;
+
+        /**
+         * @brief Reads INI-style lines from in and adds them to the given layer.
+         *
+         * Panics with the line and column of the problem if the input is malformed.
+         */
+        void parse(std::istream &in, Layer layer = Layer::FILE);
+
+        /**
+         * @brief Applies an override of the form "section.key=value" (or "key=value" for keys outside any section).
+         *
+         * Meant for command line arguments. Panics if the override is malformed.
+         */
+        void applyOverride(const std::string &assignment, Layer layer = Layer::COMMAND_LINE);
+
+        void set(Layer layer, const std::string &section, const std::string &key, const std::string &value);
+
+        /**
+         * @brief Removes all values and non-associative arguments of a layer. Use this before parsing a reloaded file.
+         */
+        void clear(Layer layer);
 
         /**
          * @brief Accesses a value, trying to parse it as a certain type.
@@ -37,8 +75,7 @@ namespace od
          *
          * If the key can not be found or not be parsed, this method will panic.
          *
-         * A specialization for T=std::string is provided, which gives direct access to the key's value without
-         * parsing anything.
+         * Besides anything that can be read from a stream, bools can be given as true/false, yes/no, on/off or 1/0.
          */
         template <typename T>
         T get(const std::string &section, const std::string &key);
@@ -52,17 +89,59 @@ namespace od
         template <typename T>
         T get(const std::string &section, const std::string &key, const T &defaultValue);
 
+        /**
+         * @brief Returns the non-associative arguments of a section from the highest layer that has any.
+         */
         const std::vector<std::string> &getRawValuesInSection(const std::string &section);
 
 
     private:
 
+        struct Entry
+        {
+            Entry()
+            : layerMask(0)
+            {
+            }
+
+            const std::string &getValue() const;
+
+            std::array<std::string, LAYER_COUNT> layerValues;
+            uint8_t layerMask;
+
+            // parsed form of getValue(), of the type that was last asked for. empty if it changed since
+            std::any parsed;
+        };
+
         struct Section
         {
-            std::unordered_map<std::string, std::string> keyValueMap;
-            std::vector<std::string> rawValueList;
+            std::unordered_map<std::string, Entry> entries;
+            std::array<std::vector<std::string>, LAYER_COUNT> rawValueLists;
         };
 
+        Entry *_findEntry(const std::string &section, const std::string &key);
+
+        template <typename T>
+        const T *_getParsed(Entry &entry);
+
+        template <typename T>
+        static bool _parseValue(const std::string &str, T &value)
+        {
+            std::istringstream iss(str);
+            iss >> value;
+            if(iss.fail())
+            {
+                return false;
+            }
+
+            // the whole value has to be consumed. otherwise "12abc" would silently be read as 12
+            iss >> std::ws;
+            return iss.eof();
+        }
+
+        static bool _parseValue(const std::string &str, std::string &value);
+        static bool _parseValue(const std::string &str, bool &value);
+
         std::unordered_map<std::string, Section> mSections;
 
     };
@@ -70,52 +149,58 @@ namespace od
     template <typename T>
     T ConfigFile::get(const std::string &section, const std::string &key)
     {
-        std::istringstream iss(get<std::string>(section, key));
-
-        T value;
-        iss >> value;
+        Entry *entry = _findEntry(section, key);
+        if(entry == nullptr)
+        {
+            OD_PANIC() << "Key not found in config file: [" << section << "] " << key;
+        }
 
-        if(iss.bad())
+        const T *value = _getParsed<T>(*entry);
+        if(value == nullptr)
         {
-            OD_PANIC() << "Failed to parse key in config file: " << key;
+            OD_PANIC() << "Failed to parse key in config file: [" << section << "] " << key << " = " << entry->getValue();
         }
 
-        return value;
+        return *value;
     }
 
     template <typename T>
     T ConfigFile::get(const std::string &section, const std::string &key, const T &defaultValue)
     {
-        auto sectionIt = mSections.find(section);
-        if(sectionIt == mSections.end())
+        Entry *entry = _findEntry(section, key);
+        if(entry == nullptr)
         {
             return defaultValue;
         }
 
-        auto keyIt = sectionIt->second.keyValueMap.find(key);
-        if(keyIt == sectionIt->second.keyValueMap.end())
+        const T *value = _getParsed<T>(*entry);
+        if(value == nullptr)
         {
             return defaultValue;
         }
 
-        std::istringstream iss(keyIt->second);
-
-        T value;
-        iss >> value;
+        return *value;
+    }
 
-        if(iss.bad())
+    template <typename T>
+    const T *ConfigFile::_getParsed(Entry &entry)
+    {
+        const T *cached = std::any_cast<T>(&entry.parsed);
+        if(cached != nullptr)
         {
-            return defaultValue;
+            return cached;
         }
 
-        return value;
-    }
+        T value;
+        if(!_parseValue(entry.getValue(), value))
+        {
+            return nullptr;
+        }
 
-    template <>
-    std::string ConfigFile::get(const std::string &section, const std::string &key);
+        entry.parsed = std::move(value);
 
-    template <>
-    std::string ConfigFile::get(const std::string &section, const std::string &key, const std::string &defaultValue);
+        return std::any_cast<T>(&entry.parsed);
+    }
 
 }
 
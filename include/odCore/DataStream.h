@@ -10,6 +10,7 @@
 
 #include <istream>
 #include <vector>
+#include <array>
 
 #include <odCore/CTypes.h>
 #include <odCore/Logger.h>
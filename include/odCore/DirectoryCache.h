@@ -0,0 +1,48 @@
+/*
+ * DirectoryCache.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: zal
+ */
+
+#ifndef INCLUDE_ODCORE_DIRECTORYCACHE_H_
+#define INCLUDE_ODCORE_DIRECTORYCACHE_H_
+
+#include <string>
+
+namespace od
+{
+
+    /**
+     * @brief Process-wide cache of directory listings used for case-insensitive path resolution.
+     *
+     * Each directory is listed once and its entries are kept in a hash map keyed by their lower-cased name.
+     * A cached listing is thrown away as soon as the directory's modification time or size changes, so
+     * files created after the first lookup will still be found.
+     *
+     * All methods are thread safe. On Windows, where the file system is case-insensitive anyway, nothing is cached.
+     */
+    class DirectoryCache
+    {
+    public:
+
+        /**
+         * @brief Finds the entry in directory \c dirPath whose name matches \c name when ignoring case.
+         *
+         * If several entries match, the first one reported by the OS is used.
+         *
+         * @param realName  Receives the name of the entry as stored in the file system.
+         * @return true if a matching entry was found, false if there was none or the directory could not be accessed.
+         */
+        static bool findIgnoringCase(const std::string &dirPath, const std::string &name, std::string &realName);
+
+        /**
+         * @brief Drops all cached listings.
+         */
+        static void clear();
+
+    };
+
+}
+
+#endif /* INCLUDE_ODCORE_DIRECTORYCACHE_H_ */
@@ -7,6 +7,7 @@
 #define INCLUDE_ENGINE_H_
 
 #include <cassert>
+#include <string>
 
 #include <odCore/FilePath.h>
 
@@ -81,6 +82,13 @@ namespace od
 
     };
 
+    /**
+     * @brief Finds the engine root by ascending from dir until a directory containing rrcFileName is found.
+     *
+     * The file name's case is adjusted on the way. Panics if no such directory exists.
+     */
+    FilePath findEngineRoot(const FilePath &dir, const std::string &rrcFileName);
+
 }
 
 #endif
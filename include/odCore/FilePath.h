@@ -115,6 +115,8 @@ namespace od
 		 * If a part of the path can't be accessed (either because it does not exist or because of insufficient
 		 * permissions, that part of the path is kept as-is.
 		 *
+		 * Directory listings are cached by DirectoryCache, so repeated calls only cost a stat per path component.
+		 *
 		 * On Windows this returns an exact copy without chaning anything right now.
 		 */
 		FilePath adjustCase() const;
@@ -28,11 +28,13 @@ namespace odPhysics
 {
     class PhysicsSystem;
     class LayerHandle;
+    class LayerShape;
 }
 
 namespace odRender
 {
     class Renderer;
+    class PreparedLayerModel;
 }
 
 namespace od
@@ -132,6 +134,14 @@ namespace od
         void loadDefinition(DataReader &dr);
         void loadPolyData(DataReader &dr);
 
+        /**
+         * @brief Builds everything spawn() needs that only depends on this layer's geometry.
+         *
+         * This touches neither the renderer nor the physics world, so it may be called from any thread, even for several
+         * layers at once. The next call to spawn() will use the prepared data instead of building it itself.
+         */
+        void prepareSpawn(odPhysics::PhysicsSystem &physicsSystem, odRender::Renderer *renderer);
+
         void spawn(odPhysics::PhysicsSystem &physicsSystem, odRender::Renderer *renderer);
         void despawn();
 
@@ -191,6 +201,10 @@ namespace od
         std::shared_ptr<odRender::Model> mRenderModel;
         std::shared_ptr<odPhysics::LayerHandle> mPhysicsHandle;
 
+        // built by prepareSpawn(), consumed by spawn()
+        std::shared_ptr<odRender::PreparedLayerModel> mPreparedRenderModel;
+        std::shared_ptr<odPhysics::LayerShape> mPreparedPhysicsShape;
+
         std::vector<glm::vec3> mLocalNormals; // temporary array, unused right now
 
         bool mIsSpawned;
@@ -10,8 +10,11 @@
 
 #include <string>
 #include <vector>
+#include <deque>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <functional>
 #include <unordered_set>
 #include <unordered_map>
 #include <glm/vec3.hpp>
@@ -20,6 +23,7 @@
 #include <odCore/Engine.h>
 #include <odCore/FilePath.h>
 #include <odCore/ObjectRecord.h>
+#include <odCore/TimerWheel.h>
 
 #include <odCore/rfl/Class.h>
 
@@ -36,16 +40,60 @@ namespace od
     {
     public:
 
+        /// Seconds a layer has to be out of the active PVS before it gets despawned.
+        static const float LayerDespawnDelay;
+
+        /// Maximum number of layers spawned per call to update().
+        static const size_t LayerSpawnsPerUpdate;
+
+        /// Maximum number of objects spawned per call to update().
+        static const size_t ObjectSpawnsPerUpdate;
+
+        /// Number of objects whose spawn state is checked per call to update().
+        static const size_t ObjectSpawnChecksPerUpdate;
+
+        /**
+         * @brief The parts loadLevel() is made of. Some of them run concurrently, so progress is reported per stage.
+         */
+        enum class LoadingStage
+        {
+            Dependencies,
+            Layers,
+            ObjectRecords,
+            Objects
+        };
+
+        /**
+         * @brief Called by loadLevel() whenever \c done out of \c total items of \c stage have been loaded.
+         *
+         * Since stages are loaded concurrently, this may be called from worker threads. Calls never overlap, though.
+         */
+        typedef std::function<void(LoadingStage stage, size_t done, size_t total)> LoadingProgressCallback;
+
         Level(Engine engine);
         ~Level();
 
         inline Engine &getEngine() { return mEngine; }
         inline odPhysics::PhysicsSystem &getPhysicsSystem() { return mPhysicsSystem; }
+
+        /**
+         * @brief Returns the wheel for callbacks that should run after some level time. Advanced at the start of each update.
+         */
+        inline TimerWheel &getTimerWheel() { return mTimerWheel; }
         inline float getVerticalExtent() const { return mVerticalExtent; } ///< @return The distance between the lowest and the highest point in terrain
         inline std::shared_ptr<odDb::DependencyTable> getDependencyTable() const { return mDependencyTable; }
 
+        inline void setLoadingProgressCallback(const LoadingProgressCallback &callback) { mLoadingProgressCallback = callback; }
+
         /**
          * @brief Loads a level from the given file.
+         *
+         * Only reading the level file happens in sequence. The databases the level depends on are loaded on a worker thread
+         * while the layers' poly data is decompressed and parsed on others, and the object records are parsed on the calling
+         * thread. Objects are only created once all of that is done, since that requires their classes to be loaded.
+         *
+         * The \c dbManager must not be used by anyone else until this returns.
+         *
          * @param levelPath  A path to the .lvl file.
          * @param dbManager  A DbManager from which to load databases the level depends on.
          */
@@ -53,6 +101,13 @@ namespace od
 
         void addToDestructionQueue(LevelObjectId objId);
 
+        /**
+         * @brief Adds an object to the list of objects that get updated each tick.
+         *
+         * Only called by LevelObject when it becomes active. Inactive objects are dropped from that list at the end of update().
+         */
+        void addToActiveObjects(LevelObject &obj);
+
         Layer *getLayerById(LayerId id);
         Layer *getLayerByIndex(uint16_t index); // FIXME: this should be removed (if possible). the index is really only correct during loading
         void findAdjacentAndOverlappingLayers(Layer *checkLayer, std::vector<Layer*> &results);
@@ -63,10 +118,21 @@ namespace od
         void initialSpawn();
 
         /**
-         * @brief Spawns all objects, regardless of their visibility and SpawnStrategy.
+         * @brief Spawns all objects and layers, regardless of their visibility and SpawnStrategy.
+         *
+         * This is meant for hosts that have no viewer to derive a PVS from. Clients should use initialSpawn()
+         * and let the PVS set by updateViewerPosition() or activateLayerPVS() decide what else gets spawned.
          */
         void spawnAllObjects();
 
+        /**
+         * @brief Spawns all given layers that are not spawned yet.
+         *
+         * Their render models and collision shapes are built concurrently on worker threads. Only adding them to the
+         * renderer and the physics world happens on the calling thread.
+         */
+        void spawnLayers(const std::vector<Layer*> &layers);
+
         void update(float relTime);
 
         /**
@@ -98,8 +164,34 @@ namespace od
          */
         void findObjectsOfType(odRfl::ClassId id, std::vector<std::shared_ptr<LevelObject>> &results);
 
+        /**
+         * @brief Makes the PVS of \c layer (including \c layer itself) the set of visible layers.
+         *
+         * This does not spawn anything right away. Layers entering the PVS are queued and spawned gradually
+         * during update(), objects with SpawnStrategy::WhenInSight follow the layer they are associated with.
+         * Layers leaving the PVS are only despawned after they have been out of it for LayerDespawnDelay
+         * seconds, so moving back and forth between two layers won't cause them to be rebuilt every time.
+         *
+         * Passing nullptr makes all layers leave the PVS.
+         */
         void activateLayerPVS(Layer *layer);
 
+        /**
+         * @brief Activates the PVS of the layer the viewer at \c viewerPos is standing on, if it differs from the current one.
+         *
+         * If no layer can be found below the viewer, the current PVS is kept.
+         */
+        void updateViewerPosition(const glm::vec3 &viewerPos);
+
+        /**
+         * @brief Finds the highest non-ceiling layer that lies below \c pos and has no hole at that point.
+         *
+         * This works purely on layer geometry, so it can be used for layers that are not spawned.
+         *
+         * @return The layer below \c pos or nullptr if none found.
+         */
+        Layer *findLayerBelow(const glm::vec3 &pos);
+
         void calculateInitialLayerAssociations();
 
         template <typename F>
@@ -114,15 +206,43 @@ namespace od
 
     private:
 
-        void _loadNameAndDeps(SrscFile &file, odDb::DbManager &dbManager);
-        void _loadLayers(SrscFile &file);
+        struct DependencyDefinition
+        {
+            uint16_t index;
+            FilePath path;
+        };
+
+        std::vector<DependencyDefinition> _loadNameAndDepDefinitions(SrscFile &file);
+        void _loadDependencies(const std::vector<DependencyDefinition> &dependencies, odDb::DbManager &dbManager);
+        void _loadLayerDefinitions(SrscFile &file, std::vector<std::vector<char>> &compressedPolyData);
+        void _loadLayerPolyData(const std::vector<std::vector<char>> &compressedPolyData);
         void _loadLayerGroups(SrscFile &file);
-        void _loadObjects(SrscFile &file, odDb::DbManager &dbManage);
+        void _loadObjectRecords(SrscFile &file);
+        bool _loadObjectRecordCache(const FilePath &cachePath, uint64_t levelFileSize, uint32_t recordHash, size_t expectedObjectCount);
+        void _writeObjectRecordCache(const FilePath &cachePath, uint64_t levelFileSize, uint32_t recordHash);
+        void _createObjects();
+
+        void _reportProgress(LoadingStage stage, size_t done, size_t total);
+
+        void _updateSpawning(float relTime);
+        bool _isObjectInSight(LevelObject &obj);
+
+        struct LayerStreamingState
+        {
+            bool inPvs;
+            bool queued;
+            float timeOutsidePvs;
+        };
 
         Engine mEngine;
         odPhysics::PhysicsSystem &mPhysicsSystem;
         odRender::Renderer *mRenderer;
 
+        TimerWheel mTimerWheel;
+
+        LoadingProgressCallback mLoadingProgressCallback;
+        std::mutex mLoadingProgressMutex;
+
         std::string mLevelName;
         uint32_t mMaxWidth;
         uint32_t mMaxHeight;
@@ -134,10 +254,20 @@ namespace od
 		float mVerticalExtent;
 		Layer *mCurrentActivePvsLayer;
 
+        // PVS streaming. only active once activateLayerPVS() has been called, so levels that spawn everything up front are unaffected
+        bool mPvsStreamingActive;
+        std::vector<LayerStreamingState> mLayerStreamingStates; // indexed like mLayers
+        std::deque<size_t> mLayerSpawnQueue;
+        std::vector<Layer*> mLayersToSpawn; // only kept as a member so we don't allocate every update
+        std::vector<LevelObjectId> mStreamedObjectIds;
+        size_t mObjectSpawnCheckCursor;
+        glm::vec3 mLastViewerPosition;
+
         std::unordered_set<LevelObjectId> mDestructionQueue;
 
         std::vector<std::unique_ptr<Layer>> mLayers;
         std::unordered_map<LevelObjectId, std::shared_ptr<LevelObject>> mLevelObjects;
+        std::vector<LevelObject*> mActiveObjects; // may contain objects that went inactive this tick. see LevelObject::isActive()
     };
 
 
@@ -99,6 +99,7 @@ namespace od
         inline void setSpawnStrategy(SpawnStrategy s) { mSpawnStrategy = s; }
         inline SpawnStrategy getSpawnStrategy() const { return mSpawnStrategy; }
         inline bool isSpawned() const { return mIsSpawned; }
+        inline bool isActive() const { return mIsActive; } ///< @return true if this object is spawned and has per-tick work to do (update hooks or an animation)
         inline const std::vector<LevelObjectId> &getLinkedObjects() const { return mLinkedObjects; }
         inline Layer *getLightSourceLayer() { return mLightingLayer; }
         inline bool isVisible() const { return mStates.visibility.get(); }
@@ -256,6 +257,9 @@ namespace od
     private:
 
         friend class HandleVisitor;
+        friend class Level;
+
+        void _updateActiveState();
 
         Level &mLevel;
 
@@ -272,6 +276,9 @@ namespace od
         bool mIsSpawned;
         SpawnStrategy mSpawnStrategy;
 
+        bool mIsActive;
+        bool mIsInActiveList; // managed by Level. might stay true for a tick after we became inactive
+
         Layer *mAssociatedLayer;
         bool mAssociateWithCeiling;
 
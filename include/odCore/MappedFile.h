@@ -0,0 +1,50 @@
+/*
+ * MappedFile.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: zal
+ */
+
+#ifndef INCLUDE_ODCORE_MAPPEDFILE_H_
+#define INCLUDE_ODCORE_MAPPEDFILE_H_
+
+#include <vector>
+
+#include <odCore/CTypes.h>
+#include <odCore/FilePath.h>
+
+namespace od
+{
+
+    /**
+     * @brief Read-only view of a whole file in memory.
+     *
+     * On POSIX systems, the file is memory-mapped, so only the pages that are actually accessed are read from disk
+     * and the OS can share and evict them as it sees fit. Elsewhere, the file is read into memory as a whole.
+     */
+    class MappedFile
+    {
+    public:
+
+        MappedFile(const FilePath &path);
+        MappedFile(const MappedFile &f) = delete;
+        ~MappedFile();
+
+        inline const FilePath &getFilePath() const { return mFilePath; }
+        inline const char *data() const { return mData; }
+        inline size_t size() const { return mSize; }
+
+
+    private:
+
+        FilePath mFilePath;
+        const char *mData;
+        size_t mSize;
+
+        std::vector<char> mFallbackBuffer;
+
+    };
+
+}
+
+#endif /* INCLUDE_ODCORE_MAPPEDFILE_H_ */
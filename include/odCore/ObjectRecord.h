@@ -25,8 +25,25 @@ namespace od
         static constexpr uint32_t FLAG_OBJECT_FLAG_SCALED  = 0x100;
 
         explicit ObjectRecordData(DataReader &dr);
+
+        /**
+         * @brief Creates an empty record, to be filled using loadFromCache().
+         */
+        ObjectRecordData();
+
         ObjectRecordData(ObjectRecordData &&o) = default;
 
+        /**
+         * @brief Reads a record in the format written by writeToCache(), never reading past the stream offset end.
+         *
+         * Position and rotation are cached already converted, so none of the math in the record constructor is repeated.
+         *
+         * @return false if the record is corrupt. The contents of this are undefined then.
+         */
+        bool loadFromCache(DataReader &dr, size_t end, const odRfl::FieldNameTable &fieldNames);
+
+        void writeToCache(DataWriter &dw, odRfl::FieldNameTable &fieldNames) const;
+
         inline LevelObjectId getObjectId() const { return mId; }
         inline odDb::AssetRef getClassRef() const { return mClassRef; }
         inline LayerId getLightSourceLayerId() const { return mLightingLayerId; }
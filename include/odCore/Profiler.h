@@ -0,0 +1,203 @@
+/*
+ * Profiler.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: zal
+ */
+
+#ifndef INCLUDE_ODCORE_PROFILER_H_
+#define INCLUDE_ODCORE_PROFILER_H_
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace od
+{
+
+    enum class ProfileCounter
+    {
+        OBJECTS_UPDATED,
+        RAY_TESTS,
+        CONTACT_TESTS,
+        SNAPSHOT_BYTES,
+        EVENTS_DISPATCHED
+    };
+
+    /**
+     * @brief Records timed zones and counters per thread and exports them as Chrome trace events.
+     *
+     * Use the OD_PROFILE_* macros instead of calling this directly. If the engine is built without ENABLE_PROFILER,
+     * they expand to nothing.
+     *
+     * Recording is off until enabled via setEnabled(). A disabled zone costs a single relaxed atomic load. An enabled
+     * one costs two clock reads and an append to a buffer owned by the recording thread. Zones nest, and since trace
+     * viewers derive the hierarchy from the timestamps, no explicit parent links are stored.
+     *
+     * Counters are summed per thread and written as one sample per thread whenever OD_PROFILE_TICK() is called, so
+     * they show up as per-tick values aligned with the tick zones.
+     *
+     * The resulting JSON can be loaded in chrome://tracing, Perfetto or Speedscope.
+     */
+    class Profiler
+    {
+    public:
+
+        using Clock = std::chrono::steady_clock;
+
+        static constexpr size_t COUNTER_COUNT = 5;
+
+        // keeps memory bounded if nobody ever exports. at 24 bytes per event, this is about 100MiB per thread
+        static constexpr size_t MAX_EVENTS_PER_THREAD = 1 << 22;
+
+        static Profiler &getInstance();
+
+        static const char *getCounterName(ProfileCounter counter);
+
+        inline bool isEnabled() const { return mEnabled.load(std::memory_order_relaxed); }
+
+        void setEnabled(bool b);
+
+        /**
+         * @brief Names the calling thread in exported traces. Threads that are never named show up with a number only.
+         */
+        void setCurrentThreadName(const char *name);
+
+        inline void recordZone(const char *name, Clock::time_point start, Clock::time_point end)
+        {
+            ThreadBuffer &buffer = _getThreadBuffer();
+            std::lock_guard<std::mutex> lock(buffer.mutex);
+            if(buffer.events.size() >= MAX_EVENTS_PER_THREAD)
+            {
+                ++buffer.droppedEventCount;
+                return;
+            }
+
+            buffer.events.push_back({name, start, end});
+        }
+
+        inline void addToCounter(ProfileCounter counter, int64_t amount)
+        {
+            if(!isEnabled()) return;
+
+            // only the owning thread ever writes these, so no lock needed. export only reads the finished samples
+            _getThreadBuffer().counters[static_cast<size_t>(counter)] += amount;
+        }
+
+        /**
+         * @brief Stores the counters of the calling thread as a sample and resets them.
+         */
+        void sampleCounters();
+
+        /**
+         * @brief Writes everything recorded so far as a Chrome trace_event JSON object.
+         *
+         * Recording may continue while this runs.
+         */
+        void writeChromeTrace(std::ostream &out);
+
+        /**
+         * @brief Discards all recorded events and samples.
+         */
+        void clear();
+
+
+    private:
+
+        struct Event
+        {
+            const char *name; // always a string literal, so we don't need to copy it
+            Clock::time_point start;
+            Clock::time_point end;
+        };
+
+        struct CounterSample
+        {
+            Clock::time_point time;
+            std::array<int64_t, COUNTER_COUNT> values;
+        };
+
+        struct ThreadBuffer
+        {
+            uint32_t threadId;
+            std::string threadName;
+
+            std::mutex mutex; // only ever contended while exporting
+            std::vector<Event> events;
+            std::vector<CounterSample> counterSamples;
+            size_t droppedEventCount;
+
+            std::array<int64_t, COUNTER_COUNT> counters;
+        };
+
+        Profiler();
+
+        ThreadBuffer &_getThreadBuffer();
+        ThreadBuffer &_createThreadBuffer();
+
+        std::atomic<bool> mEnabled;
+        Clock::time_point mEpoch;
+
+        std::mutex mThreadBuffersMutex;
+        std::vector<std::unique_ptr<ThreadBuffer>> mThreadBuffers; // kept after their threads die so their events survive until export
+
+    };
+
+    /**
+     * @brief RAII helper recording the time between it's construction and destruction as a zone.
+     */
+    class ProfileZone
+    {
+    public:
+
+        ProfileZone(const char *name)
+        : mName(Profiler::getInstance().isEnabled() ? name : nullptr)
+        {
+            if(mName != nullptr)
+            {
+                mStart = Profiler::Clock::now();
+            }
+        }
+
+        ProfileZone(const ProfileZone &z) = delete;
+
+        ~ProfileZone()
+        {
+            if(mName != nullptr)
+            {
+                Profiler::getInstance().recordZone(mName, mStart, Profiler::Clock::now());
+            }
+        }
+
+
+    private:
+
+        const char *mName;
+        Profiler::Clock::time_point mStart;
+
+    };
+
+}
+
+#define OD_PROFILE_CONCAT_IMPL(a, b) a##b
+#define OD_PROFILE_CONCAT(a, b) OD_PROFILE_CONCAT_IMPL(a, b)
+
+#ifdef OD_ENABLE_PROFILER
+    #define OD_PROFILE_ZONE(name) od::ProfileZone OD_PROFILE_CONCAT(odProfileZone_, __LINE__)(name)
+    #define OD_PROFILE_COUNT(counter, amount) od::Profiler::getInstance().addToCounter(od::ProfileCounter::counter, (amount))
+    #define OD_PROFILE_TICK() od::Profiler::getInstance().sampleCounters()
+    #define OD_PROFILE_THREAD_NAME(name) od::Profiler::getInstance().setCurrentThreadName(name)
+#else
+    #define OD_PROFILE_ZONE(name) do {} while(false)
+    #define OD_PROFILE_COUNT(counter, amount) do {} while(false)
+    #define OD_PROFILE_TICK() do {} while(false)
+    #define OD_PROFILE_THREAD_NAME(name) do {} while(false)
+#endif
+
+#endif /* INCLUDE_ODCORE_PROFILER_H_ */
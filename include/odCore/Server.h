@@ -166,8 +166,21 @@ namespace od
 
         void loadLevel(const FilePath &path);
 
+        /**
+         * @brief Runs the main server loop, calling tick() at 60 Hz until setIsDone(true) is called.
+         */
         void run();
 
+        /**
+         * @brief Advances the simulation by relTime seconds and sends updates to all clients.
+         *
+         * This is what run() does every iteration. It is exposed so tools can step the server
+         * themselves, e.g. to measure tick times. Never call this while run() is active.
+         *
+         * A level must have been loaded before calling this.
+         */
+        void tick(double relTime);
+
 
     private:
 
@@ -10,6 +10,7 @@
 
 #include <string>
 #include <vector>
+#include <unordered_map>
 #include <fstream>
 #include <mutex>
 
@@ -107,9 +108,21 @@ namespace od
 
 	protected:
 
+		/// Directory indices in ascending order
+		typedef std::vector<uint16_t> IndexList;
+
 		void _readHeaderAndDirectory();
+		void _buildIndices();
 		void _checkDirIterator(const DirIterator &it);
 
+		// these return nullptr if no record matches
+		const IndexList *_getTypeIndex(RecordType type) const;
+		const IndexList *_getIdIndex(RecordId id) const;
+		const IndexList *_getTypeIdIndex(RecordType type, RecordId id) const;
+
+		DirIterator _getFirstInIndex(const IndexList *indexList);
+		bool _stepToNextInIndex(DirIterator &it, const IndexList *indexList, int32_t maxDistance);
+
 		FilePath mFilePath;
 		std::ifstream mInputStream;
 
@@ -117,6 +130,11 @@ namespace od
 		uint32_t mDirectoryOffset;
 		std::vector<DirEntry> mDirectory;
 
+		// built once after reading the directory so lookups don't have to scan it
+		std::unordered_map<RecordType, IndexList> mTypeIndex;
+		std::unordered_map<RecordId, IndexList> mIdIndex;
+		std::unordered_map<uint32_t, IndexList> mTypeIdIndex; // key is (type << 16) | id
+
 		std::mutex mMutex;
 	};
 
@@ -3,6 +3,16 @@
 #define INCLUDE_THREADUTILS_H_
 
 #include <thread>
+#include <atomic>
+#include <future>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <exception>
+#include <algorithm>
 
 namespace od
 {
@@ -21,6 +31,124 @@ namespace od
          */
         void setThreadName(std::thread &thread, const char *name);
 
+        /**
+         * @brief A fixed set of threads running posted tasks in the order they were posted.
+         *
+         * Threads are started in the constructor and joined in the destructor, after the tasks left in the queue
+         * have been run.
+         */
+        class WorkerPool
+        {
+        public:
+
+            WorkerPool(size_t threadCount);
+            WorkerPool(const WorkerPool &p) = delete;
+            ~WorkerPool();
+
+            inline size_t getThreadCount() const { return mThreads.size(); }
+
+            void post(std::function<void()> task);
+
+            /**
+             * @brief Returns the pool used by parallelFor(), with one thread less than there are hardware threads.
+             *
+             * The pool is created on first use.
+             */
+            static WorkerPool &getSharedPool();
+
+
+        private:
+
+            void _work();
+
+            std::vector<std::thread> mThreads;
+
+            std::mutex mMutex;
+            std::condition_variable mCondition;
+            std::deque<std::function<void()>> mTasks;
+            bool mTerminate;
+        };
+
+        /**
+         * @brief Calls f(i) for every i in [0, count) on a number of threads and returns once all calls are done.
+         *
+         * The calling thread does its share of the work, too. The others are borrowed from the shared WorkerPool, so
+         * frequent calls with small counts don't pay for starting threads. Calls with a count of 1 run inline.
+         * \c busyThreads hardware threads are assumed to be occupied with something else and won't get a worker. An
+         * exception thrown by any of the calls is rethrown on the calling thread once all workers are done.
+         */
+        template <typename F>
+        void parallelFor(size_t count, const F &f, size_t busyThreads = 0)
+        {
+            size_t hardwareThreads = std::thread::hardware_concurrency();
+            size_t threadCount = (hardwareThreads > busyThreads + 1) ? (hardwareThreads - busyThreads) : 1;
+            threadCount = std::min(threadCount, count);
+
+            if(threadCount <= 1)
+            {
+                for(size_t i = 0; i < count; ++i)
+                {
+                    f(i);
+                }
+
+                return;
+            }
+
+            WorkerPool &pool = WorkerPool::getSharedPool();
+            threadCount = std::min(threadCount, pool.getThreadCount() + 1);
+
+            struct Helper
+            {
+                std::once_flag once;
+                std::exception_ptr error;
+            };
+
+            std::atomic<size_t> nextIndex(0);
+            auto work = [&nextIndex, &f, count](Helper &helper)
+            {
+                try
+                {
+                    for(size_t i = nextIndex++; i < count; i = nextIndex++)
+                    {
+                        f(i);
+                    }
+
+                }catch(...)
+                {
+                    helper.error = std::current_exception();
+                }
+            };
+
+            // like an AssetPrefetcher request, a helper not yet picked up by a pool thread when we are done is run
+            //  by us instead (finding no work left), so we never wait in the pool's queue. a pool thread getting to it
+            //  later finds it done and never touches our stack
+            std::vector<std::shared_ptr<Helper>> helpers;
+            helpers.reserve(threadCount);
+            for(size_t i = 0; i < threadCount; ++i)
+            {
+                helpers.push_back(std::make_shared<Helper>());
+            }
+
+            for(size_t i = 1; i < threadCount; ++i)
+            {
+                std::shared_ptr<Helper> helper = helpers[i];
+                pool.post([helper, &work](){ std::call_once(helper->once, work, std::ref(*helper)); });
+            }
+
+            for(auto &helper : helpers)
+            {
+                std::call_once(helper->once, work, std::ref(*helper));
+            }
+
+            for(auto &helper : helpers)
+            {
+                if(helper->error != nullptr)
+                {
+                    std::rethrow_exception(helper->error);
+                }
+            }
+        }
+
     }
 
 }
@@ -0,0 +1,125 @@
+/*
+ * TimerWheel.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: zal
+ */
+
+#ifndef INCLUDE_ODCORE_TIMERWHEEL_H_
+#define INCLUDE_ODCORE_TIMERWHEEL_H_
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace od
+{
+
+    class TimerHandle;
+
+    /**
+     * @brief Hierarchical timer wheel for callbacks that should run after a given amount of level time.
+     *
+     * Lets objects that only wait for a deadline stay out of the level's update loop. Time advances in ticks of
+     * 1/TICKS_PER_SECOND seconds, so callbacks may fire up to one tick late. Scheduling and cancelling is O(1), and
+     * advancing only touches slots that are due.
+     *
+     * Callbacks run from within advance() in the order of their deadlines. They may schedule or cancel timers.
+     *
+     * Not thread safe. A level's wheel must only be used from the thread updating that level.
+     */
+    class TimerWheel
+    {
+    public:
+
+        typedef std::function<void()> Callback;
+
+        static constexpr uint32_t TICKS_PER_SECOND = 100;
+
+        TimerWheel();
+        TimerWheel(const TimerWheel &w) = delete;
+
+        /**
+         * @brief Returns the time that has been advanced so far, in seconds. Precise to one tick.
+         */
+        double getTime() const;
+
+        /**
+         * @brief Makes the wheel call the given callback once \c delay seconds have passed.
+         *
+         * If \c repeatInterval is positive, the callback is called again every \c repeatInterval seconds after that
+         * until the returned handle is cancelled.
+         *
+         * The callback is cancelled as soon as the returned handle is destroyed, so it is safe to capture the handle's
+         * owner in the callback. Ignoring the returned handle thus makes the call a no-op.
+         */
+        TimerHandle schedule(float delay, Callback callback, float repeatInterval = 0.0f);
+
+        void advance(float relTime);
+
+
+    private:
+
+        friend class TimerHandle;
+
+        struct Entry
+        {
+            uint64_t deadline;
+            uint64_t interval;
+            Callback callback;
+            bool finished; // cancelled or, for one-shot timers, already called
+        };
+
+        static constexpr size_t LEVEL_BITS = 6;
+        static constexpr size_t SLOTS_PER_LEVEL = 1 << LEVEL_BITS;
+        static constexpr size_t LEVEL_COUNT = 4;
+
+        typedef std::vector<std::shared_ptr<Entry>> Slot;
+
+        void _insert(std::shared_ptr<Entry> entry);
+        void _cascade(size_t level);
+        void _tick();
+
+        uint64_t mCurrentTick;
+        float mTickRemainder;
+        std::array<std::array<Slot, SLOTS_PER_LEVEL>, LEVEL_COUNT> mLevels;
+    };
+
+
+    /**
+     * @brief Token for a callback scheduled on a TimerWheel. Cancels the callback when destroyed.
+     *
+     * Handles do not reference the wheel, so they may outlive it.
+     */
+    class TimerHandle
+    {
+    public:
+
+        TimerHandle() = default;
+        TimerHandle(TimerHandle &&h) = default;
+        ~TimerHandle();
+
+        TimerHandle &operator=(TimerHandle &&h);
+
+        /**
+         * @brief Returns true if the callback has not been cancelled and will be called at least once more.
+         */
+        bool isPending() const;
+
+        void cancel();
+
+
+    private:
+
+        friend class TimerWheel;
+
+        TimerHandle(std::shared_ptr<TimerWheel::Entry> entry);
+
+        std::shared_ptr<TimerWheel::Entry> mEntry;
+    };
+
+}
+
+#endif /* INCLUDE_ODCORE_TIMERWHEEL_H_ */
@@ -71,7 +71,7 @@ namespace odAnim
 
         private:
 
-            void _flattenRecursive(odRender::Rig &rig, const glm::mat4 &parentMatrix);
+            void _flattenRecursive(std::vector<glm::mat4> &flattened, const glm::mat4 &parentMatrix);
 
             Skeleton &mSkeleton;
             Bone *mParent;
@@ -102,6 +102,9 @@ namespace odAnim
             }
         }
 
+        /**
+         * @brief Calculates the model space transforms of all bones and passes them to the rig in a single call.
+         */
         void flatten(odRender::Rig &rig);
         bool checkForLoops(); ///< @brief Returns true if skeleton has loops
 
@@ -112,6 +115,9 @@ namespace odAnim
         std::vector<Bone> mBones;
         std::vector<Bone*> mRootBones;
 
+        // indexed by joint index. kept around so flattening does not allocate
+        std::vector<glm::mat4> mFlattenedTransforms;
+
     };
 
 }
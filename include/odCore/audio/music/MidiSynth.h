@@ -8,6 +8,8 @@
 #ifndef INCLUDE_ODCORE_AUDIO_MUSIC_MIDISYNTH_H_
 #define INCLUDE_ODCORE_AUDIO_MUSIC_MIDISYNTH_H_
 
+#include <string>
+
 #include <odCore/CTypes.h>
 #include <odCore/Guid.h>
 
@@ -36,6 +38,14 @@ namespace odAudio
         virtual void preloadDls(const od::Guid &dlsGuid) = 0;
         virtual void assignPreset(uint8_t channel, uint32_t bank, uint32_t patch, const od::Guid &dlsGuid) = 0;
 
+        /**
+         * @brief Returns a string identifying this synth and all settings that affect it's output.
+         *
+         * Music rendered by synths with differing keys must not be considered interchangeable. This is used to key
+         * the pre-rendered music cache, so it must only contain characters that are valid in a filename.
+         */
+        virtual std::string getSettingsKey() const = 0;
+
     };
 
 }
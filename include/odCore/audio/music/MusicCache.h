@@ -0,0 +1,146 @@
+/*
+ * MusicCache.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: zal
+ */
+
+#ifndef INCLUDE_ODCORE_AUDIO_MUSIC_MUSICCACHE_H_
+#define INCLUDE_ODCORE_AUDIO_MUSIC_MUSICCACHE_H_
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <fstream>
+
+#include <odCore/CTypes.h>
+#include <odCore/FilePath.h>
+#include <odCore/ZStream.h>
+
+namespace odAudio
+{
+
+    typedef uint32_t MusicId;
+
+    /**
+     * @brief Disk cache for music that has been pre-rendered using a MusicRenderer.
+     *
+     * Entries are zlib-compressed interleaved stereo PCM, keyed by music ID, the synth's settings key and the sample rate.
+     * Each entry also stores a hash of the segment data it was rendered from, so renders of a segment that has since
+     * changed in the music container are discarded. Playing music from here instead of synthesizing it in realtime
+     * takes the synth out of the audio thread entirely.
+     */
+    class MusicCache
+    {
+    public:
+
+        /**
+         * @brief Streams cached PCM data from a cache file, decompressing it on the fly.
+         */
+        class Stream
+        {
+        public:
+
+            Stream(const od::FilePath &path, size_t sampleCount, std::streamoff dataOffset);
+            Stream(const Stream &s) = delete;
+
+            inline bool isAtEnd() const { return mSamplesLeft == 0; }
+
+            /**
+             * @brief Fills the buffer with the next \c size interleaved samples. Pads with silence once the end is reached.
+             */
+            void read(int16_t *buffer, size_t size);
+
+
+        private:
+
+            std::ifstream mInput;
+            std::unique_ptr<od::ZStream> mZStream;
+            size_t mSamplesLeft;
+        };
+
+        /**
+         * @brief Compresses PCM into a new cache entry chunk by chunk, so a whole segment never has to be held in memory.
+         *
+         * The entry is written to a temporary file and only replaces the cache file in commit(), so streams opened
+         * meanwhile never see a partial entry. If the writer is destroyed without committing, the temporary file is deleted.
+         */
+        class Writer
+        {
+        public:
+
+            Writer(const od::FilePath &path, uint32_t sampleRate, uint32_t segmentHash);
+            Writer(const Writer &w) = delete;
+            ~Writer();
+
+            inline bool hasFailed() const { return mFailed; }
+
+            /**
+             * @brief Compresses and writes the next \c size interleaved samples.
+             *
+             * @return false if writing failed. The entry can't be committed then.
+             */
+            bool write(const int16_t *samples, size_t size);
+
+            /**
+             * @brief Finishes the entry and moves it into place.
+             *
+             * @return false if anything went wrong while writing. No entry is created then.
+             */
+            bool commit();
+
+
+        private:
+
+            bool _deflate(int flush);
+
+            od::FilePath mPath;
+            std::string mTmpPath;
+            std::ofstream mOutput;
+            z_stream mZStream;
+            bool mZStreamInitialized;
+            std::vector<char> mOutputBuffer;
+            uint32_t mSampleRate;
+            uint32_t mSegmentHash;
+            size_t mSampleCount;
+            size_t mCompressedSize;
+            bool mFailed;
+        };
+
+        /**
+         * @param cacheDir     Directory where cache files are stored. Must exist.
+         * @param prefix       Prefix for cache file names (like the music container's name), so several containers can share a directory
+         * @param synthKey     Settings key of the synth used for rendering (see MidiSynth::getSettingsKey())
+         * @param sampleRate   Sample rate of the rendered PCM
+         */
+        MusicCache(const od::FilePath &cacheDir, const std::string &prefix, const std::string &synthKey, uint32_t sampleRate);
+
+        od::FilePath getCacheFilePath(MusicId id) const;
+
+        /**
+         * @brief Opens a stream for the cached music with the given ID.
+         *
+         * Returns nullptr if there is no valid cache entry, or if it was rendered from segment data with another hash.
+         */
+        std::unique_ptr<Stream> open(MusicId id, uint32_t segmentHash);
+
+        /**
+         * @brief Starts a new cache entry for the music with the given ID, replacing any existing one once committed.
+         *
+         * @return nullptr if the cache file could not be created (e.g. because the cache directory was not writable).
+         */
+        std::unique_ptr<Writer> beginStore(MusicId id, uint32_t segmentHash);
+
+
+    private:
+
+        od::FilePath mCacheDir;
+        std::string mPrefix;
+        std::string mSynthKey;
+        uint32_t mSampleRate;
+
+    };
+
+}
+
+#endif /* INCLUDE_ODCORE_AUDIO_MUSIC_MUSICCACHE_H_ */
@@ -0,0 +1,85 @@
+/*
+ * MusicRenderer.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: zal
+ */
+
+#ifndef INCLUDE_ODCORE_AUDIO_MUSIC_MUSICRENDERER_H_
+#define INCLUDE_ODCORE_AUDIO_MUSIC_MUSICRENDERER_H_
+
+#include <vector>
+#include <functional>
+#include <memory>
+
+#include <odCore/CTypes.h>
+
+namespace odDb
+{
+    class Segment;
+}
+
+namespace odAudio
+{
+    class MidiSynth;
+
+    /**
+     * @brief Renders segments to PCM offline, i.e. as fast as the synth allows instead of in realtime.
+     *
+     * This drives a SegmentPlayer and a MidiSynth the same way the streaming music source does, only without
+     * waiting for the output device.
+     */
+    class MusicRenderer
+    {
+    public:
+
+        /**
+         * @brief Number of frames synthesized between two updates of the segment player.
+         *
+         * This determines the timing resolution of MIDI events. Keep this close to what realtime playback does.
+         */
+        static const size_t FRAMES_PER_UPDATE = 64;
+
+        /**
+         * @brief Seconds of audio rendered past the last event of a segment, so released notes can fade out.
+         */
+        static constexpr double RELEASE_TAIL_SECONDS = 2.0;
+
+        /**
+         * @brief Upper limit for the length of a rendered segment in seconds. Guards against broken segment lengths.
+         */
+        static constexpr double MAX_LENGTH_SECONDS = 30*60.0;
+
+        /**
+         * @brief Number of frames handed to the chunk consumer at once. Only the last chunk of a segment may be shorter.
+         */
+        static const size_t FRAMES_PER_CHUNK = 16384;
+
+        /**
+         * @brief Receives a chunk of rendered interleaved stereo samples. Returning false aborts rendering.
+         */
+        using ChunkConsumer = std::function<bool(const int16_t *samples, size_t size)>;
+
+        MusicRenderer(MidiSynth &synth, uint32_t sampleRate);
+
+        /**
+         * @brief Plays the passed segment from start to end, passing the synthesized audio to the consumer in chunks.
+         *
+         * Only one chunk is held in memory at a time, so rendering long segments stays cheap. The synth should be fresh
+         * or at least silent, as no reset is performed before rendering.
+         *
+         * @return false if the consumer aborted rendering.
+         */
+        bool render(std::shared_ptr<odDb::Segment> segment, const ChunkConsumer &consumer);
+
+
+    private:
+
+        MidiSynth &mSynth;
+        uint32_t mSampleRate;
+
+    };
+
+}
+
+#endif /* INCLUDE_ODCORE_AUDIO_MUSIC_MUSICRENDERER_H_ */
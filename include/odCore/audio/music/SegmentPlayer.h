@@ -34,6 +34,8 @@ namespace odAudio
         SegmentPlayer(MidiSynth &synth);
         ~SegmentPlayer();
 
+        inline double getCurrentMusicTime() const { return mCurrentMusicTime; }
+
         void setSegment(std::shared_ptr<odDb::Segment> s);
 
         void play();
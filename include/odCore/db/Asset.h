@@ -60,6 +60,14 @@ namespace odDb
 		 */
 		virtual void postLoad();
 
+		/**
+		 * @brief Returns roughly how many bytes of memory this asset occupies, for the AssetCache's budget.
+		 *
+		 * Assets referenced by this one should not be included, as they are accounted for separately.
+		 * Returns 0 by default.
+		 */
+		virtual size_t getMemoryUsage() const;
+
 
 	private:
 
@@ -0,0 +1,130 @@
+/*
+ * AssetCache.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: zal
+ */
+
+#ifndef INCLUDE_ODCORE_DB_ASSETCACHE_H_
+#define INCLUDE_ODCORE_DB_ASSETCACHE_H_
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace odDb
+{
+    class Asset;
+
+    /**
+     * @brief Keeps recently used assets of one type alive after their last user released them, within a memory budget.
+     *
+     * Asset factories only hold weak references, so without this an asset gets unloaded as soon as nobody uses
+     * it and has to be read and decoded again the next time it is requested. Factories hand every asset they
+     * return to retain(), which keeps it in an LRU list.
+     *
+     * Only assets nobody but the cache is using (idle ones) count towards the budget, as releasing assets that are
+     * still in use frees nothing. When a newly loaded asset pushes the idle assets over budget, idle assets are
+     * released in least-recently-used order until they fit again. Idle-ness is judged by reference count, so it's
+     * only approximate while other threads acquire or release assets.
+     *
+     * All methods are thread-safe. Several factories of the same asset type usually share one cache.
+     */
+    class AssetCache
+    {
+    public:
+
+        struct Statistics
+        {
+            size_t hits; ///< Requests for assets that were still loaded
+            size_t revivals; ///< Hits on idle assets, i.e. loads that would have been necessary without the cache
+            size_t misses; ///< Requests that had to load the asset
+            size_t evictions; ///< Idle assets released to stay within budget
+            size_t entryCount;
+            size_t idleCount;
+            size_t idleBytes;
+        };
+
+        /**
+         * @param assetTypeName  Only used for logging.
+         * @param budget  Maximum total size of idle assets in bytes. 0 disables retention.
+         */
+        AssetCache(const std::string &assetTypeName, size_t budget);
+        AssetCache(const AssetCache &c) = delete;
+        ~AssetCache();
+
+        inline const std::string &getAssetTypeName() const { return mAssetTypeName; }
+
+        void setBudget(size_t budget);
+        size_t getBudget();
+
+        /**
+         * @brief Marks the asset as most recently used, adding it to the cache if it is not in there yet.
+         *
+         * @param wasLoaded  true if the factory just loaded the asset, false if it found it loaded already. Only affects statistics.
+         */
+        template <typename _AssetType>
+        void retain(const std::shared_ptr<_AssetType> &asset, bool wasLoaded)
+        {
+            // take the count before converting to shared_ptr<Asset>, as the converted temporary holds another reference
+            _retain(asset, asset.use_count(), wasLoaded);
+        }
+
+        /**
+         * @brief Releases idle assets until they fit within the budget.
+         *
+         * This happens automatically whenever an asset is loaded. Call it after releasing many assets at
+         * once, like when unloading a level, if their memory is needed before the next asset gets loaded.
+         */
+        void trim();
+
+        /**
+         * @brief Releases all idle assets and forgets about those in use.
+         */
+        void clear();
+
+        /**
+         * @brief Returns the counters accumulated so far and the current state of the cache.
+         *
+         * The latter requires a pass over all entries, so don't call this every frame.
+         */
+        Statistics getStatistics();
+
+        void resetStatistics();
+
+
+    private:
+
+        struct Entry
+        {
+            std::shared_ptr<Asset> asset;
+            size_t size;
+        };
+
+        using EntryList = std::list<Entry>;
+
+        // useCount is the asset's reference count as seen by the caller of retain()
+        void _retain(const std::shared_ptr<Asset> &asset, long useCount, bool wasLoaded);
+
+        // needs mMutex to be held. moves evicted assets into the passed list, so they can be destroyed without holding the lock
+        void _trim(EntryList &evicted);
+
+        std::string mAssetTypeName;
+
+        std::mutex mMutex;
+        size_t mBudget;
+        EntryList mEntries; // most recently used first
+        std::unordered_map<const Asset*, EntryList::iterator> mEntryMap;
+
+        size_t mHits;
+        size_t mRevivals;
+        size_t mMisses;
+        size_t mEvictions;
+
+    };
+
+}
+
+#endif
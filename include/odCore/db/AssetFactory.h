@@ -10,6 +10,7 @@
 
 #include <unordered_map>
 #include <memory>
+#include <mutex>
 #include <vector>
 
 #include <odCore/FilePath.h>
@@ -17,6 +18,7 @@
 #include <odCore/Logger.h>
 
 #include <odCore/db/Asset.h>
+#include <odCore/db/AssetCache.h>
 
 namespace odDb
 {
@@ -39,17 +41,39 @@ namespace odDb
 
 		inline od::SrscFile &getSrscFile() { return mSrscFile; }
 
+		/**
+		 * @brief Assigns a cache that keeps assets loaded by this factory alive for a while after their last use.
+		 *
+		 * By default, there is none and assets are unloaded as soon as they are no longer used. The cache must outlive the factory.
+		 */
+		inline void setAssetCache(AssetCache *cache) { mAssetCache = cache; }
+
+		/**
+		 * @brief Returns the asset with the given ID, loading it if it is not cached.
+		 *
+		 * This may be called from multiple threads. The cache is only locked for lookup and insertion, so loads of
+		 * different assets can run in parallel. If two threads load the same asset at once, both load it, but only
+		 * the first one to finish gets it cached and returned to both.
+		 */
 		std::shared_ptr<_AssetType> getAsset(od::RecordId assetId)
         {
-            // we access the cache using the []-operator, so we create an entry for the asset if if not existed yet.
-            //  since most of the time the assets we are looking for are either cached or can be loaded from the container,
-            //  doing it this way will save us one traversal of the map, as we don't have to use insert() to add a newly loaded
-            //  asset to the cache. for the rare case that we can not find an asset in the file, just erase the unnecessary entry.
-            std::weak_ptr<_AssetType> &asset = mAssetCache[assetId];
-            if(!asset.expired())
+            std::shared_ptr<_AssetType> cached;
+
+            {
+                std::lock_guard<std::mutex> lock(mLoadedAssetsMutex);
+
+                auto it = mLoadedAssets.find(assetId);
+                if(it != mLoadedAssets.end())
+                {
+                    cached = it->second.lock();
+                }
+            }
+
+            if(cached != nullptr)
             {
                 Logger::debug() << AssetTraits<_AssetType>::name() << " " << std::hex << assetId << std::dec << " found in cache";
-                return asset.lock();
+                _retain(cached, false);
+                return cached;
             }
 
             // asset was not cached or got deleted. let implementation handle loading
@@ -57,13 +81,26 @@ namespace odDb
             std::shared_ptr<_AssetType> loaded = this->loadAsset(assetId);
             if(loaded == nullptr)
             {
-                mAssetCache.erase(assetId);
-
                 Logger::error() << AssetTraits<_AssetType>::name() << " " << std::hex << assetId << std::dec << " neither found in cache nor asset container " << mSrscFile.getFilePath().fileStr();
                 return nullptr;
             }
 
-            asset = loaded; // this effectively inserts the asset into the cache
+            {
+                std::lock_guard<std::mutex> lock(mLoadedAssetsMutex);
+
+                std::weak_ptr<_AssetType> &cacheEntry = mLoadedAssets[assetId];
+                auto other = cacheEntry.lock();
+                if(other != nullptr)
+                {
+                    loaded = other; // someone else was faster. drop ours so there is only ever one instance of the asset
+
+                }else
+                {
+                    cacheEntry = loaded;
+                }
+            }
+
+            _retain(loaded, true);
 
             return loaded;
         }
@@ -94,6 +131,7 @@ namespace odDb
 		AssetFactory(std::shared_ptr<DependencyTable> depTable, od::SrscFile &assetContainer)
         : mDependencyTable(depTable)
         , mSrscFile(assetContainer)
+        , mAssetCache(nullptr)
         {
         }
 
@@ -120,8 +158,8 @@ namespace odDb
             newAsset->setDepTableAndId(mDependencyTable, id);
             newAsset->load(std::move(cursor));
 
-		    // FIXME: in contrast to load(...), postLoad() is not synchronized (due to it not using the cursor which holds the lock)
-		    //  this is not a problem atm, as asset loading is not threaded. later we might want to add a second mutex or something
+		    // in contrast to load(...), postLoad() is not synchronized by the cursor's lock. that's fine as long as it only touches
+		    //  the new asset and loads others through getAsset(), which is safe to call from multiple threads
 		    newAsset->postLoad();
 
 		    return newAsset;
@@ -130,10 +168,21 @@ namespace odDb
 
 	private:
 
+		void _retain(const std::shared_ptr<_AssetType> &asset, bool wasLoaded)
+		{
+		    if(mAssetCache != nullptr)
+		    {
+		        mAssetCache->retain(asset, wasLoaded);
+		    }
+		}
+
 		std::shared_ptr<DependencyTable> mDependencyTable;
 		od::SrscFile &mSrscFile;
 
-		std::unordered_map<od::RecordId, std::weak_ptr<_AssetType>> mAssetCache;
+		std::mutex mLoadedAssetsMutex;
+		std::unordered_map<od::RecordId, std::weak_ptr<_AssetType>> mLoadedAssets;
+
+		AssetCache *mAssetCache;
 	};
 
 
@@ -0,0 +1,145 @@
+/*
+ * AssetPrefetcher.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: zal
+ */
+
+#ifndef INCLUDE_ODCORE_DB_ASSETPREFETCHER_H_
+#define INCLUDE_ODCORE_DB_ASSETPREFETCHER_H_
+
+#include <memory>
+#include <chrono>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <queue>
+#include <thread>
+#include <vector>
+#include <exception>
+
+namespace odDb
+{
+
+    /**
+     * @brief Runs asset loads on background threads, most urgent first.
+     *
+     * Every request has a deadline, which is only used for ordering. Whoever needs the result calls Request::get(). If no
+     * worker has picked up the request by then, get() runs the load on the calling thread instead of waiting in line, so
+     * a late prefetch never costs more than loading synchronously would have.
+     *
+     * Workers are started with the first request. Loads must be safe to run concurrently with anything else that might
+     * load assets (see AssetFactory::getAsset()).
+     */
+    class AssetPrefetcher
+    {
+    private:
+
+        struct Job
+        {
+            double deadline;
+            std::once_flag once;
+            std::function<void()> run;
+        };
+
+
+    public:
+
+        static constexpr size_t MAX_WORKER_COUNT = 2;
+
+        template <typename R>
+        class Request
+        {
+        public:
+
+            Request() = default;
+
+            inline bool isValid() const { return mJob != nullptr; }
+
+            inline bool isReady() const
+            {
+                return mResult.valid() && mResult.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+            }
+
+            /**
+             * @brief Returns the result, loading it on the calling thread if no worker has started loading it yet.
+             *
+             * If a worker is loading it right now, this blocks until it is done. An exception thrown by the loader is rethrown here.
+             */
+            R get()
+            {
+                std::call_once(mJob->once, mJob->run);
+                return mResult.get();
+            }
+
+
+        private:
+
+            friend class AssetPrefetcher;
+
+            std::shared_ptr<Job> mJob;
+            std::shared_future<R> mResult;
+        };
+
+        AssetPrefetcher();
+        AssetPrefetcher(const AssetPrefetcher &p) = delete;
+        ~AssetPrefetcher();
+
+        /**
+         * @brief Queues a call to loader, to be done before the given deadline if possible.
+         *
+         * The deadline can be in any time base, as long as all requests use the same one.
+         */
+        template <typename R>
+        Request<R> prefetch(double deadline, std::function<R()> loader)
+        {
+            auto promise = std::make_shared<std::promise<R>>();
+
+            Request<R> request;
+            request.mResult = promise->get_future().share();
+            request.mJob = std::make_shared<Job>();
+            request.mJob->deadline = deadline;
+            request.mJob->run = [promise, loader = std::move(loader)]()
+            {
+                try
+                {
+                    promise->set_value(loader());
+
+                }catch(...)
+                {
+                    promise->set_exception(std::current_exception());
+                }
+            };
+
+            _enqueue(request.mJob);
+
+            return request;
+        }
+
+
+    private:
+
+        struct JobOrder
+        {
+            bool operator()(const std::shared_ptr<Job> &left, const std::shared_ptr<Job> &right) const
+            {
+                return left->deadline > right->deadline;
+            }
+        };
+
+        void _enqueue(std::shared_ptr<Job> job);
+        void _startWorkers();
+        void _work();
+
+        std::mutex mMutex;
+        std::condition_variable mCondition;
+        std::priority_queue<std::shared_ptr<Job>, std::vector<std::shared_ptr<Job>>, JobOrder> mJobs;
+        std::vector<std::thread> mWorkers;
+        bool mTerminate;
+
+    };
+
+}
+
+#endif /* INCLUDE_ODCORE_DB_ASSETPREFETCHER_H_ */
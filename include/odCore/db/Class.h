@@ -9,10 +9,14 @@
 #define INCLUDE_CLASS_H_
 
 #include <memory>
+#include <mutex>
+#include <typeindex>
+#include <unordered_map>
 
 #include <odCore/db/Asset.h>
 #include <odCore/rfl/Class.h>
 #include <odCore/rfl/FieldLoaderProbe.h>
+#include <odCore/rfl/FieldBindingPlan.h>
 
 namespace od
 {
@@ -51,6 +55,13 @@ namespace odDb
          */
         void fillFields(odRfl::FieldBundle &fields);
 
+        /**
+         * @brief Returns the binding plan for bundles of the given one's type, building it on first use.
+         *
+         * Plans are kept per bundle type, as client and server may implement this class differently.
+         */
+        const odRfl::FieldBindingPlan &getFieldBindingPlan(odRfl::FieldBundle &fields);
+
         /**
          * @brief Queries a factory from the RFL that can be used to instantiate the class.
          *
@@ -89,6 +100,9 @@ namespace odDb
 
         odRfl::ClassFactory *mCachedRflClassFactory;
         std::shared_ptr<odDb::Model> mCachedModel;
+
+        std::mutex mFieldBindingPlanMutex;
+        std::unordered_map<std::type_index, std::unique_ptr<odRfl::FieldBindingPlan>> mFieldBindingPlans;
 	};
 
 
@@ -66,7 +66,7 @@ namespace odDb
 	private:
 
         template <typename T>
-        void _tryOpeningAssetContainer(std::unique_ptr<T> &factoryPtr, std::unique_ptr<od::SrscFile> &containerPtr, const char *extension);
+        void _tryOpeningAssetContainer(std::unique_ptr<T> &factoryPtr, std::unique_ptr<od::SrscFile> &containerPtr, const char *extension, AssetCache *cache);
 
 
 		od::FilePath mDbFilePath;
@@ -9,12 +9,16 @@
 #define INCLUDE_DBMANAGER_H_
 
 #include <memory>
+#include <mutex>
 #include <unordered_map>
+#include <vector>
 
 #include <odCore/CTypes.h>
 #include <odCore/FilePath.h>
 
 #include <odCore/db/Database.h>
+#include <odCore/db/AssetCache.h>
+#include <odCore/db/AssetPrefetcher.h>
 
 namespace odDb
 {
@@ -60,16 +64,52 @@ namespace odDb
             }
         }
 
+        /**
+         * @brief Queues loading the referenced asset on a prefetch worker.
+         *
+         * Calling get() on the returned request yields the same as loadAsset(ref) would have, waiting for the
+         * worker or loading on the calling thread if necessary.
+         */
+        template <typename T>
+        AssetPrefetcher::Request<std::shared_ptr<T>> prefetchAsset(const GlobalAssetRef &ref, double deadline)
+        {
+            std::function<std::shared_ptr<T>()> loader = [this, ref](){ return loadAsset<T>(ref); };
+            return mAssetPrefetcher.prefetch(deadline, std::move(loader));
+        }
+
+        inline AssetPrefetcher &getAssetPrefetcher() { return mAssetPrefetcher; }
+
+        /**
+         * @brief Caches shared by the factories of all databases loaded by this manager.
+         *
+         * Use these to adjust the memory budget per asset type or to query statistics.
+         */
+        inline AssetCache &getTextureCache() { return mTextureCache; }
+        inline AssetCache &getModelCache() { return mModelCache; }
+        inline AssetCache &getAnimationCache() { return mAnimationCache; }
+        inline AssetCache &getSoundCache() { return mSoundCache; }
+
         template <typename F>
         void forEachLoadedDatabase(const F &f)
         {
-            for(auto &weakDb : mLoadedDatabases)
+            // f might load databases itself, so don't hold the lock while calling it
+            std::vector<std::shared_ptr<Database>> databases;
+
             {
-                if(auto db = weakDb.second.lock(); db != nullptr)
+                std::lock_guard<std::mutex> lock(mLoadedDatabasesMutex);
+                for(auto &weakDb : mLoadedDatabases)
                 {
-                    f(db);
+                    if(auto db = weakDb.second.lock(); db != nullptr)
+                    {
+                        databases.push_back(db);
+                    }
                 }
             }
+
+            for(auto &db : databases)
+            {
+                f(db);
+            }
         }
 
 
@@ -78,6 +118,17 @@ namespace odDb
         // FIXME: make sure a database that is unloaded, then loaded again gets the same global index!
         std::unordered_map<GlobalDatabaseIndex, std::weak_ptr<Database>> mLoadedDatabases;
         size_t mNextGlobalIndex;
+
+        // databases are only loaded by one thread, but prefetch workers look them up concurrently
+        mutable std::mutex mLoadedDatabasesMutex;
+
+        AssetCache mTextureCache;
+        AssetCache mModelCache;
+        AssetCache mAnimationCache;
+        AssetCache mSoundCache;
+
+        // declared last so workers are stopped before anything they might use is destroyed
+        AssetPrefetcher mAssetPrefetcher;
 	};
 
 }
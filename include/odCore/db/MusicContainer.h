@@ -9,10 +9,13 @@
 #define INCLUDE_ODCORE_AUDIO_MUSICCONTAINER_H_
 
 #include <map>
+#include <unordered_map>
 #include <string>
 #include <memory>
+#include <vector>
 
 #include <odCore/SrscFile.h>
+#include <odCore/MappedFile.h>
 #include <odCore/RiffReader.h>
 #include <odCore/Guid.h>
 
@@ -22,6 +25,10 @@ namespace odDb
 
     /**
      * @brief Helper class for reading and indexing Music.rrc and for providing music data to the music system.
+     *
+     * The container file is memory-mapped. Which records hold DLS or segment data and what the DLS GUIDs are is
+     * stored in an index file next to the container, so it only needs to be built once. DLS and segment data is only
+     * parsed when it is needed.
      */
     class MusicContainer
     {
@@ -29,24 +36,79 @@ namespace odDb
 
         typedef uint32_t MusicId;
 
+        enum class RecordKind : uint8_t
+        {
+            Unknown,
+            Dls,
+            Segment
+        };
+
+        struct IndexEntry
+        {
+            od::RecordId recordId;
+            RecordKind kind;
+            od::Guid guid; // only valid for DLS records
+            uint32_t dataOffset;
+            uint32_t dataSize;
+        };
+
+        /**
+         * @brief A view of the raw RIFF bytes of a record in the mapped container.
+         *
+         * Valid for as long as the container exists.
+         */
+        struct RecordData
+        {
+            const char *data;
+            size_t size;
+        };
+
         MusicContainer(const od::FilePath &musicContainerFile);
 
-        od::RecordId getDlsRecordByGuid(const od::Guid &guid);
-        od::SrscFile::RecordInputCursor getCursorForDls(const od::Guid &guid);
+        inline const od::FilePath &getIndexFilePath() const { return mIndexFile; }
 
+        od::RecordId getDlsRecordByGuid(const od::Guid &guid);
+        RecordData getDlsData(const od::Guid &guid);
+
+        /**
+         * @brief Returns the IDs of all segments in the container.
+         */
+        std::vector<MusicId> getMusicIds() const;
+
+        /**
+         * @brief Returns the segment with the given ID, parsing it on first access.
+         *
+         * Parsed segments are kept, so playing the same music again does not require reparsing.
+         */
         std::shared_ptr<Segment> loadSegment(MusicId id);
 
+        /**
+         * @brief Returns a hash of the raw data of the segment with the given ID, for detecting changes to it.
+         */
+        uint32_t getSegmentDataHash(MusicId id) const;
+
 
     private:
 
+        bool _loadIndex();
+        void _writeIndex();
         void _buildIndex();
-        void _addDlsToIndex(od::RiffReader rr, od::RecordId id);
-        void _addSegmentToIndex(od::RiffReader rr, od::RecordId id);
+        void _addDlsToIndex(od::RiffReader rr, IndexEntry &entry);
+        void _insertIntoMaps(const IndexEntry &entry);
+
+        uint32_t _getDirectoryHash() const;
+        RecordData _getRecordData(const IndexEntry &entry) const;
 
         od::FilePath mFile;
+        od::FilePath mIndexFile;
         od::SrscFile mRrc;
+        od::MappedFile mMappedRrc;
+
+        std::vector<IndexEntry> mIndex;
+        std::map<od::Guid, size_t> mDlsGuidMap; // values are indices into mIndex
+        std::unordered_map<MusicId, size_t> mSegmentMap; // values are indices into mIndex
 
-        std::map<od::Guid, od::RecordId> mDlsGuidMap;
+        std::unordered_map<MusicId, std::shared_ptr<Segment>> mSegmentCache;
     };
 
 }
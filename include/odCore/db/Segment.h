@@ -123,6 +123,7 @@ namespace odDb
         typedef std::vector<BandEvent> BandVector;
 
         inline od::Guid getGuid() const { return mGuid; }
+        inline music_time_t getLength() const { return mLength; }
         inline const MidiEventVector &getMidiEvents() const { return mMidiEvents; }
         inline const CurveVector &getMidiCurves() const { return mMidiCurves; }
         inline const TempoVector &getTempoEvents() const { return mTempoEvents; }
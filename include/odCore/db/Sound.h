@@ -10,6 +10,10 @@
 
 #include <vector>
 #include <memory>
+#include <istream>
+
+#include <odCore/DataStream.h>
+#include <odCore/ZStream.h>
 
 #include <odCore/db/Asset.h>
 
@@ -29,21 +33,81 @@ namespace odDb
 	{
 	public:
 
+        /**
+         * @brief Sounds whose decompressed sample data is bigger than this many bytes should be streamed
+         * rather than uploaded as a whole.
+         */
+        static const size_t StreamingThreshold;
+
+        /**
+         * @brief Decodes the sample data of a sound in chunks.
+         *
+         * The sound only stores it's sample data the way it was found in the record (possibly compressed).
+         * Use this to inflate it on demand. A decoder must not outlive the sound it was created for.
+         */
+        class Decoder
+        {
+        public:
+
+            Decoder(const Sound &sound, size_t chunkSize = od::ZStreamBuffer::DefaultBufferSize);
+            Decoder(const Decoder &d) = delete;
+
+            inline bool isAtEnd() const { return mBytesDecoded >= mSound.getDecompressedSize(); }
+
+            /**
+             * @brief Decodes at most \c size bytes of sample data into \c data.
+             *
+             * @return The number of bytes actually decoded. Less than \c size only when the end of the sound was reached.
+             */
+            size_t read(uint8_t *data, size_t size);
+
+            /**
+             * @brief Resets the decoder so the next call to read() starts at the first sample again.
+             */
+            void rewind();
+
+
+        private:
+
+            const Sound &mSound;
+            size_t mChunkSize;
+            od::MemoryInputBuffer mMemoryBuffer;
+            std::istream mRecordStream;
+            std::unique_ptr<od::ZStream> mZStream;
+            size_t mBytesDecoded;
+        };
+
 		Sound();
 		virtual ~Sound();
 
         inline uint32_t getChannelCount() const { return mChannels; }
         inline uint32_t getBitsPerChannel() const { return mBits; }
 		inline uint32_t getSamplingFrequency() const { return mFrequency; }
-		inline const std::vector<uint8_t> &getDataBuffer() const { return mDataBuffer; }
 		inline const std::string &getName() const { return mSoundName; }
+		inline size_t getDecompressedSize() const { return mDecompressedSize; }
+		inline bool isCompressed() const { return mCompressionLevel != 0; }
+		inline bool shouldStream() const { return mDecompressedSize > StreamingThreshold; }
+
+		/**
+		 * @brief Returns the sample data as stored in the record. Inflate it using a Decoder if the sound is compressed.
+		 */
+		inline const std::vector<uint8_t> &getStoredData() const { return mStoredData; }
 
         inline std::weak_ptr<odAudio::Buffer> &getCachedSoundBuffer() { return mCachedSoundBuffer; }
 
 		virtual void load(od::SrscFile::RecordInputCursor cursor) override;
+		virtual size_t getMemoryUsage() const override;
 
 		float getLinearGain() const;
 
+		/**
+		 * @brief Decodes the whole sample data into a temporary buffer.
+		 *
+		 * The sound does not keep a decompressed copy around. The returned data is meant to be uploaded
+		 * and dropped right after.
+		 */
+		std::vector<uint8_t> decodeAll() const;
+
 
 	private:
 
@@ -58,7 +122,7 @@ namespace odDb
         uint32_t    mDecompressedSize;
         uint32_t 	mCompressionLevel; // 0 = none, 1 = lowest, 9 = highest
 
-        std::vector<uint8_t> mDataBuffer;
+        std::vector<uint8_t> mStoredData; // sample data exactly as stored in the record. compressed if mCompressionLevel != 0
 
         std::weak_ptr<odAudio::Buffer> mCachedSoundBuffer;
 	};
@@ -58,6 +58,7 @@ namespace odDb
 
         virtual void load(od::SrscFile::RecordInputCursor cursor) override;
         virtual void postLoad() override;
+        virtual size_t getMemoryUsage() const override;
 
 
     private:
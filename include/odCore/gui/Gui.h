@@ -11,11 +11,14 @@
 #include <string>
 #include <vector>
 #include <memory>
+#include <mutex>
 
 #include <glm/vec2.hpp>
 #include <glm/mat4x4.hpp>
 
 #include <odCore/gui/WidgetIntersector.h>
+#include <odCore/gui/HitTestGrid.h>
+#include <odCore/gui/QuadBatcher.h>
 
 #include <odCore/input/Keys.h>
 
@@ -37,6 +40,13 @@ namespace odGui
 
     class Widget;
 
+    /**
+     * @brief Root of the widget tree and dispatcher of GUI input.
+     *
+     * The renderer calls onUpdate() on the render thread while input arrives on the simulation thread, so the widget
+     * tree is guarded by a single mutex. Every method that changes or walks the tree locks it. Widget callbacks invoked
+     * from here run with the lock held and may change widgets freely.
+     */
     class Gui : public odRender::GuiCallback
     {
     public:
@@ -46,10 +56,17 @@ namespace odGui
 
         inline bool isMenuMode() const { return mMenuMode; }
         inline odRender::Renderer &getRenderer() { return mRenderer; }
-        inline void markNeedsFlattening() { mNeedsFlattening = true; }
-        inline void markMeasurementsDirty() { mMeasurementsDirty = true; }
+        inline const QuadBatcher &getQuadBatcher() const { return mQuadBatcher; }
         inline const glm::vec2 &getCursorPosition() const { return mCursorPos; }
 
+        /**
+         * @brief The mutex guarding the widget tree.
+         *
+         * Code that changes widgets from outside a GUI callback, like game logic updating the HUD, must hold this.
+         * It is recursive, so it is safe to call any method of this class while holding it.
+         */
+        inline std::recursive_mutex &getMutex() { return mMutex; }
+
         void addWidget(std::shared_ptr<Widget> widget);
         void removeWidget(std::shared_ptr<Widget> widget);
 
@@ -80,27 +97,23 @@ namespace odGui
          * *Measure:* Walks the GUI tree top-down to figure out the absolute dimensions of
          * each widget. This becomes necessary everytime a widget or the screen change dimensions. Only
          * that subtree (i.e. the widget itself and all of it's direct or indirect children) has to be
-         * re-measured, but this process is relatively inexpensive so we could consider doing this on
-         * the whole tree everytime so we have one less dirty-state to manage.
+         * re-measured.
          *
-         * *Flatten Transform:* Walks the GUI tree top-down to figure out where in the screen-space to
-         * place the widgets. The renderer has no notion of a hierarchical GUI, so it needs each render
-         * handle to know exactly where it should be placed on the screen in NDC. This steps becomes
-         * necessary whenever a widget or a drawable moves, but only on that widget's subtree. The widgets
-         * in question must have been measured before this step can be executed successfully.
+         * *Flatten:* Walks the GUI tree top-down to figure out where in GUI space to place the widgets.
+         * The renderer has no notion of a hierarchical GUI, so it needs each render handle and quad to
+         * know exactly where it should be placed on the screen. This becomes necessary whenever a widget
+         * moves, but only on that widget's subtree. Stacking is handled by the Z component of the flattened
+         * transforms, so no global ordering needs to be maintained.
          *
-         * *Flatten Depth:* Walks the GUI tree top-down to figure out a global sorting of render handles
-         * that produces the widget stacking as determined by the individual Z-indices. Since Z-indices
-         * are nested but the render handles are not, we have to tell the renderer in what order to draw
-         * the handles so overlap is handled correctly. Recalculating this becomes necessary everytime a
-         * widget's Z-index changes or a widget or drawable is added to the hierarchy. This has to happen
-         * only on the widgets that come after the invalidated one in the global ordering, but determining
-         * those widgets generally requires more bookkeeping and the worst case is still O(n), so it really
-         * only makes sense to flatten the whole tree here. That's why this step is managed by a single
-         * dirty-flag in the Gui object.
+         * *Batch:* All quads added via Widget::addQuad() are merged into one render handle per texture.
+         * Only batches containing changed quads are rewritten. This method merely copies their state into the
+         * QuadBatcher. The batches themselves are written in onUpdate(), after the mutex has been released.
          *
-         * Note that due to me being lazy, all of these dirty states are currently centralized in the Gui object.
-         * If they are invalidated on any widget in the tree, the whole tree has to be re-flattened or measured.
+         * Dirty states are tracked per widget, and every widget knows whether some widget below it is
+         * dirty. Thus, the first two steps only visit dirty subtrees and the paths leading to them.
+         *
+         * The hit test grid used for mouse picking is updated in place for widgets that moved. Only when
+         * widgets are added or removed it has to be rebuilt, which happens here or on the next query.
          */
         void rebuild();
 
@@ -110,15 +123,22 @@ namespace odGui
 
     private:
 
+        friend class Widget;
+
         void _setupGui();
+        void _intersectWithCursor();
 
         odRender::Renderer &mRenderer;
         std::shared_ptr<odInput::InputListener> mInputListener;
 
+        std::recursive_mutex mMutex;
+
         bool mMenuMode;
 
-        bool mMeasurementsDirty;
-        bool mNeedsFlattening;
+        // declared before the root widget so widgets can still remove their quads while they are being destroyed
+        QuadBatcher mQuadBatcher;
+        HitTestGrid mHitTestGrid;
+        bool mHitTestGridStale;
 
         std::shared_ptr<Widget> mRootWidget;
         glm::vec2 mCursorPos; // in GUI space!
@@ -0,0 +1,84 @@
+/*
+ * HitTestGrid.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: zal
+ */
+
+#ifndef INCLUDE_ODCORE_GUI_HITTESTGRID_H_
+#define INCLUDE_ODCORE_GUI_HITTESTGRID_H_
+
+#include <array>
+#include <vector>
+
+#include <glm/vec2.hpp>
+
+#include <odCore/gui/WidgetIntersector.h>
+
+namespace odGui
+{
+
+    class Widget;
+
+    /**
+     * @brief Uniform grid over GUI space for finding the widgets under a point without walking the whole tree.
+     *
+     * Every cell lists the widgets whose bounds overlap it, in the order a depth-first walk of the widget tree would
+     * visit them. Thus, a query only has to look at a single cell and still reports hits in the same order as
+     * Widget::intersect(), parents before their children.
+     *
+     * This assumes that a widget's logical area (see Widget::liesWithinLogicalArea()) never exceeds it's bounds.
+     *
+     * Widgets that only moved can be updated in place. Whenever widgets are added to or removed from the tree, the
+     * grid has to be rebuilt, since the tree order changes.
+     */
+    class HitTestGrid
+    {
+    public:
+
+        static constexpr int CELLS_PER_AXIS = 16;
+
+        HitTestGrid();
+
+        /**
+         * @brief Clears the grid and inserts all widgets in the tree below (and including) root.
+         *
+         * All widgets must have been flattened.
+         */
+        void rebuild(Widget &root);
+
+        /**
+         * @brief Moves a widget that is already in the grid to the cells matching it's current bounds.
+         */
+        void update(Widget &widget);
+
+        /**
+         * @brief Collects all widgets hit by the given point, just like Widget::intersect() on the root widget would.
+         */
+        void intersect(const glm::vec2 &pointInGuiSpace, std::vector<HitWidgetInfo> &hitWidgets);
+
+
+    private:
+
+        struct Entry
+        {
+            size_t order; // stored here so we never have to dereference widgets that might have died since the last rebuild
+            Widget *widget;
+        };
+
+        using Cell = std::vector<Entry>;
+
+        void _insertRecursive(Widget &widget, size_t &nextOrder);
+        void _insert(Widget &widget);
+        void _remove(Widget &widget);
+        inline Cell &_getCell(int x, int y) { return mCells[y*CELLS_PER_AXIS + x]; }
+        static int _toCellIndex(float coord);
+
+        std::array<Cell, CELLS_PER_AXIS*CELLS_PER_AXIS> mCells;
+        size_t mQueryNumber;
+
+    };
+
+}
+
+#endif /* INCLUDE_ODCORE_GUI_HITTESTGRID_H_ */
@@ -3,6 +3,7 @@
 #define INCLUDE_GUI_QUAD_H_
 
 #include <memory>
+#include <cstdint>
 
 #include <glm/vec2.hpp>
 #include <glm/vec4.hpp>
@@ -43,20 +44,47 @@ namespace odGui
      * Since basically any Quad in a GUI tends to be transparent in some way,
      * the handle is put into the transparency bin by default. If you do not
      * want that, you have to change it yourself.
+     *
+     * Instead of adding the handle to a widget, a Quad can also be added to a
+     * widget via Widget::addQuad(). It will then be drawn as part of a batch
+     * with all other quads using the same texture, and no handle is ever
+     * created for it. Changes made through the Quad after adding it still
+     * apply, since the widget shares the Quad's data.
      */
     class Quad
     {
     public:
 
+        /**
+         * @brief The state of a quad, shared between the Quad object and anything drawing it.
+         *
+         * Once the quad is added to a widget, it must only be changed with the GUI's mutex held. The QuadBatcher
+         * copies it from there, so the render thread never reads it while it is being changed.
+         */
+        struct Data
+        {
+            odRender::Renderer *renderer;
+            std::shared_ptr<odRender::Texture> texture;
+            glm::vec2 vertexTopLeft;
+            glm::vec2 vertexBottomRight;
+            glm::vec2 uvTopLeft;
+            glm::vec2 uvBottomRight;
+            glm::vec4 color;
+
+            // incremented on every change, so batches can tell whether they need rebuilding
+            uint32_t version;
+        };
+
         Quad();
         Quad(Quad &&q) = default;
         Quad(odRender::Renderer &renderer);
 
-        inline std::shared_ptr<odRender::Handle> getHandle() { return mHandle; }
-        inline std::shared_ptr<odRender::Model> getModel() { return mModel; }
-        inline std::shared_ptr<odRender::Geometry> getGeometry() { return mGeometry; }
-        inline std::shared_ptr<odRender::Texture> getTexture() { return mTexture; }
-        inline bool empty() const { return mHandle == nullptr; }
+        std::shared_ptr<odRender::Handle> getHandle();
+        std::shared_ptr<odRender::Model> getModel();
+        std::shared_ptr<odRender::Geometry> getGeometry();
+        inline std::shared_ptr<odRender::Texture> getTexture() { return (mData != nullptr) ? mData->texture : nullptr; }
+        inline std::shared_ptr<Data> getData() const { return mData; }
+        inline bool empty() const { return mData == nullptr; }
 
         void init(odRender::Renderer &renderer);
 
@@ -72,11 +100,17 @@ namespace odGui
     private:
 
         void _check();
+        void _createHandle();
+        void _writeVertexCoords();
+        void _writeTextureCoords();
+        void _writeColor();
+
+        std::shared_ptr<Data> mData;
 
+        // only created once someone asks for the handle
         std::shared_ptr<odRender::Handle> mHandle;
         std::shared_ptr<odRender::Model> mModel;
         std::shared_ptr<odRender::Geometry> mGeometry;
-        std::shared_ptr<odRender::Texture> mTexture;
     };
 
 }
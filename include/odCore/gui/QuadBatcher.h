@@ -0,0 +1,131 @@
+/*
+ * QuadBatcher.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: zal
+ */
+
+#ifndef INCLUDE_ODCORE_GUI_QUADBATCHER_H_
+#define INCLUDE_ODCORE_GUI_QUADBATCHER_H_
+
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <unordered_map>
+
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+
+#include <odCore/gui/Quad.h>
+
+namespace odRender
+{
+    class Renderer;
+    class Handle;
+    class Model;
+    class Geometry;
+    class Texture;
+}
+
+namespace odGui
+{
+
+    class Widget;
+
+    /**
+     * @brief Merges all quads added via Widget::addQuad() into one render handle per texture.
+     *
+     * Quads are transformed into GUI space on the CPU and written into a single triangle list per texture. A batch is
+     * only rewritten when one of it's quads changed (see Quad::Data::version). Widgets bump the versions of their quads
+     * when they move or change visibility, so a static HUD costs nothing but one draw per texture.
+     *
+     * Quad data is shared with the widgets, which may change it from any thread while holding the GUI's mutex. Thus,
+     * the batcher only reads it in sync(), which copies the GUI space corners, texture coordinates and color of every
+     * quad on a changed texture. update() builds the batches from those copies alone and can run without the lock.
+     *
+     * Within a batch, quads are written back to front. Overlapping quads with different textures are ordered by the
+     * renderer's depth sorting of the batch handles, so widgets that need exact interleaving across textures should
+     * keep using their own render handles.
+     */
+    class QuadBatcher
+    {
+    public:
+
+        QuadBatcher(odRender::Renderer &renderer);
+        ~QuadBatcher();
+
+        void addQuad(Widget &widget, std::shared_ptr<Quad::Data> quad);
+        void removeQuad(Widget &widget, const std::shared_ptr<Quad::Data> &quad);
+        void removeWidget(Widget &widget);
+
+        /**
+         * @brief Copies the state of all quads sharing a texture with a changed quad.
+         *
+         * Must be called with the GUI's mutex held, after the widgets have been flattened.
+         */
+        void sync();
+
+        /**
+         * @brief Rewrites all batches changed by the last sync().
+         *
+         * Must be called from the render thread. Does not touch any widget or quad data.
+         */
+        void update();
+
+        inline size_t getBatchCount() const { return mBatches.size(); }
+
+
+    private:
+
+        // guarded by the GUI's mutex
+        struct Member
+        {
+            Widget *widget;
+            std::shared_ptr<Quad::Data> quad;
+            std::shared_ptr<odRender::Texture> texture; // the one this member was last synced with
+            uint32_t seenVersion;
+        };
+
+        struct QuadState
+        {
+            glm::vec3 corners[4]; // in GUI space, same order as the standalone quad's triangle fan
+            glm::vec2 uvs[4];
+            glm::vec4 color;
+            float depth;
+        };
+
+        // the complete, visible contents of one batch as of the last sync
+        struct SyncedBatch
+        {
+            std::shared_ptr<odRender::Texture> texture;
+            std::vector<QuadState> quads;
+        };
+
+        // only touched by update()
+        struct Batch
+        {
+            std::shared_ptr<odRender::Handle> handle;
+            std::shared_ptr<odRender::Model> model;
+            std::shared_ptr<odRender::Geometry> geometry;
+        };
+
+        void _markTextureDirty(const std::shared_ptr<odRender::Texture> &texture);
+        Batch &_getOrCreateBatch(const std::shared_ptr<odRender::Texture> &texture);
+        void _rebuildBatch(Batch &batch, std::vector<QuadState> &quads);
+
+        odRender::Renderer &mRenderer;
+
+        std::vector<Member> mMembers;
+        std::unordered_map<odRender::Texture*, std::shared_ptr<odRender::Texture>> mDirtyTextures;
+
+        std::mutex mSyncedBatchesMutex;
+        std::unordered_map<odRender::Texture*, SyncedBatch> mSyncedBatches;
+        std::unordered_map<odRender::Texture*, SyncedBatch> mBatchesToRebuild;
+
+        std::unordered_map<odRender::Texture*, Batch> mBatches;
+    };
+
+}
+
+#endif /* INCLUDE_ODCORE_GUI_QUADBATCHER_H_ */
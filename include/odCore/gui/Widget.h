@@ -8,6 +8,7 @@
 #ifndef INCLUDE_GUI_WIDGET_H_
 #define INCLUDE_GUI_WIDGET_H_
 
+#include <array>
 #include <vector>
 #include <memory>
 
@@ -16,6 +17,7 @@
 #include <glm/gtc/quaternion.hpp>
 
 #include <odCore/gui/WidgetIntersector.h>
+#include <odCore/gui/Quad.h>
 
 namespace odRender
 {
@@ -69,6 +71,9 @@ namespace odGui
      * a dimension of (1/1) is exactly the parent's size, (0.5/0.5) is half the parent's size, etc.
      *
      * UI scaling is not yet implemented, but can be easily achieved by applying a scale factor to a widget's dimensions.
+     *
+     * Changing a widget only marks it's own subtree as dirty. The next GUI rebuild then visits only the dirty subtrees and
+     * the paths leading to them, so a HUD where a single widget moves costs about as much as that widget.
      */
     class Widget
     {
@@ -83,6 +88,7 @@ namespace odGui
         inline WidgetDimensionType getDimensionType() const { return mDimensionType; }
         inline glm::vec2 getDimensions() const { return mDimensions; }
         inline bool isMouseOver() const { return mMouseOver; }
+        inline bool isVisible() const { return mVisible; }
         inline void setMouseOver(bool b) { mMouseOver = b; }
 
         void setPosition(const glm::vec2 &pos);
@@ -163,6 +169,16 @@ namespace odGui
         void addRenderHandle(std::shared_ptr<odRender::Handle> r);
         void removeRenderHandle(std::shared_ptr<odRender::Handle> r);
 
+        /**
+         * @brief Adds a quad to be drawn in this widget's space.
+         *
+         * Unlike adding the quad's handle via addRenderHandle(), this draws the quad as part of a batch with all other
+         * quads in the GUI that use the same texture. The widget shares the quad's data, so changes made through the
+         * Quad object after adding it still apply.
+         */
+        void addQuad(const Quad &quad);
+        void removeQuad(const Quad &quad);
+
         /**
          * @brief Performs recursive intersection check, collecting all found widgets in a vector.
          * @param pointInWidgetSpace  The point to check, using *this* Widget's space
@@ -176,6 +192,13 @@ namespace odGui
          */
         inline glm::vec2 getMeasuredDimensions() const { return mMeasuredDimensionsPx; }
 
+        /**
+         * @brief Returns the transform from this widget's space to GUI space.
+         *
+         * This is only valid after this widget has been flattened during a GUI rebuild.
+         */
+        inline const glm::mat4 &getMySpaceToGuiSpace() const { return mMySpaceToGuiSpace; }
+
         void setVisible(bool b);
 
         /**
@@ -201,20 +224,15 @@ namespace odGui
         void update(float relTime);
 
         /**
-         * @brief Pushes measurements down the widget hierarchy recursively.
+         * @brief Measures and flattens all dirty subtrees below (and including) this widget.
          *
-         * This terminology is borrowed from Android, and except for the fact
-         * that our system is far less complex, essentially works the same way.
-         */
-        void measure(glm::vec2 parentDimensionsPx);
-
-        /**
-         * @brief Updates the widget transforms if necessary and flattens this and it's children.
+         * Measuring pushes pixel dimensions down the widget hierarchy. This terminology is borrowed from Android, and
+         * except for the fact that our system is far less complex, essentially works the same way. Flattening then
+         * calculates where in GUI space each widget ends up.
          *
-         * It really only makes sense to call this on the root widget. Partially flattening the widget tree does not
-         * yield correct results as of now.
+         * It only makes sense to call this on the root widget.
          */
-        void flatten();
+        void rebuild(glm::vec2 parentDimensionsPx);
 
 
     protected:
@@ -224,9 +242,17 @@ namespace odGui
 
     private:
 
-        void _moveToNoneRenderSpaceRecursive();
+        friend class Gui;
+        friend class HitTestGrid;
+
+        /**
+         * @brief Flags this widget for flattening (and measuring, if requested) and tells all ancestors about it.
+         */
+        void _markDirty(bool needsMeasure);
+        void _detachRecursive();
+        void _bumpQuadVersions();
         void _recalculateMatrix();
-        void _flattenRecursive(const glm::mat4 &parentToRoot);
+        void _rebuildRecursive(const glm::vec2 &parentDimensionsPx, const glm::mat4 &parentToGui, bool forceMeasure, bool forceFlatten);
         void _intersectRecursive(const glm::vec2 &pointInParent, std::vector<HitWidgetInfo> &hitWidgets);
         glm::vec2 _getOriginVector();
 
@@ -244,15 +270,34 @@ namespace odGui
 
         glm::vec2 mMeasuredDimensionsPx;
 
+        // dirty states. mChildNeedsRebuild means that somewhere below this widget is a widget with one of the other flags
+        bool mMeasureDirty;
+        bool mFlattenDirty;
+        bool mChildNeedsRebuild;
         bool mMatrixDirty;
         glm::mat4 mParentSpaceToMySpace;
         glm::mat4 mMySpaceToParentSpace;
+        glm::mat4 mMySpaceToGuiSpace;
+        glm::mat4 mGuiSpaceToMySpace;
+
+        // true once this has been flattened while connected to the root widget, until it gets removed from the tree
+        bool mAttachedToGui;
 
         bool mMouseOver;
 
         std::vector<std::shared_ptr<Widget>> mChildWidgets;
 
         std::shared_ptr<odRender::Group> mRenderGroup;
+        std::vector<std::shared_ptr<Quad::Data>> mQuads;
+
+        // managed by the HitTestGrid
+        size_t mHitTestOrder;
+        glm::vec2 mBoundsMinInGuiSpace;
+        glm::vec2 mBoundsMaxInGuiSpace;
+        std::array<int, 4> mHitTestCells; // x0, y0, x1, y1
+        bool mInHitTestGrid;
+        size_t mHitTestQuery;
+        bool mHitTestResult;
     };
 
 }
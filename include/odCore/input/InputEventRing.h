@@ -0,0 +1,116 @@
+/*
+ * InputEventRing.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: zal
+ */
+
+#ifndef INCLUDE_ODCORE_INPUT_INPUTEVENTRING_H_
+#define INCLUDE_ODCORE_INPUT_INPUTEVENTRING_H_
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace odInput
+{
+
+    /**
+     * @brief Bounded lock-free queue for handing input events from input threads to the update loop.
+     *
+     * Any number of threads may push(), but only one thread may pop() at a time. Neither ever blocks. If the ring is full,
+     * push() fails and the caller has to decide what to do with the event.
+     *
+     * Every cell carries a sequence number that tells producers and the consumer whose turn it is, so a producer that
+     * claimed a cell but did not finish writing it yet simply looks like an empty cell to the consumer.
+     */
+    template <typename T, size_t CAPACITY>
+    class InputEventRing
+    {
+    public:
+
+        static_assert(CAPACITY >= 2 && (CAPACITY & (CAPACITY - 1)) == 0, "Ring capacity must be a power of two");
+
+        InputEventRing()
+        : mPushPosition(0)
+        , mPopPosition(0)
+        {
+            for(size_t i = 0; i < CAPACITY; ++i)
+            {
+                mCells[i].sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        InputEventRing(const InputEventRing &r) = delete;
+
+        bool push(const T &value)
+        {
+            size_t pos = mPushPosition.load(std::memory_order_relaxed);
+            Cell *cell;
+            for(;;)
+            {
+                cell = &mCells[pos & MASK];
+                size_t sequence = cell->sequence.load(std::memory_order_acquire);
+                intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+                if(diff == 0)
+                {
+                    // cell is free. try to claim it. on failure, pos is updated to the current push position
+                    if(mPushPosition.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    {
+                        break;
+                    }
+
+                }else if(diff < 0)
+                {
+                    return false; // consumer has not yet taken the event that was written here one lap ago
+
+                }else
+                {
+                    pos = mPushPosition.load(std::memory_order_relaxed); // another producer was faster
+                }
+            }
+
+            cell->value = value;
+            cell->sequence.store(pos + 1, std::memory_order_release);
+
+            return true;
+        }
+
+        bool pop(T &value)
+        {
+            Cell &cell = mCells[mPopPosition & MASK];
+            if(cell.sequence.load(std::memory_order_acquire) != mPopPosition + 1)
+            {
+                return false;
+            }
+
+            value = cell.value;
+            cell.sequence.store(mPopPosition + CAPACITY, std::memory_order_release);
+            ++mPopPosition;
+
+            return true;
+        }
+
+
+    private:
+
+        static constexpr size_t MASK = CAPACITY - 1;
+
+        struct Cell
+        {
+            std::atomic<size_t> sequence;
+            T value;
+        };
+
+        std::array<Cell, CAPACITY> mCells;
+
+        // keep the producer and consumer positions on separate cache lines
+        alignas(64) std::atomic<size_t> mPushPosition;
+        alignas(64) size_t mPopPosition;
+
+    };
+
+}
+
+#endif /* INCLUDE_ODCORE_INPUT_INPUTEVENTRING_H_ */
@@ -8,8 +8,10 @@
 #ifndef INCLUDE_ODCORE_INPUT_INPUTMANAGER_H_
 #define INCLUDE_ODCORE_INPUT_INPUTMANAGER_H_
 
+#include <array>
+#include <atomic>
+#include <chrono>
 #include <unordered_map>
-#include <mutex>
 #include <vector>
 #include <functional>
 #include <glm/vec2.hpp>
@@ -19,6 +21,7 @@
 #include <odCore/input/Action.h>
 #include <odCore/input/AnalogAction.h>
 #include <odCore/input/Keys.h>
+#include <odCore/input/InputEventRing.h>
 
 namespace odInput
 {
@@ -38,8 +41,9 @@ namespace odInput
          * Coordinates are in GUI space (top-left is 0/0, bottom-right is 1/1).
          *
          * Call this from your input listener (if applicable). This method is
-         * fully synchronized, so it is safe to call this from an asynchronous
-         * input listener or a different thread.
+         * lock-free and safe to call from an asynchronous input listener or a
+         * different thread. Every sample is kept and processed in order with
+         * the other input events.
          */
         void injectMouseMovement(float absX, float absY);
 
@@ -50,8 +54,8 @@ namespace odInput
          * this is not necessary to get repeated action).
          *
          * Call this from your input listener (if applicable). This method is
-         * fully synchronized, so it is safe to call this from an asynchronous
-         * input listener or a different thread.
+         * lock-free and safe to call from an asynchronous input listener or a
+         * different thread.
          *
          * @param pressed  true if button was pressed
          */
@@ -64,7 +68,7 @@ namespace odInput
          * client and basically serves as a dispatch mechanism for the
          * callbacks.
          *
-         * This is fully synchronized, so it can be called from any thread.
+         * This is lock-free, so it can be called from any thread.
          */
         void injectAction(ActionCode actionCode, ActionState state);
 
@@ -75,7 +79,7 @@ namespace odInput
          * client and basically serves as a dispatch mechanism for the
          * callbacks.
          *
-         * This is fully synchronized, so it can be called from any thread.
+         * This is lock-free, so it can be called from any thread.
          */
         void injectAnalogAction(ActionCode actionCode, const glm::vec2 &axisData);
 
@@ -158,8 +162,23 @@ namespace odInput
          */
         std::shared_ptr<InputListener> createInputListener();
 
+        using Clock = std::chrono::steady_clock;
+
+        /**
+         * @brief Processes all input injected since the last call, calling listeners and action callbacks.
+         *
+         * No locks are held while callbacks run, so injecting input never waits for game logic.
+         */
         void update(float relTime);
 
+        /**
+         * @brief Returns the time at which the input event whose callbacks are currently being run was injected.
+         *
+         * Callbacks can use this to place the input within the frame. Outside of update(), this is the time of the
+         * last event processed.
+         */
+        inline Clock::time_point getCurrentEventTime() const { return mCurrentEventTime; }
+
 
     private:
 
@@ -169,7 +188,7 @@ namespace odInput
         void _bind(AnalogActionHandleBase &action, AnalogSource source);
         void _unbind(AnalogActionHandleBase &action, AnalogSource source);
 
-        void _processMouseMove(glm::vec2 pos);
+        void _processMouseMove(glm::vec2 pos, bool triggerAnalogActions);
         void _processKey(Key key, bool pressed);
 
         // these notify all raw action listeners, then call the action callback
@@ -208,15 +227,42 @@ namespace odInput
             std::array<ActionHandleBase*, MAX_BINDINGS> actions;
         };
 
-        std::vector<std::pair<Key, bool>> mKeyQueue; // second = button pressed
-        glm::vec2 mMouseMoveTarget;
-        bool mMouseMoved;
-        std::vector<std::pair<ActionCode, ActionState>> mInjectedActionQueue;
-        std::vector<std::pair<ActionCode, glm::vec2>> mInjectedAnalogActionQueue;
-        std::mutex mInputEventQueueMutex;
+        struct QueuedInputEvent
+        {
+            enum class Type
+            {
+                MOUSE_MOVE,
+                KEY,
+                ACTION,
+                ANALOG_ACTION
+            };
+
+            Type type;
+            Clock::time_point time;
+            Key key;
+            bool pressed;
+            ActionCode actionCode;
+            ActionState actionState;
+            glm::vec2 axes; // mouse position for MOUSE_MOVE
+        };
+
+        static constexpr size_t INPUT_RING_CAPACITY = 1024;
+
+        // key codes are either ASCII or in OSG's 0xFF00 function key page (which includes our mouse buttons),
+        //  so two pages of slots cover every key we know
+        static constexpr size_t KEY_SLOT_COUNT = 0x200;
+
+        static size_t _getKeySlot(Key key);
+
+        void _queueInputEvent(const QueuedInputEvent &event);
+
+        InputEventRing<QueuedInputEvent, INPUT_RING_CAPACITY> mInputEventRing;
+        std::atomic<size_t> mDroppedInputEventCount;
+        std::vector<QueuedInputEvent> mDrainedInputEvents; // only used during update. kept to reuse its memory
+        Clock::time_point mCurrentEventTime;
 
         std::unordered_map<ActionCode, std::unique_ptr<ActionHandleBase>> mActions;
-        std::unordered_map<Key, KeyBinding> mKeyBindings;
+        std::array<KeyBinding, KEY_SLOT_COUNT> mKeyBindings;
 
         std::unordered_map<ActionCode, std::unique_ptr<AnalogActionHandleBase>> mAnalogActions;
         std::vector<AnalogActionHandleBase*> mAnalogActionsBoundToMousePos;
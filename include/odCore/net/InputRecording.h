@@ -0,0 +1,117 @@
+/*
+ * InputRecording.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: zal
+ */
+
+#ifndef INCLUDE_ODCORE_NET_INPUTRECORDING_H_
+#define INCLUDE_ODCORE_NET_INPUTRECORDING_H_
+
+#include <chrono>
+#include <istream>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+#include <glm/vec2.hpp>
+
+#include <odCore/net/UplinkConnector.h>
+
+namespace odNet
+{
+
+    /**
+     * @brief A timed sequence of the input actions a client sent to it's server.
+     *
+     * Stored as text with one action per line, times in seconds:
+     *
+     *     <time> action <code> <begin|end|repeat>
+     *     <time> analog <code> <x> <y>
+     *
+     * Empty lines and lines starting with # are ignored. Times must not decrease.
+     */
+    class InputRecording
+    {
+    public:
+
+        struct Entry
+        {
+            double time;
+            bool analog;
+            odInput::ActionCode code;
+            odInput::ActionState state; // only for digital actions
+            glm::vec2 axes; // only for analog actions
+        };
+
+        inline const std::vector<Entry> &getEntries() const { return mEntries; }
+        inline bool empty() const { return mEntries.empty(); }
+
+        /**
+         * @brief Returns the time of the last entry, or 0 if the recording is empty.
+         */
+        double getDuration() const;
+
+        void addAction(double time, odInput::ActionCode code, odInput::ActionState state);
+        void addAnalogAction(double time, odInput::ActionCode code, const glm::vec2 &axes);
+
+        /**
+         * @brief Calls the uplink method corresponding to the given entry.
+         */
+        static void replayEntry(const Entry &entry, UplinkConnector &connector);
+
+        /**
+         * @brief Appends the entries stored in the passed stream. Panics on malformed input.
+         */
+        void read(std::istream &in);
+        void write(std::ostream &out) const;
+
+
+    private:
+
+        void _checkTime(double time);
+
+        std::vector<Entry> mEntries;
+
+    };
+
+
+    /**
+     * @brief Forwards everything to another uplink connector and records the input actions passing through.
+     *
+     * Snapshot acknowledgements are forwarded but not recorded, as they depend on what the server sent.
+     * Recorded times are relative to the first action.
+     */
+    class RecordingUplinkConnector final : public UplinkConnector
+    {
+    public:
+
+        RecordingUplinkConnector(std::shared_ptr<UplinkConnector> output);
+
+        /**
+         * @brief Returns a copy of everything recorded so far. It's okay to call this from a different thread.
+         */
+        InputRecording getRecording();
+
+        virtual void actionTriggered(odInput::ActionCode code, odInput::ActionState state) override;
+        virtual void analogActionTriggered(odInput::ActionCode code, const glm::vec2 &axes) override;
+        virtual void acknowledgeSnapshot(odState::TickNumber tick) override;
+
+
+    private:
+
+        double _getTime();
+
+        std::shared_ptr<UplinkConnector> mOutput;
+
+        std::mutex mMutex;
+        InputRecording mRecording;
+        bool mHasStarted;
+        std::chrono::steady_clock::time_point mStartTime;
+
+    };
+
+}
+
+#endif
@@ -0,0 +1,29 @@
+/*
+ * LayerShape.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: zal
+ */
+
+#ifndef INCLUDE_ODCORE_PHYSICS_LAYERSHAPE_H_
+#define INCLUDE_ODCORE_PHYSICS_LAYERSHAPE_H_
+
+namespace odPhysics
+{
+
+    /**
+     * Abstract interface for a layer's collision shape. Implementation is provided by the physics system.
+     *
+     * Unlike a LayerHandle, this is not part of the physics world, so it can be built on any thread.
+     */
+    class LayerShape
+    {
+    public:
+
+        virtual ~LayerShape() = default;
+
+    };
+
+}
+
+#endif /* INCLUDE_ODCORE_PHYSICS_LAYERSHAPE_H_ */
@@ -37,6 +37,7 @@ namespace odRender
 namespace odPhysics
 {
     class ModelShape;
+    class LayerShape;
 
     struct PhysicsTypeMasks
     {
@@ -94,9 +95,22 @@ namespace odPhysics
         virtual void sphereTest(const glm::vec3 &position, float radius, odPhysics::PhysicsTypeMasks::Mask typeMask, ContactTestResultVector &resultsOut) = 0;
 
         virtual std::shared_ptr<ObjectHandle> createObjectHandle(od::LevelObject &obj, bool isDetector) = 0;
-        virtual std::shared_ptr<LayerHandle>  createLayerHandle(od::Layer &layer) = 0;
         virtual std::shared_ptr<LightHandle>  createLightHandle(const od::Light &light) = 0;
 
+        /**
+         * @brief Builds the collision shape of a layer without adding anything to the world.
+         *
+         * This only reads the layer's geometry, so it may be called from any thread, even for several layers at once.
+         */
+        virtual std::shared_ptr<LayerShape> createLayerShape(od::Layer &layer) = 0;
+
+        /**
+         * @brief Creates a handle for a layer and adds it to the world.
+         *
+         * @param shape  A shape created by createLayerShape() for the same layer. If nullptr, it will be built on the spot.
+         */
+        virtual std::shared_ptr<LayerHandle> createLayerHandle(od::Layer &layer, std::shared_ptr<LayerShape> shape = nullptr) = 0;
+
         virtual std::shared_ptr<ModelShape> createModelShape(std::shared_ptr<odDb::Model> model) = 0;
 
         /**
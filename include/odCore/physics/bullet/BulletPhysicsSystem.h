@@ -54,10 +54,11 @@ namespace odBulletPhysics
         virtual void sphereTest(const glm::vec3 &position, float radius, odPhysics::PhysicsTypeMasks::Mask typeMask, odPhysics::ContactTestResultVector &resultsOut) override;
 
         virtual std::shared_ptr<odPhysics::ObjectHandle> createObjectHandle(od::LevelObject &obj, bool isDetector) override;
-        virtual std::shared_ptr<odPhysics::LayerHandle>  createLayerHandle(od::Layer &layer) override;
+        virtual std::shared_ptr<odPhysics::LayerHandle>  createLayerHandle(od::Layer &layer, std::shared_ptr<odPhysics::LayerShape> shape) override;
         virtual std::shared_ptr<odPhysics::LightHandle>  createLightHandle(const od::Light &light) override;
 
         virtual std::shared_ptr<odPhysics::ModelShape> createModelShape(std::shared_ptr<odDb::Model> model) override;
+        virtual std::shared_ptr<odPhysics::LayerShape> createLayerShape(od::Layer &layer) override;
 
         virtual void setEnableDebugDrawing(bool enable) override;
         virtual bool isDebugDrawingEnabled() override;
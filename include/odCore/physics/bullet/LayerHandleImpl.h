@@ -12,8 +12,6 @@
 
 #include <BulletCollision/CollisionDispatch/btCollisionWorld.h>
 #include <BulletCollision/CollisionDispatch/btCollisionObject.h>
-#include <BulletCollision/CollisionShapes/btTriangleMesh.h>
-#include <BulletCollision/CollisionShapes/btCollisionShape.h>
 
 #include <odCore/physics/Handles.h>
 
@@ -24,12 +22,13 @@ namespace od
 
 namespace odBulletPhysics
 {
+    class LayerShape;
 
     class LayerHandle final : public odPhysics::LayerHandle
     {
     public:
 
-        LayerHandle(od::Layer &layer, btCollisionWorld *collisionWorld);
+        LayerHandle(od::Layer &layer, std::shared_ptr<LayerShape> shape, btCollisionWorld *collisionWorld);
         virtual ~LayerHandle();
 
         inline btCollisionObject *getBulletObject() { return mCollisionObject.get(); }
@@ -39,13 +38,10 @@ namespace odBulletPhysics
 
     private:
 
-        void _buildCollisionShape();
-
         od::Layer &mLayer;
         btCollisionWorld *mCollisionWorld;
 
-        std::unique_ptr<btTriangleMesh> mTriMesh;
-        std::unique_ptr<btCollisionShape> mShape;
+        std::shared_ptr<LayerShape> mShape;
         std::unique_ptr<btCollisionObject> mCollisionObject;
     };
 
@@ -0,0 +1,46 @@
+/*
+ * LayerShapeImpl.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: zal
+ */
+
+#ifndef INCLUDE_ODCORE_PHYSICS_BULLET_LAYERSHAPEIMPL_H_
+#define INCLUDE_ODCORE_PHYSICS_BULLET_LAYERSHAPEIMPL_H_
+
+#include <memory>
+
+#include <BulletCollision/CollisionShapes/btTriangleMesh.h>
+#include <BulletCollision/CollisionShapes/btCollisionShape.h>
+
+#include <odCore/physics/LayerShape.h>
+
+namespace od
+{
+    class Layer;
+}
+
+namespace odBulletPhysics
+{
+
+    class LayerShape final : public odPhysics::LayerShape
+    {
+    public:
+
+        explicit LayerShape(od::Layer &layer);
+
+        /// @return The triangle mesh shape or nullptr if the layer has no colliding triangles.
+        inline btCollisionShape *getShape() { return mShape.get(); }
+
+
+    private:
+
+        void _buildCollisionShape(od::Layer &layer);
+
+        std::unique_ptr<btTriangleMesh> mTriMesh;
+        std::unique_ptr<btCollisionShape> mShape;
+    };
+
+}
+
+#endif /* INCLUDE_ODCORE_PHYSICS_BULLET_LAYERSHAPEIMPL_H_ */
@@ -0,0 +1,29 @@
+/*
+ * PreparedLayerModel.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: zal
+ */
+
+#ifndef INCLUDE_ODCORE_RENDER_PREPAREDLAYERMODEL_H_
+#define INCLUDE_ODCORE_RENDER_PREPAREDLAYERMODEL_H_
+
+namespace odRender
+{
+
+    /**
+     * @brief Abstract interface for the part of a layer's model that can be built without touching the renderer.
+     *
+     * Implementation is provided by the renderer. See Renderer::prepareModelFromLayer().
+     */
+    class PreparedLayerModel
+    {
+    public:
+
+        virtual ~PreparedLayerModel() = default;
+
+    };
+
+}
+
+#endif /* INCLUDE_ODCORE_RENDER_PREPAREDLAYERMODEL_H_ */
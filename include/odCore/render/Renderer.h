@@ -33,6 +33,7 @@ namespace odRender
     class Model;
     class Group;
     class GuiCallback;
+    class PreparedLayerModel;
 
     /**
      * @brief Used when creating a handle. Determines where and how that handle is to be rendered.
@@ -87,7 +88,22 @@ namespace odRender
          */
         std::shared_ptr<Model> getOrCreateModelFromDb(std::shared_ptr<odDb::Model> model);
 
-        virtual std::shared_ptr<Model> createModelFromLayer(od::Layer *layer) = 0;
+        /**
+         * @brief Does all the work of building a layer's model that needs neither the renderer's nor any database's state.
+         *
+         * This only reads the layer's geometry, so it may be called from any thread, even for several layers at once.
+         */
+        virtual std::shared_ptr<PreparedLayerModel> prepareModelFromLayer(od::Layer *layer) = 0;
+
+        /**
+         * @brief Turns the result of prepareModelFromLayer() into a Model. This is where textures are loaded.
+         */
+        virtual std::shared_ptr<Model> createModelFromPreparedLayer(std::shared_ptr<PreparedLayerModel> preparedModel) = 0;
+
+        /**
+         * @brief Prepares and creates a layer's model in one go.
+         */
+        std::shared_ptr<Model> createModelFromLayer(od::Layer *layer);
 
         virtual std::shared_ptr<Image> createImageFromDb(std::shared_ptr<odDb::Texture> dbTexture) = 0;
 
@@ -123,10 +139,22 @@ namespace odRender
 
         /**
          * @brief Renders a frame.
+         *
+         * This should always be called from the same thread. Changes made to the scene from other threads only
+         * become visible once they are published via publishSceneState().
+         *
          * @param relTime  Time passed since last frame was rendered, in seconds.
          */
         virtual void frame(float relTime) = 0;
 
+        /**
+         * @brief Hands all scene changes made outside the render thread since the last call over to the renderer.
+         *
+         * The simulation calls this once at the end of each tick. All changes published in one call will be applied together
+         * before the next frame is drawn, so the renderer never shows a partially updated tick.
+         */
+        virtual void publishSceneState() = 0;
+
     };
 
 }
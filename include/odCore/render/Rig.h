@@ -24,6 +24,13 @@ namespace odRender
 
         virtual void setBoneTransform(size_t boneIndex, glm::mat4 &transform) = 0;
 
+        /**
+         * @brief Sets the transforms of bones 0 to count-1 in one go.
+         *
+         * Implementations should compare against the current pose and skip the upload if no bone changed.
+         */
+        virtual void setBoneTransforms(const glm::mat4 *transforms, size_t count) = 0;
+
     };
 
 }
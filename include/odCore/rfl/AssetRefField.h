@@ -57,7 +57,7 @@ namespace odRfl
                 mReferencedAsset = dt.loadAsset<_AssetType>(mReference);
             }
 
-            return mReferencedAsset == nullptr;
+            return mReference.isNull() || mReferencedAsset != nullptr;
         }
 
         virtual void releaseAssets() override
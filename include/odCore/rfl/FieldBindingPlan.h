@@ -0,0 +1,53 @@
+/*
+ * FieldBindingPlan.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: zal
+ */
+
+#ifndef INCLUDE_ODCORE_RFL_FIELDBINDINGPLAN_H_
+#define INCLUDE_ODCORE_RFL_FIELDBINDINGPLAN_H_
+
+#include <vector>
+
+#include <odCore/rfl/Field.h>
+
+namespace odRfl
+{
+
+    class FieldBundle;
+
+    /**
+     * @brief The types and names of the fields of a FieldBundle in the order they are registered in.
+     *
+     * Since probeFields() must register the same fields every time, this is the same for all instances of a bundle type.
+     * FieldLoaderProbe uses it to check record entries against the bundle without querying the fields or comparing names.
+     */
+    class FieldBindingPlan
+    {
+    public:
+
+        struct Slot
+        {
+            Field::Type fieldType;
+            bool isArray;
+            const char *fieldName; // interned, so it can be compared to the names in FieldLoaderProbe entries by pointer
+        };
+
+        /**
+         * @brief Builds the plan by probing the given bundle once.
+         */
+        explicit FieldBindingPlan(FieldBundle &fieldBundle);
+
+        inline size_t getSlotCount() const { return mSlots.size(); }
+        inline const Slot &getSlot(size_t registrationIndex) const { return mSlots[registrationIndex]; }
+
+
+    private:
+
+        std::vector<Slot> mSlots;
+    };
+
+}
+
+#endif /* INCLUDE_ODCORE_RFL_FIELDBINDINGPLAN_H_ */
@@ -3,17 +3,56 @@
 #define INCLUDE_ODCORE_RFL_FIELDLOADERPROBE_H_
 
 #include <vector>
+#include <unordered_map>
 
 #include <odCore/rfl/FieldProbe.h>
 
 namespace od
 {
     class DataReader;
+    class DataWriter;
 }
 
 namespace odRfl
 {
 
+    class FieldBindingPlan;
+
+    /**
+     * @brief Assigns compact indices to field names so caches can store each name once instead of once per record.
+     *
+     * Only works with names obtained from FieldLoaderProbe::FieldEntry, as those are interned and compared by pointer.
+     */
+    class FieldNameTable
+    {
+    public:
+
+        /// Returns a process-wide copy of the given name. Equal names always yield the same pointer.
+        static const char *intern(const std::string &name);
+
+        /// Returns the index of the given interned name, adding it to the table if it is not yet in there.
+        uint32_t getIndex(const char *name);
+
+        const char *getName(uint32_t index) const;
+        inline size_t getNameCount() const { return mNames.size(); }
+
+        void write(od::DataWriter &dw) const;
+
+        /**
+         * @brief Reads a table written by write(), never reading past the stream offset end.
+         *
+         * @return false if the table does not fit before end.
+         */
+        bool read(od::DataReader &dr, size_t end);
+
+
+    private:
+
+        std::vector<const char*> mNames;
+        std::unordered_map<const char*, uint32_t> mIndices;
+    };
+
+
     /**
      * @brief A FieldProbe that can read and permanently store the data from a field record, and use it to fill FieldBundles.
      */
@@ -33,7 +72,7 @@ namespace odRfl
             bool isArray;
             uint16_t index;
             size_t dataOffset; // offset of entry in mFieldData
-            std::string fieldName;
+            const char *fieldName; // interned. lives as long as the process
         };
 
         FieldLoaderProbe();
@@ -47,10 +86,26 @@ namespace odRfl
          */
         void loadFromRecord(od::DataReader &dr, RecordFormat format);
 
+        /**
+         * @brief Reads entries and data in the format written by writeToCache().
+         *
+         * Entries are stored already sorted and with their data offsets resolved, so this does little more than copy them.
+         * Nothing is read past the stream offset end.
+         *
+         * @return false if the data does not fit before end or refers to names or offsets that don't exist.
+         */
+        bool loadFromCache(od::DataReader &dr, size_t end, const FieldNameTable &names);
+        void writeToCache(od::DataWriter &dw, FieldNameTable &names) const;
+
         FieldLoaderProbe &operator=(FieldLoaderProbe &&p) = default;
 
-        /// Resets internal index counter so this builder can be used to build another class.
-        void reset();
+        /**
+         * @brief Resets internal index counter so this builder can be used to build another class.
+         *
+         * If a plan for the bundle about to be probed is given, record entries are checked against the plan instead of
+         * against the registered fields. The plan must outlive the next probing.
+         */
+        void reset(const FieldBindingPlan *plan = nullptr);
 
         virtual void beginCategory(const char *categoryName) override;
         virtual void registerField(Field &field, const char *fieldName) override;
@@ -61,6 +116,8 @@ namespace odRfl
         std::vector<FieldEntry> mFieldEntries;
         std::vector<char> mFieldData;
         size_t mRegistrationIndex;
+        size_t mEntryCursor;
+        const FieldBindingPlan *mBindingPlan;
     };
 
 }
@@ -8,10 +8,14 @@
 #ifndef INCLUDE_RFL_PREFETCHPROBE_H_
 #define INCLUDE_RFL_PREFETCHPROBE_H_
 
+#include <exception>
 #include <memory>
+#include <vector>
 
 #include <odCore/rfl/FieldProbe.h>
 
+#include <odCore/db/AssetPrefetcher.h>
+
 namespace odDb
 {
     class DependencyTable;
@@ -20,19 +24,44 @@ namespace odDb
 namespace odRfl
 {
 
+    /**
+     * @brief Loads the assets referenced by all asset ref fields of a bundle.
+     *
+     * If an AssetPrefetcher is passed, registerField() only queues the loads, so all fields of a bundle are loaded in
+     * parallel. In that case, the fields must not be accessed until wait() has been called (the destructor waits, too).
+     */
     class PrefetchProbe : public FieldProbe
     {
     public:
 
-        PrefetchProbe(std::shared_ptr<odDb::DependencyTable> dt, bool ignoreMissing = true);
+        PrefetchProbe(std::shared_ptr<odDb::DependencyTable> dt, bool ignoreMissing = true, odDb::AssetPrefetcher *prefetcher = nullptr);
+        ~PrefetchProbe();
 
         virtual void registerField(AssetRefField &field, const char *fieldName) override;
 
+        /**
+         * @brief Blocks until all queued loads are done. Panics on missing assets unless missing assets are ignored.
+         *
+         * If loaders threw, the first of their exceptions is rethrown, but only after all loads are done.
+         */
+        void wait();
+
 
     private:
 
+        struct PendingField
+        {
+            const char *fieldName;
+            odDb::AssetPrefetcher::Request<bool> request;
+        };
+
+        void _checkResult(bool success, const char *fieldName);
+        void _waitForAll(std::exception_ptr &firstError, std::vector<const char*> &failedFields);
+
         std::shared_ptr<odDb::DependencyTable> mDependencyTable;
         bool mIgnoreMissing;
+        odDb::AssetPrefetcher *mPrefetcher;
+        std::vector<PendingField> mPendingFields;
 
     };
 
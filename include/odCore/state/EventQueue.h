@@ -2,8 +2,12 @@
 #ifndef INCLUDE_ODCORE_STATE_EVENTQUEUE_H_
 #define INCLUDE_ODCORE_STATE_EVENTQUEUE_H_
 
+#include <array>
 #include <deque>
+#include <functional>
 #include <utility>
+#include <vector>
+#include <unordered_map>
 
 #include <odCore/state/Event.h>
 
@@ -35,12 +39,31 @@ namespace odState
     {
     public:
 
+        struct EventTypeStatistics
+        {
+            size_t queued;
+            size_t dispatched;
+            size_t retried; ///< Number of times dispatch of an event of this type had to be deferred
+            size_t dropped;
+            size_t sent;
+        };
+
+        static constexpr size_t EVENT_TYPE_COUNT = std::variant_size_v<EventVariant>;
+
+        /// Events that could not be dispatched for this long are dropped.
+        static constexpr double MAX_RETRY_AGE = 30.0;
+
+        /// If more events than this wait for a retry, the oldest ones are dropped.
+        static constexpr size_t MAX_RETRY_EVENTS = 4096;
+
         EventQueue(odDb::DbManager &dbManager, od::Level &level);
 
         inline void setCurrentTime(double t) { mCurrentTime = t; }
 
         /**
          * @brief Adds an event coming from the server to the queue.
+         *
+         * Assets referenced by the event are prefetched in the background, using the event's time as deadline.
          */
         void addIncomingEvent(double realtime, const EventVariant &event);
 
@@ -57,8 +80,20 @@ namespace odState
          */
         void logEvent(const EventVariant &event);
 
+        /**
+         * @brief Dispatches all events up to realtime that have not been dispatched yet.
+         *
+         * Events that could not be dispatched (e.g. because their receiver is stopped) are moved to a retry list and retried
+         * on every following call until they succeed or are older than MAX_RETRY_AGE. They do not hold back other events.
+         */
         void dispatch(double realtime);
 
+        /**
+         * @brief Sends all events up to realtime that have not been sent to the given connector or marked as sent.
+         *
+         * Every connector has its own cursor into the queue, so this only touches events that are new to it. Events that were
+         * logged with a time the connector's cursor had already passed are kept in a separate list and sent first.
+         */
         void sendEventsToClient(odNet::DownlinkConnector &connector, double realtime);
 
         /**
@@ -66,6 +101,9 @@ namespace odState
          *
          * This will prevent them from being sent the at the next call of sendEventsToClient(). If they are also marked as dispatched,
          * the next call to cleanup() will remove them from the queue.
+         *
+         * Connectors that sendEventsToClient() was not called for since the previous call of this are forgotten, along
+         * with any late events still waiting for them.
          */
         void markAsSent(double realtime);
 
@@ -74,6 +112,13 @@ namespace odState
          */
         void cleanup();
 
+        /**
+         * @brief Returns counters for events of the type with the given index in EventVariant.
+         */
+        inline const EventTypeStatistics &getStatistics(size_t typeIndex) const { return mStatistics[typeIndex]; }
+        inline size_t getQueuedEventCount() const { return mEvents.size(); }
+        inline size_t getRetryEventCount() const { return mRetryEvents.size(); }
+
 
     private:
 
@@ -81,14 +126,34 @@ namespace odState
         {
             EventVariant event;
             double realtime;
-            bool dispatched;
-            bool sent;
+            bool dispatched; // or not meant for dispatch
+            bool sent; // or not meant for sending
+
+            // fills in the assets prefetched for the event. must be called before the event is dispatched
+            std::function<void(EventVariant&)> prefetchCompletion;
         };
 
         using EventVector = std::deque<EventData>;
         using EventIterator = EventVector::iterator;
 
+        // cursors count events ever added to the queue, so they stay valid when cleanup() pops from the front
+        using Cursor = uint64_t;
+
+        struct ConnectorState
+        {
+            Cursor cursor;
+            bool active; // sent to since the last markAsSent()
+
+            // unsent events that were inserted behind the cursor
+            std::vector<std::pair<double, EventVariant>> lateEvents;
+        };
+
+        void _insertEvent(EventData &&eventData);
+        bool _tryDispatch(const EventData &eventData, double realtime);
+        void _completePrefetch(EventData &eventData);
         EventIterator _getEventInsertPoint(double realtime);
+        inline EventData &_getEvent(Cursor c) { return mEvents[c - mFrontCursor]; }
+        inline Cursor _getEndCursor() const { return mFrontCursor + mEvents.size(); }
 
         odDb::DbManager &mDbManager;
         od::Level &mLevel;
@@ -96,6 +161,15 @@ namespace odState
         double mCurrentTime;
         EventVector mEvents;
 
+        Cursor mFrontCursor; // cursor of mEvents.front()
+        Cursor mDispatchCursor; // first event dispatch() has not looked at yet
+        Cursor mSentCursor; // first event not marked as sent by markAsSent()
+        std::unordered_map<odNet::DownlinkConnector*, ConnectorState> mConnectors;
+
+        std::vector<EventData> mRetryEvents;
+
+        std::array<EventTypeStatistics, EVENT_TYPE_COUNT> mStatistics;
+
     };
 
 }
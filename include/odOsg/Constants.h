@@ -25,6 +25,14 @@ namespace odOsg
          */
         static constexpr uint32_t MAX_LIGHTS = 8;
 
+        /**
+         * @brief Maximum number of distinct lights that can affect the instances of one instanced model.
+         *
+         * Each instance still only receives MAX_LIGHTS of these. Note that the instancing shader passes the per-instance
+         * light indices in two vec4 attributes, so MAX_LIGHTS must not exceed 8.
+         */
+        static constexpr uint32_t MAX_INSTANCE_LIGHTS = 32;
+
         /**
          * @brief Maximum number of bones to account for in the rigging shader.
          */
@@ -40,6 +48,18 @@ namespace odOsg
          */
         static constexpr uint32_t ATTRIB_WEIGHT_LOCATION = 5;
 
+        /**
+         * @brief Locations of the per-instance attributes for the instancing shader.
+         *
+         * The instance matrix takes four consecutive locations (one per row), the light indices two. Location 8 is left out
+         * since some drivers alias it with gl_MultiTexCoord0.
+         */
+        static constexpr uint32_t ATTRIB_INSTANCE_LAYER_LIGHT_DIFFUSE_LOCATION = 6;
+        static constexpr uint32_t ATTRIB_INSTANCE_LAYER_LIGHT_AMBIENT_LOCATION = 7;
+        static constexpr uint32_t ATTRIB_INSTANCE_MATRIX_LOCATION = 9;
+        static constexpr uint32_t ATTRIB_INSTANCE_LIGHTS_LOCATION = 13;
+        static constexpr uint32_t ATTRIB_INSTANCE_LAYER_LIGHT_DIRECTION_LOCATION = 15;
+
         /**
          * @brief Default fullscreen gamma. This probably should be a config default instead.
          */
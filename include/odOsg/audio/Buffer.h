@@ -33,6 +33,10 @@ namespace odOsg
 
         inline ALuint getBufferId() const { return mBufferId; }
 
+        void setData(ALenum format, const void *data, size_t size, uint32_t frequency);
+
+        static ALenum getFormatForSound(const odDb::Sound &sound);
+
 
     private:
 
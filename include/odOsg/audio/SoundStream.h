@@ -0,0 +1,84 @@
+/*
+ * SoundStream.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: zal
+ */
+
+#ifndef INCLUDE_ODOSG_AUDIO_SOUNDSTREAM_H_
+#define INCLUDE_ODOSG_AUDIO_SOUNDSTREAM_H_
+
+#include <deque>
+#include <memory>
+#include <vector>
+
+#include <AL/al.h>
+
+#include <odCore/db/Sound.h>
+
+namespace odOsg
+{
+    class SoundSystem;
+    class Buffer;
+
+    /**
+     * @brief Feeds a database sound into a source in chunks, decoding it on the fly.
+     *
+     * Used by Source for sounds that are too big to be uploaded as a whole (see odDb::Sound::shouldStream()).
+     * All methods must be called with the owning source's mutex held.
+     */
+    class SoundStream
+    {
+    public:
+
+        static constexpr size_t BUFFER_COUNT = 4;
+        static constexpr size_t BUFFER_SIZE = (1 << 16);
+
+        SoundStream(SoundSystem &ss, std::shared_ptr<odDb::Sound> sound, ALuint sourceId);
+        SoundStream(const SoundStream &s) = delete;
+        ~SoundStream();
+
+        inline void setLooping(bool looping) { mLooping = looping; }
+
+        /**
+         * @brief Prepares the stream for the source to be played. Call before alSourcePlay().
+         *
+         * If the source has stopped, this will rewind the stream to the start of the sound.
+         */
+        void play();
+
+        /**
+         * @brief Call when the source was stopped explicitly, so update() won't treat this as an underrun.
+         */
+        void stop();
+
+        /**
+         * @brief Rewinds the stream to the start of the sound and requeues all buffers. Source must be stopped.
+         */
+        void restart();
+
+        /**
+         * @brief Refills all buffers the source has finished playing and recovers from underruns.
+         */
+        void update();
+
+
+    private:
+
+        bool _fillBuffer(Buffer &buffer);
+        void _unqueueAll();
+
+        ALuint mSourceId;
+        std::shared_ptr<odDb::Sound> mSound;
+        odDb::Sound::Decoder mDecoder;
+        ALenum mFormat;
+        bool mLooping;
+        bool mPlaying;
+        std::vector<uint8_t> mChunk;
+        std::deque<std::shared_ptr<Buffer>> mQueuedBuffers;
+        std::vector<std::shared_ptr<Buffer>> mFreeBuffers;
+    };
+
+}
+
+#endif /* INCLUDE_ODOSG_AUDIO_SOUNDSTREAM_H_ */
@@ -10,18 +10,23 @@
 
 #include <thread>
 #include <mutex>
+#include <condition_variable>
 #include <atomic>
 #include <string>
 #include <vector>
+#include <deque>
+#include <unordered_set>
 #include <memory>
 
 #include <odCore/audio/SoundSystem.h>
+#include <odCore/audio/music/MusicCache.h>
 
 #include <odOsg/audio/OpenAlContext.h>
 
 namespace odDb
 {
     class MusicContainer;
+    class Segment;
 }
 
 namespace odAudio
@@ -63,7 +68,28 @@ namespace odOsg
 
     private:
 
+        struct MusicRenderJob
+        {
+            odAudio::MusicId musicId;
+            uint32_t segmentHash;
+            std::shared_ptr<odDb::Segment> segment;
+        };
+
         void _doWorkerStuff();
+        void _doMusicRenderStuff();
+
+        std::unique_ptr<odAudio::MidiSynth> _createSynth();
+
+        /**
+         * @brief Queues the music with the given ID for rendering into the cache on the music render thread.
+         *
+         * Each music is only queued once per loaded container, even if rendering it failed.
+         */
+        void _requestMusicRender(odAudio::MusicId musicId, uint32_t segmentHash);
+        void _renderMusic(odAudio::MidiSynth &synth, const MusicRenderJob &job);
+        void _stopMusicRenderThread();
+
+        void _playLiveSynthesizedMusic(odAudio::MusicId musicId);
 
         OpenAlContext mContext;
 
@@ -78,6 +104,15 @@ namespace odOsg
         std::shared_ptr<odOsg::StreamingSource> mMusicSource;
         std::unique_ptr<odAudio::MidiSynth> mSynth;
         std::unique_ptr<odAudio::SegmentPlayer> mSegmentPlayer;
+        std::unique_ptr<odAudio::MusicCache> mMusicCache;
+
+        // rendering a segment can take as long as minutes of synthesis, so it never happens on the caller's thread
+        std::thread mMusicRenderThread;
+        std::atomic_bool mMusicRenderTerminateFlag;
+        std::mutex mMusicRenderMutex;
+        std::condition_variable mMusicRenderCondition;
+        std::deque<MusicRenderJob> mMusicRenderJobs;
+        std::unordered_set<odAudio::MusicId> mRequestedMusicRenders;
     };
 
 }
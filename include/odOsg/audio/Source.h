@@ -10,6 +10,7 @@
 
 #include <string>
 #include <mutex>
+#include <memory>
 
 #include <odCore/audio/Source.h>
 
@@ -26,6 +27,7 @@ namespace odOsg
 {
     class SoundSystem;
     class Buffer;
+    class SoundStream;
 
     class Source : public odAudio::Source
     {
@@ -71,6 +73,8 @@ namespace odOsg
 
         std::shared_ptr<odDb::Sound> mCurrentSound;
         std::shared_ptr<Buffer> mCurrentBuffer;
+        std::unique_ptr<SoundStream> mCurrentStream; // used instead of mCurrentBuffer for sounds that need streaming
+        bool mLooping;
 
         float mSourceGain;
         float mSoundGain;
@@ -43,6 +43,7 @@ namespace odOsg
 
         virtual void preloadDls(const od::Guid &dlsGuid) override;
         virtual void assignPreset(uint8_t channel, uint32_t bank, uint32_t patch, const od::Guid &dlsGuid) override;
+        virtual std::string getSettingsKey() const override;
 
 
     private:
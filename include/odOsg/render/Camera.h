@@ -8,30 +8,50 @@
 #ifndef INCLUDE_ODOSG_CAMERA_H_
 #define INCLUDE_ODOSG_CAMERA_H_
 
+#include <atomic>
+#include <mutex>
+
 #include <osg/Camera>
 
 #include <odCore/render/Camera.h>
 
 namespace odOsg
 {
+    class Renderer;
 
     class Camera : public odRender::Camera
     {
     public:
 
-        Camera(osg::Camera *osgCam);
+        Camera(Renderer &renderer, osg::Camera *osgCam);
 
         inline void setIgnoreViewChanges(bool b) { mIgnoreViewChanges = b; }
 
         virtual glm::vec3 getEyePoint() override;
         virtual void lookAt(const glm::vec3 &eye, const glm::vec3 &center, const glm::vec3 &up) override;
 
+        /**
+         * @brief Copies the eye point out of the current view matrix, so getEyePoint() can report it while view changes are ignored.
+         *
+         * Must be called from the render thread, after anything that might move the camera (like a manipulator) has run.
+         */
+        void publishViewMatrixEyePoint();
+
 
     private:
 
+        Renderer &mRenderer;
         osg::ref_ptr<osg::Camera> mOsgCamera;
 
-        bool mIgnoreViewChanges;
+        std::atomic_bool mIgnoreViewChanges;
+
+        // the view matrix lags behind lookAt() until the next frame, so we report the last eye we were given
+        bool mHasEyePoint;
+        glm::vec3 mEyePoint;
+
+        // while view changes are ignored, the view matrix is owned by the render thread. it publishes the eye point here
+        std::mutex mViewMatrixEyePointMutex;
+        glm::vec3 mViewMatrixEyePoint;
     };
 
 }
@@ -0,0 +1,68 @@
+/*
+ * DrawCounter.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: zal
+ */
+
+#ifndef INCLUDE_ODOSG_RENDER_DRAWCOUNTER_H_
+#define INCLUDE_ODOSG_RENDER_DRAWCOUNTER_H_
+
+#include <atomic>
+#include <vector>
+
+#include <osg/Drawable>
+#include <osg/StateSet>
+
+namespace odOsg
+{
+
+    struct RenderStatistics
+    {
+        size_t drawCalls;
+        size_t stateChanges;
+        size_t instancedDrawCalls;
+        size_t instances;
+    };
+
+    /**
+     * @brief Draw callback counting the draw calls and state changes issued for the drawables it is attached to.
+     *
+     * A state change is counted whenever a drawable is drawn with a different path of StateSets than the one drawn
+     * before it, which is what makes OSG touch the GL state between two draws.
+     *
+     * Counting is disabled by default, in which case the callback only forwards the draw.
+     */
+    class DrawCounter : public osg::Drawable::DrawCallback
+    {
+    public:
+
+        DrawCounter();
+
+        inline void setEnabled(bool b) { mEnabled.store(b, std::memory_order_relaxed); }
+        inline bool isEnabled() const { return mEnabled.load(std::memory_order_relaxed); }
+
+        virtual void drawImplementation(osg::RenderInfo &renderInfo, const osg::Drawable *drawable) const override;
+
+        /**
+         * @brief Returns the counts accumulated since the last call and resets them.
+         */
+        RenderStatistics takeStatistics();
+
+
+    private:
+
+        std::atomic_bool mEnabled;
+
+        mutable std::atomic<size_t> mDrawCalls;
+        mutable std::atomic<size_t> mStateChanges;
+        mutable std::atomic<size_t> mInstancedDrawCalls;
+        mutable std::atomic<size_t> mInstances;
+
+        // only touched by the draw thread
+        mutable std::vector<const osg::StateSet*> mLastStatePath;
+    };
+
+}
+
+#endif /* INCLUDE_ODOSG_RENDER_DRAWCOUNTER_H_ */
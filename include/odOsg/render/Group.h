@@ -9,12 +9,13 @@
 namespace odOsg
 {
     class Handle;
+    class Renderer;
 
     class Group : public odRender::Group
     {
     public:
 
-        Group();
+        Group(Renderer &renderer);
         virtual ~Group() override;
 
         inline osg::Group *getOsgNode() { return mTransform; }
@@ -32,6 +33,7 @@ namespace odOsg
 
     private:
 
+        Renderer &mRenderer;
         osg::ref_ptr<osg::Group> mParentGroup;
         std::vector<std::shared_ptr<Handle>> mHandles;
 
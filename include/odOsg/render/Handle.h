@@ -9,6 +9,7 @@
 #define INCLUDE_ODOSG_RENDER_HANDLE_H_
 
 #include <memory>
+#include <functional>
 
 #include <osg/PositionAttitudeTransform>
 #include <osg/Depth>
@@ -73,13 +74,60 @@ namespace odOsg
          */
         virtual void setGlobalLight(const glm::vec3 &direction, const glm::vec3 &diffuse, const glm::vec3 &ambient) override;
 
+        /**
+         * @brief Called by our Rig when bones changed outside the render thread.
+         */
+        void rigChanged();
+
+        /**
+         * @brief Decides again whether our model is drawn below our own transform or as part of an instance batch.
+         *
+         * Called by the Renderer after moving the handle to another render space.
+         */
+        void updateModelAttachment();
+
+        /**
+         * @brief Creates a scene change applying the current transform, visibility and rig state. Used by Renderer when publishing.
+         *
+         * This clears the handle's dirty state.
+         */
+        std::function<void()> makeStateUpdate();
+
 
     private:
 
+        /**
+         * @brief The part of a handle's state that changes often enough to be collected per tick instead of queued per call.
+         */
+        struct StagedState
+        {
+            glm::vec3 position;
+            glm::quat orientation;
+            glm::vec3 scale;
+            bool visible;
+        };
+
+        static void _applyState(osg::PositionAttitudeTransform &transform, const StagedState &state);
+
+        void _stateChanged();
+        bool _canBeInstanced();
+
+        Renderer &mRenderer;
+
+        // getters report this, since the OSG nodes lag behind until the next frame
+        StagedState mState;
+        bool mIsDirty;
+
         osg::ref_ptr<osg::Group> mParentGroup;
 
         std::shared_ptr<Model> mModel;
+        odRender::RenderBin mRenderBin;
         odRender::FrameListener *mFrameListener;
+
+        // what the scene graph will look like after all our staged changes are applied. might lag behind mModel
+        std::shared_ptr<Model> mAttachedModel;
+        bool mAttachedInstanced;
+
         osg::ref_ptr<osg::PositionAttitudeTransform> mTransform;
         osg::ref_ptr<osg::Depth> mDepth;
         osg::ref_ptr<osg::Uniform> mColorModifierUniform;
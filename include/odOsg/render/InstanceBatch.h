@@ -0,0 +1,102 @@
+/*
+ * InstanceBatch.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: zal
+ */
+
+#ifndef INCLUDE_ODOSG_RENDER_INSTANCEBATCH_H_
+#define INCLUDE_ODOSG_RENDER_INSTANCEBATCH_H_
+
+#include <memory>
+#include <vector>
+#include <unordered_map>
+
+#include <osg/Group>
+#include <osg/Geode>
+#include <osg/Geometry>
+#include <osg/PositionAttitudeTransform>
+#include <osg/Uniform>
+
+#include <odOsg/render/LightState.h>
+
+namespace odOsg
+{
+    class Model;
+    class DrawCounter;
+
+    /**
+     * @brief Draws all handles showing the same model with one instanced draw call per geometry of that model.
+     *
+     * Handles are not moved out of the scene graph when they are batched. Instead, their transform simply stops having
+     * the model as a child. The batch reads the transform, visibility, light list and layer light of every member once per
+     * frame in update() and writes them into per-instance attribute arrays, which are only re-uploaded if something changed.
+     *
+     * The lights of all instances are collected into a table of up to Constants::MAX_INSTANCE_LIGHTS lights per batch.
+     *
+     * Since all instances are culled as one, this only pays off for models that are either small or appear often. Any
+     * member that needs per-object state (rigs, color modifiers, non-default render bins) must not be batched.
+     *
+     * All methods must be called from the render thread.
+     */
+    class InstanceBatch
+    {
+    public:
+
+        InstanceBatch(std::shared_ptr<Model> model, DrawCounter *drawCounter);
+        ~InstanceBatch();
+
+        inline osg::Node *getOsgNode() { return mRoot; }
+        inline size_t getInstanceCount() const { return mInstances.size(); }
+
+        void addInstance(osg::PositionAttitudeTransform *transform, LightStateAttribute *lightState);
+        void removeInstance(osg::PositionAttitudeTransform *transform);
+
+        /**
+         * @brief Copies the current state of all members into the instance attributes. Call once per frame before culling.
+         *
+         * @param lightingEnabled  If false, all instances are lit by a white ambient light only.
+         */
+        void update(bool lightingEnabled);
+
+
+    private:
+
+        struct Instance
+        {
+            osg::ref_ptr<osg::PositionAttitudeTransform> transform;
+            osg::ref_ptr<LightStateAttribute> lightState;
+        };
+
+        float _getLightTableIndex(const std::shared_ptr<LightSnapshot> &light);
+        void _resizeInstanceArrays(size_t count);
+        void _updateBound();
+
+        std::shared_ptr<Model> mModel;
+
+        osg::ref_ptr<osg::Group> mRoot;
+        osg::ref_ptr<osg::Geode> mGeode;
+        std::vector<osg::ref_ptr<osg::Geometry>> mGeometries;
+
+        std::vector<Instance> mInstances;
+        size_t mDrawnInstanceCount;
+
+        osg::ref_ptr<osg::Vec4Array> mMatrixRowArrays[4];
+        osg::ref_ptr<osg::Vec4Array> mLightIndexArrays[2];
+        osg::ref_ptr<osg::Vec3Array> mLayerLightDiffuseArray;
+        osg::ref_ptr<osg::Vec3Array> mLayerLightAmbientArray;
+        osg::ref_ptr<osg::Vec3Array> mLayerLightDirectionArray;
+
+        osg::ref_ptr<osg::Uniform> mLightColorUniform;
+        osg::ref_ptr<osg::Uniform> mLightIntensityUniform;
+        osg::ref_ptr<osg::Uniform> mLightRadiusUniform;
+        osg::ref_ptr<osg::Uniform> mLightPositionUniform;
+
+        // rebuilt every update. lights can come and go and change their parameters at any time
+        std::vector<std::shared_ptr<LightSnapshot>> mLightTable;
+        std::unordered_map<LightSnapshot*, float> mLightTableIndices;
+    };
+
+}
+
+#endif /* INCLUDE_ODOSG_RENDER_INSTANCEBATCH_H_ */
@@ -15,13 +15,26 @@
 #include <osg/StateAttribute>
 #include <osg/NodeCallback>
 
-#include <odCore/Light.h>
-
 namespace odOsg
 {
 
     class Renderer;
 
+    /**
+     * @brief Render-side copy of an od::Light's parameters.
+     *
+     * The simulation changes lights at any time, so the render thread never reads an od::Light directly. Instead, the
+     * Renderer copies every light it tracks into its snapshot in publishSceneState(), and the copy is applied together
+     * with the other published changes. Snapshots are only written and read on the render thread after that.
+     */
+    struct LightSnapshot
+    {
+        osg::Vec3 color;
+        float intensityScaling;
+        float radius;
+        osg::Vec3 position;
+    };
+
     /**
      * @brief A StateAttribute handling a list of lights used internally by LightStateCallback.
      */
@@ -50,6 +63,11 @@ namespace odOsg
             mLayerLightDirection = direction;
         }
 
+        inline const osg::Vec3 &getLayerLightDiffuse() const { return mLayerLightDiffuse; }
+        inline const osg::Vec3 &getLayerLightAmbient() const { return mLayerLightAmbient; }
+        inline const osg::Vec3 &getLayerLightDirection() const { return mLayerLightDirection; }
+        inline const std::vector<std::weak_ptr<LightSnapshot>> &getLights() const { return mLights; }
+
         void clearLightList();
 
         /**
@@ -57,16 +75,16 @@ namespace odOsg
          *
          * If more lights than the maximum possible number of lights are added, the additional calls are ignored.
          */
-        void addLight(std::shared_ptr<od::Light> light);
+        void addLight(std::shared_ptr<LightSnapshot> light);
 
-        void removeLight(std::shared_ptr<od::Light> light);
+        void removeLight(std::shared_ptr<LightSnapshot> light);
 
 
     private:
 
         Renderer &mRenderer;
         size_t mMaxLightCount;
-        std::vector<std::weak_ptr<od::Light>> mLights; // weak pointers so lights that get removed will stop being rendered
+        std::vector<std::weak_ptr<LightSnapshot>> mLights; // weak pointers so lights that get removed will stop being rendered
         osg::Vec3 mLayerLightDiffuse;
         osg::Vec3 mLayerLightAmbient;
         osg::Vec3 mLayerLightDirection;
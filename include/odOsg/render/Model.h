@@ -28,6 +28,12 @@ namespace odOsg
         inline osg::Geode *getGeode() { return mGeode; }
         inline void setHasSharedVertexArrays(bool b) { mHasSharedVertexArrays = b; }
 
+        /**
+         * @brief Whether handles showing this model may be drawn as part of an InstanceBatch. Requires the model shader.
+         */
+        inline void setInstanceable(bool b) { mInstanceable = b; }
+        inline bool isInstanceable() const { return mInstanceable; }
+
         virtual size_t getGeometryCount() override;
         virtual std::shared_ptr<odRender::Geometry> getGeometry(size_t index) override;
         virtual void addGeometry(std::shared_ptr<odRender::Geometry> g) override;
@@ -45,6 +51,7 @@ namespace odOsg
         osg::ref_ptr<osg::Geode> mGeode;
 
         bool mHasSharedVertexArrays;
+        bool mInstanceable;
 
     };
 
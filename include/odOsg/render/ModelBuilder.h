@@ -57,6 +57,13 @@ namespace odOsg
 		void setPolygonVector(PolygonIterator begin, PolygonIterator end);
 		void setBoneAffectionVector(BoneAffectionIterator begin, BoneAffectionIterator end);
 
+		/**
+		 * @brief Generates normals and sorts triangles by texture. Called by build() if it hasn't been called before.
+		 *
+		 * This neither touches the renderer nor loads any textures, so it may be called on any thread.
+		 */
+		void prepare();
+
 		std::shared_ptr<Model> build();
 		void buildAndAppend(Model *model);
 
@@ -98,6 +105,7 @@ namespace odOsg
 		std::vector<glm::vec4> mBoneIndices;
 		std::vector<glm::vec4> mBoneWeights;
 		bool mHasBoneInfo;
+		bool mPrepared;
 	};
 
 }
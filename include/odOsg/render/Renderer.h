@@ -10,9 +10,14 @@
 
 #include <vector>
 #include <memory>
+#include <unordered_map>
+#include <functional>
+#include <mutex>
+#include <thread>
 
 #include <osg/Group>
 #include <osg/Uniform>
+#include <osg/PositionAttitudeTransform>
 #include <osgViewer/Viewer>
 
 #include <odCore/BoundingSphere.h>
@@ -20,6 +25,7 @@
 #include <odCore/render/Renderer.h>
 
 #include <odOsg/render/ShaderFactory.h>
+#include <odOsg/render/DrawCounter.h>
 
 namespace od
 {
@@ -31,6 +37,10 @@ namespace odOsg
     class Texture;
     class Camera;
     class Model;
+    class Handle;
+    class InstanceBatch;
+    class LightStateAttribute;
+    struct LightSnapshot;
 
     class Renderer : public odRender::Renderer
     {
@@ -39,9 +49,32 @@ namespace odOsg
         Renderer();
         ~Renderer();
 
+        /**
+         * @brief Must only be used from the render thread. Programs returned by it may already be in use for drawing.
+         */
         inline ShaderFactory &getShaderFactory() { return mShaderFactory; }
         inline osgViewer::Viewer *getViewer() { return mViewer; }
         inline const osg::Matrix &getNdcToGuiSpaceTransform() const { return mNdcToGuiSpaceTransform; }
+        inline osg::Group *getLevelRoot() { return mLevelRoot; }
+        inline DrawCounter *getDrawCounter() { return mDrawCounter; }
+
+        /**
+         * @brief Enables or disables drawing handles that share a model as instanced batches. Enabled by default.
+         *
+         * Only affects handles whose model is set after this call.
+         */
+        inline void setEnableInstancing(bool b) { mInstancingEnabled = b; }
+        inline bool isInstancingEnabled() const { return mInstancingEnabled; }
+
+        /**
+         * @brief Enables counting draw calls and state changes each frame. If enabled, the counts are logged once per second.
+         */
+        void setEnableRenderStatistics(bool b);
+
+        /**
+         * @brief Returns the counts of the last frame. Only valid if statistics are enabled.
+         */
+        inline const RenderStatistics &getRenderStatistics() const { return mLastFrameStatistics; }
 
         virtual void setRendererEventListener(odRender::RendererEventListener *listener) override;
 
@@ -54,7 +87,8 @@ namespace odOsg
         virtual std::shared_ptr<odRender::Group> createGroup(odRender::RenderSpace space) override;
 
         virtual std::shared_ptr<odRender::Model> createModelFromDb(std::shared_ptr<odDb::Model> model) override;
-        virtual std::shared_ptr<odRender::Model> createModelFromLayer(od::Layer *layer) override;
+        virtual std::shared_ptr<odRender::PreparedLayerModel> prepareModelFromLayer(od::Layer *layer) override;
+        virtual std::shared_ptr<odRender::Model> createModelFromPreparedLayer(std::shared_ptr<odRender::PreparedLayerModel> preparedModel) override;
 
         virtual std::shared_ptr<odRender::Image> createImageFromDb(std::shared_ptr<odDb::Texture> dbTexture) override;
         virtual std::shared_ptr<odRender::Texture> createTexture(std::shared_ptr<odRender::Image> image, odRender::TextureReuseSlot reuseSlot) override;
@@ -72,9 +106,52 @@ namespace odOsg
         virtual void shutdown() override;
 
         virtual void frame(float relTime) override;
+        virtual void publishSceneState() override;
+
+        /**
+         * @brief Returns true if called from the thread that renders frames.
+         *
+         * Before setup() has been called, every thread counts as the render thread.
+         */
+        bool isRenderThread() const;
+
+        /**
+         * @brief Runs \c change right away if called from the render thread, or queues it until the next publishSceneState() otherwise.
+         *
+         * Queued changes might run after the object that queued them is gone, so they must only capture what they need by value.
+         */
+        void applyOrStageSceneChange(std::function<void()> change);
+
+        /**
+         * @brief Marks a handle whose transform or rig changed outside the render thread, so its state is included in the next publish.
+         */
+        void markHandleDirty(Handle *handle);
+        void unmarkHandleDirty(Handle *handle);
+
+        /**
+         * @brief Returns the render-side snapshot of a light, starting to track the light if it isn't already.
+         *
+         * Tracked lights are copied into their snapshot on every publishSceneState() until the light is destroyed.
+         * Must be called from the thread that changes the light, usually the simulation thread.
+         */
+        std::shared_ptr<LightSnapshot> getLightSnapshot(const std::shared_ptr<od::Light> &light);
+
+        /**
+         * @brief Adds a transform to the instance batch of the given model, creating the batch if necessary.
+         *
+         * Must be called from the render thread.
+         */
+        void addInstance(std::shared_ptr<Model> model, osg::PositionAttitudeTransform *transform, LightStateAttribute *lightState);
+
+        /**
+         * @brief Removes a transform from the instance batch of the given model. Batches are destroyed once they become empty.
+         *
+         * Must be called from the render thread.
+         */
+        void removeInstance(Model *model, osg::PositionAttitudeTransform *transform);
 
         void applyLayerLight(const osg::Matrix &viewMatrix, const osg::Vec3 &diffuse, const osg::Vec3 &ambient, const osg::Vec3 &direction);
-        void applyToLightUniform(const osg::Matrix &viewMatrix, od::Light &light, size_t index);
+        void applyToLightUniform(const osg::Matrix &viewMatrix, const LightSnapshot &light, size_t index);
         void applyNullLight(size_t index);
 
         void setFreeLook(bool f);
@@ -89,6 +166,8 @@ namespace odOsg
         std::shared_ptr<Model> _buildMultiLodModelNode(odDb::Model &model);
 
         ShaderFactory mShaderFactory;
+        osg::ref_ptr<osg::Program> mModelProgram;
+        osg::ref_ptr<osg::Program> mLayerProgram;
 
         odRender::RendererEventListener *mEventListener;
 
@@ -116,6 +195,33 @@ namespace odOsg
 
         double mSimTime;
 
+        bool mRenderThreadKnown;
+        std::thread::id mRenderThreadId;
+
+        // double-buffered handoff. the simulation fills the staging side, publishSceneState() moves it to the
+        //  published side, and frame() takes the published side and applies it before drawing
+        std::mutex mStagingMutex;
+        std::vector<std::function<void()>> mStagedChanges;
+        std::vector<Handle*> mDirtyHandles;
+        std::mutex mPublishMutex;
+        std::vector<std::function<void()>> mPublishedChanges;
+        std::vector<std::function<void()>> mChangesToApply; // only touched by the render thread
+
+        struct TrackedLight
+        {
+            std::weak_ptr<od::Light> light;
+            std::shared_ptr<LightSnapshot> snapshot;
+        };
+        std::mutex mTrackedLightsMutex;
+        std::unordered_map<const od::Light*, TrackedLight> mTrackedLights;
+
+        bool mInstancingEnabled;
+        std::unordered_map<Model*, std::unique_ptr<InstanceBatch>> mInstanceBatches;
+
+        osg::ref_ptr<DrawCounter> mDrawCounter;
+        RenderStatistics mLastFrameStatistics;
+        double mStatisticsLogTimer;
+
         std::vector<odRender::GuiCallback*> mGuiCallbacks;
     };
 
@@ -8,28 +8,61 @@
 #ifndef INCLUDE_ODOSG_RIG_H_
 #define INCLUDE_ODOSG_RIG_H_
 
+#include <functional>
+#include <vector>
+
 #include <osg/Node>
 #include <osg/Uniform>
+#include <osg/Vec4f>
 
 #include <odCore/render/Rig.h>
 
 namespace odOsg
 {
+    class Renderer;
+    class Handle;
 
+    /**
+     * @brief Uploads bone transforms to the rigging shader.
+     *
+     * Since bone transforms are affine, only the first three rows of each are passed to the shader, as an array of
+     * three vec4s per bone.
+     */
     class Rig : public odRender::Rig
     {
     public:
 
-        Rig(osg::Node *riggedModelRoot);
+        Rig(Renderer &renderer, Handle &handle, osg::Node *riggedModelRoot);
         virtual ~Rig();
 
         virtual void setBoneTransform(size_t boneIndex, glm::mat4 &transform) override;
+        virtual void setBoneTransforms(const glm::mat4 *transforms, size_t count) override;
+
+        /**
+         * @brief Creates a scene change uploading all bones set since the last call, or an empty function if none changed.
+         */
+        std::function<void()> makeUpdate();
 
 
     private:
 
+        /**
+         * @brief Stores a bone's rows in mBoneRows. Returns true if they differed from the stored ones.
+         */
+        bool _storeBone(size_t boneIndex, const glm::mat4 &transform);
+        void _bonesChanged();
+
+        static void _uploadBoneRows(osg::Uniform &uniform, const std::vector<osg::Vec4f> &boneRows);
+
+        Renderer &mRenderer;
+        Handle &mHandle;
+
+        // the current pose. on the render thread, this is uploaded right away. otherwise, it waits until the handle is published
+        std::vector<osg::Vec4f> mBoneRows;
+        bool mBonesDirty;
+
         osg::ref_ptr<osg::Node> mRiggedModelRoot;
-        osg::ref_ptr<osg::Uniform> mBoneMatrixUniform;
+        osg::ref_ptr<osg::Uniform> mBoneRowUniform;
     };
 
 }
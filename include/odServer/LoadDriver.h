@@ -0,0 +1,86 @@
+/*
+ * LoadDriver.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: zal
+ */
+
+#ifndef INCLUDE_ODSERVER_LOADDRIVER_H_
+#define INCLUDE_ODSERVER_LOADDRIVER_H_
+
+#include <atomic>
+#include <memory>
+#include <ostream>
+#include <vector>
+
+#include <odServer/SyntheticClient.h>
+
+namespace od
+{
+    class Server;
+}
+
+namespace odServer
+{
+
+    /**
+     * @brief Runs a server headlessly at a fixed tick rate, with synthetic clients attached, and measures it.
+     *
+     * Input replay, server tick and client downlinks all happen in lockstep on the calling thread, so
+     * runs with the same level, recording and client count are reproducible. Only the server tick
+     * itself counts towards the measured tick time.
+     */
+    class LoadDriver
+    {
+    public:
+
+        static constexpr double TICK_INTERVAL = 1.0/60.0;
+
+        LoadDriver(od::Server &server);
+        ~LoadDriver();
+
+        inline void setIsDone(bool b) { mIsDone.store(b, std::memory_order_relaxed); }
+
+        /**
+         * @brief If false, ticks are not paced to real time but run back-to-back. Simulated time still advances at 60 Hz. Default is true.
+         */
+        inline void setRealtime(bool b) { mRealtime = b; }
+
+        /**
+         * @brief Connects count synthetic clients to the server, spreading their start points evenly across the recording.
+         *
+         * Has to be called before the level is loaded, or the RFL won't spawn anything for the clients.
+         *
+         * @param recording  Input each client replays in a loop, or nullptr for idle clients. Must outlive this.
+         */
+        void addClients(size_t count, const odNet::InputRecording *recording);
+
+        /**
+         * @brief Ticks the server until duration seconds of server time have passed, or until setIsDone(true) is called.
+         *
+         * A duration of 0 means no time limit. The server needs to have a level loaded.
+         */
+        void run(double duration);
+
+        void printReport(std::ostream &out) const;
+
+
+    private:
+
+        od::Server &mServer;
+
+        std::vector<std::unique_ptr<SyntheticClient>> mClients;
+
+        std::atomic_bool mIsDone;
+        bool mRealtime;
+
+        std::vector<double> mTickTimes;
+        size_t mSlowTickCount;
+        double mSimulatedTime;
+        double mWallTime;
+
+    };
+
+}
+
+#endif
@@ -0,0 +1,97 @@
+/*
+ * SyntheticClient.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: zal
+ */
+
+#ifndef INCLUDE_ODSERVER_SYNTHETICCLIENT_H_
+#define INCLUDE_ODSERVER_SYNTHETICCLIENT_H_
+
+#include <memory>
+#include <vector>
+
+#include <odCore/net/DownlinkConnector.h>
+#include <odCore/net/IdTypes.h>
+#include <odCore/net/InputRecording.h>
+#include <odCore/net/PacketBuilder.h>
+#include <odCore/net/QueuedDownlinkConnector.h>
+#include <odCore/net/QueuedUplinkConnector.h>
+
+namespace od
+{
+    class Server;
+}
+
+namespace odServer
+{
+
+    /**
+     * @brief Stands in for a remote client without simulating anything itself.
+     *
+     * Registers itself with the server on construction and is connected through queued connectors,
+     * like a local client would be. Everything the server sends is encoded with the network protocol
+     * so we know how much a real client would have received. Snapshots are acknowledged right away,
+     * so the server delta-encodes against them just like with a client on a fast connection.
+     *
+     * Optionally replays an input recording in a loop.
+     */
+    class SyntheticClient final : public odNet::DownlinkConnector
+    {
+    public:
+
+        /**
+         * @param recording  Input to replay, or nullptr for a client that does nothing. Must outlive this.
+         * @param replayOffset  Where in the recording to start, in seconds. Use this so not all clients act in lockstep.
+         */
+        SyntheticClient(od::Server &server, const odNet::InputRecording *recording, double replayOffset);
+
+        inline odNet::ClientId getClientId() const { return mClientId; }
+        inline const std::vector<size_t> &getSnapshotSizes() const { return mSnapshotSizes; }
+        inline size_t getReceivedBytes() const { return mReceivedBytes; }
+        inline size_t getObjectStatesCount() const { return mObjectStatesCount; }
+        inline size_t getEventCount() const { return mEventCount; }
+        inline size_t getReplayedActionCount() const { return mReplayedActionCount; }
+
+        /**
+         * @brief Sends all recorded actions that became due in the last relTime seconds to the server.
+         */
+        void replayInput(double relTime);
+
+        /**
+         * @brief Processes everything the server sent since the last call.
+         */
+        void flushDownlink();
+
+        virtual void globalDatabaseTableEntry(odDb::GlobalDatabaseIndex dbIndex, const std::string &path) override;
+        virtual void loadLevel(const std::string &path, size_t loadedDatabaseCount) override;
+        virtual void objectStatesChanged(odState::TickNumber tick, od::LevelObjectId id, const od::ObjectStates &states) override;
+        virtual void objectExtraStatesChanged(odState::TickNumber tick, od::LevelObjectId id, const char *data, size_t size) override;
+        virtual void confirmSnapshot(odState::TickNumber tick, double realtime, size_t discreteChangeCount, odState::TickNumber referenceTick) override;
+        virtual void globalMessage(odNet::MessageChannelCode code, const char *data, size_t size) override;
+        virtual void event(const odState::EventVariant &e, double realtime) override;
+
+
+    private:
+
+        odNet::ClientId mClientId;
+        std::shared_ptr<odNet::QueuedDownlinkConnector> mDownlinkQueue;
+        std::shared_ptr<odNet::QueuedUplinkConnector> mUplinkConnector;
+        odNet::PacketBuilder mPacketBuilder;
+
+        const odNet::InputRecording *mRecording;
+        double mReplayTime;
+        size_t mReplayCursor;
+
+        size_t mReceivedBytes;
+        size_t mPendingSnapshotBytes;
+        std::vector<size_t> mSnapshotSizes;
+        size_t mObjectStatesCount;
+        size_t mEventCount;
+        size_t mReplayedActionCount;
+
+    };
+
+}
+
+#endif
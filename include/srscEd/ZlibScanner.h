@@ -0,0 +1,80 @@
+/*
+ * ZlibScanner.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: zal
+ */
+
+#ifndef INCLUDE_SRSCED_ZLIBSCANNER_H_
+#define INCLUDE_SRSCED_ZLIBSCANNER_H_
+
+#include <string>
+#include <vector>
+#include <zlib.h>
+
+#include <odCore/SrscFile.h>
+
+namespace srscEd
+{
+
+    struct ZlibStreamInfo
+    {
+        size_t offset; ///< Offset of the zlib header relative to the start of the scanned data
+        size_t compressedSize;
+        size_t inflatedSize;
+        bool corrupt;
+        std::string error; ///< Only set if corrupt
+    };
+
+    /**
+     * @brief Finds zlib streams embedded in record data.
+     *
+     * SRSC records don't flag compressed data on their own. For record types whose layout is known (textures, sounds
+     * and level layers), streams are located by parsing the record, and a stream that fails to inflate there is
+     * reported as corrupt.
+     *
+     * Records of other types (or known types that don't parse) are searched for anything that looks like a zlib header,
+     * trying to inflate from there. As any byte pair can pass the header check, a failure at such an offset can't be
+     * told apart from random data. Candidates there only count as streams if they inflate to the end with a valid
+     * checksum. They are never reported as corrupt.
+     *
+     * Not thread-safe. Use one scanner per thread.
+     */
+    class ZlibScanner
+    {
+    public:
+
+        ZlibScanner();
+        ZlibScanner(const ZlibScanner &s) = delete;
+        ~ZlibScanner();
+
+        /**
+         * @brief Scans the given data of a record of the given type and appends all streams found to \c streams.
+         *
+         * @param inflatedData  If not nullptr, the inflated contents of each non-corrupt stream are appended here, in the
+         *                      same order as the streams they belong to. Corrupt streams get an empty entry.
+         */
+        void scan(od::RecordType type, const char *data, size_t size, std::vector<ZlibStreamInfo> &streams, std::vector<std::vector<char>> *inflatedData = nullptr);
+
+
+    private:
+
+        struct KnownStream
+        {
+            size_t offset;
+            size_t size; // as stored in the record. may exceed the record
+        };
+
+        bool _findKnownStreams(od::RecordType type, const char *data, size_t size, std::vector<KnownStream> &knownStreams);
+        void _scanForHeaders(const char *data, size_t size, std::vector<ZlibStreamInfo> &streams, std::vector<std::vector<char>> *inflatedData);
+        bool _looksLikeHeader(const unsigned char *p, size_t available);
+        // returns true if the stream inflated to its end. fills in the error otherwise
+        bool _tryInflate(const char *data, size_t size, ZlibStreamInfo &info, std::vector<char> *inflated);
+
+        z_stream mStream;
+        std::vector<char> mOutputBuffer;
+    };
+
+}
+
+#endif /* INCLUDE_SRSCED_ZLIBSCANNER_H_ */
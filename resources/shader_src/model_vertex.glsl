@@ -1,13 +1,30 @@
 #version 120
 
 
-#pragma import_defines(LIGHTING, RIGGING, SPECULAR, MAX_LIGHTS, MAX_BONES)
+#pragma import_defines(LIGHTING, RIGGING, SPECULAR, INSTANCED, MAX_LIGHTS, MAX_BONES, MAX_INSTANCE_LIGHTS)
 
 
 varying vec2 texCoord;
 varying vec4 vertexColor;
 
 
+#ifdef INSTANCED
+    // one row of the instance's model matrix per attribute
+    attribute vec4 instanceMatrix0;
+    attribute vec4 instanceMatrix1;
+    attribute vec4 instanceMatrix2;
+    attribute vec4 instanceMatrix3;
+    
+    // indices into the batch's light table. negative means no light
+    attribute vec4 instanceLights0;
+    attribute vec4 instanceLights1;
+    
+    attribute vec3 instanceLayerLightDiffuse;
+    attribute vec3 instanceLayerLightAmbient;
+    attribute vec3 instanceLayerLightDirection; // world space
+#endif
+
+
 #ifdef LIGHTING
     varying vec3 lightColor;
     
@@ -15,50 +32,86 @@ varying vec4 vertexColor;
         varying vec3 specularColor;
     #endif
     
-    uniform vec3  layerLightDiffuse;
-    uniform vec3  layerLightAmbient;
-    uniform vec3  layerLightDirection;
-    
-    uniform vec3  objectLightDiffuse[MAX_LIGHTS];
-    uniform float objectLightIntensity[MAX_LIGHTS];
-    uniform float objectLightRadius[MAX_LIGHTS];
-    uniform vec3  objectLightPosition[MAX_LIGHTS];
+    #ifdef INSTANCED
+        uniform vec3  instanceLightDiffuse[MAX_INSTANCE_LIGHTS];
+        uniform float instanceLightIntensity[MAX_INSTANCE_LIGHTS];
+        uniform float instanceLightRadius[MAX_INSTANCE_LIGHTS];
+        uniform vec3  instanceLightPosition[MAX_INSTANCE_LIGHTS]; // world space, unlike objectLightPosition
+    #else
+        uniform vec3  layerLightDiffuse;
+        uniform vec3  layerLightAmbient;
+        uniform vec3  layerLightDirection;
+        
+        uniform vec3  objectLightDiffuse[MAX_LIGHTS];
+        uniform float objectLightIntensity[MAX_LIGHTS];
+        uniform float objectLightRadius[MAX_LIGHTS];
+        uniform vec3  objectLightPosition[MAX_LIGHTS];
+    #endif
 
-    vec3 calcLighting(vec3 vertex_cs, vec3 normal_cs)
+    vec3 calcLayerLighting(vec3 vertex_cs, vec3 normal_cs, vec3 diffuse, vec3 ambient, vec3 direction_cs)
     {
-        vec3 resultLightColor;
+        // note that the riot engine seems to add the layer ambient light twice
+        float layerCosTheta = max(dot(normal_cs, direction_cs), 0.0);
+        vec3 resultLightColor = 2*ambient + diffuse*layerCosTheta;
         
-        // layer light first
-        //  note that the riot engine seems to add the layer ambient light twice
-        float layerCosTheta = max(dot(normal_cs, layerLightDirection), 0.0);
-        resultLightColor = 2*layerLightAmbient + layerLightDiffuse*layerCosTheta;
+        #ifdef SPECULAR
+            vec3 halfVector = normalize(direction_cs + normalize(-vertex_cs));
+            float cosAlpha = max(dot(halfVector, normal_cs), 0.0);
+            specularColor = diffuse * pow(cosAlpha, 50);
+        #endif
+        
+        return resultLightColor;
+    }
+    
+    vec3 calcObjectLighting(vec3 vertex_cs, vec3 normal_cs, vec3 diffuse, float intensity, float radius, vec3 position_cs)
+    {
+        vec3 lightDir_cs = position_cs - vertex_cs;
+        float distance = length(lightDir_cs);
+        lightDir_cs = normalize(lightDir_cs);
+        
+        float normDistance = distance/radius;
+        float attenuation = -0.82824*normDistance*normDistance - 0.13095*normDistance + 1.01358;
+        attenuation = clamp(attenuation, 0.0, 1.0);
+
+        float cosTheta = max(dot(normal_cs, lightDir_cs), 0.0);
         
         #ifdef SPECULAR
-            vec3 halfVector = normalize(layerLightDirection + normalize(-vertex_cs));
+            vec3 halfVector = normalize(lightDir_cs + normalize(-vertex_cs));
             float cosAlpha = max(dot(halfVector, normal_cs), 0.0);
-            specularColor = layerLightDiffuse * pow(cosAlpha, 50);
+            specularColor += diffuse * attenuation * pow(cosAlpha, 50);
         #endif
         
+        return intensity * diffuse * cosTheta * attenuation;
+    }
+
+    vec3 calcLighting(vec3 vertex_cs, vec3 normal_cs)
+    {
+        vec3 resultLightColor;
+        
+    #ifdef INSTANCED
+        // the batch is not transformed, so the modelview matrix is just the view matrix
+        vec3 layerLightDirection_cs = (gl_ModelViewMatrix * vec4(instanceLayerLightDirection, 0.0)).xyz;
+        resultLightColor = calcLayerLighting(vertex_cs, normal_cs, instanceLayerLightDiffuse, instanceLayerLightAmbient, layerLightDirection_cs);
+        
         for(int i = 0; i < MAX_LIGHTS; ++i)
         {
-            vec3 lightDir_cs = objectLightPosition[i] - vertex_cs;
-            float distance = length(lightDir_cs);
-            lightDir_cs = normalize(lightDir_cs);
-            
-            float normDistance = distance/objectLightRadius[i];
-            float attenuation = -0.82824*normDistance*normDistance - 0.13095*normDistance + 1.01358;
-            attenuation = clamp(attenuation, 0.0, 1.0);
-    
-            float cosTheta = max(dot(normal_cs, lightDir_cs), 0.0);
-            
-            resultLightColor += objectLightIntensity[i] * objectLightDiffuse[i] * cosTheta * attenuation;
-            
-            #ifdef SPECULAR
-                vec3 halfVector = normalize(lightDir_cs + normalize(-vertex_cs));
-                float cosAlpha = max(dot(halfVector, normal_cs), 0.0);
-                specularColor += objectLightDiffuse[i] * attenuation * pow(cosAlpha, 50);
-            #endif
+            int lightIndex = int((i < 4) ? instanceLights0[i] : instanceLights1[i - 4]);
+            if(lightIndex >= 0)
+            {
+                vec3 lightPosition_cs = (gl_ModelViewMatrix * vec4(instanceLightPosition[lightIndex], 1.0)).xyz;
+                resultLightColor += calcObjectLighting(vertex_cs, normal_cs, instanceLightDiffuse[lightIndex], 
+                        instanceLightIntensity[lightIndex], instanceLightRadius[lightIndex], lightPosition_cs);
+            }
         }
+    #else
+        resultLightColor = calcLayerLighting(vertex_cs, normal_cs, layerLightDiffuse, layerLightAmbient, layerLightDirection);
+        
+        for(int i = 0; i < MAX_LIGHTS; ++i)
+        {
+            resultLightColor += calcObjectLighting(vertex_cs, normal_cs, objectLightDiffuse[i], objectLightIntensity[i], 
+                    objectLightRadius[i], objectLightPosition[i]);
+        }
+    #endif
         
         return resultLightColor;
     }
@@ -68,23 +121,25 @@ varying vec4 vertexColor;
 #ifdef RIGGING
     attribute vec4 influencingBones;
     attribute vec4 vertexWeights;
-    uniform mat4 bones[MAX_BONES];
     
-    mat4 calcTotalBoneTransform()
-    {   
-        mat4 totalBoneXform = mat4(0.0);
+    // the first three rows of each bone's transform. the last row would only affect w, which we force to 1 anyway
+    uniform vec4 bones[MAX_BONES*3];
+    
+    void calcTotalBoneTransform(out vec4 row0, out vec4 row1, out vec4 row2)
+    {
+        row0 = vec4(0.0);
+        row1 = vec4(0.0);
+        row2 = vec4(0.0);
         
         for(int i = 0; i < 4; ++i)
         {
             int boneIndex = int(min(influencingBones[i], MAX_BONES - 0.6)); // subtract less than 1 to prevent rounding errors in min function
             
             float vertexWeight = vertexWeights[i];
-            mat4 bone = bones[boneIndex];
-            
-            totalBoneXform += bone * vertexWeight;
+            row0 += bones[boneIndex*3]     * vertexWeight;
+            row1 += bones[boneIndex*3 + 1] * vertexWeight;
+            row2 += bones[boneIndex*3 + 2] * vertexWeight;
         }
-        
-        return totalBoneXform;
     }
 #endif
 
@@ -95,10 +150,18 @@ void main(void)
     vec3 normal_ms = gl_Normal;
 
 #ifdef RIGGING
-    mat4 boneTransform = calcTotalBoneTransform();
-    vertex_ms = boneTransform * vertex_ms;
-    vertex_ms.w = 1.0;
-    normal_ms = (boneTransform * vec4(normal_ms, 0.0)).xyz;
+    vec4 boneRow0;
+    vec4 boneRow1;
+    vec4 boneRow2;
+    calcTotalBoneTransform(boneRow0, boneRow1, boneRow2);
+    vertex_ms = vec4(dot(boneRow0, vertex_ms), dot(boneRow1, vertex_ms), dot(boneRow2, vertex_ms), 1.0);
+    normal_ms = vec3(dot(boneRow0.xyz, normal_ms), dot(boneRow1.xyz, normal_ms), dot(boneRow2.xyz, normal_ms));
+#endif
+
+#ifdef INSTANCED
+    mat4 instanceMatrix = mat4(instanceMatrix0, instanceMatrix1, instanceMatrix2, instanceMatrix3);
+    vertex_ms = instanceMatrix * vertex_ms;
+    normal_ms = mat3(instanceMatrix) * normal_ms;
 #endif
 
     vec4 vertex_cs = gl_ModelViewMatrix * vertex_ms;
@@ -114,6 +114,7 @@ namespace dragonRfl
         menuAction.setIgnoreUpEvents(true);
         menuAction.addCallback([this](auto action, auto state)
         {
+            std::lock_guard<std::recursive_mutex> lock(mGui->getMutex());
             mGui->setMenuMode(!mGui->isMenuMode());
         });
 
@@ -70,9 +70,10 @@ namespace dragonRfl
         mLightHandle = getClient().getPhysicsSystem().createLightHandle(lightPrototype);
         getClient().getPhysicsSystem().dispatchLighting(mLightHandle);
 
-        obj.setEnableUpdate(true);
-
         mStarted = (mFields.startEffect == DynamicLightFields::EffectStartType::WhenCreated);
+
+        _applyLightColor();
+        _updateEnableState();
     }
 
     void DynamicLight_Cl::onDespawned()
@@ -119,14 +120,8 @@ namespace dragonRfl
             break;
         }
 
-        if(mLightIsOn)
-        {
-            mLightHandle->getLight()->setColor(mLightColorVector*mColorFactor);
-
-        }else
-        {
-            mLightHandle->getLight()->setColor(glm::vec3(0.0, 0.0, 0.0)); // TODO: lights need an off-flag. an off-state light could free up one light slot
-        }
+        _applyLightColor();
+        _updateEnableState();
     }
 
     void DynamicLight_Cl::onTransformChanged()
@@ -142,15 +137,18 @@ namespace dragonRfl
             if(mFields.startEffect == DynamicLightFields::EffectStartType::WhenEnabled)
             {
                 mStarted = true;
+                _updateEnableState();
             }
             break;
 
         case od::Message::On:
             mLightIsOn = true;
+            _applyLightColor();
             break;
 
         case od::Message::Off:
             mLightIsOn = false;
+            _applyLightColor();
             break;
 
         default:
@@ -158,4 +156,45 @@ namespace dragonRfl
         }
     }
 
+    void DynamicLight_Cl::_applyLightColor()
+    {
+        if(mLightHandle == nullptr)
+        {
+            return;
+        }
+
+        if(mLightIsOn)
+        {
+            mLightHandle->getLight()->setColor(mLightColorVector*mColorFactor);
+
+        }else
+        {
+            mLightHandle->getLight()->setColor(glm::vec3(0.0, 0.0, 0.0)); // TODO: lights need an off-flag. an off-state light could free up one light slot
+        }
+    }
+
+    void DynamicLight_Cl::_updateEnableState()
+    {
+        // only a running effect changes the light over time. on/off switches are applied right when the message arrives
+        bool effectRunning = false;
+        if(mLightHandle != nullptr && mStarted)
+        {
+            switch(mFields.intensityEffect)
+            {
+            case DynamicLightFields::IntensityEffect::Pulse:
+                effectRunning = true;
+                break;
+
+            case DynamicLightFields::IntensityEffect::Fade:
+                effectRunning = (mColorFactor > 0.0);
+                break;
+
+            default:
+                break;
+            }
+        }
+
+        getLevelObject().setEnableUpdate(effectRunning);
+    }
+
 }
@@ -2,6 +2,7 @@
 #include <dragonRfl/classes/Fader.h>
 
 #include <odCore/Client.h>
+#include <odCore/Level.h>
 #include <odCore/LevelObject.h>
 
 #include <odCore/db/Class.h>
@@ -45,14 +46,13 @@ namespace dragonRfl
 
 	void Fader_Sv::onSpawned()
 	{
-        auto &obj = getLevelObject();
-        obj.setEnableUpdate(true);
+        _setPhase((mFields.startMode == StartMode::RUN_INSTANTLY) ? FadePhase::FADE_IN : FadePhase::NOT_TRIGGERED);
+	}
 
-        if(mFields.startMode == StartMode::RUN_INSTANTLY)
-        {
-            mPhase = FadePhase::FADE_IN;
-            mTime = 0.0f;
-        }
+	void Fader_Sv::onDespawned()
+	{
+	    // the callback captures this, so it must not fire while we are despawned
+	    mFadedTimeout.cancel();
 	}
 
 	void Fader_Sv::onUpdate(float relTime)
@@ -61,7 +61,7 @@ namespace dragonRfl
         switch(mPhase)
         {
         case FadePhase::NOT_TRIGGERED:
-            //fadeState = 1.0f;
+        case FadePhase::FADED:
             return;
 
         case FadePhase::FADE_IN:
@@ -69,24 +69,10 @@ namespace dragonRfl
             fadeState = mTime / mFields.fadeInTime;
             if(mTime >= mFields.fadeInTime)
             {
-                mTime = 0.0f;
-                mPhase = FadePhase::FADED;
+                _setPhase(FadePhase::FADED);
             }
             break;
 
-        case FadePhase::FADED:
-            //fadeState = 1.0f;
-            if(mFields.fadedTime >= 0) // negative faded-time would mean "wait for trigger to start fade-out"
-            {
-                mTime += relTime;
-                if(mTime >= mFields.fadedTime)
-                {
-                    mTime = 0.0f;
-                    mPhase = FadePhase::FADE_OUT;
-                }
-            }
-            return;
-
         case FadePhase::FADE_OUT:
             if(mTime < mFields.fadeOutTime)
             {
@@ -96,7 +82,7 @@ namespace dragonRfl
             }else
             {
                 fadeState = 0.0f;
-                mPhase = FadePhase::NOT_TRIGGERED;
+                _setPhase(FadePhase::NOT_TRIGGERED);
             }
             break;
         }
@@ -112,8 +98,7 @@ namespace dragonRfl
         case FadePhase::NOT_TRIGGERED:
             if(mFields.startMode == StartMode::RUN_WHEN_TRIGGERED)
             {
-                mPhase = FadePhase::FADE_IN;
-                mTime = 0.0f;
+                _setPhase(FadePhase::FADE_IN);
             }
             break;
 
@@ -121,8 +106,7 @@ namespace dragonRfl
             if(mFields.fadedTime < 0)
             {
                 // TODO: does the numerical value of the message affect this in any way?
-                mPhase = FadePhase::FADE_OUT;
-                mTime = 0.0f;
+                _setPhase(FadePhase::FADE_OUT);
             }
             break;
 
@@ -131,6 +115,23 @@ namespace dragonRfl
         }
     }
 
+    void Fader_Sv::_setPhase(FadePhase phase)
+    {
+        auto &obj = getLevelObject();
+
+        mPhase = phase;
+        mTime = 0.0f;
+
+        // only fading needs per-frame updates. while faded, we just wait for the timer wheel to start the fade-out
+        obj.setEnableUpdate(phase == FadePhase::FADE_IN || phase == FadePhase::FADE_OUT);
+
+        mFadedTimeout.cancel();
+        if(phase == FadePhase::FADED && mFields.fadedTime >= 0) // negative faded-time would mean "wait for trigger to start fade-out"
+        {
+            mFadedTimeout = obj.getLevel().getTimerWheel().schedule(mFields.fadedTime, [this](){ _setPhase(FadePhase::FADE_OUT); });
+        }
+    }
+
 
     Fader_Cl::Fader_Cl()
     {
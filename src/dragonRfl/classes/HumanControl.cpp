@@ -16,6 +16,8 @@
 #include <odCore/Client.h>
 #include <odCore/Server.h>
 
+#include <odCore/db/DbManager.h>
+
 #include <odCore/anim/Skeleton.h>
 #include <odCore/anim/SkeletonAnimationPlayer.h>
 
@@ -55,8 +57,9 @@ namespace dragonRfl
     void HumanControl_Sv::onLoaded()
     {
         // prefetch referenced assets
-        odRfl::PrefetchProbe probe(getLevelObject().getClass()->getDependencyTable());
+        odRfl::PrefetchProbe probe(getLevelObject().getClass()->getDependencyTable(), true, &getServer().getDbManager().getAssetPrefetcher());
         mFields.probeFields(probe);
+        probe.wait();
 
         // configure controls FIXME: these handlers are not memory safe because actions are not uniquely owned!
         auto actionHandler = std::bind(&HumanControl_Sv::_handleAction, this, std::placeholders::_1, std::placeholders::_2);
@@ -269,8 +272,9 @@ namespace dragonRfl
 
     void HumanControl_Cl::onLoaded()
     {
-        odRfl::PrefetchProbe probe(getLevelObject().getClass()->getDependencyTable());
+        odRfl::PrefetchProbe probe(getLevelObject().getClass()->getDependencyTable(), true, &getClient().getDbManager().getAssetPrefetcher());
         mFields.probeFields(probe);
+        probe.wait();
 
         getLevelObject().setSpawnStrategy(od::SpawnStrategy::Always);
 
@@ -8,6 +8,7 @@
 
 #include <dragonRfl/classes/Timer.h>
 
+#include <odCore/Level.h>
 #include <odCore/LevelObject.h>
 
 namespace dragonRfl
@@ -41,6 +42,7 @@ namespace dragonRfl
 	: mGotStartTrigger(false)
     , mTimerRunning(false)
     , mTimeElapsed(0.0)
+    , mRunStartTime(0.0)
 	{
 	}
 
@@ -52,60 +54,90 @@ namespace dragonRfl
 
 	void Timer_Sv::onSpawned()
 	{
-        auto &obj = getLevelObject();
-
-	    obj.setEnableUpdate(true);
-
-	    mTimerRunning = (mFields.startMode == StartMode::RUN_INSTANTLY);
+	    // the timer only waits for a deadline, so it does not need per-frame updates
+	    if(mFields.startMode == StartMode::RUN_INSTANTLY)
+	    {
+	        _start();
+	    }
 	}
 
-	void Timer_Sv::onUpdate(float relTime)
+	void Timer_Sv::onDespawned()
 	{
-        auto &obj = getLevelObject();
+	    _stop();
+	}
 
-	    if(!mTimerRunning)
+	void Timer_Sv::onMessageReceived(od::LevelObject &sender, od::Message message)
+	{
+	    if(mFields.startMode == StartMode::RUN_WHEN_TRIGGERED && !mGotStartTrigger)
 	    {
-	        return;
-	    }
+	        // i assume any message will trigger the timer. there is no field that would indicate otherwise
+	        _start();
+	        mGotStartTrigger = true;
 
-	    mTimeElapsed += relTime;
+	        Logger::verbose() << "Timer " << getLevelObject().getObjectId() << " started by object " << sender.getObjectId();
 
-	    if(mTimeElapsed >= mFields.timeUntilTrigger)
+	    }else if(mFields.toggle && message == mFields.disableReenableMessage)
 	    {
-	        Logger::verbose() << "Timer " << obj.getObjectId() << " triggered after " << mTimeElapsed << "s";
-
-	        obj.messageAllLinkedObjects(mFields.triggerMessage);
-
-	        mTimerRunning = false;
-
-	        if(mFields.destroyAfterTimeout)
+	        if(mTimerRunning)
 	        {
-	            obj.requestDestruction();
+	            _stop();
 
-	        }else if(mFields.repeat)
+	        }else
 	        {
-	            mTimerRunning = true;
-	            mTimeElapsed = 0.0;
+	            _start();
 	        }
+
+	        Logger::verbose() << "Timer " << getLevelObject().getObjectId() << " " << (mTimerRunning ? "enabled" : "disabled")
+	                          << " by object " << sender.getObjectId();
 	    }
 	}
 
-	void Timer_Sv::onMessageReceived(od::LevelObject &sender, od::Message message)
+	void Timer_Sv::_start()
 	{
-	    if(mFields.startMode == StartMode::RUN_WHEN_TRIGGERED && !mGotStartTrigger)
+	    if(mTimerRunning)
 	    {
-	        // i assume any message will trigger the timer. there is no field that would indicate otherwise
-	        mTimerRunning = true;
-	        mGotStartTrigger = true;
+	        return;
+	    }
 
-	        Logger::verbose() << "Timer " << getLevelObject().getObjectId() << " started by object " << sender.getObjectId();
+	    auto &timerWheel = getLevelObject().getLevel().getTimerWheel();
 
-	    }else if(mFields.toggle && message == mFields.disableReenableMessage)
+	    mTimerRunning = true;
+	    mRunStartTime = timerWheel.getTime();
+	    mTimeout = timerWheel.schedule(mFields.timeUntilTrigger - mTimeElapsed, [this](){ _onTimeout(); });
+	}
+
+	void Timer_Sv::_stop()
+	{
+	    if(!mTimerRunning)
 	    {
-	        mTimerRunning = !mTimerRunning;
+	        return;
+	    }
 
-	        Logger::verbose() << "Timer " << getLevelObject().getObjectId() << " " << (mTimerRunning ? "enabled" : "disabled")
-	                          << " by object " << sender.getObjectId();
+	    // keep what has elapsed so far so toggling the timer back on continues where it left off
+	    mTimeElapsed += getLevelObject().getLevel().getTimerWheel().getTime() - mRunStartTime;
+	    mTimerRunning = false;
+	    mTimeout.cancel();
+	}
+
+	void Timer_Sv::_onTimeout()
+	{
+	    auto &obj = getLevelObject();
+
+	    _stop();
+
+	    Logger::verbose() << "Timer " << obj.getObjectId() << " triggered after " << mTimeElapsed << "s";
+
+	    mTimeElapsed = 0.0;
+
+	    obj.messageAllLinkedObjects(mFields.triggerMessage);
+
+	    if(mFields.destroyAfterTimeout)
+	    {
+	        obj.requestDestruction();
+
+	    }else if(mFields.repeat)
+	    {
+	        _start();
 	    }
 	}
 
@@ -20,7 +20,7 @@ namespace dragonRfl
     Cursor::Cursor(DragonGui &gui)
     : Widget(gui)
     {
-        // the quad never changes after here and the widget shares ownership over the handle.
+        // the quad never changes after here and the widget shares ownership over the quad data.
         //  thus we can put it on the stack and let it die after the constructor
         auto quad = gui.makeQuadFromGuiTexture(GuiTextures::Cursor);
         quad.setVertexCoords(glm::vec2(0.0, 0.0), glm::vec2(1, 1));
@@ -31,7 +31,7 @@ namespace dragonRfl
         quad.getTexture()->setEnableWrapping(odRender::Texture::Dimension::U, true);
         quad.setTextureCoordsFromPixels(glm::vec2(-2.5, 0), glm::vec2(29.5, 32));
 
-        this->addRenderHandle(quad.getHandle());
+        this->addQuad(quad);
 
         this->setOrigin(odGui::WidgetOrigin::TopLeft);
         this->setDimensions({32.0, 32.0}, odGui::WidgetDimensionType::Pixels);
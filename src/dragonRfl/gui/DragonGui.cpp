@@ -153,9 +153,13 @@ namespace dragonRfl
         auto &renderer = mClient.getRenderer();
 
         odGui::Quad quad(renderer);
-        std::shared_ptr<odDb::Texture> dbTexture = mRrcTextureFactory.getAsset(id);
-        std::shared_ptr<odRender::Image> image = renderer.getOrCreateImageFromDb(dbTexture);
-        std::shared_ptr<odRender::Texture> texture = renderer.createTexture(image, odRender::TextureReuseSlot::NONE);
+        std::shared_ptr<odRender::Texture> &texture = mGuiTextureCache[id];
+        if(texture == nullptr)
+        {
+            std::shared_ptr<odDb::Texture> dbTexture = mRrcTextureFactory.getAsset(id);
+            std::shared_ptr<odRender::Image> image = renderer.getOrCreateImageFromDb(dbTexture);
+            texture = renderer.createTexture(image, odRender::TextureReuseSlot::NONE);
+        }
         quad.setTexture(texture);
 
         return std::move(quad);
@@ -40,7 +40,7 @@ namespace dragonRfl
             }
 
             mOrbQuad_Left.getTexture()->setEnableWrapping(false);
-            this->addRenderHandle(mOrbQuad_Left.getHandle());
+            this->addQuad(mOrbQuad_Left);
 
             setFillRatio(1.0);
 
@@ -73,10 +73,10 @@ namespace dragonRfl
             }
 
             mOrbQuad_Left.getTexture()->setEnableWrapping(false);
-            this->addRenderHandle(mOrbQuad_Left.getHandle());
+            this->addQuad(mOrbQuad_Left);
 
             mOrbQuad_Right.getTexture()->setEnableWrapping(false);
-            this->addRenderHandle(mOrbQuad_Right.getHandle());
+            this->addQuad(mOrbQuad_Right);
 
             setFillRatio(1.0);
 
@@ -161,7 +161,7 @@ namespace dragonRfl
         auto border = gui.makeQuadFromGuiTexture(GuiTextures::HudElements);
         border.setTextureCoordsFromPixels(glm::vec2(0, 130), glm::vec2(95, 220));
         border.setVertexCoords(glm::vec2(0, 0), glm::vec2(1, 1));
-        this->addRenderHandle(border.getHandle());
+        this->addQuad(border);
 
         glm::vec2 orbOffset(10, 13);
 
@@ -209,6 +209,9 @@ namespace dragonRfl
     {
         state = glm::clamp(state, 0.0f, 1.0f);
 
+        // called by game logic on the simulation thread, while onUpdate() runs on the render thread
+        std::lock_guard<std::recursive_mutex> lock(mDragonGui.getMutex());
+
         if(animTime <= 0)
         {
             mHealthLevel.set(state);
@@ -33,22 +33,22 @@ namespace dragonRfl
             auto topLeft = gui.makeQuadFromGuiTexture(GuiTextures::MainMenu_TopLeft);
             topLeft.setTextureCoordsFromPixels(glm::vec2(0, 0), glm::vec2(255, 255));
             topLeft.setVertexCoords(glm::vec2(0.0, 0.0), glm::vec2(0.5, 0.5));
-            this->addRenderHandle(topLeft.getHandle());
+            this->addQuad(topLeft);
 
             auto topRight = gui.makeQuadFromGuiTexture(GuiTextures::MainMenu_TopRight);
             topRight.setTextureCoordsFromPixels(glm::vec2(0, 0), glm::vec2(255, 255));
             topRight.setVertexCoords(glm::vec2(0.5, 0.0), glm::vec2(1, 0.5));
-            this->addRenderHandle(topRight.getHandle());
+            this->addQuad(topRight);
 
             auto bottomLeft = gui.makeQuadFromGuiTexture(GuiTextures::MainMenu_BottomLeft);
             bottomLeft.setTextureCoordsFromPixels(glm::vec2(0, 0), glm::vec2(255, 255));
             bottomLeft.setVertexCoords(glm::vec2(0.0, 0.5), glm::vec2(0.5, 1));
-            this->addRenderHandle(bottomLeft.getHandle());
+            this->addQuad(bottomLeft);
 
             auto bottomRight = gui.makeQuadFromGuiTexture(GuiTextures::MainMenu_BottomRight);
             bottomRight.setTextureCoordsFromPixels(glm::vec2(0, 0), glm::vec2(255, 255));
             bottomRight.setVertexCoords(glm::vec2(0.5, 0.5), glm::vec2(1.0, 1.0));
-            this->addRenderHandle(bottomRight.getHandle());
+            this->addQuad(bottomRight);
 
             this->setDimensions({512.0, 512.0}, odGui::WidgetDimensionType::Pixels);
         }
@@ -65,7 +65,7 @@ namespace dragonRfl
             odGui::Quad bg(gui.getRenderer());
             bg.setVertexCoords(glm::vec2(0.0, 0.0), glm::vec2(1.0, 1.0));
             bg.setColor(glm::vec4(0.0, 0.0, 0.0, 0.5));
-            this->addRenderHandle(bg.getHandle());
+            this->addQuad(bg);
 
             this->setDimensions({1.0, 1.0}, odGui::WidgetDimensionType::ParentRelative);
         }
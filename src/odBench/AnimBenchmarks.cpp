@@ -0,0 +1,232 @@
+/*
+ * AnimBenchmarks.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: zal
+ */
+
+#include <odBench/Benchmark.h>
+
+#include <cmath>
+
+#include <glm/mat4x4.hpp>
+
+#include <odCore/db/Animation.h>
+#include <odCore/db/AnimationFactory.h>
+#include <odCore/db/SkeletonDefinition.h>
+
+#include <odCore/anim/Skeleton.h>
+#include <odCore/anim/SkeletonAnimationPlayer.h>
+
+#include <odCore/render/Rig.h>
+
+#include <odBench/SyntheticData.h>
+
+namespace odBench
+{
+
+    // roughly what a humanoid character in the original game has
+    static const size_t JOINT_COUNT = 64;
+    static const size_t KEYFRAMES_PER_JOINT = 30;
+    static const float ANIMATION_DURATION = 1.0f;
+
+
+    namespace
+    {
+        /**
+         * @brief Stands in for the renderer's rig. Copies the transforms, which is what an upload would have to do anyway.
+         */
+        class CopyingRig final : public odRender::Rig
+        {
+        public:
+
+            virtual void setBoneTransform(size_t boneIndex, glm::mat4 &transform) override
+            {
+                if(boneIndex >= mTransforms.size())
+                {
+                    mTransforms.resize(boneIndex + 1);
+                }
+
+                mTransforms[boneIndex] = transform;
+            }
+
+            virtual void setBoneTransforms(const glm::mat4 *transforms, size_t count) override
+            {
+                mTransforms.assign(transforms, transforms + count);
+            }
+
+            inline const std::vector<glm::mat4> &getTransforms() const { return mTransforms; }
+
+
+        private:
+
+            std::vector<glm::mat4> mTransforms;
+        };
+
+
+        /**
+         * @brief A skeleton shaped like a binary tree and a looping animation moving all of it's joints.
+         */
+        struct AnimFixture
+        {
+            static const od::RecordId ANIMATION_ID = 1;
+
+            AnimFixture()
+            : file("animation")
+            {
+                skeletonDefinition = std::make_shared<odDb::SkeletonDefinition>();
+                for(size_t i = 0; i < JOINT_COUNT; ++i)
+                {
+                    // joint i has children 2i+1 and 2i+2. the first child links to the second as it's sibling
+                    int32_t firstChild = (2*i + 1 < JOINT_COUNT) ? static_cast<int32_t>(2*i + 1) : -1;
+                    int32_t nextSibling = (i % 2 == 1 && i + 1 < JOINT_COUNT) ? static_cast<int32_t>(i + 1) : -1;
+
+                    glm::mat4 boneXform(1.0f);
+                    boneXform[3] = glm::vec4(0.0f, -0.5f, 0.0f, 1.0f);
+                    skeletonDefinition->addJointInfo(boneXform, -1, firstChild, nextSibling);
+                }
+                skeletonDefinition->finalize();
+
+                _addAnimationRecords();
+                animationFactory = std::make_unique<odDb::AnimationFactory>(nullptr, file.open());
+                animation = animationFactory->getAsset(ANIMATION_ID);
+            }
+
+            static AnimFixture &get()
+            {
+                static AnimFixture fixture;
+                return fixture;
+            }
+
+            SyntheticSrscFile file;
+            std::shared_ptr<odDb::SkeletonDefinition> skeletonDefinition;
+            std::unique_ptr<odDb::AnimationFactory> animationFactory;
+            std::shared_ptr<odDb::Animation> animation;
+
+
+        private:
+
+            void _addAnimationRecords()
+            {
+                file.addRecord(od::SrscRecordType::ANIMATION_INFO, ANIMATION_ID, buildRecord([](od::DataWriter &dw)
+                {
+                    writeString(dw, "benchmark animation");
+                    dw << ANIMATION_DURATION
+                       << static_cast<uint32_t>(KEYFRAMES_PER_JOINT) // original frame count
+                       << static_cast<uint32_t>(KEYFRAMES_PER_JOINT)
+                       << static_cast<uint32_t>(0) // flags (looping)
+                       << static_cast<uint32_t>(JOINT_COUNT) // node count
+                       << static_cast<uint32_t>(JOINT_COUNT) // channel count
+                       << static_cast<uint32_t>(0)
+                       << static_cast<uint32_t>(0) // reference count
+                       << 0.0f << 0.0f << 0.0f; // thresholds
+                }));
+
+                Random random(5);
+                file.addRecord(od::SrscRecordType::ANIMATION_FRAMES, ANIMATION_ID, buildRecord([&](od::DataWriter &dw)
+                {
+                    dw << static_cast<uint16_t>(JOINT_COUNT * KEYFRAMES_PER_JOINT);
+                    for(size_t joint = 0; joint < JOINT_COUNT; ++joint)
+                    {
+                        float phase = random.nextFloat(0.0f, 6.28f);
+                        for(size_t frame = 0; frame < KEYFRAMES_PER_JOINT; ++frame)
+                        {
+                            float time = ANIMATION_DURATION * frame / (KEYFRAMES_PER_JOINT - 1);
+                            float angle = 0.5f * std::sin(phase + 6.28f * time / ANIMATION_DURATION);
+                            float c = std::cos(angle);
+                            float s = std::sin(angle);
+
+                            // rotation about Z in row-major order, followed by the translation
+                            dw << time
+                               <<    c << -s << 0.0f
+                               <<    s <<  c << 0.0f
+                               << 0.0f << 0.0f << 1.0f
+                               << 0.0f << -0.5f << 0.0f;
+                        }
+                    }
+                }));
+
+                file.addRecord(od::SrscRecordType::ANIMATION_LOOKUP, ANIMATION_ID, buildRecord([](od::DataWriter &dw)
+                {
+                    dw << static_cast<uint16_t>(JOINT_COUNT);
+                    for(size_t joint = 0; joint < JOINT_COUNT; ++joint)
+                    {
+                        dw << static_cast<uint32_t>(joint * KEYFRAMES_PER_JOINT)
+                           << static_cast<uint32_t>(KEYFRAMES_PER_JOINT);
+                    }
+                }));
+            }
+        };
+    }
+
+    static void _benchLoadAnimation(State &state)
+    {
+        auto &fixture = AnimFixture::get();
+
+        // the fixture keeps it's own instance alive, so we need a separate factory to force reloading
+        odDb::AnimationFactory factory(nullptr, fixture.file.open());
+
+        state.setItemsPerIteration(JOINT_COUNT * KEYFRAMES_PER_JOINT);
+        state.measure([&]()
+        {
+            auto animation = factory.getAsset(AnimFixture::ANIMATION_ID);
+            doNotOptimize(animation.get());
+        });
+    }
+
+    static void _benchFlatten(State &state)
+    {
+        auto &fixture = AnimFixture::get();
+        odAnim::Skeleton skeleton(fixture.skeletonDefinition);
+        CopyingRig rig;
+
+        state.setItemsPerIteration(JOINT_COUNT);
+        state.measure([&]()
+        {
+            skeleton.flatten(rig);
+            doNotOptimize(rig.getTransforms().back());
+        });
+    }
+
+    template <bool _Interpolated>
+    static void _benchBoneAnimators(State &state)
+    {
+        auto &fixture = AnimFixture::get();
+        odAnim::Skeleton skeleton(fixture.skeletonDefinition);
+
+        odAnim::AnimModes modes;
+        modes.playbackType = odAnim::PlaybackType::LOOPING;
+
+        std::vector<std::unique_ptr<odAnim::BoneAnimator>> animators;
+        for(size_t i = 0; i < JOINT_COUNT; ++i)
+        {
+            auto animator = std::make_unique<odAnim::BoneAnimator>(skeleton.getBoneByJointIndex(i));
+            animator->setUseInterpolation(_Interpolated);
+            animator->playAnimation(fixture.animation, modes);
+            animators.push_back(std::move(animator));
+        }
+
+        // not a multiple of the keyframe spacing, so we hit every position between frames eventually
+        const float relTime = 1.0f/61.0f;
+
+        state.setItemsPerIteration(JOINT_COUNT);
+        state.measure([&]()
+        {
+            for(auto &animator : animators)
+            {
+                animator->update(relTime);
+            }
+            doNotOptimize(skeleton.getBoneByJointIndex(0).getCurrentTransform());
+        });
+    }
+
+
+    void registerAnimBenchmarks(std::vector<Benchmark> &benchmarks)
+    {
+        benchmarks.push_back({ "Animation/load",        &_benchLoadAnimation });
+        benchmarks.push_back({ "Skeleton/flatten",      &_benchFlatten });
+        benchmarks.push_back({ "BoneAnimator/nearest",  &_benchBoneAnimators<false> });
+        benchmarks.push_back({ "BoneAnimator/linear",   &_benchBoneAnimators<true> });
+    }
+
+}
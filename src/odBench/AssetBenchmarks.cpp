@@ -0,0 +1,333 @@
+/*
+ * AssetBenchmarks.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: zal
+ */
+
+#include <odBench/Benchmark.h>
+
+#include <zlib.h>
+
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+
+#include <odCore/Panic.h>
+
+#include <odCore/db/AssetRef.h>
+#include <odCore/db/Model.h>
+#include <odCore/db/ModelFactory.h>
+#include <odCore/db/Texture.h>
+#include <odCore/db/TextureFactory.h>
+
+#include <odBench/SyntheticData.h>
+
+namespace odBench
+{
+
+    static const uint32_t TEXTURE_SIZE = 256;
+
+    static const size_t MODEL_VERTEX_COUNT = 2048;
+    static const size_t MODEL_POLYGON_COUNT = 4096;
+    static const size_t MODEL_TEXTURE_COUNT = 8;
+
+    // same values as in Texture.cpp
+    static const uint8_t TEXTURE_FLAG_ALPHACHANNEL = 0x02;
+
+    enum class TextureFormat
+    {
+        PAL8,
+        RGB565,
+        ARGB1555,
+        ARGB4444,
+        ARGB8332,
+        RGB888,
+        RGB888_KEYED,
+        BGRA8888,
+        RGB888_ZLIB
+    };
+
+    static const TextureFormat ALL_TEXTURE_FORMATS[] =
+    {
+        TextureFormat::PAL8,
+        TextureFormat::RGB565,
+        TextureFormat::ARGB1555,
+        TextureFormat::ARGB4444,
+        TextureFormat::ARGB8332,
+        TextureFormat::RGB888,
+        TextureFormat::RGB888_KEYED,
+        TextureFormat::BGRA8888,
+        TextureFormat::RGB888_ZLIB
+    };
+
+    static od::RecordId _getTextureId(TextureFormat format)
+    {
+        // leave gaps so Texture::load() never mistakes a neighbour for an animation frame
+        return 0x10 * (static_cast<od::RecordId>(format) + 1);
+    }
+
+    static std::vector<char> _buildPaletteRecord()
+    {
+        return buildRecord([](od::DataWriter &dw)
+        {
+            dw << static_cast<uint16_t>(256);
+            for(size_t i = 0; i < 256; ++i)
+            {
+                dw << static_cast<uint8_t>(i)
+                   << static_cast<uint8_t>(255 - i)
+                   << static_cast<uint8_t>(i * 7)
+                   << static_cast<uint8_t>(0);
+            }
+        });
+    }
+
+    static std::vector<char> _buildTextureRecord(TextureFormat format, Random &random)
+    {
+        uint16_t bitsPerPixel;
+        uint16_t alphaBitsPerPixel = 0;
+        uint8_t flags = 0;
+        uint32_t colorKey = 0xffffffff;
+        bool compress = false;
+        switch(format)
+        {
+        case TextureFormat::PAL8:
+            bitsPerPixel = 8;
+            break;
+
+        case TextureFormat::RGB565:
+            bitsPerPixel = 16;
+            break;
+
+        case TextureFormat::ARGB1555:
+            bitsPerPixel = 16;
+            alphaBitsPerPixel = 1;
+            flags = TEXTURE_FLAG_ALPHACHANNEL;
+            break;
+
+        case TextureFormat::ARGB4444:
+            bitsPerPixel = 16;
+            alphaBitsPerPixel = 4;
+            flags = TEXTURE_FLAG_ALPHACHANNEL;
+            break;
+
+        case TextureFormat::ARGB8332:
+            bitsPerPixel = 16;
+            alphaBitsPerPixel = 8;
+            flags = TEXTURE_FLAG_ALPHACHANNEL;
+            break;
+
+        case TextureFormat::RGB888:
+            bitsPerPixel = 24;
+            break;
+
+        case TextureFormat::RGB888_KEYED:
+            bitsPerPixel = 24;
+            colorKey = 0x00ff00ff;
+            break;
+
+        case TextureFormat::BGRA8888:
+            bitsPerPixel = 32;
+            alphaBitsPerPixel = 8;
+            break;
+
+        case TextureFormat::RGB888_ZLIB:
+            bitsPerPixel = 24;
+            compress = true;
+            break;
+
+        default:
+            OD_UNREACHABLE();
+        }
+
+        // gradients with a bit of noise, so compression behaves roughly like it does on real textures
+        size_t bytesPerPixel = bitsPerPixel / 8;
+        std::vector<char> pixels(TEXTURE_SIZE * TEXTURE_SIZE * bytesPerPixel);
+        for(size_t y = 0; y < TEXTURE_SIZE; ++y)
+        {
+            for(size_t x = 0; x < TEXTURE_SIZE; ++x)
+            {
+                size_t offset = (y*TEXTURE_SIZE + x) * bytesPerPixel;
+                for(size_t b = 0; b < bytesPerPixel; ++b)
+                {
+                    pixels[offset + b] = static_cast<char>((x + y*(b + 1)) ^ (random.next() & 0x03));
+                }
+            }
+        }
+
+        uint32_t compressionLevel = 0;
+        if(compress)
+        {
+            compressionLevel = 9;
+
+            uLongf compressedSize = compressBound(pixels.size());
+            std::vector<char> compressed(compressedSize);
+            int result = compress2(reinterpret_cast<Bytef*>(compressed.data()), &compressedSize, reinterpret_cast<const Bytef*>(pixels.data()), pixels.size(), compressionLevel);
+            if(result != Z_OK)
+            {
+                OD_PANIC() << "Failed to compress synthetic texture";
+            }
+            compressed.resize(compressedSize);
+
+            pixels = std::move(compressed);
+        }
+
+        return buildRecord([&](od::DataWriter &dw)
+        {
+            dw << TEXTURE_SIZE
+               << TEXTURE_SIZE
+               << static_cast<uint32_t>(TEXTURE_SIZE * bytesPerPixel) // row spacing
+               << bitsPerPixel
+               << alphaBitsPerPixel
+               << static_cast<uint16_t>(0)
+               << colorKey
+               << odDb::AssetRef::NULL_REF // next mipmap
+               << odDb::AssetRef::NULL_REF // alternate
+               << odDb::AssetRef::NULL_REF // bump map
+               << static_cast<uint8_t>(0) // anim FPS
+               << flags
+               << static_cast<uint16_t>(0) // mipmap number
+               << odDb::AssetRef::NULL_REF // material class
+               << static_cast<uint32_t>(0) // usage count
+               << compressionLevel
+               << static_cast<uint32_t>(compress ? pixels.size() : 0);
+
+            dw.write(pixels.data(), pixels.size());
+        });
+    }
+
+    static void _addModelRecords(SyntheticSrscFile &file, od::RecordId id, Random &random)
+    {
+        file.addRecord(od::SrscRecordType::MODEL_NAME, id, buildRecord([](od::DataWriter &dw)
+        {
+            writeString(dw, "benchmark model");
+            dw << static_cast<uint32_t>(0x02); // smooth shading
+        }));
+
+        file.addRecord(od::SrscRecordType::MODEL_VERTICES, id, buildRecord([&](od::DataWriter &dw)
+        {
+            dw << static_cast<uint16_t>(MODEL_VERTEX_COUNT);
+            for(size_t i = 0; i < MODEL_VERTEX_COUNT; ++i)
+            {
+                glm::vec3 v(random.nextFloat(-10, 10), random.nextFloat(-10, 10), random.nextFloat(-10, 10));
+                dw << v;
+            }
+        }));
+
+        file.addRecord(od::SrscRecordType::MODEL_TEXTURES, id, buildRecord([](od::DataWriter &dw)
+        {
+            dw << static_cast<uint32_t>(MODEL_TEXTURE_COUNT);
+            for(size_t i = 0; i < MODEL_TEXTURE_COUNT; ++i)
+            {
+                dw << odDb::AssetRef(static_cast<od::RecordId>(i + 1), 0);
+            }
+        }));
+
+        // mix of triangles and quads, which is what ModelBuilder would have to triangulate
+        file.addRecord(od::SrscRecordType::MODEL_POLYGONS, id, buildRecord([&](od::DataWriter &dw)
+        {
+            dw << static_cast<uint16_t>(MODEL_POLYGON_COUNT);
+            for(size_t i = 0; i < MODEL_POLYGON_COUNT; ++i)
+            {
+                uint16_t vertexCount = random.nextBool(0.5f) ? 4 : 3;
+                dw << static_cast<uint16_t>(0) // flags
+                   << vertexCount
+                   << static_cast<uint16_t>(random.next() % MODEL_TEXTURE_COUNT);
+
+                for(size_t v = 0; v < vertexCount; ++v)
+                {
+                    glm::vec2 uv(random.nextFloat(0, 1), random.nextFloat(0, 1));
+                    dw << static_cast<uint16_t>(random.next() % MODEL_VERTEX_COUNT)
+                       << uv;
+                }
+            }
+        }));
+    }
+
+
+    namespace
+    {
+        /**
+         * @brief One container with a palette, a texture for each format and a model. Built on first use.
+         */
+        struct AssetFixture
+        {
+            static const od::RecordId MODEL_ID = 1;
+
+            AssetFixture()
+            : file("assets")
+            {
+                Random random(3);
+
+                file.addRecord(od::SrscRecordType::PALETTE, 0, _buildPaletteRecord());
+
+                for(auto format : ALL_TEXTURE_FORMATS)
+                {
+                    auto record = _buildTextureRecord(format, random);
+                    textureRecordSizes.push_back(record.size());
+                    file.addRecord(od::SrscRecordType::TEXTURE, _getTextureId(format), std::move(record));
+                }
+
+                _addModelRecords(file, MODEL_ID, random);
+
+                od::SrscFile &srscFile = file.open();
+                textureFactory = std::make_unique<odDb::TextureFactory>(nullptr, srscFile);
+                modelFactory = std::make_unique<odDb::ModelFactory>(nullptr, srscFile);
+            }
+
+            static AssetFixture &get()
+            {
+                static AssetFixture fixture;
+                return fixture;
+            }
+
+            SyntheticSrscFile file;
+            std::vector<size_t> textureRecordSizes; // indexed by format
+            std::unique_ptr<odDb::TextureFactory> textureFactory;
+            std::unique_ptr<odDb::ModelFactory> modelFactory;
+        };
+    }
+
+    template <TextureFormat _Format>
+    static void _benchLoadTexture(State &state)
+    {
+        auto &fixture = AssetFixture::get();
+        od::RecordId id = _getTextureId(_Format);
+
+        state.setBytesPerIteration(fixture.textureRecordSizes[static_cast<size_t>(_Format)]);
+        state.setItemsPerIteration(TEXTURE_SIZE * TEXTURE_SIZE);
+        state.measure([&]()
+        {
+            // the factory only holds weak references, so this reloads the texture every time
+            auto texture = fixture.textureFactory->getAsset(id);
+            doNotOptimize(texture->getRawR8G8B8A8Data()[0]);
+        });
+    }
+
+    static void _benchLoadModel(State &state)
+    {
+        auto &fixture = AssetFixture::get();
+
+        state.setItemsPerIteration(MODEL_POLYGON_COUNT);
+        state.measure([&]()
+        {
+            auto model = fixture.modelFactory->getAsset(AssetFixture::MODEL_ID);
+            doNotOptimize(model.get());
+        });
+    }
+
+
+    void registerAssetBenchmarks(std::vector<Benchmark> &benchmarks)
+    {
+        benchmarks.push_back({ "Texture/pal8",        &_benchLoadTexture<TextureFormat::PAL8> });
+        benchmarks.push_back({ "Texture/rgb565",      &_benchLoadTexture<TextureFormat::RGB565> });
+        benchmarks.push_back({ "Texture/argb1555",    &_benchLoadTexture<TextureFormat::ARGB1555> });
+        benchmarks.push_back({ "Texture/argb4444",    &_benchLoadTexture<TextureFormat::ARGB4444> });
+        benchmarks.push_back({ "Texture/argb8332",    &_benchLoadTexture<TextureFormat::ARGB8332> });
+        benchmarks.push_back({ "Texture/rgb888",      &_benchLoadTexture<TextureFormat::RGB888> });
+        benchmarks.push_back({ "Texture/rgb888Keyed", &_benchLoadTexture<TextureFormat::RGB888_KEYED> });
+        benchmarks.push_back({ "Texture/bgra8888",    &_benchLoadTexture<TextureFormat::BGRA8888> });
+        benchmarks.push_back({ "Texture/rgb888Zlib",  &_benchLoadTexture<TextureFormat::RGB888_ZLIB> });
+        benchmarks.push_back({ "Model/load",          &_benchLoadModel });
+    }
+
+}
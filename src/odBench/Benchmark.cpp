@@ -0,0 +1,51 @@
+/*
+ * Benchmark.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: zal
+ */
+
+#include <odBench/Benchmark.h>
+
+#include <algorithm>
+
+#include <odCore/Panic.h>
+
+namespace odBench
+{
+
+    State::State(double minSampleTime, size_t sampleCount)
+    : mMinSampleTime(minSampleTime)
+    , mSampleCount(std::max<size_t>(sampleCount, 1))
+    , mBytesPerIteration(0)
+    , mItemsPerIteration(0)
+    , mIterations(0)
+    {
+    }
+
+    Result runBenchmark(const Benchmark &benchmark, double minSampleTime, size_t sampleCount)
+    {
+        State state(minSampleTime, sampleCount);
+        benchmark.function(state);
+
+        if(!state.hasMeasured())
+        {
+            OD_PANIC() << "Benchmark '" << benchmark.name << "' never called measure()";
+        }
+
+        std::vector<double> sorted = state.getSamples();
+        std::sort(sorted.begin(), sorted.end());
+
+        // with an even sample count, the upper one of the two middle samples is used. this only ever errs on the slow side
+        Result result;
+        result.name = benchmark.name;
+        result.iterations = state.getIterations();
+        result.medianTime = sorted[sorted.size()/2];
+        result.minTime = sorted.front();
+        result.bytesPerSecond = (result.medianTime > 0.0) ? state.getBytesPerIteration() / result.medianTime : 0.0;
+        result.itemsPerSecond = (result.medianTime > 0.0) ? state.getItemsPerIteration() / result.medianTime : 0.0;
+
+        return result;
+    }
+
+}
@@ -0,0 +1,141 @@
+/*
+ * DataStreamBenchmarks.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: zal
+ */
+
+#include <odBench/Benchmark.h>
+
+#include <istream>
+
+#include <glm/vec3.hpp>
+
+#include <odCore/DataStream.h>
+#include <odCore/Panic.h>
+#include <odCore/ZStream.h>
+
+#include <odBench/SyntheticData.h>
+
+namespace odBench
+{
+
+    static const size_t READER_INPUT_SIZE = (1 << 20);
+    static const size_t INFLATE_OUTPUT_SIZE = (1 << 22);
+
+    static const std::vector<char> &_getReaderInput()
+    {
+        static const std::vector<char> input = []()
+        {
+            Random random(1);
+            std::vector<char> data(READER_INPUT_SIZE);
+            for(auto &c : data)
+            {
+                c = static_cast<char>(random.next());
+            }
+            return data;
+        }();
+
+        return input;
+    }
+
+    template <typename T>
+    static void _benchReadPrimitive(State &state)
+    {
+        auto &input = _getReaderInput();
+        size_t count = input.size() / sizeof(T);
+
+        state.setBytesPerIteration(count * sizeof(T));
+        state.setItemsPerIteration(count);
+        state.measure([&]()
+        {
+            od::MemoryInputBuffer buffer(input.data(), input.size());
+            std::istream in(&buffer);
+            od::DataReader dr(in);
+
+            T value;
+            for(size_t i = 0; i < count; ++i)
+            {
+                dr >> value;
+                doNotOptimize(value);
+            }
+        });
+    }
+
+    static void _benchReadBlocks(State &state)
+    {
+        auto &input = _getReaderInput();
+        std::vector<char> block(4096);
+        size_t count = input.size() / block.size();
+
+        state.setBytesPerIteration(count * block.size());
+        state.setItemsPerIteration(count);
+        state.measure([&]()
+        {
+            od::MemoryInputBuffer buffer(input.data(), input.size());
+            std::istream in(&buffer);
+            od::DataReader dr(in);
+
+            for(size_t i = 0; i < count; ++i)
+            {
+                dr.read(block.data(), block.size());
+                doNotOptimize(block[0]);
+            }
+        });
+    }
+
+    static void _benchInflate(State &state)
+    {
+        // smooth ramps with noise in the low bits. compresses about as well as typical texture data
+        Random random(2);
+        std::vector<char> raw(INFLATE_OUTPUT_SIZE);
+        for(size_t i = 0; i < raw.size(); ++i)
+        {
+            raw[i] = static_cast<char>(((i / 64) & 0xff) ^ (random.next() & 0x07));
+        }
+
+        uLongf compressedSize = compressBound(raw.size());
+        std::vector<char> compressed(compressedSize);
+        int result = compress2(reinterpret_cast<Bytef*>(compressed.data()), &compressedSize, reinterpret_cast<const Bytef*>(raw.data()), raw.size(), Z_DEFAULT_COMPRESSION);
+        if(result != Z_OK)
+        {
+            OD_PANIC() << "Failed to compress inflate benchmark input";
+        }
+        compressed.resize(compressedSize);
+
+        std::vector<char> chunk(1 << 16);
+
+        state.setBytesPerIteration(raw.size());
+        state.measure([&]()
+        {
+            od::MemoryInputBuffer buffer(compressed.data(), compressed.size());
+            std::istream in(&buffer);
+            od::ZStreamBuffer zbuf(in);
+
+            size_t total = 0;
+            std::streamsize n;
+            while((n = zbuf.sgetn(chunk.data(), chunk.size())) > 0)
+            {
+                total += n;
+            }
+
+            if(total != raw.size())
+            {
+                OD_PANIC() << "Inflated " << total << " bytes, expected " << raw.size();
+            }
+        });
+    }
+
+
+    void registerDataStreamBenchmarks(std::vector<Benchmark> &benchmarks)
+    {
+        benchmarks.push_back({ "DataReader/uint8",      &_benchReadPrimitive<uint8_t> });
+        benchmarks.push_back({ "DataReader/uint16",     &_benchReadPrimitive<uint16_t> });
+        benchmarks.push_back({ "DataReader/uint32",     &_benchReadPrimitive<uint32_t> });
+        benchmarks.push_back({ "DataReader/float",      &_benchReadPrimitive<float> });
+        benchmarks.push_back({ "DataReader/vec3",       &_benchReadPrimitive<glm::vec3> });
+        benchmarks.push_back({ "DataReader/read4K",     &_benchReadBlocks });
+        benchmarks.push_back({ "ZStreamBuffer/inflate", &_benchInflate });
+    }
+
+}
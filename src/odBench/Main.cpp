@@ -0,0 +1,206 @@
+/*
+ * Main.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: zal
+ */
+
+#include <unistd.h>
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <odCore/Logger.h>
+#include <odCore/Version.h>
+
+#include <odBench/Benchmark.h>
+#include <odBench/SyntheticData.h>
+
+static void printUsage()
+{
+    std::cout
+        << "Usage: odBench [options] [filter]" << std::endl
+        << "Runs microbenchmarks of the engine core on synthetic data" << std::endl
+        << "Options:" << std::endl
+        << "    -h  Display this message and exit" << std::endl
+        << "    -l  List benchmarks and exit" << std::endl
+        << "    -c  Print results as CSV" << std::endl
+        << "    -t <seconds>  Minimum duration of a single sample (default 0.05)" << std::endl
+        << "    -r <count>  Number of samples per benchmark (default 9)" << std::endl
+        << "    -d <dir>  Directory for temporary files (default is the working directory)" << std::endl
+        << "Only benchmarks whose name contains the filter are run." << std::endl
+        << "Reported times are the median of all samples, so results of different builds are comparable" << std::endl
+        << "as long as they were taken on the same machine with the same options." << std::endl
+        << std::endl;
+}
+
+static std::string formatTime(double seconds)
+{
+    std::ostringstream ss;
+    ss << std::fixed << std::setprecision(1);
+
+    double ns = seconds * 1e9;
+    if(ns < 1e4)
+    {
+        ss << ns << " ns";
+
+    }else if(ns < 1e7)
+    {
+        ss << (ns * 1e-3) << " us";
+
+    }else
+    {
+        ss << (ns * 1e-6) << " ms";
+    }
+
+    return ss.str();
+}
+
+static std::string formatThroughput(const odBench::Result &result)
+{
+    std::ostringstream ss;
+    ss << std::fixed << std::setprecision(1);
+
+    if(result.bytesPerSecond > 0)
+    {
+        ss << (result.bytesPerSecond / (1024*1024)) << " MiB/s";
+    }
+
+    if(result.itemsPerSecond > 0)
+    {
+        if(result.bytesPerSecond > 0) ss << ", ";
+        ss << (result.itemsPerSecond * 1e-6) << " M/s";
+    }
+
+    return ss.str();
+}
+
+int main(int argc, char **argv)
+{
+    od::Logger::getDefaultLogger().setOutputLogLevel(od::LogLevel::Error);
+
+    int c;
+    bool listOnly = false;
+    bool csv = false;
+    double minSampleTime = 0.05;
+    size_t sampleCount = 9;
+    while((c = getopt(argc, argv, "hlct:r:d:")) != -1)
+    {
+        switch(c)
+        {
+        case 'h':
+            printUsage();
+            return 0;
+
+        case 'l':
+            listOnly = true;
+            break;
+
+        case 'c':
+            csv = true;
+            break;
+
+        case 't':
+            {
+                std::istringstream in(optarg);
+                in >> minSampleTime;
+                if(in.fail() || minSampleTime <= 0)
+                {
+                    std::cout << "-t option needs a positive real number as argument" << std::endl;
+                    return 1;
+                }
+            }
+            break;
+
+        case 'r':
+            {
+                std::istringstream in(optarg);
+                in >> sampleCount;
+                if(in.fail() || sampleCount == 0)
+                {
+                    std::cout << "-r option needs a positive integer as argument" << std::endl;
+                    return 1;
+                }
+            }
+            break;
+
+        case 'd':
+            odBench::setScratchDirectory(optarg);
+            break;
+
+        case '?':
+            std::cout << "Unknown option -" << optopt << std::endl;
+            printUsage();
+            return 1;
+        }
+    }
+
+    std::string filter;
+    if(optind < argc)
+    {
+        filter = argv[optind];
+    }
+
+    std::vector<odBench::Benchmark> benchmarks;
+    odBench::registerDataStreamBenchmarks(benchmarks);
+    odBench::registerAssetBenchmarks(benchmarks);
+    odBench::registerStateBenchmarks(benchmarks);
+    odBench::registerAnimBenchmarks(benchmarks);
+
+    if(listOnly)
+    {
+        for(auto &benchmark : benchmarks)
+        {
+            std::cout << benchmark.name << std::endl;
+        }
+        return 0;
+    }
+
+    if(csv)
+    {
+        std::cout << "name,iterations,median_ns,min_ns,bytes_per_second,items_per_second" << std::endl;
+
+    }else
+    {
+        std::cout << "OpenDrakan " << OD_VERSION_TAG << " (" << OD_VERSION_BRANCH << " " << OD_VERSION_COMMIT << ")" << std::endl
+                  << std::left << std::setw(26) << "Benchmark"
+                  << std::right << std::setw(12) << "Iterations"
+                  << std::setw(14) << "Median"
+                  << std::setw(14) << "Min"
+                  << "   Throughput" << std::endl;
+    }
+
+    for(auto &benchmark : benchmarks)
+    {
+        if(!filter.empty() && benchmark.name.find(filter) == std::string::npos)
+        {
+            continue;
+        }
+
+        odBench::Result result = odBench::runBenchmark(benchmark, minSampleTime, sampleCount);
+
+        if(csv)
+        {
+            std::cout << result.name << ","
+                      << result.iterations << ","
+                      << std::fixed << std::setprecision(2)
+                      << (result.medianTime * 1e9) << ","
+                      << (result.minTime * 1e9) << ","
+                      << std::setprecision(0)
+                      << result.bytesPerSecond << ","
+                      << result.itemsPerSecond << std::endl;
+
+        }else
+        {
+            std::cout << std::left << std::setw(26) << result.name
+                      << std::right << std::setw(12) << result.iterations
+                      << std::setw(14) << formatTime(result.medianTime)
+                      << std::setw(14) << formatTime(result.minTime)
+                      << "   " << formatThroughput(result) << std::endl;
+        }
+    }
+
+    return 0;
+}
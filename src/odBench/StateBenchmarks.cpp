@@ -0,0 +1,305 @@
+/*
+ * StateBenchmarks.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: zal
+ */
+
+#include <odBench/Benchmark.h>
+
+#include <istream>
+#include <ostream>
+
+#include <glm/gtc/quaternion.hpp>
+
+#include <odCore/DataStream.h>
+#include <odCore/ObjectStates.h>
+#include <odCore/Panic.h>
+
+#include <odCore/net/DownlinkConnector.h>
+#include <odCore/net/PacketBuilder.h>
+#include <odCore/net/PacketParser.h>
+
+#include <odBench/SyntheticData.h>
+
+namespace odBench
+{
+
+    static const size_t OBJECT_COUNT = 1024;
+
+
+    namespace
+    {
+        /**
+         * @brief Two consecutive snapshots of a level's worth of objects, with a typical share of them changed.
+         */
+        struct SnapshotFixture
+        {
+            SnapshotFixture()
+            : previous(OBJECT_COUNT)
+            , current(OBJECT_COUNT)
+            , deltas(OBJECT_COUNT)
+            {
+                Random random(4);
+
+                auto randomVec = [&](float range)
+                {
+                    return glm::vec3(random.nextFloat(-range, range), random.nextFloat(-range, range), random.nextFloat(-range, range));
+                };
+
+                auto randomRotation = [&]()
+                {
+                    glm::vec3 axis = glm::normalize(randomVec(1.0f) + glm::vec3(0, 0.01, 0));
+                    return glm::angleAxis(random.nextFloat(0.0f, 6.28f), axis);
+                };
+
+                for(size_t i = 0; i < OBJECT_COUNT; ++i)
+                {
+                    od::ObjectStates &prev = previous[i];
+                    prev.position = randomVec(100.0f);
+                    prev.rotation = randomRotation();
+                    prev.scale = glm::vec3(1.0f);
+                    prev.visibility = true;
+                    prev.running = true;
+
+                    // most objects are static, some are moving, very few change discrete states
+                    od::ObjectStates &curr = current[i];
+                    curr.assign(prev);
+                    if(random.nextBool(0.3f)) curr.position = prev.position.get() + randomVec(1.0f);
+                    if(random.nextBool(0.2f)) curr.rotation = randomRotation();
+                    if(random.nextBool(0.01f)) curr.scale = randomVec(2.0f);
+                    if(random.nextBool(0.02f)) curr.visibility = false;
+
+                    deltas[i].deltaEncode(prev, curr);
+                }
+
+                serializedDeltas = buildRecord([&](od::DataWriter &dw)
+                {
+                    for(auto &delta : deltas)
+                    {
+                        delta.serialize(dw, odState::StateSerializationPurpose::NETWORK);
+                    }
+                });
+            }
+
+            static SnapshotFixture &get()
+            {
+                static SnapshotFixture fixture;
+                return fixture;
+            }
+
+            std::vector<od::ObjectStates> previous;
+            std::vector<od::ObjectStates> current;
+            std::vector<od::ObjectStates> deltas;
+            std::vector<char> serializedDeltas;
+        };
+
+
+        class CountingDownlinkConnector final : public odNet::DownlinkConnector
+        {
+        public:
+
+            CountingDownlinkConnector()
+            : objectStatesCount(0)
+            , snapshotCount(0)
+            {
+            }
+
+            virtual void globalDatabaseTableEntry(odDb::GlobalDatabaseIndex dbIndex, const std::string &path) override {}
+            virtual void loadLevel(const std::string &path, size_t loadedDatabaseCount) override {}
+
+            virtual void objectStatesChanged(odState::TickNumber tick, od::LevelObjectId id, const od::ObjectStates &states) override
+            {
+                ++objectStatesCount;
+                doNotOptimize(states);
+            }
+
+            virtual void objectExtraStatesChanged(odState::TickNumber tick, od::LevelObjectId id, const char *data, size_t size) override {}
+
+            virtual void confirmSnapshot(odState::TickNumber tick, double realtime, size_t discreteChangeCount, odState::TickNumber referenceTick) override
+            {
+                ++snapshotCount;
+            }
+
+            virtual void globalMessage(odNet::MessageChannelCode code, const char *data, size_t size) override {}
+            virtual void event(const odState::EventVariant &e, double realtime) override {}
+
+            size_t objectStatesCount;
+            size_t snapshotCount;
+        };
+    }
+
+    static void _buildSnapshotPackets(odNet::PacketBuilder &builder, const std::vector<od::ObjectStates> &deltas)
+    {
+        const odState::TickNumber tick = 1000;
+
+        for(size_t i = 0; i < deltas.size(); ++i)
+        {
+            builder.objectStatesChanged(tick, static_cast<od::LevelObjectId>(i), deltas[i]);
+        }
+
+        builder.confirmSnapshot(tick, 16.0, 0, tick - 1);
+    }
+
+    static void _parseAll(odNet::PacketParser &parser, const std::vector<char> &packets)
+    {
+        size_t offset = 0;
+        while(offset < packets.size())
+        {
+            size_t consumed = parser.parse(packets.data() + offset, packets.size() - offset);
+            if(consumed == 0)
+            {
+                OD_PANIC() << "Packet parser stalled at offset " << offset;
+            }
+
+            offset += consumed;
+        }
+    }
+
+    static void _benchDeltaEncode(State &state)
+    {
+        auto &fixture = SnapshotFixture::get();
+        std::vector<od::ObjectStates> results(OBJECT_COUNT);
+
+        state.setItemsPerIteration(OBJECT_COUNT);
+        state.measure([&]()
+        {
+            for(size_t i = 0; i < OBJECT_COUNT; ++i)
+            {
+                results[i].deltaEncode(fixture.previous[i], fixture.current[i]);
+            }
+            doNotOptimize(results);
+        });
+    }
+
+    static void _benchSerialize(State &state)
+    {
+        auto &fixture = SnapshotFixture::get();
+        std::vector<char> output;
+        output.reserve(fixture.serializedDeltas.size());
+
+        state.setBytesPerIteration(fixture.serializedDeltas.size());
+        state.setItemsPerIteration(OBJECT_COUNT);
+        state.measure([&]()
+        {
+            output.clear();
+
+            od::VectorOutputBuffer buffer(output);
+            std::ostream out(&buffer);
+            od::DataWriter dw(out);
+            for(auto &delta : fixture.deltas)
+            {
+                delta.serialize(dw, odState::StateSerializationPurpose::NETWORK);
+            }
+        });
+    }
+
+    static void _benchDeserialize(State &state)
+    {
+        auto &fixture = SnapshotFixture::get();
+        auto &input = fixture.serializedDeltas;
+        od::ObjectStates result;
+
+        state.setBytesPerIteration(input.size());
+        state.setItemsPerIteration(OBJECT_COUNT);
+        state.measure([&]()
+        {
+            od::MemoryInputBuffer buffer(input.data(), input.size());
+            std::istream in(&buffer);
+            od::DataReader dr(in);
+            for(size_t i = 0; i < OBJECT_COUNT; ++i)
+            {
+                result.clear();
+                result.deserialize(dr, odState::StateSerializationPurpose::NETWORK);
+                doNotOptimize(result);
+            }
+        });
+    }
+
+    static void _benchBuildPackets(State &state)
+    {
+        auto &fixture = SnapshotFixture::get();
+
+        std::vector<char> packets;
+        odNet::PacketBuilder builder([&packets](const char *data, size_t size, odNet::PacketBuilder::LinkType)
+        {
+            packets.insert(packets.end(), data, data + size);
+        });
+
+        _buildSnapshotPackets(builder, fixture.deltas);
+        state.setBytesPerIteration(packets.size());
+        state.setItemsPerIteration(OBJECT_COUNT);
+
+        state.measure([&]()
+        {
+            packets.clear();
+            _buildSnapshotPackets(builder, fixture.deltas);
+        });
+    }
+
+    static void _benchParsePackets(State &state)
+    {
+        auto &fixture = SnapshotFixture::get();
+
+        std::vector<char> packets;
+        odNet::PacketBuilder builder([&packets](const char *data, size_t size, odNet::PacketBuilder::LinkType)
+        {
+            packets.insert(packets.end(), data, data + size);
+        });
+        _buildSnapshotPackets(builder, fixture.deltas);
+
+        auto sink = std::make_shared<CountingDownlinkConnector>();
+        odNet::PacketParser parser(sink, nullptr);
+
+        state.setBytesPerIteration(packets.size());
+        state.setItemsPerIteration(OBJECT_COUNT);
+        state.measure([&]()
+        {
+            _parseAll(parser, packets);
+        });
+
+        if(sink->snapshotCount == 0 || sink->objectStatesCount != sink->snapshotCount * OBJECT_COUNT)
+        {
+            OD_PANIC() << "Parser did not deliver all packets";
+        }
+    }
+
+    static void _benchPacketRoundTrip(State &state)
+    {
+        auto &fixture = SnapshotFixture::get();
+
+        // hand every packet to the parser as soon as it is built, like a local tunnel would
+        auto sink = std::make_shared<CountingDownlinkConnector>();
+        odNet::PacketParser parser(sink, nullptr);
+        size_t bytesPerSnapshot = 0;
+        odNet::PacketBuilder builder([&](const char *data, size_t size, odNet::PacketBuilder::LinkType)
+        {
+            if(parser.parse(data, size) != size)
+            {
+                OD_PANIC() << "Parser did not consume whole packet";
+            }
+            bytesPerSnapshot += size;
+        });
+
+        _buildSnapshotPackets(builder, fixture.deltas);
+        state.setBytesPerIteration(bytesPerSnapshot);
+        state.setItemsPerIteration(OBJECT_COUNT);
+
+        state.measure([&]()
+        {
+            _buildSnapshotPackets(builder, fixture.deltas);
+        });
+    }
+
+
+    void registerStateBenchmarks(std::vector<Benchmark> &benchmarks)
+    {
+        benchmarks.push_back({ "StateBundle/deltaEncode", &_benchDeltaEncode });
+        benchmarks.push_back({ "StateBundle/serialize",   &_benchSerialize });
+        benchmarks.push_back({ "StateBundle/deserialize", &_benchDeserialize });
+        benchmarks.push_back({ "Packet/build",            &_benchBuildPackets });
+        benchmarks.push_back({ "Packet/parse",            &_benchParsePackets });
+        benchmarks.push_back({ "Packet/roundTrip",        &_benchPacketRoundTrip });
+    }
+
+}
@@ -0,0 +1,139 @@
+/*
+ * SyntheticData.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: zal
+ */
+
+#include <odBench/SyntheticData.h>
+
+#include <cstdio>
+#include <fstream>
+#include <limits>
+
+#include <odCore/Panic.h>
+
+namespace odBench
+{
+
+    static std::string sScratchDirectory = ".";
+
+
+    Random::Random(uint32_t seed)
+    : mEngine(seed)
+    {
+    }
+
+    float Random::nextFloat(float min, float max)
+    {
+        double unit = static_cast<double>(next()) / (static_cast<double>(std::numeric_limits<uint32_t>::max()) + 1.0);
+        return static_cast<float>(min + unit*(max - min));
+    }
+
+    bool Random::nextBool(float probability)
+    {
+        return nextFloat(0.0f, 1.0f) < probability;
+    }
+
+
+    void writeString(od::DataWriter &writer, const std::string &s)
+    {
+        writer << static_cast<uint16_t>(s.size());
+        writer.write(s.data(), s.size());
+    }
+
+    void setScratchDirectory(const std::string &dir)
+    {
+        sScratchDirectory = dir;
+    }
+
+
+    SyntheticSrscFile::SyntheticSrscFile(const std::string &name)
+    : mPath(sScratchDirectory + "/odBench_" + name + ".srsc")
+    {
+    }
+
+    SyntheticSrscFile::~SyntheticSrscFile()
+    {
+        if(mFile != nullptr)
+        {
+            mFile.reset();
+            std::remove(mPath.c_str());
+        }
+    }
+
+    void SyntheticSrscFile::addRecord(od::SrscRecordType type, od::RecordId id, std::vector<char> data)
+    {
+        if(mFile != nullptr)
+        {
+            OD_PANIC() << "Can't add records to synthetic SRSC file after it has been opened";
+        }
+
+        Record record;
+        record.type = static_cast<od::RecordType>(type);
+        record.id = id;
+        record.data = std::move(data);
+        mRecords.push_back(std::move(record));
+    }
+
+    od::SrscFile &SyntheticSrscFile::open()
+    {
+        if(mFile != nullptr)
+        {
+            return *mFile;
+        }
+
+        if(mRecords.size() > std::numeric_limits<uint16_t>::max())
+        {
+            OD_PANIC() << "Too many records for a single SRSC file";
+        }
+
+        std::ofstream out(mPath, std::ios::out | std::ios::binary | std::ios::trunc);
+        if(out.fail())
+        {
+            OD_PANIC() << "Could not create scratch file '" << mPath << "'";
+        }
+
+        // header: magic, version, directory offset, record count
+        const uint32_t headerSize = 12;
+        uint32_t directoryOffset = headerSize;
+        for(auto &record : mRecords)
+        {
+            directoryOffset += record.data.size();
+        }
+
+        od::DataWriter dw(out);
+        dw << static_cast<uint32_t>(0x43535253)
+           << static_cast<uint16_t>(0x101)
+           << directoryOffset
+           << static_cast<uint16_t>(mRecords.size());
+
+        for(auto &record : mRecords)
+        {
+            dw.write(record.data.data(), record.data.size());
+        }
+
+        uint32_t dataOffset = headerSize;
+        for(auto &record : mRecords)
+        {
+            dw << record.type
+               << record.id
+               << static_cast<od::RecordId>(0) // group
+               << dataOffset
+               << static_cast<uint32_t>(record.data.size());
+
+            dataOffset += record.data.size();
+        }
+
+        out.close();
+        if(out.fail())
+        {
+            OD_PANIC() << "Failed to write scratch file '" << mPath << "'";
+        }
+
+        mFile = std::make_unique<od::SrscFile>(od::FilePath(mPath));
+
+        return *mFile;
+    }
+
+}
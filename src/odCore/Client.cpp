@@ -9,13 +9,17 @@
 
 #include <chrono>
 #include <cmath>
+#include <thread>
 
 #include <odCore/Level.h>
 #include <odCore/LevelObject.h>
+#include <odCore/Profiler.h>
+#include <odCore/ThreadUtils.h>
 
 #include <odCore/db/Database.h>
 
 #include <odCore/render/Renderer.h>
+#include <odCore/render/Camera.h>
 
 #include <odCore/input/InputManager.h>
 #include <odCore/input/RawActionListener.h>
@@ -188,6 +192,15 @@ namespace od
         Engine engine(*this);
 
         mLevel = std::make_unique<Level>(engine);
+
+        // TODO: this is where a loading screen would hook in. for now, we just log finished stages
+        mLevel->setLoadingProgressCallback([](Level::LoadingStage stage, size_t done, size_t total)
+        {
+            if(done == total)
+            {
+                Logger::verbose() << "Finished loading stage " << static_cast<int>(stage) << " (" << total << " items)";
+            }
+        });
         mLevel->loadLevel(lvlPath.adjustCase(), mDbManager);
 
         // TODO: all the subsytems whose existence depends on the level could be very elegantly moved to the level class itself
@@ -196,21 +209,50 @@ namespace od
 
         mEventQueue = std::make_unique<odState::EventQueue>(mDbManager, *mLevel);
 
-        mLevel->spawnAllObjects();
+        // everything besides the objects that are always spawned is streamed in once we know where the camera is
+        mLevel->calculateInitialLayerAssociations();
+        mLevel->initialSpawn();
     }
 
     void Client::run()
     {
         Logger::info() << "OpenDrakan client starting...";
 
-        LocalDownlinkConnector localDownlinkConnector(*this);
+        OD_PROFILE_THREAD_NAME("client render");
 
         mRenderer.setup();
 
+        // the render loop stays on this thread, since most windowing systems require that. simulation gets a thread of its own
+        //  and hands its results over to the renderer via publishSceneState()
+        std::thread simulationThread(&Client::_runSimulation, this);
+        od::ThreadUtils::setThreadName(simulationThread, "client sim");
+
         Logger::info() << "Client set up. Starting render loop";
 
-        float lerpTime = 0.1;
-        float timeTolerance = 0.05;
+        auto lastFrameStartTime = std::chrono::high_resolution_clock::now();
+        while(!mIsDone.load(std::memory_order_relaxed))
+        {
+            auto frameStart = std::chrono::high_resolution_clock::now();
+            double relTime = 1e-9 * std::chrono::duration_cast<std::chrono::nanoseconds>(frameStart - lastFrameStartTime).count();
+            lastFrameStartTime = frameStart;
+
+            OD_PROFILE_ZONE("Render frame");
+            mRenderer.frame(relTime);
+        }
+
+        simulationThread.join();
+
+        Logger::info() << "Shutting down client gracefully";
+    }
+
+    void Client::_runSimulation()
+    {
+        OD_PROFILE_THREAD_NAME("client sim");
+
+        LocalDownlinkConnector localDownlinkConnector(*this);
+
+        double targetUpdateIntervalNs = (1e9/60.0);
+        auto targetUpdateInterval = std::chrono::nanoseconds((int64_t)targetUpdateIntervalNs);
 
         double clientTime = 0;
         auto lastUpdateStartTime = std::chrono::high_resolution_clock::now();
@@ -220,45 +262,75 @@ namespace od
             double relTime = 1e-9 * std::chrono::duration_cast<std::chrono::nanoseconds>(loopStart - lastUpdateStartTime).count();
             lastUpdateStartTime = loopStart;
 
-            clientTime += relTime;
-            if(mEventQueue != nullptr)
+            _tickSimulation(localDownlinkConnector, clientTime, relTime);
+
+            auto loopTime = std::chrono::high_resolution_clock::now() - loopStart;
+            if(loopTime < targetUpdateInterval)
             {
-                mEventQueue->setCurrentTime(clientTime);
+                std::this_thread::sleep_for(targetUpdateInterval - loopTime);
             }
+        }
+    }
 
+    void Client::_tickSimulation(LocalDownlinkConnector &localDownlinkConnector, double &clientTime, double relTime)
+    {
+        OD_PROFILE_ZONE("Client tick");
+
+        const float lerpTime = 0.1;
+        const float timeTolerance = 0.05;
+
+        clientTime += relTime;
+        if(mEventQueue != nullptr)
+        {
+            mEventQueue->setCurrentTime(clientTime);
+        }
+
+        {
+            OD_PROFILE_ZONE("Downlink");
             mDownlinkConnector->flushQueue(localDownlinkConnector);
+        }
 
-            if(mLevel != nullptr)
+        if(mLevel != nullptr)
+        {
+            odRender::Camera *camera = mRenderer.getCamera();
+            if(camera != nullptr)
             {
-                mLevel->update(relTime);
+                mLevel->updateViewerPosition(camera->getEyePoint());
             }
 
+            mLevel->update(relTime);
+        }
+
+        {
+            OD_PROFILE_ZONE("Physics update");
             mPhysicsSystem->update(relTime);
-            mInputManager->update(relTime);
+        }
 
-            if(mStateManager != nullptr)
-            {
-                // check if we are still in sync before advancing the world
-                double latestServerTime = mStateManager->getLatestRealtime();
-                if(latestServerTime > clientTime + lerpTime + timeTolerance)
-                {
-                    Logger::info() << "Client resyncing (servertime=" << latestServerTime << " clienttime=" << clientTime << ")";
-                    clientTime = latestServerTime - lerpTime;
-                }
-
-                mStateManager->apply(clientTime);
-            }
+        mInputManager->update(relTime);
 
-            if(mEventQueue != nullptr)
+        if(mStateManager != nullptr)
+        {
+            // check if we are still in sync before advancing the world
+            double latestServerTime = mStateManager->getLatestRealtime();
+            if(latestServerTime > clientTime + lerpTime + timeTolerance)
             {
-                mEventQueue->dispatch(clientTime);
-                mEventQueue->cleanup();
+                Logger::info() << "Client resyncing (servertime=" << latestServerTime << " clienttime=" << clientTime << ")";
+                clientTime = latestServerTime - lerpTime;
             }
 
-            mRenderer.frame(relTime);
+            mStateManager->apply(clientTime);
         }
 
-        Logger::info() << "Shutting down client gracefully";
+        if(mEventQueue != nullptr)
+        {
+            mEventQueue->dispatch(clientTime);
+            mEventQueue->cleanup();
+        }
+
+        // everything this tick changed in the scene becomes visible to the renderer at once, so it never draws a half-updated state
+        mRenderer.publishSceneState();
+
+        OD_PROFILE_TICK();
     }
 
     odDb::GlobalDatabaseIndex Client::translateGlobalDatabaseIndex(odDb::GlobalDatabaseIndex serverSideIndex)
@@ -7,96 +7,259 @@
 
 #include <odCore/ConfigFile.h>
 
-#include <regex>
+#include <algorithm>
 
 #include <odCore/Logger.h>
+#include <odCore/StringUtils.h>
 
 namespace od
 {
 
-    void ConfigFile::parse(std::istream &in)
+    static bool _isSpace(char c)
     {
-        std::regex sectionRegex("\\s*\\[\\s*(.+)\\s*\\]\\s*");
-        std::regex keyValueRegex("\\s*(\\w+)\\s*[\\:\\=]\\s*(.*)");
-        std::regex keyOnlyRegex("\\s*(.+)");
-        std::regex commentRegex("\\s*(#.*)?");
+        return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+    }
 
-        std::string line;
-        Section *currentSection = &mSections[""];
-        while(std::getline(in, line))
+    static bool _isWordChar(char c)
+    {
+        return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
+    }
+
+    static size_t _skipSpace(const std::string &str, size_t pos)
+    {
+        while(pos < str.size() && _isSpace(str[pos]))
+        {
+            ++pos;
+        }
+
+        return pos;
+    }
+
+    // returns [begin, end) without trailing whitespace
+    static std::string _trimmedSubstring(const std::string &str, size_t begin, size_t end)
+    {
+        while(end > begin && _isSpace(str[end - 1]))
+        {
+            --end;
+        }
+
+        return str.substr(begin, end - begin);
+    }
+
+
+    const std::string &ConfigFile::Entry::getValue() const
+    {
+        // only called on entries that exist, so at least one layer is set
+        for(size_t layer = LAYER_COUNT; layer > 0; --layer)
         {
-            // getline leaves the CR byte (0x0D) in the string if given windows line endings. remove if it is there
-            if(line.size() != 0 && line[line.size() - 1] == 0x0D)
+            if(layerMask & (1 << (layer - 1)))
             {
-                line.erase(line.size() - 1);
+                return layerValues[layer - 1];
             }
+        }
 
-            std::smatch results;
+        OD_UNREACHABLE();
+    }
 
-            if(std::regex_match(line, results, sectionRegex))
-            {
-                currentSection = &mSections[results[1].str()];
 
-                Logger::error() << "Got section " << results[1].str();
+    void ConfigFile::parse(std::istream &in, Layer layer)
+    {
+        size_t layerIndex = static_cast<size_t>(layer);
+
+        std::string line;
+        size_t lineNumber = 0;
+        size_t valueCount = 0;
+        std::string sectionName;
+        Section *currentSection = &mSections[sectionName];
+        while(std::getline(in, line))
+        {
+            ++lineNumber;
 
-            }else if(std::regex_match(line, results, keyValueRegex))
+            // columns are 1-based, positions are 0-based
+            auto malformed = [&](size_t pos, const char *reason)
             {
-                currentSection->keyValueMap.insert(std::make_pair(results[1].str(), results[2].str()));
+                OD_PANIC() << "Malformed line in config file at line " << lineNumber << ", column " << (pos + 1) << ": " << reason;
+            };
 
-                Logger::error() << "Got value " << results[1].str() << "=" << results[2].str();
+            size_t pos = _skipSpace(line, 0);
+            if(pos == line.size() || line[pos] == '#')
+            {
+                continue;
+            }
 
-            }else if(std::regex_match(line, results, keyOnlyRegex))
+            if(line[pos] == '[')
             {
-                currentSection->rawValueList.push_back(results[1].str());
+                size_t close = line.find(']', pos + 1);
+                if(close == std::string::npos)
+                {
+                    malformed(line.size(), "Expected ']' to close section name");
+                }
 
-                Logger::error() << "Got key w/o value " << results[1].str() ;
+                size_t nameBegin = _skipSpace(line, pos + 1);
+                sectionName = _trimmedSubstring(line, nameBegin, close);
+                if(sectionName.empty())
+                {
+                    malformed(nameBegin, "Empty section name");
+                }
 
-            }else if(std::regex_match(line, results, commentRegex))
-            {
-                Logger::error() << "Got comment";
+                size_t rest = _skipSpace(line, close + 1);
+                if(rest != line.size())
+                {
+                    malformed(rest, "Unexpected characters after section name");
+                }
+
+                currentSection = &mSections[sectionName];
                 continue;
+            }
+
+            // a key is a word followed by = or :. anything else is a non-associative argument
+            size_t keyEnd = pos;
+            while(keyEnd < line.size() && _isWordChar(line[keyEnd]))
+            {
+                ++keyEnd;
+            }
+
+            size_t separator = _skipSpace(line, keyEnd);
+            if(keyEnd > pos && separator < line.size() && (line[separator] == '=' || line[separator] == ':'))
+            {
+                size_t valueBegin = _skipSpace(line, separator + 1);
+                Entry &entry = currentSection->entries[line.substr(pos, keyEnd - pos)];
+                entry.layerValues[layerIndex] = _trimmedSubstring(line, valueBegin, line.size());
+                entry.layerMask |= (1 << layerIndex);
+                entry.parsed.reset();
 
             }else
             {
-                OD_PANIC() << "Malformed line in config file: " << line;
+                currentSection->rawValueLists[layerIndex].push_back(_trimmedSubstring(line, pos, line.size()));
             }
+
+            ++valueCount;
         }
+
+        Logger::debug() << "Parsed " << valueCount << " values from " << lineNumber << " lines of config";
+    }
+
+    void ConfigFile::applyOverride(const std::string &assignment, Layer layer)
+    {
+        size_t equals = assignment.find('=');
+        if(equals == std::string::npos)
+        {
+            OD_PANIC() << "Config override '" << assignment << "' is missing '=' (expected section.key=value)";
+        }
+
+        size_t dot = assignment.rfind('.', equals);
+        size_t keyBegin = (dot == std::string::npos) ? 0 : dot + 1;
+        std::string section = (dot == std::string::npos) ? std::string() : assignment.substr(0, dot);
+        std::string key = assignment.substr(keyBegin, equals - keyBegin);
+        if(key.empty() || !std::all_of(key.begin(), key.end(), _isWordChar))
+        {
+            OD_PANIC() << "Invalid key in config override '" << assignment << "' at column " << (keyBegin + 1);
+        }
+
+        set(layer, section, key, assignment.substr(equals + 1));
     }
 
-    template <>
-    std::string ConfigFile::get<std::string>(const std::string &section, const std::string &key)
+    void ConfigFile::set(Layer layer, const std::string &section, const std::string &key, const std::string &value)
     {
+        size_t layerIndex = static_cast<size_t>(layer);
+
+        Entry &entry = mSections[section].entries[key];
+        entry.layerValues[layerIndex] = value;
+        entry.layerMask |= (1 << layerIndex);
+        entry.parsed.reset();
+    }
+
+    void ConfigFile::clear(Layer layer)
+    {
+        size_t layerIndex = static_cast<size_t>(layer);
+
+        for(auto &section : mSections)
+        {
+            section.second.rawValueLists[layerIndex].clear();
+
+            auto &entries = section.second.entries;
+            for(auto it = entries.begin(); it != entries.end(); )
+            {
+                Entry &entry = it->second;
+                if(entry.layerMask & (1 << layerIndex))
+                {
+                    entry.layerMask &= ~(1 << layerIndex);
+                    entry.layerValues[layerIndex].clear();
+                    entry.parsed.reset();
+                }
+
+                if(entry.layerMask == 0)
+                {
+                    it = entries.erase(it);
+
+                }else
+                {
+                    ++it;
+                }
+            }
+        }
+    }
+
+    const std::vector<std::string> &ConfigFile::getRawValuesInSection(const std::string &section)
+    {
+        static const std::vector<std::string> empty;
+
         auto sectionIt = mSections.find(section);
         if(sectionIt == mSections.end())
         {
-            OD_PANIC() << "Section not found in config file: " << section;
+            return empty;
         }
 
-        auto keyIt = sectionIt->second.keyValueMap.find(key);
-        if(keyIt == sectionIt->second.keyValueMap.end())
+        auto &lists = sectionIt->second.rawValueLists;
+        for(size_t layer = LAYER_COUNT; layer > 0; --layer)
         {
-            OD_PANIC() << "Key not found in config file: " << key;
+            if(!lists[layer - 1].empty())
+            {
+                return lists[layer - 1];
+            }
         }
 
-        return keyIt->second;
+        return empty;
     }
 
-    template <>
-    std::string ConfigFile::get<std::string>(const std::string &section, const std::string &key, const std::string &defaultValue)
+    ConfigFile::Entry *ConfigFile::_findEntry(const std::string &section, const std::string &key)
     {
         auto sectionIt = mSections.find(section);
         if(sectionIt == mSections.end())
         {
-            return defaultValue;
+            return nullptr;
         }
 
-        auto keyIt = sectionIt->second.keyValueMap.find(key);
-        if(keyIt == sectionIt->second.keyValueMap.end())
+        auto keyIt = sectionIt->second.entries.find(key);
+        if(keyIt == sectionIt->second.entries.end())
+        {
+            return nullptr;
+        }
+
+        return &keyIt->second;
+    }
+
+    bool ConfigFile::_parseValue(const std::string &str, std::string &value)
+    {
+        value = str;
+        return true;
+    }
+
+    bool ConfigFile::_parseValue(const std::string &str, bool &value)
+    {
+        std::string lower = StringUtils::toLower(str);
+        if(lower == "true" || lower == "yes" || lower == "on" || lower == "1")
+        {
+            value = true;
+            return true;
+
+        }else if(lower == "false" || lower == "no" || lower == "off" || lower == "0")
         {
-            return defaultValue;
+            value = false;
+            return true;
         }
 
-        return keyIt->second;
+        return false;
     }
 
 }
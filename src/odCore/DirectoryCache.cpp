@@ -0,0 +1,138 @@
+/*
+ * DirectoryCache.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: zal
+ */
+
+#include <odCore/DirectoryCache.h>
+
+#include <mutex>
+#include <unordered_map>
+
+#include <odCore/StringUtils.h>
+
+#if !defined (__WIN32__)
+extern "C"
+{
+#   include <dirent.h>
+#   include <sys/stat.h>
+}
+#endif
+
+namespace od
+{
+
+#if !defined (__WIN32__)
+
+    namespace
+    {
+        struct CachedDirectory
+        {
+            time_t mtime;
+            long mtimeNs;
+            off_t size;
+            std::unordered_map<std::string, std::string> entries; // lower-cased name -> real name
+        };
+
+        std::mutex sCacheMutex;
+        std::unordered_map<std::string, CachedDirectory> sCache;
+    }
+
+    static long _getMtimeNs(const struct stat &s)
+    {
+        // a directory can easily change twice within a second, so we need the sub-second part, too
+#if defined (__APPLE__)
+        return s.st_mtimespec.tv_nsec;
+#else
+        return s.st_mtim.tv_nsec;
+#endif
+    }
+
+    static bool _listDirectory(const std::string &dirPath, CachedDirectory &listing)
+    {
+        DIR *dir = opendir(dirPath.c_str());
+        if(dir == NULL)
+        {
+            return false;
+        }
+
+        listing.entries.clear();
+
+        dirent *entry = readdir(dir);
+        while(entry != NULL)
+        {
+            std::string realName(entry->d_name);
+
+            // emplace won't overwrite, so the first match reported by readdir wins just like the old linear search
+            listing.entries.emplace(StringUtils::toLower(realName), realName);
+
+            entry = readdir(dir);
+        }
+
+        closedir(dir);
+
+        return true;
+    }
+
+    bool DirectoryCache::findIgnoringCase(const std::string &dirPath, const std::string &name, std::string &realName)
+    {
+        // a stat is a lot cheaper than listing the directory again, especially on network-backed storage
+        struct stat dirStat;
+        if(stat(dirPath.c_str(), &dirStat) != 0 || !S_ISDIR(dirStat.st_mode))
+        {
+            return false;
+        }
+
+        std::lock_guard<std::mutex> lock(sCacheMutex);
+
+        auto it = sCache.find(dirPath);
+        if(it == sCache.end()
+                || it->second.mtime != dirStat.st_mtime
+                || it->second.mtimeNs != _getMtimeNs(dirStat)
+                || it->second.size != dirStat.st_size)
+        {
+            CachedDirectory listing;
+            listing.mtime = dirStat.st_mtime;
+            listing.mtimeNs = _getMtimeNs(dirStat);
+            listing.size = dirStat.st_size;
+            if(!_listDirectory(dirPath, listing))
+            {
+                sCache.erase(dirPath);
+                return false;
+            }
+
+            it = sCache.insert_or_assign(dirPath, std::move(listing)).first;
+        }
+
+        auto entryIt = it->second.entries.find(StringUtils::toLower(name));
+        if(entryIt == it->second.entries.end())
+        {
+            return false;
+        }
+
+        realName = entryIt->second;
+
+        return true;
+    }
+
+    void DirectoryCache::clear()
+    {
+        std::lock_guard<std::mutex> lock(sCacheMutex);
+        sCache.clear();
+    }
+
+#else
+
+    bool DirectoryCache::findIgnoringCase(const std::string &dirPath, const std::string &name, std::string &realName)
+    {
+        return false;
+    }
+
+    void DirectoryCache::clear()
+    {
+    }
+
+#endif
+
+}
@@ -4,6 +4,7 @@
 #include <odCore/Client.h>
 #include <odCore/Server.h>
 #include <odCore/Panic.h>
+#include <odCore/Logger.h>
 
 namespace od
 {
@@ -130,4 +131,24 @@ namespace od
         OD_UNREACHABLE();
     }
 
+    FilePath findEngineRoot(const FilePath &dir, const std::string &rrcFileName)
+    {
+        // ascend in the passed directory until we find a Dragon.rrc
+        FilePath path = FilePath(rrcFileName, dir).adjustCase();
+        while(!path.exists() && path.depth() > 1)
+        {
+            path = FilePath(rrcFileName, path.dir().dir()).adjustCase();
+        }
+
+        if(!path.exists())
+        {
+            OD_PANIC() << "Could not find engine root in passed level path. "
+                    << "Make sure your level is located in the same directory or a subdirectory of " << rrcFileName;
+        }
+
+        FilePath root = path.dir();
+        Logger::verbose() << "Found engine root here: " << root;
+        return root;
+    }
+
 }
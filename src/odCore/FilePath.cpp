@@ -12,6 +12,7 @@
 #include <fstream>
 
 #include <odCore/StringUtils.h>
+#include <odCore/DirectoryCache.h>
 #include <odCore/Panic.h>
 
 #if defined (__WIN32__)
@@ -20,10 +21,6 @@
 #else
 #	define OD_FILEPATH_SEPERATOR	    '/'
 #	define OD_FILEPATH_HOST_STYLE		PathRootStyle::POSIX
-extern "C"
-{
-#	include <dirent.h>
-}
 #endif
 
 namespace od
@@ -117,6 +114,7 @@ namespace od
 #else
 
 		FilePath fp(*this);
+		fp.mAlreadyBuiltPath = false; // we are about to change components, so the copied path string might become stale
 
 		std::string adjustedPath((mRootStyle == PathRootStyle::RELATIVE) ? "./" : mRoot);
 
@@ -131,30 +129,12 @@ namespace od
 				adjustedPath += OD_FILEPATH_SEPERATOR + fp.mPathComponents[i-1];
 			}
 
-			DIR *dir = opendir(adjustedPath.c_str());
-			if(dir == NULL)
+			// could not access path or no match found? keep this component as-is
+			std::string realName;
+			if(DirectoryCache::findIgnoringCase(adjustedPath, fp.mPathComponents[i], realName))
 			{
-				// could not access path. keep this component as-is
-				continue;
+			    fp.mPathComponents[i] = realName;
 			}
-
-			std::string &name = fp.mPathComponents[i];
-
-			dirent *entry = readdir(dir);
-			while(entry != NULL)
-			{
-				std::string realName(entry->d_name);
-
-				if(StringUtils::compareIgnoringCase(realName, name))
-				{
-					fp.mPathComponents[i] = realName;
-					break;
-				}
-
-				entry = readdir(dir);
-			}
-
-			closedir(dir);
 		}
 
 		return fp;
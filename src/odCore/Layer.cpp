@@ -18,9 +18,11 @@
 #include <odCore/render/Geometry.h>
 #include <odCore/render/Array.h>
 #include <odCore/render/Model.h>
+#include <odCore/render/PreparedLayerModel.h>
 
 #include <odCore/physics/PhysicsSystem.h>
 #include <odCore/physics/Handles.h>
+#include <odCore/physics/LayerShape.h>
 
 namespace od
 {
@@ -184,12 +186,27 @@ namespace od
         }
     }
 
+    void Layer::prepareSpawn(odPhysics::PhysicsSystem &physicsSystem, odRender::Renderer *renderer)
+    {
+        if(renderer != nullptr)
+        {
+            mPreparedRenderModel = renderer->prepareModelFromLayer(this);
+        }
+
+        mPreparedPhysicsShape = physicsSystem.createLayerShape(*this);
+    }
+
     void Layer::spawn(odPhysics::PhysicsSystem &physicsSystem, odRender::Renderer *renderer)
     {
         if(renderer != nullptr)
         {
+            if(mPreparedRenderModel == nullptr)
+            {
+                mPreparedRenderModel = renderer->prepareModelFromLayer(this);
+            }
+
             mRenderHandle = renderer->createHandle(odRender::RenderSpace::LEVEL);
-            mRenderModel = renderer->createModelFromLayer(this);
+            mRenderModel = renderer->createModelFromPreparedLayer(mPreparedRenderModel);
 
             mRenderHandle->setModel(mRenderModel);
             mRenderHandle->setPosition(getOrigin());
@@ -198,9 +215,12 @@ namespace od
             mRenderHandle->setGlobalLight(glm::vec3(1,0,0), glm::vec3(0,0,0), glm::vec3(0,0,0));
         }
 
-        mPhysicsHandle = physicsSystem.createLayerHandle(*this);
+        mPhysicsHandle = physicsSystem.createLayerHandle(*this, mPreparedPhysicsShape);
         mPhysicsHandle->setLightCallback(this);
 
+        mPreparedRenderModel = nullptr;
+        mPreparedPhysicsShape = nullptr;
+
         _bakeLocalLayerLight();
 
         mIsSpawned = true;
@@ -9,23 +9,83 @@
 #include <odCore/Level.h>
 
 #include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <future>
+#include <limits>
+#include <sstream>
+#include <glm/glm.hpp>
 
 #include <odCore/Client.h>
 #include <odCore/SrscRecordTypes.h>
 #include <odCore/SrscFile.h>
+#include <odCore/DataStream.h>
 #include <odCore/Logger.h>
 #include <odCore/ZStream.h>
 #include <odCore/Panic.h>
+#include <odCore/Profiler.h>
+#include <odCore/ThreadUtils.h>
+#include <odCore/MappedFile.h>
 #include <odCore/Layer.h>
 #include <odCore/LevelObject.h>
 #include <odCore/BoundingBox.h>
 
 #include <odCore/physics/PhysicsSystem.h>
 #include <odCore/physics/Handles.h>
+#include <odCore/physics/LayerShape.h>
+
+#if defined (__WIN32__)
+#   include <process.h>
+#else
+extern "C"
+{
+#   include <unistd.h>
+}
+#endif
 
 namespace od
 {
 
+    static constexpr uint32_t OBJECT_CACHE_MAGIC = 0x434c444f; // 'ODLC' in LE
+    static constexpr uint16_t OBJECT_CACHE_VERSION = 1;
+    static constexpr size_t OBJECT_CACHE_HEADER_SIZE = 4 + 2 + 8 + 4 + 8 + 4;
+
+    static uint32_t _hashRecordData(const char *data, size_t size)
+    {
+        // FNV-1a
+        uint32_t hash = 2166136261u;
+        for(size_t i = 0; i < size; ++i)
+        {
+            hash ^= static_cast<uint8_t>(data[i]);
+            hash *= 16777619u;
+        }
+
+        return hash;
+    }
+
+    static std::string _makeUniqueTmpPath(const std::string &path)
+    {
+        // unique across processes by the PID, and across the Levels in this process by the counter
+        static std::atomic<uint32_t> sTmpCounter(0);
+
+#if defined (__WIN32__)
+        long pid = _getpid();
+#else
+        long pid = getpid();
+#endif
+
+        std::ostringstream tmpPath;
+        tmpPath << path << "." << pid << "." << sTmpCounter.fetch_add(1) << ".tmp";
+        return tmpPath.str();
+    }
+
+    const float Level::LayerDespawnDelay = 3.0f;
+    const size_t Level::LayerSpawnsPerUpdate = 2;
+    const size_t Level::ObjectSpawnsPerUpdate = 16;
+    const size_t Level::ObjectSpawnChecksPerUpdate = 256;
+
     Level::Level(Engine engine)
     : mEngine(engine)
     , mPhysicsSystem(engine.getPhysicsSystem())
@@ -35,6 +95,9 @@ namespace od
     , mDependencyTable(std::make_shared<odDb::DependencyTable>())
     , mVerticalExtent(0)
     , mCurrentActivePvsLayer(nullptr)
+    , mPvsStreamingActive(false)
+    , mObjectSpawnCheckCursor(0)
+    , mLastViewerPosition(std::numeric_limits<float>::max())
     {
         if(engine.isClient())
         {
@@ -57,10 +120,31 @@ namespace od
 
         SrscFile file(levelPath);
 
-        _loadNameAndDeps(file, dbManager);
-        _loadLayers(file);
+        // the level file is read in one go, so none of the workers below need to access it
+        auto dependencies = _loadNameAndDepDefinitions(file);
+        std::vector<std::vector<char>> compressedPolyData;
+        _loadLayerDefinitions(file, compressedPolyData);
         //_loadLayerGroups(file); unnecessary, as this is probably just an editor thing
-        _loadObjects(file, dbManager);
+
+        // loading the databases is mostly waiting for the disk, so it goes to its own thread while we parse everything
+        //  that does not depend on it. futures are declared after the data they reference so their destructors wait for
+        //  the workers before that data goes away, should anything below panic
+        auto dependencyFuture = std::async(std::launch::async, [this, &dependencies, &dbManager]()
+        {
+            _loadDependencies(dependencies, dbManager);
+        });
+
+        auto layerFuture = std::async(std::launch::async, [this, &compressedPolyData]()
+        {
+            _loadLayerPolyData(compressedPolyData);
+        });
+
+        _loadObjectRecords(file);
+
+        layerFuture.get();
+        dependencyFuture.get();
+
+        _createObjects();
 
         Logger::info() << "Level loaded successfully";
     }
@@ -70,6 +154,11 @@ namespace od
         mDestructionQueue.insert(objId);
     }
 
+    void Level::addToActiveObjects(LevelObject &obj)
+    {
+        mActiveObjects.push_back(&obj);
+    }
+
     Layer *Level::getLayerById(uint32_t id)
     {
         // TODO: we can do better than O(n)
@@ -131,12 +220,15 @@ namespace od
 
     void Level::spawnAllObjects()
     {
-        Logger::info() << "Spawning all objects for debugging (conditional spawning not implemented yet)";
+        Logger::info() << "Spawning all objects and layers";
 
-        for(auto it = mLayers.begin(); it != mLayers.end(); ++it)
+        std::vector<Layer*> layers;
+        layers.reserve(mLayers.size());
+        for(auto &layer : mLayers)
         {
-            (*it)->spawn(mPhysicsSystem, mRenderer);
+            layers.push_back(layer.get());
         }
+        spawnLayers(layers);
 
         for(auto &objMap : mLevelObjects)
         {
@@ -144,8 +236,34 @@ namespace od
         }
     }
 
+    void Level::spawnLayers(const std::vector<Layer*> &layers)
+    {
+        std::vector<Layer*> layersToSpawn;
+        layersToSpawn.reserve(layers.size());
+        for(auto layer : layers)
+        {
+            if(!layer->isSpawned())
+            {
+                layersToSpawn.push_back(layer);
+            }
+        }
+
+        ThreadUtils::parallelFor(layersToSpawn.size(), [this, &layersToSpawn](size_t i)
+        {
+            layersToSpawn[i]->prepareSpawn(mPhysicsSystem, mRenderer);
+        });
+
+        // this is what touches the renderer and the physics world, so it has to happen on the calling thread
+        for(auto layer : layersToSpawn)
+        {
+            layer->spawn(mPhysicsSystem, mRenderer);
+        }
+    }
+
     void Level::update(float relTime)
     {
+        OD_PROFILE_ZONE("Level::update");
+
         if(!mDestructionQueue.empty())
         {
             for(auto objId : mDestructionQueue)
@@ -153,22 +271,51 @@ namespace od
                 auto it = mLevelObjects.find(objId);
                 if(it == mLevelObjects.end()) continue;
 
-                it->second->despawn();
+                LevelObject *obj = it->second.get();
+                obj->despawn();
+
+                if(obj->mIsInActiveList)
+                {
+                    mActiveObjects.erase(std::find(mActiveObjects.begin(), mActiveObjects.end(), obj));
+                }
 
                 mLevelObjects.erase(it);
             }
             mDestructionQueue.clear();
         }
 
-        for(auto &objIt : mLevelObjects)
+        if(mPvsStreamingActive)
         {
-            objIt.second->update(relTime);
+            _updateSpawning(relTime);
         }
 
-        for(auto &objIt : mLevelObjects)
+        // timers usually wake objects up or message them, so run them before objects get updated
+        mTimerWheel.advance(relTime);
+
+        // objects may become active during these loops, which appends to mActiveObjects. thus, iterate by index
+        for(size_t i = 0; i < mActiveObjects.size(); ++i)
         {
-            objIt.second->postUpdate(relTime);
+            mActiveObjects[i]->update(relTime);
         }
+
+        OD_PROFILE_COUNT(OBJECTS_UPDATED, mActiveObjects.size());
+
+        for(size_t i = 0; i < mActiveObjects.size(); ++i)
+        {
+            mActiveObjects[i]->postUpdate(relTime);
+        }
+
+        auto isInactive = [](LevelObject *obj)
+        {
+            if(obj->isActive())
+            {
+                return false;
+            }
+
+            obj->mIsInActiveList = false;
+            return true;
+        };
+        mActiveObjects.erase(std::remove_if(mActiveObjects.begin(), mActiveObjects.end(), isInactive), mActiveObjects.end());
     }
 
     ObjectRecordData &Level::getObjectRecord(uint16_t index)
@@ -220,73 +367,127 @@ namespace od
 
     void Level::activateLayerPVS(Layer *layer)
     {
-        if(layer == nullptr)
+        mPvsStreamingActive = true;
+
+        if(layer == mCurrentActivePvsLayer)
+        {
+            return;
+        }
+
+        for(auto &state : mLayerStreamingStates)
+        {
+            state.inPvs = false;
+        }
+
+        if(layer != nullptr)
         {
-            for(auto &layer : mLayers)
+            for(size_t i = 0; i < mLayers.size(); ++i)
             {
-                layer->despawn();
+                if(mLayers[i].get() == layer)
+                {
+                    mLayerStreamingStates[i].inPvs = true;
+                    break;
+                }
             }
 
-        }else if(mCurrentActivePvsLayer == nullptr)
-        {
             for(auto index : layer->getVisibleLayerIndices())
             {
-                getLayerByIndex(index)->spawn(mPhysicsSystem, mRenderer);
+                if(index < mLayerStreamingStates.size())
+                {
+                    mLayerStreamingStates[index].inPvs = true;
+                }
             }
+        }
 
-        }else
+        // layers that entered the PVS get queued, the ones that left it start their despawn delay in _updateSpawning()
+        for(size_t i = 0; i < mLayers.size(); ++i)
         {
-            // we want to despawn all layers that are in the previous layer's PVS but not in the passed layer's PVS,
-            // while keeping all the ones that are in both. despawning all active layers and respawning the relevant
-            // ones would be too inefficient
+            auto &state = mLayerStreamingStates[i];
+            if(!state.inPvs)
+            {
+                continue;
+            }
 
-            auto &newPvs = layer->getVisibleLayerIndices();
-            auto &oldPvs = mCurrentActivePvsLayer->getVisibleLayerIndices();
+            state.timeOutsidePvs = 0;
 
-            std::vector<uint32_t> layerPvsMerged = newPvs;
-            layerPvsMerged.insert(layerPvsMerged.end(), oldPvs.begin(), oldPvs.end());
-            std::sort(layerPvsMerged.begin(), layerPvsMerged.end());
+            if(!mLayers[i]->isSpawned() && !state.queued)
+            {
+                state.queued = true;
+                mLayerSpawnQueue.push_back(i);
+            }
+        }
 
-            for(size_t i = 0; i < layerPvsMerged.size()-1; ++i)
+        mCurrentActivePvsLayer = layer;
+    }
+
+    void Level::updateViewerPosition(const glm::vec3 &viewerPos)
+    {
+        // searching is brute force, so only do it if the viewer actually moved
+        static const float minDistance = 0.1;
+        if(mCurrentActivePvsLayer != nullptr && glm::length(viewerPos - mLastViewerPosition) < minDistance)
+        {
+            return;
+        }
+
+        mLastViewerPosition = viewerPos;
+
+        Layer *viewerLayer = findLayerBelow(viewerPos);
+        if(viewerLayer != nullptr)
+        {
+            activateLayerPVS(viewerLayer);
+        }
+    }
+
+    Layer *Level::findLayerBelow(const glm::vec3 &pos)
+    {
+        glm::vec2 xz(pos.x, pos.z);
+
+        Layer *bestLayer = nullptr;
+        float bestHeight = std::numeric_limits<float>::lowest();
+        for(auto &layer : mLayers)
+        {
+            if(layer->getLayerType() == Layer::TYPE_CEILING || !layer->contains(xz) || layer->hasHoleAt(xz))
             {
-                if(layerPvsMerged[i] == layerPvsMerged[i+1])
-                {
-                    // this layer stays
-                    i++;
-                    continue;
+                continue;
+            }
 
-                }else
-                {
-                    // this layer changed
-                    Layer *layerToToggle = getLayerByIndex(layerPvsMerged[i]);
-                    if(layerToToggle->isSpawned())
-                    {
-                        layerToToggle->despawn();
-
-                    }else
-                    {
-                        layerToToggle->spawn(mPhysicsSystem, mRenderer);
-                    }
-                }
+            float height = layer->getAbsoluteHeightAt(xz);
+            if(std::isnan(height) || height > pos.y || height <= bestHeight)
+            {
+                continue;
             }
+
+            bestLayer = layer.get();
+            bestHeight = height;
         }
 
-        mCurrentActivePvsLayer = layer;
+        return bestLayer;
     }
 
     void Level::calculateInitialLayerAssociations()
     {
         // create temporary physics handles for all layers (without lighting, etc.)
-        std::vector<std::shared_ptr<odPhysics::LayerHandle>> layerHandles;
-        layerHandles.reserve(mLayers.size());
+        std::vector<Layer*> unspawnedLayers;
+        unspawnedLayers.reserve(mLayers.size());
         for(auto &layer : mLayers)
         {
-            if(layer->isSpawned())
+            if(!layer->isSpawned())
             {
-                continue;
+                unspawnedLayers.push_back(layer.get());
             }
+        }
+
+        std::vector<std::shared_ptr<odPhysics::LayerShape>> layerShapes(unspawnedLayers.size());
+        ThreadUtils::parallelFor(unspawnedLayers.size(), [this, &unspawnedLayers, &layerShapes](size_t i)
+        {
+            layerShapes[i] = mPhysicsSystem.createLayerShape(*unspawnedLayers[i]);
+        });
 
-            layerHandles.push_back(mPhysicsSystem.createLayerHandle(*layer));
+        std::vector<std::shared_ptr<odPhysics::LayerHandle>> layerHandles;
+        layerHandles.reserve(unspawnedLayers.size());
+        for(size_t i = 0; i < unspawnedLayers.size(); ++i)
+        {
+            layerHandles.push_back(mPhysicsSystem.createLayerHandle(*unspawnedLayers[i], layerShapes[i]));
         }
 
         for(auto &obj : mLevelObjects)
@@ -295,7 +496,83 @@ namespace od
         }
     }
 
-    void Level::_loadNameAndDeps(SrscFile &file, odDb::DbManager &dbManager)
+    void Level::_updateSpawning(float relTime)
+    {
+        for(size_t i = 0; i < mLayers.size(); ++i)
+        {
+            auto &state = mLayerStreamingStates[i];
+            if(!state.inPvs && mLayers[i]->isSpawned())
+            {
+                state.timeOutsidePvs += relTime;
+                if(state.timeOutsidePvs >= LayerDespawnDelay)
+                {
+                    mLayers[i]->despawn();
+                }
+            }
+        }
+
+        mLayersToSpawn.clear();
+        while(mLayersToSpawn.size() < LayerSpawnsPerUpdate && !mLayerSpawnQueue.empty())
+        {
+            size_t index = mLayerSpawnQueue.front();
+            mLayerSpawnQueue.pop_front();
+
+            auto &state = mLayerStreamingStates[index];
+            state.queued = false;
+
+            // might have left the PVS again while waiting in the queue
+            if(!state.inPvs || mLayers[index]->isSpawned())
+            {
+                continue;
+            }
+
+            mLayersToSpawn.push_back(mLayers[index].get());
+        }
+        spawnLayers(mLayersToSpawn);
+
+        // objects are checked round-robin, so the cost per update stays constant no matter how many objects the level has
+        size_t objectBudget = ObjectSpawnsPerUpdate;
+        size_t checks = std::min(ObjectSpawnChecksPerUpdate, mStreamedObjectIds.size());
+        for(size_t i = 0; i < checks && objectBudget > 0; ++i)
+        {
+            if(mObjectSpawnCheckCursor >= mStreamedObjectIds.size())
+            {
+                mObjectSpawnCheckCursor = 0;
+            }
+
+            auto it = mLevelObjects.find(mStreamedObjectIds[mObjectSpawnCheckCursor++]);
+            if(it == mLevelObjects.end() || it->second->getSpawnStrategy() != SpawnStrategy::WhenInSight)
+            {
+                continue;
+            }
+
+            LevelObject &obj = *it->second;
+            bool inSight = _isObjectInSight(obj);
+            if(inSight && !obj.isSpawned())
+            {
+                obj.spawn();
+                --objectBudget;
+
+            }else if(!inSight && obj.isSpawned())
+            {
+                obj.despawn();
+            }
+        }
+    }
+
+    bool Level::_isObjectInSight(LevelObject &obj)
+    {
+        // objects not on any layer can't be culled by the PVS. keep them around as long as there is a PVS at all
+        Layer *layer = obj.getAssociatedLayer();
+        if(layer == nullptr)
+        {
+            return mCurrentActivePvsLayer != nullptr;
+        }
+
+        return layer->isSpawned();
+    }
+
+    std::vector<Level::DependencyDefinition> Level::_loadNameAndDepDefinitions(SrscFile &file)
     {
         auto cursor = file.getFirstRecordOfType(SrscRecordType::LEVEL_NAME);
     	DataReader dr = cursor.getReader();
@@ -309,6 +586,8 @@ namespace od
 
         Logger::verbose() << "Level depends on " << dbRefCount << " databases";
 
+        std::vector<DependencyDefinition> dependencies;
+        dependencies.reserve(dbRefCount);
         for(size_t i = 0; i < dbRefCount; ++i)
         {
         	uint16_t dbIndex;
@@ -319,15 +598,28 @@ namespace od
             dr >> dbPathStr;
 
             FilePath dbPath(dbPathStr, file.getFilePath().dir());
+            dependencies.push_back({dbIndex, dbPath});
+        }
+
+        return dependencies;
+    }
+
+    void Level::_loadDependencies(const std::vector<DependencyDefinition> &dependencies, odDb::DbManager &dbManager)
+    {
+        for(size_t i = 0; i < dependencies.size(); ++i)
+        {
+            auto &dep = dependencies[i];
 
-            Logger::debug() << "Gonna load level dependency index " << dbIndex << ": " << dbPath;
-            auto db = dbManager.loadDatabase(dbPath.ext(".db").adjustCase());
+            Logger::debug() << "Gonna load level dependency index " << dep.index << ": " << dep.path;
+            auto db = dbManager.loadDatabase(dep.path.ext(".db").adjustCase());
 
-            mDependencyTable->addDependency(dbIndex, db);
+            mDependencyTable->addDependency(dep.index, db);
+
+            _reportProgress(LoadingStage::Dependencies, i+1, dependencies.size());
         }
     }
 
-    void Level::_loadLayers(SrscFile &file)
+    void Level::_loadLayerDefinitions(SrscFile &file, std::vector<std::vector<char>> &compressedPolyData)
     {
     	auto cursor = file.getFirstRecordOfType(SrscRecordType::LEVEL_LAYERS);
     	DataReader dr = cursor.getReader();
@@ -349,27 +641,51 @@ namespace od
 
     	dr >> DataReader::Expect<uint32_t>(1);
 
-    	float minHeight = std::numeric_limits<float>::max();
-    	float maxHeight = std::numeric_limits<float>::lowest();
-
+    	// poly data is only copied here. inflating and parsing it is what takes time, and that can be done in parallel
+    	compressedPolyData.resize(layerCount);
     	for(size_t i = 0; i < layerCount; ++i)
     	{
     		uint32_t compressedDataSize;
 			dr >> compressedDataSize;
 
-			ZStream zstr(dr.getStream(), compressedDataSize, ZStreamBuffer::DefaultBufferSize);
-			DataReader zdr(zstr);
-			mLayers[i]->loadPolyData(zdr);
-			zstr.seekToEndOfZlib();
+			compressedPolyData[i].resize(compressedDataSize);
+			dr.read(compressedPolyData[i].data(), compressedDataSize);
+    	}
+
+    	mLayerStreamingStates.resize(layerCount, LayerStreamingState{false, false, 0.0f});
+    }
+
+    void Level::_loadLayerPolyData(const std::vector<std::vector<char>> &compressedPolyData)
+    {
+        size_t layerCount = mLayers.size();
+
+        // one thread is already busy loading dependencies, another one parses object records
+        std::atomic<size_t> layersDone(0);
+        ThreadUtils::parallelFor(layerCount, [this, &compressedPolyData, &layersDone, layerCount](size_t i)
+        {
+            auto &data = compressedPolyData[i];
+            MemoryInputBuffer buffer(data.data(), data.size());
+            std::istream in(&buffer);
+            ZStream zstr(in, data.size(), ZStreamBuffer::DefaultBufferSize);
+            DataReader zdr(zstr);
+            mLayers[i]->loadPolyData(zdr);
 
-			if(mLayers[i]->getMinHeight() < minHeight)
+            _reportProgress(LoadingStage::Layers, ++layersDone, layerCount);
+
+        }, 2);
+
+    	float minHeight = std::numeric_limits<float>::max();
+    	float maxHeight = std::numeric_limits<float>::lowest();
+    	for(auto &layer : mLayers)
+    	{
+			if(layer->getMinHeight() < minHeight)
 			{
-			    minHeight = mLayers[i]->getMinHeight();
+			    minHeight = layer->getMinHeight();
 			}
 
-			if(mLayers[i]->getMaxHeight() > maxHeight)
+			if(layer->getMaxHeight() > maxHeight)
 			{
-			    maxHeight = mLayers[i]->getMaxHeight();
+			    maxHeight = layer->getMaxHeight();
 			}
     	}
 
@@ -402,7 +718,7 @@ namespace od
     	}
     }
 
-    void Level::_loadObjects(SrscFile &file, odDb::DbManager &dbManager)
+    void Level::_loadObjectRecords(SrscFile &file)
     {
     	Logger::verbose() << "Loading level objects";
 
@@ -419,17 +735,179 @@ namespace od
     	dr >> objectCount;
     	Logger::verbose() << "Level has " << objectCount << " objects";
 
+        // the cache is keyed on the raw bytes of the objects record, so any edit to the level's objects invalidates it
+        FilePath cachePath = file.getFilePath().ext(".odlc");
+        uint64_t levelFileSize;
+        uint32_t recordHash;
+        {
+            MappedFile levelMapping(file.getFilePath());
+            auto &dirEntry = *cursor.getDirIterator();
+            if(static_cast<uint64_t>(dirEntry.dataOffset) + dirEntry.dataSize > levelMapping.size())
+            {
+                OD_PANIC() << "Objects record exceeds bounds of level file";
+            }
+
+            levelFileSize = levelMapping.size();
+            recordHash = _hashRecordData(levelMapping.data() + dirEntry.dataOffset, dirEntry.dataSize);
+        }
+
+        if(_loadObjectRecordCache(cachePath, levelFileSize, recordHash, objectCount))
+        {
+            Logger::verbose() << "Loaded object records from cache " << cachePath;
+            _reportProgress(LoadingStage::ObjectRecords, objectCount, objectCount);
+            return;
+        }
+
+    	// records have no size prefix, so there is no way to split this up among threads
         mObjectRecords.reserve(objectCount);
         for(size_t i = 0; i < objectCount; ++i)
     	{
             mObjectRecords.emplace_back(dr);
+
+            _reportProgress(LoadingStage::ObjectRecords, i+1, objectCount);
+        }
+
+        _writeObjectRecordCache(cachePath, levelFileSize, recordHash);
+    }
+
+    bool Level::_loadObjectRecordCache(const FilePath &cachePath, uint64_t levelFileSize, uint32_t recordHash, size_t expectedObjectCount)
+    {
+        if(!cachePath.exists())
+        {
+            return false;
         }
 
+        MappedFile cacheMapping(cachePath);
+
+        // DataReader panics on EOF, so check the size before parsing anything
+        if(cacheMapping.size() < OBJECT_CACHE_HEADER_SIZE)
+        {
+            return false;
+        }
+
+        MemoryInputBuffer buf(cacheMapping.data(), cacheMapping.size());
+        std::istream in(&buf);
+        DataReader dr(in);
+
+        uint32_t magic;
+        uint16_t version;
+        uint64_t cachedLevelFileSize;
+        uint32_t cachedRecordHash;
+        uint64_t cacheSize;
+        uint32_t objectCount;
+        dr >> magic
+           >> version
+           >> cachedLevelFileSize
+           >> cachedRecordHash
+           >> cacheSize
+           >> objectCount;
+
+        if(magic != OBJECT_CACHE_MAGIC || version != OBJECT_CACHE_VERSION || cacheSize != cacheMapping.size())
+        {
+            return false;
+        }
+
+        if(cachedLevelFileSize != levelFileSize || cachedRecordHash != recordHash || objectCount != expectedObjectCount)
+        {
+            Logger::verbose() << "Object cache " << cachePath << " is outdated";
+            return false;
+        }
+
+        // the header can be fine while the body is not (say, from a crash while writing it). DataReader would panic
+        //  on that, so everything below checks its bounds and we fall back to parsing the level instead
+        size_t end = cacheMapping.size();
+        odRfl::FieldNameTable fieldNames;
+        if(!fieldNames.read(dr, end))
+        {
+            Logger::warn() << "Object cache " << cachePath << " is corrupt. Ignoring it";
+            return false;
+        }
+
+        mObjectRecords.reserve(objectCount);
+        for(size_t i = 0; i < objectCount; ++i)
+        {
+            ObjectRecordData record;
+            if(!record.loadFromCache(dr, end, fieldNames))
+            {
+                Logger::warn() << "Object cache " << cachePath << " is corrupt. Ignoring it";
+                mObjectRecords.clear();
+                return false;
+            }
+
+            mObjectRecords.push_back(std::move(record));
+        }
+
+        return true;
+    }
+
+    void Level::_writeObjectRecordCache(const FilePath &cachePath, uint64_t levelFileSize, uint32_t recordHash)
+    {
+        // records go first so the name table is complete once we write it
+        odRfl::FieldNameTable fieldNames;
+        std::ostringstream recordStream;
+        DataWriter recordWriter(recordStream);
+        for(auto &record : mObjectRecords)
+        {
+            record.writeToCache(recordWriter, fieldNames);
+        }
+
+        std::ostringstream nameStream;
+        DataWriter nameWriter(nameStream);
+        fieldNames.write(nameWriter);
+
+        std::string names = nameStream.str();
+        std::string records = recordStream.str();
+
+        // another Level in this process (the server's or the client's) may be mapping the cache right now. truncating
+        //  the file under its mapping would crash it, so write a new file and replace the old one atomically. both
+        //  might be writing at the same time, so each writer gets a temporary file of its own
+        std::string tmpPath = _makeUniqueTmpPath(cachePath.str());
+        {
+            std::ofstream out(tmpPath, std::ios::out | std::ios::binary | std::ios::trunc);
+            if(out.fail())
+            {
+                Logger::warn() << "Could not write object cache " << cachePath << ". Objects will be parsed again next time";
+                return;
+            }
+
+            DataWriter dw(out);
+            dw << OBJECT_CACHE_MAGIC
+               << OBJECT_CACHE_VERSION
+               << levelFileSize
+               << recordHash
+               << static_cast<uint64_t>(OBJECT_CACHE_HEADER_SIZE + names.size() + records.size())
+               << static_cast<uint32_t>(mObjectRecords.size());
+            dw.write(names.data(), names.size());
+            dw.write(records.data(), records.size());
+
+            out.close();
+            if(out.fail())
+            {
+                Logger::warn() << "Could not write object cache " << cachePath << ". Objects will be parsed again next time";
+                std::remove(tmpPath.c_str());
+                return;
+            }
+        }
+
+        if(std::rename(tmpPath.c_str(), cachePath.str().c_str()) != 0)
+        {
+            Logger::warn() << "Could not replace object cache " << cachePath << ". Objects will be parsed again next time";
+            std::remove(tmpPath.c_str());
+        }
+    }
+
+    void Level::_createObjects()
+    {
+        size_t objectCount = mObjectRecords.size();
+
     	mLevelObjects.reserve(objectCount);
         for(size_t i = 0; i < objectCount; ++i)
     	{
             auto &record = mObjectRecords[i];
 
+            // report before anything can make us skip this object
+            _reportProgress(LoadingStage::Objects, i+1, objectCount);
+
             auto dbClass = mDependencyTable->loadAsset<odDb::Class>(record.getClassRef());
             if(dbClass == nullptr)
             {
@@ -455,6 +933,17 @@ namespace od
             }
 
             ptrInMap = std::move(newObject);
+            mStreamedObjectIds.push_back(record.getObjectId());
     	}
     }
+
+    void Level::_reportProgress(LoadingStage stage, size_t done, size_t total)
+    {
+        std::lock_guard<std::mutex> lock(mLoadingProgressMutex);
+
+        if(mLoadingProgressCallback)
+        {
+            mLoadingProgressCallback(stage, done, total);
+        }
+    }
 }
@@ -112,6 +112,8 @@ namespace od
     , mLightingLayer(nullptr)
     , mIsSpawned(false)
     , mSpawnStrategy(SpawnStrategy::WhenInSight)
+    , mIsActive(false)
+    , mIsInActiveList(false)
     , mAssociatedLayer(nullptr)
     , mAssociateWithCeiling(false)
     , mSpawnableClass(nullptr)
@@ -307,6 +309,8 @@ namespace od
                     mSpawnableClass->onStop();
                 }
             }
+
+            _updateActiveState();
         }
 
         if(transformChanged && mSpawnableClass != nullptr)
@@ -361,6 +365,8 @@ namespace od
             mSpawnableClass->onSpawned();
         }
 
+        _updateActiveState();
+
         Logger::debug() << "Object " << getObjectId() << " spawned";
     }
 
@@ -378,6 +384,8 @@ namespace od
             mSpawnableClass->onDespawned();
         }
 
+        _updateActiveState();
+
         // TODO: destroy render and physics handle
 
         Logger::debug() << "Object " << getObjectId() << " despawned";
@@ -386,6 +394,8 @@ namespace od
     void LevelObject::setEnableUpdate(bool enable)
     {
         mEnableUpdate = enable;
+
+        _updateActiveState();
     }
 
     void LevelObject::update(float relTime)
@@ -397,6 +407,12 @@ namespace od
             {
                 mSkeleton->flatten(*mRenderHandle->getRig());
             }
+
+            if(!mSkeletonAnimationPlayer->isPlaying())
+            {
+                // animation just ended. we might not have anything else to do
+                _updateActiveState();
+            }
         }
 
         if(mStates.running.get() && mEnableUpdate && mSpawnableClass != nullptr)
@@ -552,7 +568,7 @@ namespace od
             }
 
             auto &fieldLoader = mLevel.getObjectRecord(mRecordIndex).getFieldLoader();
-            fieldLoader.reset();
+            fieldLoader.reset((mClass != nullptr) ? &mClass->getFieldBindingPlan(mRflClassInstance->getFields()) : nullptr);
             mRflClassInstance->getFields().probeFields(fieldLoader);
 
             mRflClassInstance->onLoaded();
@@ -664,12 +680,29 @@ namespace od
                 mSkeletonAnimationPlayer->setBoneModes(modes.boneModes, 0);
             }
 
+            _updateActiveState();
+
         }else
         {
             Logger::warn() << "Object " << getObjectId() << " can't play animation because it has no animation player";
         }
     }
 
+    void LevelObject::_updateActiveState()
+    {
+        bool isAnimating = (mSkeletonAnimationPlayer != nullptr) && mSkeletonAnimationPlayer->isPlaying();
+        bool hasUpdateHooks = mStates.running.get() && mEnableUpdate && (mSpawnableClass != nullptr);
+
+        mIsActive = mIsSpawned && (isAnimating || hasUpdateHooks);
+
+        // leaving the active list is handled by the level once it is done iterating over it
+        if(mIsActive && !mIsInActiveList)
+        {
+            mIsInActiveList = true;
+            mLevel.addToActiveObjects(*this);
+        }
+    }
+
     class HandleVisitor
     {
     public:
@@ -0,0 +1,93 @@
+/*
+ * MappedFile.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: zal
+ */
+
+#include <odCore/MappedFile.h>
+
+#include <fstream>
+
+#include <odCore/Panic.h>
+
+#if !defined (__WIN32__)
+extern "C"
+{
+#   include <sys/mman.h>
+#   include <sys/stat.h>
+#   include <fcntl.h>
+#   include <unistd.h>
+}
+#endif
+
+namespace od
+{
+
+    MappedFile::MappedFile(const FilePath &path)
+    : mFilePath(path)
+    , mData(nullptr)
+    , mSize(0)
+    {
+#if defined (__WIN32__)
+        std::ifstream in(mFilePath.str(), std::ios::in | std::ios::binary);
+        if(in.fail())
+        {
+            OD_PANIC() << "Could not open file " << mFilePath << " for mapping";
+        }
+
+        in.seekg(0, std::ios::end);
+        mFallbackBuffer.resize(in.tellg());
+        in.seekg(0);
+        in.read(mFallbackBuffer.data(), mFallbackBuffer.size());
+        if(in.fail())
+        {
+            OD_PANIC() << "Could not read file " << mFilePath;
+        }
+
+        mData = mFallbackBuffer.data();
+        mSize = mFallbackBuffer.size();
+
+#else
+        int fd = open(mFilePath.str().c_str(), O_RDONLY);
+        if(fd == -1)
+        {
+            OD_PANIC() << "Could not open file " << mFilePath << " for mapping";
+        }
+
+        struct stat fileStat;
+        if(fstat(fd, &fileStat) == -1)
+        {
+            close(fd);
+            OD_PANIC() << "Could not stat file " << mFilePath;
+        }
+
+        mSize = fileStat.st_size;
+        if(mSize > 0)
+        {
+            void *mapping = mmap(nullptr, mSize, PROT_READ, MAP_PRIVATE, fd, 0);
+            if(mapping == MAP_FAILED)
+            {
+                close(fd);
+                OD_PANIC() << "Could not map file " << mFilePath;
+            }
+
+            mData = static_cast<const char*>(mapping);
+        }
+
+        // the mapping stays valid after closing the descriptor
+        close(fd);
+#endif
+    }
+
+    MappedFile::~MappedFile()
+    {
+#if !defined (__WIN32__)
+        if(mData != nullptr)
+        {
+            munmap(const_cast<char*>(mData), mSize);
+        }
+#endif
+    }
+
+}
@@ -50,4 +50,74 @@ namespace od
         mRotation = glm::quat(eulerAngles);
     }
 
+    ObjectRecordData::ObjectRecordData()
+    : mId(0)
+    , mLightingLayerId(0)
+    , mFlags(0)
+    , mInitialEventCount(0)
+    , mPosition(0, 0, 0)
+    , mRotation(1, 0, 0, 0)
+    , mScale(1, 1, 1)
+    {
+    }
+
+    bool ObjectRecordData::loadFromCache(DataReader &dr, size_t end, const odRfl::FieldNameTable &fieldNames)
+    {
+        static constexpr size_t HEAD_SIZE = sizeof(mId) + sizeof(mClassRef.assetId) + sizeof(mClassRef.dbIndex)
+                + sizeof(mLightingLayerId) + sizeof(mFlags) + sizeof(mInitialEventCount) + sizeof(uint16_t);
+        static constexpr size_t TRANSFORM_SIZE = (3 + 4 + 3) * sizeof(float);
+
+        if(dr.tell() + HEAD_SIZE > end)
+        {
+            return false;
+        }
+
+        uint16_t linkCount;
+
+        dr >> mId
+           >> mClassRef
+           >> mLightingLayerId
+           >> mFlags
+           >> mInitialEventCount
+           >> linkCount;
+
+        if(dr.tell() + linkCount*sizeof(uint16_t) + TRANSFORM_SIZE > end)
+        {
+            return false;
+        }
+
+        mLinkedObjectIndices.resize(linkCount);
+        for(auto &linkedIndex : mLinkedObjectIndices)
+        {
+            dr >> linkedIndex;
+        }
+
+        dr >> mPosition
+           >> mRotation
+           >> mScale;
+
+        return mFieldLoader.loadFromCache(dr, end, fieldNames);
+    }
+
+    void ObjectRecordData::writeToCache(DataWriter &dw, odRfl::FieldNameTable &fieldNames) const
+    {
+        dw << mId
+           << mClassRef
+           << mLightingLayerId
+           << mFlags
+           << mInitialEventCount
+           << static_cast<uint16_t>(mLinkedObjectIndices.size());
+
+        for(auto linkedIndex : mLinkedObjectIndices)
+        {
+            dw << linkedIndex;
+        }
+
+        dw << mPosition
+           << mRotation
+           << mScale;
+
+        mFieldLoader.writeToCache(dw, fieldNames);
+    }
+
 }
@@ -0,0 +1,230 @@
+/*
+ * Profiler.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: zal
+ */
+
+#include <odCore/Profiler.h>
+
+#include <odCore/Logger.h>
+#include <odCore/Panic.h>
+
+namespace od
+{
+
+    static thread_local void *tThreadBuffer = nullptr;
+
+    static double _toMicroseconds(Profiler::Clock::duration d)
+    {
+        return 1e-3 * std::chrono::duration_cast<std::chrono::nanoseconds>(d).count();
+    }
+
+    static void _writeJsonString(std::ostream &out, const std::string &s)
+    {
+        out << '"';
+        for(char c : s)
+        {
+            switch(c)
+            {
+            case '"':
+                out << "\\\"";
+                break;
+
+            case '\\':
+                out << "\\\\";
+                break;
+
+            case '\n':
+                out << "\\n";
+                break;
+
+            default:
+                if(static_cast<unsigned char>(c) < 0x20)
+                {
+                    out << ' ';
+
+                }else
+                {
+                    out << c;
+                }
+                break;
+            }
+        }
+        out << '"';
+    }
+
+
+    Profiler::Profiler()
+    : mEnabled(false)
+    , mEpoch(Clock::now())
+    {
+    }
+
+    Profiler &Profiler::getInstance()
+    {
+        static Profiler profiler;
+        return profiler;
+    }
+
+    const char *Profiler::getCounterName(ProfileCounter counter)
+    {
+        switch(counter)
+        {
+        case ProfileCounter::OBJECTS_UPDATED:
+            return "objects updated";
+
+        case ProfileCounter::RAY_TESTS:
+            return "ray tests";
+
+        case ProfileCounter::CONTACT_TESTS:
+            return "contact tests";
+
+        case ProfileCounter::SNAPSHOT_BYTES:
+            return "snapshot bytes";
+
+        case ProfileCounter::EVENTS_DISPATCHED:
+            return "events dispatched";
+        }
+
+        OD_UNREACHABLE();
+    }
+
+    void Profiler::setEnabled(bool b)
+    {
+        bool wasEnabled = mEnabled.exchange(b, std::memory_order_relaxed);
+        if(wasEnabled != b)
+        {
+            Logger::info() << "Profiler " << (b ? "enabled" : "disabled");
+        }
+    }
+
+    void Profiler::setCurrentThreadName(const char *name)
+    {
+        ThreadBuffer &buffer = _getThreadBuffer();
+        std::lock_guard<std::mutex> lock(buffer.mutex);
+        buffer.threadName = name;
+    }
+
+    void Profiler::sampleCounters()
+    {
+        if(!isEnabled()) return;
+
+        ThreadBuffer &buffer = _getThreadBuffer();
+        std::lock_guard<std::mutex> lock(buffer.mutex);
+        buffer.counterSamples.push_back({Clock::now(), buffer.counters});
+        buffer.counters.fill(0);
+    }
+
+    void Profiler::writeChromeTrace(std::ostream &out)
+    {
+        std::lock_guard<std::mutex> buffersLock(mThreadBuffersMutex);
+
+        size_t eventCount = 0;
+        size_t droppedEventCount = 0;
+
+        // default float formatting would switch to scientific notation and drop precision after a few seconds
+        auto oldFlags = out.flags();
+        auto oldPrecision = out.precision(3);
+        out.setf(std::ios::fixed, std::ios::floatfield);
+
+        out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+        bool first = true;
+        auto beginEvent = [&]()
+        {
+            if(!first) out << ",";
+            out << "\n";
+            first = false;
+        };
+
+        for(auto &bufferPtr : mThreadBuffers)
+        {
+            ThreadBuffer &buffer = *bufferPtr;
+            std::lock_guard<std::mutex> lock(buffer.mutex);
+
+            std::string threadName = buffer.threadName.empty() ? ("thread " + std::to_string(buffer.threadId)) : buffer.threadName;
+
+            beginEvent();
+            out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer.threadId << ",\"args\":{\"name\":";
+            _writeJsonString(out, threadName);
+            out << "}}";
+
+            for(auto &event : buffer.events)
+            {
+                beginEvent();
+                out << "{\"name\":";
+                _writeJsonString(out, event.name);
+                out << ",\"cat\":\"od\",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer.threadId
+                    << ",\"ts\":" << _toMicroseconds(event.start - mEpoch)
+                    << ",\"dur\":" << _toMicroseconds(event.end - event.start) << "}";
+            }
+
+            // counters are grouped by name in trace viewers, so prefix them with the thread to keep threads apart
+            for(auto &sample : buffer.counterSamples)
+            {
+                beginEvent();
+                out << "{\"name\":";
+                _writeJsonString(out, threadName + " counters");
+                out << ",\"ph\":\"C\",\"pid\":1,\"tid\":" << buffer.threadId
+                    << ",\"ts\":" << _toMicroseconds(sample.time - mEpoch) << ",\"args\":{";
+                for(size_t i = 0; i < COUNTER_COUNT; ++i)
+                {
+                    if(i > 0) out << ",";
+                    out << "\"" << getCounterName(static_cast<ProfileCounter>(i)) << "\":" << sample.values[i];
+                }
+                out << "}}";
+            }
+
+            eventCount += buffer.events.size();
+            droppedEventCount += buffer.droppedEventCount;
+        }
+
+        out << "\n]}\n";
+
+        out.flags(oldFlags);
+        out.precision(oldPrecision);
+
+        Logger::info() << "Wrote " << eventCount << " profiler events from " << mThreadBuffers.size() << " threads";
+        if(droppedEventCount > 0)
+        {
+            Logger::warn() << "Profiler dropped " << droppedEventCount << " events because thread buffers were full";
+        }
+    }
+
+    void Profiler::clear()
+    {
+        std::lock_guard<std::mutex> buffersLock(mThreadBuffersMutex);
+
+        for(auto &buffer : mThreadBuffers)
+        {
+            std::lock_guard<std::mutex> lock(buffer->mutex);
+            buffer->events.clear();
+            buffer->counterSamples.clear();
+            buffer->droppedEventCount = 0;
+        }
+    }
+
+    Profiler::ThreadBuffer &Profiler::_getThreadBuffer()
+    {
+        if(tThreadBuffer == nullptr)
+        {
+            tThreadBuffer = &_createThreadBuffer();
+        }
+
+        return *static_cast<ThreadBuffer*>(tThreadBuffer);
+    }
+
+    Profiler::ThreadBuffer &Profiler::_createThreadBuffer()
+    {
+        auto buffer = std::make_unique<ThreadBuffer>();
+        buffer->droppedEventCount = 0;
+        buffer->counters.fill(0);
+
+        std::lock_guard<std::mutex> lock(mThreadBuffersMutex);
+        buffer->threadId = mThreadBuffers.size() + 1;
+        mThreadBuffers.push_back(std::move(buffer));
+
+        return *mThreadBuffers.back();
+    }
+
+}
@@ -11,6 +11,7 @@
 #include <chrono>
 
 #include <odCore/Level.h>
+#include <odCore/Profiler.h>
 
 #include <odCore/net/UplinkConnector.h>
 #include <odCore/net/DownlinkConnector.h>
@@ -93,6 +94,7 @@ namespace od
     , mRflManager(rflManager)
     , mIsDone(false)
     , mNextClientId(1)
+    , mServerTime(0.0)
     {
         mPhysicsSystem = std::make_unique<odBulletPhysics::BulletPhysicsSystem>(nullptr);
     }
@@ -173,6 +175,7 @@ namespace od
         mStateManager = std::make_unique<odState::StateManager>(*mLevel);
         mEventQueue = std::make_unique<odState::EventQueue>(mDbManager, *mLevel);
 
+        // the server has no viewer of it's own and has to simulate the whole level, so it does not stream by PVS
         mLevel->spawnAllObjects();
 
         // in order for clients to be able to load the level, we have to give them
@@ -219,6 +222,8 @@ namespace od
     {
         Logger::info() << "OpenDrakan server starting...";
 
+        OD_PROFILE_THREAD_NAME("server");
+
         Logger::info() << "Server set up. Starting main server loop";
 
         double targetUpdateIntervalNs = (1e9/60.0);
@@ -232,50 +237,82 @@ namespace od
             double relTime = 1e-9 * std::chrono::duration_cast<std::chrono::nanoseconds>(loopStart - lastUpdateStartTime).count();
             lastUpdateStartTime = loopStart;
 
-            mServerTime += relTime;
-            mEventQueue->setCurrentTime(mServerTime);
+            tick(relTime);
+
+            auto loopEnd = std::chrono::high_resolution_clock::now();
+            auto loopTime = loopEnd - loopStart;
+            if(loopTime < targetUpdateInterval)
+            {
+                std::this_thread::sleep_for(targetUpdateInterval - loopTime);
 
-            if(mLevel != nullptr)
+            }else
             {
-                mLevel->update(relTime);
+                float loopTimeMs = 1e-3 * std::chrono::duration_cast<std::chrono::microseconds>(loopTime).count();
+                Logger::warn() << "Server tick took too long (" << loopTimeMs << "ms, target was " << (targetUpdateIntervalNs*1e-6) << "ms)";
             }
+        }
 
+        Logger::info() << "Shutting down server gracefully";
+    }
+
+    void Server::tick(double relTime)
+    {
+        OD_PROFILE_ZONE("Server tick");
+
+        mServerTime += relTime;
+        mEventQueue->setCurrentTime(mServerTime);
+
+        if(mLevel != nullptr)
+        {
+            mLevel->update(relTime);
+        }
+
+        {
+            OD_PROFILE_ZONE("Physics update");
             mPhysicsSystem->update(relTime);
+        }
 
-            // copy clients into temporary vector of pointers which we don't have to synchronize (to prevent deadlocks on recursive accesses to clients)
+        // copy clients into temporary vector of pointers which we don't have to synchronize (to prevent deadlocks on recursive accesses to clients)
+        {
+            std::lock_guard<std::mutex> lock(mClientsMutex);
+            mTempClientUpdateList.clear();
+            mTempClientUpdateList.reserve(mClients.size());
+            for(auto &client : mClients)
             {
-                std::lock_guard<std::mutex> lock(mClientsMutex);
-                mTempClientUpdateList.clear();
-                mTempClientUpdateList.reserve(mClients.size());
-                for(auto &client : mClients)
-                {
-                    mTempClientUpdateList.push_back(client.second.get());
-                }
+                mTempClientUpdateList.push_back(client.second.get());
             }
+        }
 
-            // update per-client subsystems and process received packets
-            for(auto client : mTempClientUpdateList)
-            {
-                LocalUplinkConnector localConnector(*this, *client);
-                client->uplinkConnector->flushQueue(localConnector);
+        // update per-client subsystems and process received packets
+        for(auto client : mTempClientUpdateList)
+        {
+            OD_PROFILE_ZONE("Client uplink");
 
-                client->inputManager->update(relTime);
-            }
+            LocalUplinkConnector localConnector(*this, *client);
+            client->uplinkConnector->flushQueue(localConnector);
 
-            // commit update
-            mStateManager->commit(mServerTime);
-            mEventQueue->dispatch(mServerTime);
+            client->inputManager->update(relTime);
+        }
+
+        // commit update
+        mStateManager->commit(mServerTime);
+        mEventQueue->dispatch(mServerTime);
 
-            // send update to clients
+        // send update to clients
+        {
+            OD_PROFILE_ZONE("Send to clients");
             odState::TickNumber latestTick = mStateManager->getLatestTick();
             for(auto client : mTempClientUpdateList)
             {
+                // clients that were added but are not connected yet have no downlink
+                if(client->downlinkConnector == nullptr)
+                {
+                    continue;
+                }
+
                 if(latestTick >= client->nextTickToSend)
                 {
-                    if(client->downlinkConnector != nullptr)
-                    {
-                        mStateManager->sendSnapshotToClient(latestTick, *client->downlinkConnector, client->lastAcknowledgedTick);
-                    }
+                    mStateManager->sendSnapshotToClient(latestTick, *client->downlinkConnector, client->lastAcknowledgedTick);
 
                     // for now, send with fixed rate. later, we'd likely adapt the rate with which we send snapshots based on the client's network speed
                     client->nextTickToSend = latestTick+3;
@@ -283,24 +320,12 @@ namespace od
 
                 mEventQueue->sendEventsToClient(*client->downlinkConnector, mServerTime);
             }
-
-            mEventQueue->markAsSent(mServerTime);
-            mEventQueue->cleanup();
-
-            auto loopEnd = std::chrono::high_resolution_clock::now();
-            auto loopTime = loopEnd - loopStart;
-            if(loopTime < targetUpdateInterval)
-            {
-                std::this_thread::sleep_for(targetUpdateInterval - loopTime);
-
-            }else
-            {
-                float loopTimeMs = 1e-3 * std::chrono::duration_cast<std::chrono::microseconds>(loopTime).count();
-                Logger::warn() << "Server tick took too long (" << loopTimeMs << "ms, target was " << (targetUpdateIntervalNs*1e-6) << "ms)";
-            }
         }
 
-        Logger::info() << "Shutting down server gracefully";
+        mEventQueue->markAsSent(mServerTime);
+        mEventQueue->cleanup();
+
+        OD_PROFILE_TICK();
     }
 
     Server::ClientData &Server::_getClientData(odNet::ClientId id)
@@ -11,7 +11,6 @@
 #include <iomanip>
 #include <sstream>
 #include <streambuf>
-#include <functional>
 #include <algorithm>
 
 #include <odCore/DataStream.h>
@@ -20,32 +19,6 @@
 namespace od
 {
 
-    static bool _stepForward(SrscFile::DirIterator &it, const SrscFile::DirIterator &end, int32_t maxSteps, const std::function<bool(const SrscFile::DirEntry&)> &predicate)
-    {
-        if(it == end)
-        {
-            return false;
-        }
-
-        if(maxSteps < 0) maxSteps = std::numeric_limits<decltype(maxSteps)>::max();
-
-        int32_t step = 0;
-        while(++it != end && ++step <= maxSteps)
-        {
-            if(predicate(*it))
-            {
-                return true;
-            }
-        }
-
-        if(step >= maxSteps)
-        {
-            it = end;
-        }
-
-        return false;
-    }
-
     SrscFile::RecordInputCursor::RecordInputCursor(SrscFile &file, std::mutex &mutex, DirIterator &dirIt)
     : mFile(file)
     , mDirIterator(dirIt)
@@ -94,20 +67,17 @@ namespace od
 
     bool SrscFile::RecordInputCursor::nextOfType(RecordType type, int32_t maxDistance)
     {
-        auto pred = [type](const SrscFile::DirEntry &d) { return d.type == type; };
-        return _stepForward(mDirIterator, mFile.getDirectoryEnd(), maxDistance, pred);
+        return mFile._stepToNextInIndex(mDirIterator, mFile._getTypeIndex(type), maxDistance);
     }
 
     bool SrscFile::RecordInputCursor::nextOfId(RecordId id, int32_t maxDistance)
     {
-        auto pred = [id](const SrscFile::DirEntry &d) { return d.recordId == id; };
-        return _stepForward(mDirIterator, mFile.getDirectoryEnd(), maxDistance, pred);
+        return mFile._stepToNextInIndex(mDirIterator, mFile._getIdIndex(id), maxDistance);
     }
 
     bool SrscFile::RecordInputCursor::nextOfTypeId(RecordType type, RecordId id, int32_t maxDistance)
     {
-        auto pred = [type, id](const SrscFile::DirEntry &d) { return d.type == type && d.recordId == id; };
-        return _stepForward(mDirIterator, mFile.getDirectoryEnd(), maxDistance, pred);
+        return mFile._stepToNextInIndex(mDirIterator, mFile._getTypeIdIndex(type, id), maxDistance);
     }
 
     void SrscFile::RecordInputCursor::moveTo(const SrscFile::DirIterator &dirIt)
@@ -155,25 +125,19 @@ namespace od
 
 	SrscFile::RecordInputCursor SrscFile::getFirstRecordOfType(RecordType type)
 	{
-	    auto pred = [type](const SrscFile::DirEntry &d) { return d.type == type; }; // TODO: duplicate predicate (see RecordInputCursor)
-	    auto it = std::find_if(getDirectoryBegin(), getDirectoryEnd(), pred);
+	    auto it = _getFirstInIndex(_getTypeIndex(type));
 	    return RecordInputCursor(*this, mMutex, it);
 	}
 
     SrscFile::RecordInputCursor SrscFile::getFirstRecordOfId(RecordId id)
     {
-        // TODO: we could create a map indexing the first record of every ID, thus speeding up finding assets in a file immensely
-        //  or maybe let the asset containers do that. IDK
-
-        auto pred = [id](const SrscFile::DirEntry &d) { return d.recordId == id; };
-        auto it = std::find_if(getDirectoryBegin(), getDirectoryEnd(), pred);
+        auto it = _getFirstInIndex(_getIdIndex(id));
         return RecordInputCursor(*this, mMutex, it);
     }
 
     SrscFile::RecordInputCursor SrscFile::getFirstRecordOfTypeId(RecordType type, RecordId id)
     {
-        auto pred = [type, id](const SrscFile::DirEntry &d) { return d.type == type && d.recordId == id; };
-        auto it = std::find_if(getDirectoryBegin(), getDirectoryEnd(), pred);
+        auto it = _getFirstInIndex(_getTypeIdIndex(type, id));
         return RecordInputCursor(*this, mMutex, it);
     }
 
@@ -197,15 +161,16 @@ namespace od
 			std::ostringstream ss;
 			ss << outputDir.str() << "/rawrecord" << dirEntry.index << "-" << std::hex << dirEntry.type << "-" << dirEntry.recordId << "-" << dirEntry.groupId << std::dec << ".dat";
 
-			std::ofstream out(ss.str(), std::ios::out | std::ios::binary);
-
+			std::vector<char> data(dirEntry.dataSize);
 			mInputStream.seekg(dirEntry.dataOffset);
-
-			for(size_t i = 0; i < dirEntry.dataSize; ++i)
+			mInputStream.read(data.data(), data.size());
+			if(static_cast<size_t>(mInputStream.gcount()) != data.size())
 			{
-				out.put(mInputStream.get());
+			    OD_PANIC() << "Record " << dirEntry.index << " exceeds end of file";
 			}
 
+			std::ofstream out(ss.str(), std::ios::out | std::ios::binary);
+			out.write(data.data(), data.size());
 			out.close();
 
 		}else
@@ -253,6 +218,71 @@ namespace od
 
 			mDirectory[i] = entry;
 		}
+
+		_buildIndices();
+	}
+
+	void SrscFile::_buildIndices()
+	{
+	    // we walk the directory in order, so every list ends up sorted without further work
+	    for(auto &entry : mDirectory)
+	    {
+	        mTypeIndex[entry.type].push_back(entry.index);
+	        mIdIndex[entry.recordId].push_back(entry.index);
+	        mTypeIdIndex[(static_cast<uint32_t>(entry.type) << 16) | entry.recordId].push_back(entry.index);
+	    }
+	}
+
+	const SrscFile::IndexList *SrscFile::_getTypeIndex(RecordType type) const
+	{
+	    auto it = mTypeIndex.find(type);
+	    return (it != mTypeIndex.end()) ? &it->second : nullptr;
+	}
+
+	const SrscFile::IndexList *SrscFile::_getIdIndex(RecordId id) const
+	{
+	    auto it = mIdIndex.find(id);
+	    return (it != mIdIndex.end()) ? &it->second : nullptr;
+	}
+
+	const SrscFile::IndexList *SrscFile::_getTypeIdIndex(RecordType type, RecordId id) const
+	{
+	    auto it = mTypeIdIndex.find((static_cast<uint32_t>(type) << 16) | id);
+	    return (it != mTypeIdIndex.end()) ? &it->second : nullptr;
+	}
+
+	SrscFile::DirIterator SrscFile::_getFirstInIndex(const IndexList *indexList)
+	{
+	    if(indexList == nullptr || indexList->empty())
+	    {
+	        return mDirectory.end();
+	    }
+
+	    return mDirectory.begin() + indexList->front();
+	}
+
+	bool SrscFile::_stepToNextInIndex(DirIterator &it, const IndexList *indexList, int32_t maxDistance)
+	{
+	    if(it == mDirectory.end())
+	    {
+	        return false;
+	    }
+
+	    size_t currentIndex = it - mDirectory.begin();
+
+	    if(indexList != nullptr)
+	    {
+	        auto nextIt = std::upper_bound(indexList->begin(), indexList->end(), currentIndex);
+	        if(nextIt != indexList->end() && (maxDistance < 0 || (*nextIt - currentIndex) <= static_cast<size_t>(maxDistance)))
+	        {
+	            it = mDirectory.begin() + *nextIt;
+	            return true;
+	        }
+	    }
+
+	    // like a failed linear search, a failed step leaves the cursor invalid
+	    it = mDirectory.end();
+	    return false;
 	}
 
     void SrscFile::_checkDirIterator(const DirIterator &dirIt)
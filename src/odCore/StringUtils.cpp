@@ -66,6 +66,20 @@ namespace od
 		return i;
 	}
 
+	std::string StringUtils::toLower(const std::string &s)
+	{
+	    std::string result(s);
+	    std::transform(result.begin(), result.end(), result.begin(), [](unsigned char c){ return std::tolower(c); });
+	    return result;
+	}
+
+	std::string StringUtils::toUpper(const std::string &s)
+	{
+	    std::string result(s);
+	    std::transform(result.begin(), result.end(), result.begin(), [](unsigned char c){ return std::toupper(c); });
+	    return result;
+	}
+
 	bool StringUtils::compareIgnoringCase(const std::string &a, const std::string &b)
 	{
 		auto ciPred = [](char a, char b){ return std::toupper(a) == std::toupper(b); };
@@ -36,6 +36,70 @@ namespace od
             #endif
         }
 
+
+        WorkerPool::WorkerPool(size_t threadCount)
+        : mTerminate(false)
+        {
+            mThreads.reserve(threadCount);
+            for(size_t i = 0; i < threadCount; ++i)
+            {
+                mThreads.emplace_back(&WorkerPool::_work, this);
+                setThreadName(mThreads.back(), "od worker");
+            }
+        }
+
+        WorkerPool::~WorkerPool()
+        {
+            {
+                std::lock_guard<std::mutex> lock(mMutex);
+                mTerminate = true;
+            }
+            mCondition.notify_all();
+
+            for(auto &thread : mThreads)
+            {
+                thread.join();
+            }
+        }
+
+        void WorkerPool::post(std::function<void()> task)
+        {
+            {
+                std::lock_guard<std::mutex> lock(mMutex);
+                mTasks.push_back(std::move(task));
+            }
+            mCondition.notify_one();
+        }
+
+        WorkerPool &WorkerPool::getSharedPool()
+        {
+            static WorkerPool sSharedPool(std::max<size_t>(std::thread::hardware_concurrency(), 2) - 1);
+            return sSharedPool;
+        }
+
+        void WorkerPool::_work()
+        {
+            for(;;)
+            {
+                std::function<void()> task;
+
+                {
+                    std::unique_lock<std::mutex> lock(mMutex);
+                    mCondition.wait(lock, [this](){ return mTerminate || !mTasks.empty(); });
+
+                    if(mTasks.empty())
+                    {
+                        return;
+                    }
+
+                    task = std::move(mTasks.front());
+                    mTasks.pop_front();
+                }
+
+                task();
+            }
+        }
+
     }
 
 }
@@ -0,0 +1,189 @@
+/*
+ * TimerWheel.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: zal
+ */
+
+#include <odCore/TimerWheel.h>
+
+#include <cmath>
+
+namespace od
+{
+
+    static uint64_t _secondsToTicks(float seconds)
+    {
+        // a timer always fires on a later tick than the one it was scheduled on. otherwise, scheduling from within a
+        //  callback could add to the slot that is just being processed
+        float ticks = std::ceil(seconds * TimerWheel::TICKS_PER_SECOND);
+        return (ticks >= 1.0f) ? static_cast<uint64_t>(ticks) : 1;
+    }
+
+
+    TimerWheel::TimerWheel()
+    : mCurrentTick(0)
+    , mTickRemainder(0.0f)
+    {
+    }
+
+    double TimerWheel::getTime() const
+    {
+        return static_cast<double>(mCurrentTick) / TICKS_PER_SECOND;
+    }
+
+    TimerHandle TimerWheel::schedule(float delay, Callback callback, float repeatInterval)
+    {
+        auto entry = std::make_shared<Entry>();
+        entry->deadline = mCurrentTick + _secondsToTicks(delay);
+        entry->interval = (repeatInterval > 0.0f) ? _secondsToTicks(repeatInterval) : 0;
+        entry->callback = std::move(callback);
+        entry->finished = false;
+
+        _insert(entry);
+
+        return TimerHandle(entry);
+    }
+
+    void TimerWheel::advance(float relTime)
+    {
+        if(relTime <= 0.0f)
+        {
+            return;
+        }
+
+        mTickRemainder += relTime * TICKS_PER_SECOND;
+        while(mTickRemainder >= 1.0f)
+        {
+            mTickRemainder -= 1.0f;
+            _tick();
+        }
+    }
+
+    void TimerWheel::_insert(std::shared_ptr<Entry> entry)
+    {
+        uint64_t deadline = entry->deadline;
+        uint64_t delta = (deadline > mCurrentTick) ? (deadline - mCurrentTick) : 0;
+
+        size_t level = 0;
+        while(level < LEVEL_COUNT - 1 && delta >= (1ull << (LEVEL_BITS*(level + 1))))
+        {
+            ++level;
+        }
+
+        // timers beyond the range of the top level wait in its last slot. they are re-inserted when it cascades
+        uint64_t range = 1ull << (LEVEL_BITS*LEVEL_COUNT);
+        if(delta >= range)
+        {
+            deadline = mCurrentTick + range - 1;
+        }
+
+        size_t slotIndex = (deadline >> (LEVEL_BITS*level)) & (SLOTS_PER_LEVEL - 1);
+        mLevels[level][slotIndex].push_back(std::move(entry));
+    }
+
+    void TimerWheel::_cascade(size_t level)
+    {
+        size_t slotIndex = (mCurrentTick >> (LEVEL_BITS*level)) & (SLOTS_PER_LEVEL - 1);
+
+        Slot entries;
+        entries.swap(mLevels[level][slotIndex]);
+        for(auto &entry : entries)
+        {
+            if(!entry->finished)
+            {
+                _insert(std::move(entry));
+            }
+        }
+    }
+
+    void TimerWheel::_tick()
+    {
+        ++mCurrentTick;
+
+        // whenever a level wraps around, the next slot of the level above becomes due and is spread over the levels below
+        for(size_t level = 1; level < LEVEL_COUNT; ++level)
+        {
+            if((mCurrentTick & ((1ull << (LEVEL_BITS*level)) - 1)) != 0)
+            {
+                break;
+            }
+
+            _cascade(level);
+        }
+
+        Slot due;
+        due.swap(mLevels[0][mCurrentTick & (SLOTS_PER_LEVEL - 1)]);
+        for(auto &entry : due)
+        {
+            if(entry->finished)
+            {
+                continue;
+            }
+
+            if(entry->deadline > mCurrentTick)
+            {
+                // a clamped timer that still has a long way to go
+                _insert(entry);
+                continue;
+            }
+
+            if(entry->interval > 0)
+            {
+                entry->deadline += entry->interval;
+                _insert(entry);
+
+            }else
+            {
+                entry->finished = true;
+            }
+
+            // the callback may cancel its own timer, which would destroy it while it runs. hold on to it until it returns
+            Callback callback = std::move(entry->callback);
+            callback();
+            if(!entry->finished)
+            {
+                entry->callback = std::move(callback);
+            }
+        }
+    }
+
+
+    TimerHandle::TimerHandle(std::shared_ptr<TimerWheel::Entry> entry)
+    : mEntry(std::move(entry))
+    {
+    }
+
+    TimerHandle::~TimerHandle()
+    {
+        cancel();
+    }
+
+    TimerHandle &TimerHandle::operator=(TimerHandle &&h)
+    {
+        if(&h != this)
+        {
+            cancel();
+            mEntry = std::move(h.mEntry);
+        }
+
+        return *this;
+    }
+
+    bool TimerHandle::isPending() const
+    {
+        return mEntry != nullptr && !mEntry->finished;
+    }
+
+    void TimerHandle::cancel()
+    {
+        if(mEntry != nullptr)
+        {
+            // the wheel drops the entry lazily once it reaches its slot. release whatever the callback captured right away
+            mEntry->finished = true;
+            mEntry->callback = nullptr;
+            mEntry = nullptr;
+        }
+    }
+
+}
@@ -72,15 +72,14 @@ namespace odAnim
         mCurrentMatrix = transform;
     }
 
-    void Skeleton::Bone::_flattenRecursive(odRender::Rig &rig, const glm::mat4 &parentMatrix)
+    void Skeleton::Bone::_flattenRecursive(std::vector<glm::mat4> &flattened, const glm::mat4 &parentMatrix)
     {
-        glm::mat4 chainMatrix = mCurrentMatrix * parentMatrix;
-
-        rig.setBoneTransform(mJointIndex, chainMatrix);
+        glm::mat4 &chainMatrix = flattened[mJointIndex];
+        chainMatrix = mCurrentMatrix * parentMatrix;
 
         for(auto it = mChildBones.begin(); it != mChildBones.end(); ++it)
         {
-            (*it)->_flattenRecursive(rig, chainMatrix);
+            (*it)->_flattenRecursive(flattened, chainMatrix);
         }
     }
 
@@ -95,6 +94,8 @@ namespace odAnim
             mBones.emplace_back(*this, i);
         }
 
+        mFlattenedTransforms.resize(boneCount, glm::mat4(1.0));
+
         mDefinition->build(*this);
     }
 
@@ -133,8 +134,10 @@ namespace odAnim
 
         for(auto root : mRootBones)
         {
-            root->_flattenRecursive(rig, eye);
+            root->_flattenRecursive(mFlattenedTransforms, eye);
         }
+
+        rig.setBoneTransforms(mFlattenedTransforms.data(), mFlattenedTransforms.size());
     }
 
     bool Skeleton::checkForLoops()
@@ -0,0 +1,290 @@
+/*
+ * MusicCache.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: zal
+ */
+
+#include <odCore/audio/music/MusicCache.h>
+
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+#include <zlib.h>
+
+#include <odCore/DataStream.h>
+#include <odCore/Logger.h>
+#include <odCore/Panic.h>
+
+namespace odAudio
+{
+
+    static constexpr uint32_t CACHE_MAGIC = 0x434d444f; // 'ODMC' in LE
+    static constexpr uint16_t CACHE_VERSION = 2;
+    static constexpr uint16_t CACHE_CHANNELS = 2;
+    static constexpr std::streamoff CACHE_HEADER_SIZE = 4 + 2 + 2 + 4 + 4 + 4 + 4;
+
+    static void _writeHeader(std::ostream &out, uint32_t sampleRate, uint32_t segmentHash, size_t sampleCount, size_t compressedSize)
+    {
+        od::DataWriter dw(out);
+        dw << CACHE_MAGIC
+           << CACHE_VERSION
+           << CACHE_CHANNELS
+           << sampleRate
+           << segmentHash
+           << static_cast<uint32_t>(sampleCount)
+           << static_cast<uint32_t>(compressedSize);
+    }
+
+
+    MusicCache::Stream::Stream(const od::FilePath &path, size_t sampleCount, std::streamoff dataOffset)
+    : mInput(path.str(), std::ios::in | std::ios::binary)
+    , mSamplesLeft(sampleCount)
+    {
+        if(mInput.fail())
+        {
+            OD_PANIC() << "Could not open music cache file " << path;
+        }
+
+        mInput.seekg(dataOffset);
+
+        size_t bufferSize = std::min(od::ZStreamBuffer::DefaultBufferSize, sampleCount*sizeof(int16_t));
+        bufferSize = std::max(bufferSize, size_t(1));
+        mZStream = std::make_unique<od::ZStream>(mInput, bufferSize, bufferSize);
+    }
+
+    void MusicCache::Stream::read(int16_t *buffer, size_t size)
+    {
+        size_t available = std::min(size, mSamplesLeft);
+        if(available > 0)
+        {
+            // FIXME: host endianess dependent
+            od::DataReader dr(*mZStream);
+            dr.read(reinterpret_cast<char*>(buffer), available*sizeof(int16_t));
+            mSamplesLeft -= available;
+        }
+
+        std::fill(buffer + available, buffer + size, 0);
+    }
+
+
+    MusicCache::Writer::Writer(const od::FilePath &path, uint32_t sampleRate, uint32_t segmentHash)
+    : mPath(path)
+    , mTmpPath(path.str() + ".tmp")
+    , mOutput(mTmpPath, std::ios::out | std::ios::binary | std::ios::trunc)
+    , mZStreamInitialized(false)
+    , mOutputBuffer(od::ZStreamBuffer::DefaultBufferSize)
+    , mSampleRate(sampleRate)
+    , mSegmentHash(segmentHash)
+    , mSampleCount(0)
+    , mCompressedSize(0)
+    , mFailed(false)
+    {
+        if(mOutput.fail())
+        {
+            Logger::warn() << "Could not open music cache file " << mTmpPath << " for writing";
+            mFailed = true;
+            return;
+        }
+
+        // the header is rewritten with the final sizes on commit
+        _writeHeader(mOutput, mSampleRate, mSegmentHash, 0, 0);
+
+        std::memset(&mZStream, 0, sizeof(mZStream));
+        mZStream.zalloc = Z_NULL;
+        mZStream.zfree = Z_NULL;
+        mZStream.opaque = Z_NULL;
+        if(deflateInit(&mZStream, Z_BEST_SPEED) != Z_OK)
+        {
+            Logger::error() << "Failed to initialize zlib stream for music caching";
+            mFailed = true;
+            return;
+        }
+
+        mZStreamInitialized = true;
+    }
+
+    MusicCache::Writer::~Writer()
+    {
+        if(mZStreamInitialized)
+        {
+            deflateEnd(&mZStream);
+        }
+
+        if(mOutput.is_open())
+        {
+            // not committed
+            mOutput.close();
+            std::remove(mTmpPath.c_str());
+        }
+    }
+
+    bool MusicCache::Writer::write(const int16_t *samples, size_t size)
+    {
+        if(mFailed)
+        {
+            return false;
+        }
+
+        // FIXME: host endianess dependent
+        mZStream.next_in = reinterpret_cast<Bytef*>(const_cast<int16_t*>(samples));
+        mZStream.avail_in = size*sizeof(int16_t);
+        mSampleCount += size;
+
+        return _deflate(Z_NO_FLUSH);
+    }
+
+    bool MusicCache::Writer::commit()
+    {
+        if(mFailed || !_deflate(Z_FINISH))
+        {
+            return false;
+        }
+
+        mOutput.seekp(0);
+        _writeHeader(mOutput, mSampleRate, mSegmentHash, mSampleCount, mCompressedSize);
+        mOutput.close();
+        if(mOutput.fail())
+        {
+            Logger::warn() << "Failed to write music cache file " << mTmpPath;
+            std::remove(mTmpPath.c_str());
+            return false;
+        }
+
+        // streams might be reading the old entry right now. renaming leaves them with the old file
+        if(std::rename(mTmpPath.c_str(), mPath.str().c_str()) != 0)
+        {
+            Logger::warn() << "Could not replace music cache file " << mPath;
+            std::remove(mTmpPath.c_str());
+            return false;
+        }
+
+        Logger::verbose() << "Cached music in " << mPath << " ("
+                << mSampleCount*sizeof(int16_t) << " bytes compressed to " << mCompressedSize << ")";
+
+        return true;
+    }
+
+    bool MusicCache::Writer::_deflate(int flush)
+    {
+        int result;
+        do
+        {
+            mZStream.next_out = reinterpret_cast<Bytef*>(mOutputBuffer.data());
+            mZStream.avail_out = mOutputBuffer.size();
+
+            result = deflate(&mZStream, flush);
+            if(result == Z_STREAM_ERROR)
+            {
+                Logger::error() << "Failed to compress music for caching";
+                mFailed = true;
+                return false;
+            }
+
+            // not using a DataWriter here, since running out of disk space should not be fatal
+            size_t produced = mOutputBuffer.size() - mZStream.avail_out;
+            mOutput.write(mOutputBuffer.data(), produced);
+            mCompressedSize += produced;
+            if(mOutput.fail())
+            {
+                Logger::warn() << "Failed to write music cache file " << mTmpPath;
+                mFailed = true;
+                return false;
+            }
+
+        // deflate leaves input unconsumed only if it ran out of output space
+        }while(mZStream.avail_out == 0 || (flush == Z_FINISH && result != Z_STREAM_END));
+
+        return true;
+    }
+
+
+    MusicCache::MusicCache(const od::FilePath &cacheDir, const std::string &prefix, const std::string &synthKey, uint32_t sampleRate)
+    : mCacheDir(cacheDir)
+    , mPrefix(prefix)
+    , mSynthKey(synthKey)
+    , mSampleRate(sampleRate)
+    {
+    }
+
+    od::FilePath MusicCache::getCacheFilePath(MusicId id) const
+    {
+        std::ostringstream ss;
+        ss << mPrefix << "_" << std::hex << std::setw(4) << std::setfill('0') << id << std::dec << "_" << mSynthKey << "_" << mSampleRate << ".odmc";
+        return od::FilePath(ss.str(), mCacheDir);
+    }
+
+    std::unique_ptr<MusicCache::Stream> MusicCache::open(MusicId id, uint32_t segmentHash)
+    {
+        od::FilePath path = getCacheFilePath(id);
+
+        std::ifstream in(path.str(), std::ios::in | std::ios::binary);
+        if(in.fail())
+        {
+            return nullptr;
+        }
+
+        // DataReader panics on EOF, so make sure the file is big enough before parsing it
+        in.seekg(0, std::ios::end);
+        std::streamoff fileSize = in.tellg();
+        in.seekg(0);
+        if(fileSize < CACHE_HEADER_SIZE)
+        {
+            Logger::warn() << "Music cache file " << path << " is truncated. Ignoring";
+            return nullptr;
+        }
+
+        uint32_t magic;
+        uint16_t version;
+        uint16_t channels;
+        uint32_t sampleRate;
+        uint32_t cachedSegmentHash;
+        uint32_t sampleCount;
+        uint32_t compressedSize;
+        od::DataReader dr(in);
+        dr >> magic
+           >> version
+           >> channels
+           >> sampleRate
+           >> cachedSegmentHash
+           >> sampleCount
+           >> compressedSize;
+
+        if(fileSize < CACHE_HEADER_SIZE + compressedSize)
+        {
+            Logger::warn() << "Music cache file " << path << " is truncated. Ignoring";
+            return nullptr;
+        }
+
+        if(magic != CACHE_MAGIC || version != CACHE_VERSION || channels != CACHE_CHANNELS || sampleRate != mSampleRate)
+        {
+            Logger::warn() << "Music cache file " << path << " is invalid or outdated. Ignoring";
+            return nullptr;
+        }
+
+        if(cachedSegmentHash != segmentHash)
+        {
+            Logger::verbose() << "Music cache file " << path << " was rendered from different segment data. Ignoring";
+            return nullptr;
+        }
+
+        Logger::verbose() << "Playing music " << std::hex << id << std::dec << " from cache file " << path;
+
+        return std::make_unique<Stream>(path, sampleCount, CACHE_HEADER_SIZE);
+    }
+
+    std::unique_ptr<MusicCache::Writer> MusicCache::beginStore(MusicId id, uint32_t segmentHash)
+    {
+        auto writer = std::make_unique<Writer>(getCacheFilePath(id), mSampleRate, segmentHash);
+        if(writer->hasFailed())
+        {
+            return nullptr;
+        }
+
+        return writer;
+    }
+
+}
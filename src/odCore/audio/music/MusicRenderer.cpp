@@ -0,0 +1,112 @@
+/*
+ * MusicRenderer.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: zal
+ */
+
+#include <odCore/audio/music/MusicRenderer.h>
+
+#include <algorithm>
+
+#include <odCore/Logger.h>
+#include <odCore/Panic.h>
+
+#include <odCore/db/Segment.h>
+
+#include <odCore/audio/music/MidiSynth.h>
+#include <odCore/audio/music/SegmentPlayer.h>
+
+namespace odAudio
+{
+
+    static double _getEndTime(const odDb::Segment &segment)
+    {
+        // the header length is not always reliable. make sure we never cut off any events
+        double endTime = segment.getLength();
+
+        for(auto &event : segment.getMidiEvents())
+        {
+            endTime = std::max(endTime, static_cast<double>(event.startTime) + event.duration);
+        }
+
+        for(auto &curve : segment.getMidiCurves())
+        {
+            endTime = std::max(endTime, static_cast<double>(curve.startTime) + curve.duration);
+        }
+
+        return endTime;
+    }
+
+
+    MusicRenderer::MusicRenderer(MidiSynth &synth, uint32_t sampleRate)
+    : mSynth(synth)
+    , mSampleRate(sampleRate)
+    {
+        if(mSampleRate == 0)
+        {
+            OD_PANIC() << "Invalid sample rate for music renderer";
+        }
+    }
+
+    bool MusicRenderer::render(std::shared_ptr<odDb::Segment> segment, const ChunkConsumer &consumer)
+    {
+        OD_CHECK_ARG_NONNULL(segment);
+
+        SegmentPlayer player(mSynth);
+        player.setSegment(segment);
+        player.play();
+
+        const size_t samplesPerUpdate = FRAMES_PER_UPDATE*2;
+        const double timePerUpdate = static_cast<double>(FRAMES_PER_UPDATE)/mSampleRate;
+        const size_t maxSamples = static_cast<size_t>(MAX_LENGTH_SECONDS*mSampleRate)*2;
+        size_t tailUpdatesLeft = static_cast<size_t>(RELEASE_TAIL_SECONDS/timePerUpdate);
+
+        double endTime = _getEndTime(*segment);
+
+        std::vector<int16_t> chunk(FRAMES_PER_CHUNK*2);
+        size_t chunkFill = 0;
+        size_t samplesRendered = 0;
+        bool aborted = false;
+        while(tailUpdatesLeft > 0)
+        {
+            if(samplesRendered >= maxSamples)
+            {
+                Logger::warn() << "Segment exceeded maximum render length of " << MAX_LENGTH_SECONDS << "s. Cutting it off";
+                break;
+            }
+
+            if(chunkFill + samplesPerUpdate > chunk.size())
+            {
+                if(!consumer(chunk.data(), chunkFill))
+                {
+                    aborted = true;
+                    break;
+                }
+
+                chunkFill = 0;
+            }
+
+            // same order as in realtime playback: synthesize first, then advance the player by the synthesized time
+            mSynth.fillInterleavedStereoBuffer(chunk.data() + chunkFill, samplesPerUpdate);
+            player.update(timePerUpdate);
+            chunkFill += samplesPerUpdate;
+            samplesRendered += samplesPerUpdate;
+
+            if(player.getCurrentMusicTime() >= endTime)
+            {
+                --tailUpdatesLeft;
+            }
+        }
+
+        if(!aborted && chunkFill > 0)
+        {
+            aborted = !consumer(chunk.data(), chunkFill);
+        }
+
+        mSynth.allNotesOff();
+
+        return !aborted;
+    }
+
+}
@@ -53,6 +53,14 @@ namespace odDb
         _loadFrameLookup(cursor.getReader());
     }
 
+    size_t Animation::getMemoryUsage() const
+    {
+        return sizeof(Animation)
+                + mAnimationName.capacity()
+                + mKeyframes.capacity() * sizeof(Keyframe)
+                + mFrameLookup.capacity() * sizeof(FrameLookupEntry);
+    }
+
 	std::pair<Animation::KfIterator, Animation::KfIterator> Animation::getKeyframesForNode(int32_t nodeId)
 	{
 		if(nodeId < 0 || (size_t)nodeId >= mFrameLookup.size())
@@ -36,4 +36,9 @@ namespace odDb
 	{
 	}
 
+	size_t Asset::getMemoryUsage() const
+	{
+	    return 0;
+	}
+
 }
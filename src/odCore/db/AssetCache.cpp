@@ -0,0 +1,165 @@
+/*
+ * AssetCache.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: zal
+ */
+
+#include <odCore/db/AssetCache.h>
+
+#include <iterator>
+
+#include <odCore/db/Asset.h>
+
+namespace odDb
+{
+
+    AssetCache::AssetCache(const std::string &assetTypeName, size_t budget)
+    : mAssetTypeName(assetTypeName)
+    , mBudget(budget)
+    , mHits(0)
+    , mRevivals(0)
+    , mMisses(0)
+    , mEvictions(0)
+    {
+    }
+
+    AssetCache::~AssetCache()
+    {
+    }
+
+    void AssetCache::setBudget(size_t budget)
+    {
+        EntryList evicted;
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        mBudget = budget;
+        _trim(evicted);
+    }
+
+    size_t AssetCache::getBudget()
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mBudget;
+    }
+
+    void AssetCache::_retain(const std::shared_ptr<Asset> &asset, long useCount, bool wasLoaded)
+    {
+        // declared before the lock so evicted assets are destroyed after it is released
+        EntryList evicted;
+
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        if(wasLoaded)
+        {
+            ++mMisses;
+
+        }else
+        {
+            ++mHits;
+        }
+
+        auto it = mEntryMap.find(asset.get());
+        if(it != mEntryMap.end())
+        {
+            // if only the caller and we hold a reference, the asset was idle and would have been unloaded without us
+            if(!wasLoaded && useCount <= 2)
+            {
+                ++mRevivals;
+            }
+
+            mEntries.splice(mEntries.begin(), mEntries, it->second);
+            return;
+        }
+
+        mEntries.push_front({ asset, asset->getMemoryUsage() });
+        mEntryMap[asset.get()] = mEntries.begin();
+
+        if(wasLoaded)
+        {
+            _trim(evicted);
+        }
+    }
+
+    void AssetCache::trim()
+    {
+        EntryList evicted;
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        _trim(evicted);
+    }
+
+    void AssetCache::clear()
+    {
+        EntryList entries;
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        entries.swap(mEntries);
+        mEntryMap.clear();
+    }
+
+    AssetCache::Statistics AssetCache::getStatistics()
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        Statistics stats;
+        stats.hits = mHits;
+        stats.revivals = mRevivals;
+        stats.misses = mMisses;
+        stats.evictions = mEvictions;
+        stats.entryCount = mEntries.size();
+        stats.idleCount = 0;
+        stats.idleBytes = 0;
+        for(auto &entry : mEntries)
+        {
+            if(entry.asset.use_count() == 1)
+            {
+                ++stats.idleCount;
+                stats.idleBytes += entry.size;
+            }
+        }
+
+        return stats;
+    }
+
+    void AssetCache::resetStatistics()
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        mHits = 0;
+        mRevivals = 0;
+        mMisses = 0;
+        mEvictions = 0;
+    }
+
+    void AssetCache::_trim(EntryList &evicted)
+    {
+        size_t idleBytes = 0;
+        for(auto &entry : mEntries)
+        {
+            if(entry.asset.use_count() == 1)
+            {
+                idleBytes += entry.size;
+            }
+        }
+
+        // walk from the least recently used end, skipping assets that are in use
+        auto it = mEntries.end();
+        while(it != mEntries.begin() && idleBytes > mBudget)
+        {
+            auto current = std::prev(it);
+            if(current->asset.use_count() == 1)
+            {
+                idleBytes -= current->size;
+                mEntryMap.erase(current->asset.get());
+                evicted.splice(evicted.end(), mEntries, current);
+                ++mEvictions;
+
+            }else
+            {
+                it = current;
+            }
+        }
+    }
+
+}
@@ -0,0 +1,96 @@
+/*
+ * AssetPrefetcher.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: zal
+ */
+
+#include <odCore/db/AssetPrefetcher.h>
+
+#include <algorithm>
+
+#include <odCore/Logger.h>
+#include <odCore/Profiler.h>
+#include <odCore/ThreadUtils.h>
+
+namespace odDb
+{
+
+    AssetPrefetcher::AssetPrefetcher()
+    : mTerminate(false)
+    {
+    }
+
+    AssetPrefetcher::~AssetPrefetcher()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mTerminate = true;
+        }
+
+        mCondition.notify_all();
+
+        for(auto &worker : mWorkers)
+        {
+            if(worker.joinable()) worker.join();
+        }
+    }
+
+    void AssetPrefetcher::_enqueue(std::shared_ptr<Job> job)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+
+            if(mWorkers.empty())
+            {
+                _startWorkers();
+            }
+
+            mJobs.push(std::move(job));
+        }
+
+        mCondition.notify_one();
+    }
+
+    void AssetPrefetcher::_startWorkers()
+    {
+        // leave one hardware thread to whoever is waiting for the results
+        size_t hardwareThreads = std::thread::hardware_concurrency();
+        size_t workerCount = std::clamp<size_t>(hardwareThreads > 1 ? hardwareThreads - 1 : 1, 1, MAX_WORKER_COUNT);
+
+        Logger::verbose() << "Starting " << workerCount << " asset prefetch worker(s)";
+
+        for(size_t i = 0; i < workerCount; ++i)
+        {
+            mWorkers.emplace_back(&AssetPrefetcher::_work, this);
+            od::ThreadUtils::setThreadName(mWorkers.back(), "asset prefetch");
+        }
+    }
+
+    void AssetPrefetcher::_work()
+    {
+        OD_PROFILE_THREAD_NAME("asset prefetch");
+
+        for(;;)
+        {
+            std::shared_ptr<Job> job;
+
+            {
+                std::unique_lock<std::mutex> lock(mMutex);
+                mCondition.wait(lock, [this](){ return mTerminate || !mJobs.empty(); });
+                if(mTerminate)
+                {
+                    return;
+                }
+
+                job = mJobs.top();
+                mJobs.pop();
+            }
+
+            // no-op if the requester already needed the result and loaded it itself. errors end up in the request's future
+            OD_PROFILE_ZONE("Asset prefetch");
+            std::call_once(job->once, job->run);
+        }
+    }
+
+}
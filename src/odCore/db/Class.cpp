@@ -42,10 +42,23 @@ namespace odDb
 
     void Class::fillFields(odRfl::FieldBundle &fieldBundle)
     {
-        mFieldLoader.reset(); // in case of throw, do this BEFORE building so counter is always fresh
+        mFieldLoader.reset(&getFieldBindingPlan(fieldBundle)); // in case of throw, do this BEFORE building so counter is always fresh
         fieldBundle.probeFields(mFieldLoader);
     }
 
+    const odRfl::FieldBindingPlan &Class::getFieldBindingPlan(odRfl::FieldBundle &fieldBundle)
+    {
+        std::lock_guard<std::mutex> lock(mFieldBindingPlanMutex);
+
+        auto &plan = mFieldBindingPlans[std::type_index(typeid(fieldBundle))];
+        if(plan == nullptr)
+        {
+            plan = std::make_unique<odRfl::FieldBindingPlan>(fieldBundle);
+        }
+
+        return *plan;
+    }
+
     std::unique_ptr<odRfl::ClassBase> Class::makeInstance(od::Engine &engine)
 	{
         odRfl::ClassFactory *factory = getRflClassFactory(engine.getRflManager());
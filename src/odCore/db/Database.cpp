@@ -25,13 +25,14 @@ namespace odDb
 
 
     template <typename T>
-    void Database::_tryOpeningAssetContainer(std::unique_ptr<T> &factoryPtr, std::unique_ptr<od::SrscFile> &containerPtr, const char *extension)
+    void Database::_tryOpeningAssetContainer(std::unique_ptr<T> &factoryPtr, std::unique_ptr<od::SrscFile> &containerPtr, const char *extension, AssetCache *cache)
     {
         od::FilePath path = mDbFilePath.ext(extension);
         if(path.exists())
         {
             containerPtr = std::make_unique<od::SrscFile>(path);
             factoryPtr = std::make_unique<T>(mDependencyTable, *containerPtr);
+            factoryPtr->setAssetCache(cache);
 
             Logger::verbose() << AssetTraits<typename T::AssetType>::name() << " container of database opened";
 
@@ -148,12 +149,13 @@ namespace odDb
         }
 
         // now that the database is loaded, create the various asset factories
-        _tryOpeningAssetContainer(mModelFactory,    mModelContainer,    ".mod");
-        _tryOpeningAssetContainer(mAnimFactory,     mAnimContainer,     ".adb");
-        _tryOpeningAssetContainer(mSoundFactory,    mSoundContainer,    ".sdb");
-        _tryOpeningAssetContainer(mSequenceFactory, mSequenceContainer, ".ssd");
-        _tryOpeningAssetContainer(mTextureFactory,  mTextureContainer,  ".txd");
-        _tryOpeningAssetContainer(mClassFactory,    mClassContainer,    ".odb");
+        //  classes and sequences are small and loaded once per level, so they are not worth caching
+        _tryOpeningAssetContainer(mModelFactory,    mModelContainer,    ".mod", &mDbManager.getModelCache());
+        _tryOpeningAssetContainer(mAnimFactory,     mAnimContainer,     ".adb", &mDbManager.getAnimationCache());
+        _tryOpeningAssetContainer(mSoundFactory,    mSoundContainer,    ".sdb", &mDbManager.getSoundCache());
+        _tryOpeningAssetContainer(mSequenceFactory, mSequenceContainer, ".ssd", nullptr);
+        _tryOpeningAssetContainer(mTextureFactory,  mTextureContainer,  ".txd", &mDbManager.getTextureCache());
+        _tryOpeningAssetContainer(mClassFactory,    mClassContainer,    ".odb", nullptr);
 	}
 
     template<>
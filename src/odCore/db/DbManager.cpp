@@ -19,13 +19,38 @@ namespace odDb
 
     static constexpr size_t MAX_DEPENDENCY_DEPTH{100};
 
+    // default budgets for idle assets. a whole level's worth of textures decoded to RGBA is a few hundred MiB,
+    //  so this covers what adjacent layers typically share, not everything a level has ever used
+    static constexpr size_t DEFAULT_TEXTURE_CACHE_BUDGET{64 << 20};
+    static constexpr size_t DEFAULT_MODEL_CACHE_BUDGET{16 << 20};
+    static constexpr size_t DEFAULT_ANIMATION_CACHE_BUDGET{16 << 20};
+    static constexpr size_t DEFAULT_SOUND_CACHE_BUDGET{32 << 20};
+
+
+    static void _logCacheStatistics(AssetCache &cache)
+    {
+        auto stats = cache.getStatistics();
+        Logger::verbose() << cache.getAssetTypeName() << " cache: "
+                << stats.hits << " hits (" << stats.revivals << " of idle assets), "
+                << stats.misses << " misses, "
+                << stats.evictions << " evictions";
+    }
+
 
     DbManager::DbManager()
+    : mTextureCache(AssetTraits<Texture>::name(), DEFAULT_TEXTURE_CACHE_BUDGET)
+    , mModelCache(AssetTraits<Model>::name(), DEFAULT_MODEL_CACHE_BUDGET)
+    , mAnimationCache(AssetTraits<Animation>::name(), DEFAULT_ANIMATION_CACHE_BUDGET)
+    , mSoundCache(AssetTraits<Sound>::name(), DEFAULT_SOUND_CACHE_BUDGET)
     {
     }
 
     DbManager::~DbManager()
     {
+        _logCacheStatistics(mTextureCache);
+        _logCacheStatistics(mModelCache);
+        _logCacheStatistics(mAnimationCache);
+        _logCacheStatistics(mSoundCache);
     }
 
     std::shared_ptr<Database> DbManager::loadDatabase(const od::FilePath &dbFilePath, size_t dependencyDepth)
@@ -45,7 +70,12 @@ namespace odDb
         auto newGlobalIndex = mNextGlobalIndex++;
 
         auto db = std::make_shared<Database>(dbFilePath, *this, newGlobalIndex);
-        mLoadedDatabases[newGlobalIndex] = db;
+
+        {
+            std::lock_guard<std::mutex> lock(mLoadedDatabasesMutex);
+            mLoadedDatabases[newGlobalIndex] = db;
+        }
+
         db->getDependencyTable()->setSelfRefDatabase(db);
         db->loadDbFileAndDependencies(dependencyDepth);
 
@@ -54,6 +84,8 @@ namespace odDb
 
     std::shared_ptr<Database> DbManager::getDatabaseByPath(const od::FilePath &dbFilePath)
     {
+        std::lock_guard<std::mutex> lock(mLoadedDatabasesMutex);
+
     	for(auto &weakDb : mLoadedDatabases)
         {
             auto db = weakDb.second.lock();
@@ -68,11 +100,16 @@ namespace odDb
 
     std::shared_ptr<Database> DbManager::getDatabaseByGlobalIndex(GlobalDatabaseIndex index)
     {
-        return mLoadedDatabases[index].lock();
+        std::lock_guard<std::mutex> lock(mLoadedDatabasesMutex);
+
+        auto it = mLoadedDatabases.find(index);
+        return (it != mLoadedDatabases.end()) ? it->second.lock() : nullptr;
     }
 
     size_t DbManager::getLoadedDatabaseCount() const
     {
+        std::lock_guard<std::mutex> lock(mLoadedDatabasesMutex);
+
         size_t count = 0;
 
         for(auto &weakDb : mLoadedDatabases)
@@ -97,6 +97,19 @@ namespace odDb
         }
 	}
 
+	size_t Model::getMemoryUsage() const
+	{
+	    // textures and animations are only referenced and accounted for separately
+	    return sizeof(Model)
+	            + mModelName.capacity()
+	            + mVertices.capacity() * sizeof(glm::vec3)
+	            + mTextureRefs.capacity() * sizeof(AssetRef)
+	            + mPolygons.capacity() * sizeof(Polygon)
+	            + mLodMeshInfos.capacity() * sizeof(LodMeshInfo)
+	            + mAnimationRefs.capacity() * sizeof(AssetRef)
+	            + mModelBounds.capacity() * sizeof(ModelBounds);
+	}
+
 	void Model::_loadNameAndShading(od::DataReader dr)
     {
         dr >> mModelName;
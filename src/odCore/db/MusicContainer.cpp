@@ -8,21 +8,37 @@
 #include <odCore/db/MusicContainer.h>
 
 #include <limits>
+#include <fstream>
 
 #include <odCore/Panic.h>
 #include <odCore/SrscRecordTypes.h>
+#include <odCore/DataStream.h>
 
 #include <odCore/db/Segment.h>
 
 namespace odDb
 {
 
+    static constexpr uint32_t INDEX_MAGIC = 0x494d444f; // 'ODMI' in LE
+    static constexpr uint16_t INDEX_VERSION = 1;
+    static constexpr size_t INDEX_HEADER_SIZE = 4 + 2 + 8 + 4 + 4;
+    static constexpr size_t INDEX_ENTRY_SIZE = 2 + 1 + od::Guid::LENGTH + 4 + 4;
+
+
     MusicContainer::MusicContainer(const od::FilePath &musicContainerFile)
     : mFile(musicContainerFile)
+    , mIndexFile(musicContainerFile.ext(".odmi"))
     , mRrc(musicContainerFile)
+    , mMappedRrc(musicContainerFile)
     {
         Logger::info() << "Loading music container " << mFile;
-        _buildIndex();
+
+        if(!_loadIndex())
+        {
+            Logger::verbose() << "No valid music index found. Building it from container";
+            _buildIndex();
+            _writeIndex();
+        }
     }
 
     od::RecordId MusicContainer::getDlsRecordByGuid(const od::Guid &guid)
@@ -33,13 +49,33 @@ namespace odDb
             OD_PANIC() << "No DLS with given GUID " << guid << " found";
         }
 
-        return it->second;
+        return mIndex[it->second].recordId;
+    }
+
+    MusicContainer::RecordData MusicContainer::getDlsData(const od::Guid &guid)
+    {
+        auto it = mDlsGuidMap.find(guid);
+        if(it == mDlsGuidMap.end())
+        {
+            OD_PANIC() << "No DLS with given GUID " << guid << " found";
+        }
+
+        return _getRecordData(mIndex[it->second]);
     }
 
-    od::SrscFile::RecordInputCursor MusicContainer::getCursorForDls(const od::Guid &guid)
+    std::vector<MusicContainer::MusicId> MusicContainer::getMusicIds() const
     {
-        od::RecordId id = getDlsRecordByGuid(guid);
-        return mRrc.getFirstRecordOfTypeId(od::SrscRecordType::MUSIC, id);
+        std::vector<MusicId> ids;
+        ids.reserve(mSegmentMap.size());
+        for(auto &entry : mIndex)
+        {
+            if(entry.kind == RecordKind::Segment)
+            {
+                ids.push_back(entry.recordId);
+            }
+        }
+
+        return ids;
     }
 
     std::shared_ptr<Segment> MusicContainer::loadSegment(MusicId id)
@@ -49,43 +85,209 @@ namespace odDb
             OD_PANIC() << "Music ID out of record ID limits: " << id;
         }
 
-        auto cursor = mRrc.getFirstRecordOfTypeId(od::SrscRecordType::MUSIC, static_cast<od::RecordId>(id));
-        if(!cursor.isValid())
+        auto cached = mSegmentCache.find(id);
+        if(cached != mSegmentCache.end())
+        {
+            return cached->second;
+        }
+
+        auto it = mSegmentMap.find(id);
+        if(it == mSegmentMap.end())
         {
             OD_PANIC() << "Music with ID " << id << " not found";
         }
 
         Logger::verbose() << "Loading music segment " << std::hex << id << std::dec;
 
-        od::RiffReader rr(cursor.getReader());
+        RecordData recordData = _getRecordData(mIndex[it->second]);
+        od::MemoryInputBuffer buffer(recordData.data, recordData.size);
+        std::istream in(&buffer);
+        od::RiffReader rr{od::DataReader(in)};
         auto segment = std::make_shared<Segment>(rr);
+
+        mSegmentCache.insert(std::make_pair(id, segment));
+
         return segment;
     }
 
+    uint32_t MusicContainer::getSegmentDataHash(MusicId id) const
+    {
+        auto it = mSegmentMap.find(id);
+        if(it == mSegmentMap.end())
+        {
+            OD_PANIC() << "Music with ID " << id << " not found";
+        }
+
+        // FNV-1a over the raw record
+        RecordData recordData = _getRecordData(mIndex[it->second]);
+        uint32_t hash = 2166136261u;
+        for(size_t i = 0; i < recordData.size; ++i)
+        {
+            hash ^= static_cast<uint8_t>(recordData.data[i]);
+            hash *= 16777619u;
+        }
+
+        return hash;
+    }
+
+    bool MusicContainer::_loadIndex()
+    {
+        std::ifstream in(mIndexFile.str(), std::ios::in | std::ios::binary);
+        if(in.fail())
+        {
+            return false;
+        }
+
+        // DataReader panics on EOF, so check the size before parsing anything
+        in.seekg(0, std::ios::end);
+        size_t fileSize = in.tellg();
+        in.seekg(0);
+        if(fileSize < INDEX_HEADER_SIZE)
+        {
+            return false;
+        }
+
+        od::DataReader dr(in);
+
+        uint32_t magic;
+        uint16_t version;
+        uint64_t containerSize;
+        uint32_t directoryHash;
+        uint32_t entryCount;
+        dr >> magic
+           >> version
+           >> containerSize
+           >> directoryHash
+           >> entryCount;
+
+        if(magic != INDEX_MAGIC || version != INDEX_VERSION)
+        {
+            return false;
+        }
+
+        if(containerSize != mMappedRrc.size() || directoryHash != _getDirectoryHash())
+        {
+            Logger::verbose() << "Music index " << mIndexFile << " is outdated";
+            return false;
+        }
+
+        if(fileSize != INDEX_HEADER_SIZE + entryCount*INDEX_ENTRY_SIZE)
+        {
+            return false;
+        }
+
+        mIndex.resize(entryCount);
+        for(auto &entry : mIndex)
+        {
+            uint8_t kind;
+            dr >> entry.recordId
+               >> kind;
+            dr.read(entry.guid.data.data(), od::Guid::LENGTH);
+            dr >> entry.dataOffset
+               >> entry.dataSize;
+
+            if(static_cast<size_t>(entry.dataOffset) + entry.dataSize > mMappedRrc.size())
+            {
+                Logger::warn() << "Music index " << mIndexFile << " points outside of container. Rebuilding";
+                mIndex.clear();
+                return false;
+            }
+
+            entry.kind = static_cast<RecordKind>(kind);
+        }
+
+        mDlsGuidMap.clear();
+        mSegmentMap.clear();
+        for(auto &entry : mIndex)
+        {
+            _insertIntoMaps(entry);
+        }
+
+        Logger::verbose() << "Loaded music index " << mIndexFile << " (" << mDlsGuidMap.size() << " DLS, " << mSegmentMap.size() << " segments)";
+
+        return true;
+    }
+
+    void MusicContainer::_writeIndex()
+    {
+        std::ofstream out(mIndexFile.str(), std::ios::out | std::ios::binary | std::ios::trunc);
+        if(out.fail())
+        {
+            Logger::warn() << "Could not write music index " << mIndexFile << ". Index will be rebuilt next time";
+            return;
+        }
+
+        od::DataWriter dw(out);
+        dw << INDEX_MAGIC
+           << INDEX_VERSION
+           << static_cast<uint64_t>(mMappedRrc.size())
+           << _getDirectoryHash()
+           << static_cast<uint32_t>(mIndex.size());
+
+        for(auto &entry : mIndex)
+        {
+            dw << entry.recordId
+               << static_cast<uint8_t>(entry.kind);
+            dw.write(entry.guid.data.data(), od::Guid::LENGTH);
+            dw << entry.dataOffset
+               << entry.dataSize;
+        }
+    }
+
     void MusicContainer::_buildIndex()
     {
-        auto cursor = mRrc.getFirstRecordOfType(od::SrscRecordType::MUSIC);
-        while(cursor.isValid())
+        mIndex.clear();
+        mDlsGuidMap.clear();
+        mSegmentMap.clear();
+
+        for(auto &dirEntry : mRrc.getDirectory())
         {
-            auto readerOption = od::RiffReader::create(cursor.getReader());
+            if(dirEntry.type != static_cast<od::RecordType>(od::SrscRecordType::MUSIC))
+            {
+                continue;
+            }
+
+            if(static_cast<size_t>(dirEntry.dataOffset) + dirEntry.dataSize > mMappedRrc.size())
+            {
+                Logger::warn() << "Music record " << std::hex << dirEntry.recordId << std::dec << " exceeds container bounds. Ignoring";
+                continue;
+            }
+
+            IndexEntry entry;
+            entry.recordId = dirEntry.recordId;
+            entry.kind = RecordKind::Unknown;
+            entry.guid = od::Guid();
+            entry.guid.data.fill(0);
+            entry.dataOffset = dirEntry.dataOffset;
+            entry.dataSize = dirEntry.dataSize;
+
+            RecordData recordData = _getRecordData(entry);
+            od::MemoryInputBuffer buffer(recordData.data, recordData.size);
+            std::istream in(&buffer);
+            auto readerOption = od::RiffReader::create(od::DataReader(in));
             if(readerOption.has_value())
             {
                 auto &riffReader = *readerOption;
                 if(riffReader.getListId() == "DLS ")
                 {
-                    _addDlsToIndex(riffReader, cursor.getDirIterator()->recordId);
+                    _addDlsToIndex(riffReader, entry);
 
                 }else if(riffReader.getListId() == "DMSG")
                 {
-                    _addSegmentToIndex(riffReader, cursor.getDirIterator()->recordId);
+                    // segments are parsed lazily in loadSegment()
+                    entry.kind = RecordKind::Segment;
                 }
             }
 
-            cursor.nextOfType(od::SrscRecordType::MUSIC);
+            if(entry.kind != RecordKind::Unknown)
+            {
+                mIndex.push_back(entry);
+                _insertIntoMaps(mIndex.back());
+            }
         }
     }
 
-    void MusicContainer::_addDlsToIndex(od::RiffReader rr, od::RecordId id)
+    void MusicContainer::_addDlsToIndex(od::RiffReader rr, IndexEntry &entry)
     {
         rr.skipToFirstSubchunk();
 
@@ -143,7 +345,8 @@ namespace odDb
                 return;
             }
 
-            mDlsGuidMap[dlid] = id;
+            entry.kind = RecordKind::Dls;
+            entry.guid = dlid;
             Logger::verbose() << "Added DLS with GUID=" << dlid << " and name '" << name << "' to index";
 
         }else if(!gotDlid)
@@ -156,9 +359,56 @@ namespace odDb
         }
     }
 
-    void MusicContainer::_addSegmentToIndex(od::RiffReader rr, od::RecordId id)
+    void MusicContainer::_insertIntoMaps(const IndexEntry &entry)
+    {
+        size_t index = &entry - mIndex.data();
+
+        switch(entry.kind)
+        {
+        case RecordKind::Dls:
+            mDlsGuidMap.insert(std::make_pair(entry.guid, index));
+            break;
+
+        case RecordKind::Segment:
+            // like getFirstRecordOfTypeId() did, the first record with a given ID wins
+            mSegmentMap.insert(std::make_pair(entry.recordId, index));
+            break;
+
+        default:
+            break;
+        }
+    }
+
+    uint32_t MusicContainer::_getDirectoryHash() const
+    {
+        // FNV-1a over the parts of the directory that determine where our records are
+        uint32_t hash = 2166136261u;
+        auto feed = [&hash](uint32_t value)
+        {
+            for(size_t i = 0; i < 4; ++i)
+            {
+                hash ^= (value >> (i*8)) & 0xff;
+                hash *= 16777619u;
+            }
+        };
+
+        for(auto &dirEntry : mRrc.getDirectory())
+        {
+            feed(dirEntry.type);
+            feed(dirEntry.recordId);
+            feed(dirEntry.dataOffset);
+            feed(dirEntry.dataSize);
+        }
+
+        return hash;
+    }
+
+    MusicContainer::RecordData MusicContainer::_getRecordData(const IndexEntry &entry) const
     {
-        //Segment segment(rr);
+        RecordData data;
+        data.data = mMappedRrc.data() + entry.dataOffset;
+        data.size = entry.dataSize;
+        return data;
     }
 
 }
@@ -9,6 +9,7 @@
 
 #include <memory>
 #include <cmath>
+#include <algorithm>
 
 #include <odCore/Panic.h>
 #include <odCore/ZStream.h>
@@ -19,6 +20,62 @@
 namespace odDb
 {
 
+    const size_t Sound::StreamingThreshold = (1 << 20);
+
+
+    Sound::Decoder::Decoder(const Sound &sound, size_t chunkSize)
+    : mSound(sound)
+    , mChunkSize(std::min(chunkSize, sound.getDecompressedSize()))
+    , mMemoryBuffer(reinterpret_cast<const char*>(sound.getStoredData().data()), sound.getStoredData().size())
+    , mRecordStream(&mMemoryBuffer)
+    , mBytesDecoded(0)
+    {
+        mRecordStream.exceptions(std::ios_base::badbit);
+
+        rewind();
+    }
+
+    size_t Sound::Decoder::read(uint8_t *data, size_t size)
+    {
+        size_t bytesLeft = mSound.getDecompressedSize() - mBytesDecoded;
+        size = std::min(size, bytesLeft);
+        if(size == 0)
+        {
+            return 0;
+        }
+
+        od::DataReader dr(mRecordStream);
+        if(mZStream != nullptr)
+        {
+            dr.setStream(*mZStream);
+        }
+
+        dr.read(reinterpret_cast<char*>(data), size);
+        mBytesDecoded += size;
+
+        return size;
+    }
+
+    void Sound::Decoder::rewind()
+    {
+        mRecordStream.clear();
+        mRecordStream.seekg(0);
+        mBytesDecoded = 0;
+
+        if(mSound.isCompressed())
+        {
+            // the output buffer only needs to hold one chunk, and since the input is already in memory,
+            //  there is no use in buffering more of it than we need to produce that chunk
+            size_t inputBufferSize = std::min(mChunkSize, mSound.getStoredData().size());
+            mZStream = std::make_unique<od::ZStream>(mRecordStream, std::max(inputBufferSize, size_t(1)), std::max(mChunkSize, size_t(1)));
+
+        }else
+        {
+            mZStream = nullptr;
+        }
+    }
+
+
 	Sound::Sound()
 	: mSoundName("")
 	, mFlags(0)
@@ -68,17 +125,17 @@ namespace odDb
         	OD_PANIC() << "Unsupported bit count per sample " << mBits;
         }
 
-        std::unique_ptr<od::ZStream> zstr;
-        od::DataReader sampleReader(dr);
-        if(mCompressionLevel != 0)
-        {
-            size_t outputBufferSize = std::min(od::ZStreamBuffer::DefaultBufferSize, (size_t)mDecompressedSize);
-            zstr = std::make_unique<od::ZStream>(dr.getStream(), compressedSize, outputBufferSize);
-            sampleReader.setStream(*zstr);
-        }
+        // we don't inflate the sample data here. keeping only the compressed record data around and decoding it
+        //  when it is needed (all at once for uploading or in chunks for streaming) saves us from holding
+        //  sounds in memory uncompressed while the sound system keeps it's own copy.
+        size_t storedSize = (mCompressionLevel != 0) ? compressedSize : mDecompressedSize;
+        mStoredData.resize(storedSize);
+        dr.read(reinterpret_cast<char*>(mStoredData.data()), storedSize);
+    }
 
-        mDataBuffer.resize(mDecompressedSize);
-        sampleReader.read(reinterpret_cast<char*>(mDataBuffer.data()), mDecompressedSize);
+    size_t Sound::getMemoryUsage() const
+    {
+        return sizeof(Sound) + mSoundName.capacity() + mStoredData.capacity();
     }
 
     float Sound::getLinearGain() const
@@ -86,4 +143,18 @@ namespace odDb
         return std::pow(10.0f, mVolume/2000.0f);
     }
 
+    std::vector<uint8_t> Sound::decodeAll() const
+    {
+        std::vector<uint8_t> data(mDecompressedSize);
+
+        Decoder decoder(*this);
+        size_t decodedSize = decoder.read(data.data(), data.size());
+        if(decodedSize != data.size())
+        {
+            OD_PANIC() << "Sound '" << mSoundName << "' decoded to less bytes than indicated by it's header";
+        }
+
+        return data;
+    }
+
 }
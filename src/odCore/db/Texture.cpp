@@ -113,6 +113,13 @@ namespace odDb
         }
     }
 
+    size_t Texture::getMemoryUsage() const
+    {
+        // animation frames and the material are assets of their own, so they don't count here
+        size_t pixelBytes = (mRgba8888Data != nullptr) ? mWidth*mHeight*4 : 0;
+        return sizeof(Texture) + pixelBytes;
+    }
+
     void Texture::_loadFromRecord(od::DataReader &dr)
     {
         Logger::debug() << "Loading texture " << std::hex << this->getAssetId() << std::dec;
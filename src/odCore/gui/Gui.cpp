@@ -28,8 +28,8 @@ namespace odGui
     Gui::Gui(odRender::Renderer &renderer, odInput::InputManager &inputManager)
     : mRenderer(renderer)
     , mMenuMode(false)
-    , mMeasurementsDirty(false)
-    , mNeedsFlattening(false)
+    , mQuadBatcher(renderer)
+    , mHitTestGridStale(true)
     {
         _setupGui();
 
@@ -47,6 +47,8 @@ namespace odGui
 
     void Gui::keyDown(odInput::Key key)
     {
+        std::lock_guard<std::recursive_mutex> lock(mMutex);
+
         if(key == odInput::Key::Mouse_Left)
         {
             if(!mMenuMode)
@@ -54,8 +56,7 @@ namespace odGui
                 return;
             }
 
-            mCurrentHitWidgets.clear();
-            mRootWidget->intersect(mCursorPos, mCurrentHitWidgets);
+            _intersectWithCursor();
 
             Logger::debug() << "Hit " << mCurrentHitWidgets.size() << " widgets!";
 
@@ -68,6 +69,8 @@ namespace odGui
 
     void Gui::addWidget(std::shared_ptr<Widget> widget)
     {
+        std::lock_guard<std::recursive_mutex> lock(mMutex);
+
         if(widget != nullptr)
         {
             mRootWidget->addChild(widget);
@@ -76,6 +79,8 @@ namespace odGui
 
     void Gui::removeWidget(std::shared_ptr<Widget> widget)
     {
+        std::lock_guard<std::recursive_mutex> lock(mMutex);
+
         if(widget != nullptr)
         {
             mRootWidget->removeChild(widget);
@@ -84,6 +89,8 @@ namespace odGui
 
     void Gui::setMenuMode(bool b)
     {
+        std::lock_guard<std::recursive_mutex> lock(mMutex);
+
         mMenuMode = b;
 
         if(mCursorWidget != nullptr)
@@ -96,6 +103,8 @@ namespace odGui
 
     void Gui::setCursorWidget(std::shared_ptr<Widget> cursor)
     {
+        std::lock_guard<std::recursive_mutex> lock(mMutex);
+
         if(mCursorWidget != nullptr)
         {
             this->removeWidget(mCursorWidget);
@@ -115,6 +124,8 @@ namespace odGui
 
     void Gui::setCursorPosition(const glm::vec2 &pos)
     {
+        std::lock_guard<std::recursive_mutex> lock(mMutex);
+
         if(mCursorPos == pos)
         {
             // no change -> no need to perform costly update
@@ -139,8 +150,7 @@ namespace odGui
         //  that are unique in that list were either entered or left by the cursor. which one of those events
         //  happened can be determined from the mouse-over state that is stored in those widgets.
         //  FIXME: this only works if every widget in the scenegraph is unique
-        mCurrentHitWidgets.clear();
-        mRootWidget->intersect(mCursorPos, mCurrentHitWidgets);
+        _intersectWithCursor();
 
         mJoinedHitWidgets.clear();
         mJoinedHitWidgets.insert(mJoinedHitWidgets.end(), mCurrentHitWidgets.begin(), mCurrentHitWidgets.end());
@@ -187,29 +197,39 @@ namespace odGui
 
     void Gui::rebuild()
     {
-        if(mMeasurementsDirty)
-        {
-            mRootWidget->measure(mRenderer.getFramebufferDimensions());
-            mMeasurementsDirty = false;
-        }
+        std::lock_guard<std::recursive_mutex> lock(mMutex);
 
-        if(mNeedsFlattening)
+        mRootWidget->rebuild(mRenderer.getFramebufferDimensions());
+
+        if(mHitTestGridStale)
         {
-            mRootWidget->flatten();
-            mNeedsFlattening = false;
+            mHitTestGrid.rebuild(*mRootWidget);
+            mHitTestGridStale = false;
         }
+
+        mQuadBatcher.sync();
     }
 
     void Gui::onUpdate(float relTime)
     {
-        rebuild();
+        {
+            std::lock_guard<std::recursive_mutex> lock(mMutex);
 
-        mRootWidget->update(relTime);
+            rebuild();
+
+            mRootWidget->update(relTime);
+        }
+
+        // only uses the quad state copied by rebuild(), so the simulation may change widgets again in the meantime
+        mQuadBatcher.update();
     }
 
     void Gui::onFramebufferResize(glm::vec2 dimensionsPx)
     {
-        mRootWidget->measure(dimensionsPx);
+        std::lock_guard<std::recursive_mutex> lock(mMutex);
+
+        // the new dimensions will be picked up during the next rebuild
+        mRootWidget->_markDirty(true);
     }
 
     void Gui::_setupGui()
@@ -219,4 +239,17 @@ namespace odGui
         mRootWidget->setZPosition(0.5);
     }
 
+    void Gui::_intersectWithCursor()
+    {
+        if(mHitTestGridStale)
+        {
+            mRootWidget->rebuild(mRenderer.getFramebufferDimensions());
+            mHitTestGrid.rebuild(*mRootWidget);
+            mHitTestGridStale = false;
+        }
+
+        mCurrentHitWidgets.clear();
+        mHitTestGrid.intersect(mCursorPos, mCurrentHitWidgets);
+    }
+
 }
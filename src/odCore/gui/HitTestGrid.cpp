@@ -0,0 +1,156 @@
+/*
+ * HitTestGrid.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: zal
+ */
+
+#include <odCore/gui/HitTestGrid.h>
+
+#include <algorithm>
+#include <cmath>
+
+#include <glm/vec4.hpp>
+#include <glm/mat4x4.hpp>
+
+#include <odCore/gui/Widget.h>
+
+namespace odGui
+{
+
+    HitTestGrid::HitTestGrid()
+    : mQueryNumber(0)
+    {
+    }
+
+    void HitTestGrid::rebuild(Widget &root)
+    {
+        for(auto &cell : mCells)
+        {
+            cell.clear();
+        }
+
+        size_t nextOrder = 0;
+        _insertRecursive(root, nextOrder);
+    }
+
+    void HitTestGrid::update(Widget &widget)
+    {
+        if(!widget.mInHitTestGrid)
+        {
+            return;
+        }
+
+        int x0 = _toCellIndex(widget.mBoundsMinInGuiSpace.x);
+        int y0 = _toCellIndex(widget.mBoundsMinInGuiSpace.y);
+        int x1 = _toCellIndex(widget.mBoundsMaxInGuiSpace.x);
+        int y1 = _toCellIndex(widget.mBoundsMaxInGuiSpace.y);
+        auto &cells = widget.mHitTestCells;
+        if(cells[0] == x0 && cells[1] == y0 && cells[2] == x1 && cells[3] == y1)
+        {
+            return; // most moves (like the cursor's) stay within the same cells
+        }
+
+        _remove(widget);
+        _insert(widget);
+    }
+
+    void HitTestGrid::intersect(const glm::vec2 &pointInGuiSpace, std::vector<HitWidgetInfo> &hitWidgets)
+    {
+        ++mQueryNumber;
+
+        // points outside the screen land in the border cells, which contain all widgets extending beyond the screen
+        Cell &cell = _getCell(_toCellIndex(pointInGuiSpace.x), _toCellIndex(pointInGuiSpace.y));
+        for(auto &entry : cell)
+        {
+            Widget &widget = *entry.widget;
+
+            // entries are in tree order, so if the parent could be hit at all, it has been checked already
+            Widget *parent = widget.mParentWidget;
+            bool parentHit = (parent == nullptr) || (parent->mHitTestQuery == mQueryNumber && parent->mHitTestResult);
+
+            widget.mHitTestQuery = mQueryNumber;
+            widget.mHitTestResult = false;
+
+            if(!parentHit)
+            {
+                continue;
+            }
+
+            glm::vec2 pointInWidget(widget.mGuiSpaceToMySpace * glm::vec4(pointInGuiSpace, 0.0, 1.0));
+            if(widget.liesWithinLogicalArea(pointInWidget))
+            {
+                widget.mHitTestResult = true;
+
+                HitWidgetInfo info;
+                info.hitPointInWidget = pointInWidget;
+                info.widget = &widget;
+                hitWidgets.push_back(info);
+            }
+        }
+    }
+
+    void HitTestGrid::_insertRecursive(Widget &widget, size_t &nextOrder)
+    {
+        widget.mHitTestOrder = nextOrder++;
+        widget.mHitTestQuery = 0;
+        _insert(widget);
+
+        for(auto &child : widget.mChildWidgets)
+        {
+            _insertRecursive(*child, nextOrder);
+        }
+    }
+
+    void HitTestGrid::_insert(Widget &widget)
+    {
+        auto &cells = widget.mHitTestCells;
+        cells[0] = _toCellIndex(widget.mBoundsMinInGuiSpace.x);
+        cells[1] = _toCellIndex(widget.mBoundsMinInGuiSpace.y);
+        cells[2] = _toCellIndex(widget.mBoundsMaxInGuiSpace.x);
+        cells[3] = _toCellIndex(widget.mBoundsMaxInGuiSpace.y);
+
+        Entry entry{widget.mHitTestOrder, &widget};
+        auto pred = [](const Entry &a, const Entry &b){ return a.order < b.order; };
+        for(int y = cells[1]; y <= cells[3]; ++y)
+        {
+            for(int x = cells[0]; x <= cells[2]; ++x)
+            {
+                Cell &cell = _getCell(x, y);
+                cell.insert(std::upper_bound(cell.begin(), cell.end(), entry, pred), entry);
+            }
+        }
+
+        widget.mInHitTestGrid = true;
+    }
+
+    void HitTestGrid::_remove(Widget &widget)
+    {
+        auto &cells = widget.mHitTestCells;
+        for(int y = cells[1]; y <= cells[3]; ++y)
+        {
+            for(int x = cells[0]; x <= cells[2]; ++x)
+            {
+                Cell &cell = _getCell(x, y);
+                auto it = std::find_if(cell.begin(), cell.end(), [&widget](const Entry &e){ return e.widget == &widget; });
+                if(it != cell.end())
+                {
+                    cell.erase(it);
+                }
+            }
+        }
+
+        widget.mInHitTestGrid = false;
+    }
+
+    int HitTestGrid::_toCellIndex(float coord)
+    {
+        if(!(coord > 0.0f)) // also catches NaN from degenerate widgets
+        {
+            return 0;
+        }
+
+        return std::min(static_cast<int>(coord * CELLS_PER_AXIS), CELLS_PER_AXIS - 1);
+    }
+
+}
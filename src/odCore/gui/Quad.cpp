@@ -23,88 +23,113 @@ namespace odGui
         init(renderer);
     }
 
-    void Quad::init(odRender::Renderer &renderer)
+    std::shared_ptr<odRender::Handle> Quad::getHandle()
     {
-        if(!empty()) return;
+        _check();
 
-        mHandle = renderer.createHandle(odRender::RenderSpace::NONE);
+        if(mHandle == nullptr)
+        {
+            _createHandle();
+        }
 
-        mHandle->setRenderBin(odRender::RenderBin::TRANSPARENT);
+        return mHandle;
+    }
 
-        mModel = renderer.createModel();
-        mHandle->setModel(mModel);
+    std::shared_ptr<odRender::Model> Quad::getModel()
+    {
+        _check();
 
-        // vertex order is top-left, bottom-left, bottom-right, top-right
-        //  this allows us to use glDrawArrays using a triangle fan, minimizing memory usage
-        mGeometry = renderer.createGeometry(odRender::PrimitiveType::TRIANGLE_FAN, false);
-        mModel->addGeometry(mGeometry);
+        if(mHandle == nullptr)
+        {
+            _createHandle();
+        }
 
-        odRender::ArrayAccessor<glm::vec3>(mGeometry->getVertexArrayAccessHandler(), odRender::ArrayAccessMode::REPLACE).resize(4);
-        odRender::ArrayAccessor<glm::vec2>(mGeometry->getTextureCoordArrayAccessHandler(), odRender::ArrayAccessMode::REPLACE).resize(4);
-        odRender::ArrayAccessor<glm::vec4>(mGeometry->getColorArrayAccessHandler(), odRender::ArrayAccessMode::REPLACE).resize(4);
+        return mModel;
+    }
+
+    std::shared_ptr<odRender::Geometry> Quad::getGeometry()
+    {
+        _check();
+
+        if(mHandle == nullptr)
+        {
+            _createHandle();
+        }
 
-        setVertexCoords({0.0, 0.0}, {1.0, 1.0});
-        setTextureCoords({0.0, 0.0}, {1.0, 1.0});
-        setColor({1.0, 1.0, 1.0, 1.0});
+        return mGeometry;
+    }
+
+    void Quad::init(odRender::Renderer &renderer)
+    {
+        if(!empty()) return;
+
+        mData = std::make_shared<Data>();
+        mData->renderer = &renderer;
+        mData->vertexTopLeft = {0.0, 0.0};
+        mData->vertexBottomRight = {1.0, 1.0};
+        mData->uvTopLeft = {0.0, 0.0};
+        mData->uvBottomRight = {1.0, 1.0};
+        mData->color = {1.0, 1.0, 1.0, 1.0};
+        mData->version = 0;
     }
 
     void Quad::setTexture(std::shared_ptr<odRender::Texture> texture)
     {
         _check();
 
-        mTexture = texture;
-        mGeometry->setTexture(texture);
+        mData->texture = texture;
+        ++mData->version;
+
+        if(mGeometry != nullptr)
+        {
+            mGeometry->setTexture(texture);
+        }
     }
 
     void Quad::setTextureCoords(const glm::vec2 &tl, const glm::vec2 &br)
     {
         _check();
 
-        odRender::ArrayAccessor<glm::vec2> uvArray(mGeometry->getTextureCoordArrayAccessHandler(), odRender::ArrayAccessMode::REPLACE);
-        uvArray[0] = { tl.x, tl.y };
-        uvArray[1] = { tl.x, br.y };
-        uvArray[2] = { br.x, br.y };
-        uvArray[3] = { br.x, tl.y };
+        mData->uvTopLeft = tl;
+        mData->uvBottomRight = br;
+        ++mData->version;
+
+        _writeTextureCoords();
     }
 
     void Quad::setTextureCoordsFromPixels(const glm::vec2 &topLeft, const glm::vec2 &bottomRight)
     {
         _check();
 
-        glm::vec2 textureDims = (mTexture != nullptr) ? mTexture->getImage()->getDimensionsUV() : glm::vec2(1.0);
+        glm::vec2 textureDims = (mData->texture != nullptr) ? mData->texture->getImage()->getDimensionsUV() : glm::vec2(1.0);
         glm::vec2 halfPixelOffset(0.5, 0.5);
         glm::vec2 tlNorm = (topLeft + halfPixelOffset) / textureDims;
         glm::vec2 brNorm = (bottomRight + halfPixelOffset) / textureDims;
         tlNorm.y = 1.0 - tlNorm.y;
         brNorm.y = 1.0 - brNorm.y;
 
-        odRender::ArrayAccessor<glm::vec2> uvArray(mGeometry->getTextureCoordArrayAccessHandler(), odRender::ArrayAccessMode::REPLACE);
-        uvArray[0] = { tlNorm.x, tlNorm.y };
-        uvArray[1] = { tlNorm.x, brNorm.y };
-        uvArray[2] = { brNorm.x, brNorm.y };
-        uvArray[3] = { brNorm.x, tlNorm.y };
+        setTextureCoords(tlNorm, brNorm);
     }
 
     void Quad::setVertexCoords(const glm::vec2 &tl, const glm::vec2 &br)
     {
         _check();
 
-        odRender::ArrayAccessor<glm::vec3> vertexArray(mGeometry->getVertexArrayAccessHandler(), odRender::ArrayAccessMode::REPLACE);
-        vertexArray[0] = { tl.x, tl.y, 0.0 };
-        vertexArray[1] = { tl.x, br.y, 0.0 };
-        vertexArray[2] = { br.x, br.y, 0.0 };
-        vertexArray[3] = { br.x, tl.y, 0.0 };
+        mData->vertexTopLeft = tl;
+        mData->vertexBottomRight = br;
+        ++mData->version;
+
+        _writeVertexCoords();
     }
 
     void Quad::setColor(const glm::vec4 &color)
     {
         _check();
 
-        odRender::ArrayAccessor<glm::vec4> colorArray(mGeometry->getColorArrayAccessHandler(), odRender::ArrayAccessMode::REPLACE);
-        colorArray[0] = color;
-        colorArray[1] = color;
-        colorArray[2] = color;
-        colorArray[3] = color;
+        mData->color = color;
+        ++mData->version;
+
+        _writeColor();
     }
 
     void Quad::_check()
@@ -115,4 +140,78 @@ namespace odGui
         }
     }
 
+    void Quad::_createHandle()
+    {
+        auto &renderer = *mData->renderer;
+
+        mHandle = renderer.createHandle(odRender::RenderSpace::NONE);
+
+        mHandle->setRenderBin(odRender::RenderBin::TRANSPARENT);
+
+        mModel = renderer.createModel();
+        mHandle->setModel(mModel);
+
+        // vertex order is top-left, bottom-left, bottom-right, top-right
+        //  this allows us to use glDrawArrays using a triangle fan, minimizing memory usage
+        mGeometry = renderer.createGeometry(odRender::PrimitiveType::TRIANGLE_FAN, false);
+        mModel->addGeometry(mGeometry);
+
+        odRender::ArrayAccessor<glm::vec3>(mGeometry->getVertexArrayAccessHandler(), odRender::ArrayAccessMode::REPLACE).resize(4);
+        odRender::ArrayAccessor<glm::vec2>(mGeometry->getTextureCoordArrayAccessHandler(), odRender::ArrayAccessMode::REPLACE).resize(4);
+        odRender::ArrayAccessor<glm::vec4>(mGeometry->getColorArrayAccessHandler(), odRender::ArrayAccessMode::REPLACE).resize(4);
+
+        mGeometry->setTexture(mData->texture);
+        _writeVertexCoords();
+        _writeTextureCoords();
+        _writeColor();
+    }
+
+    void Quad::_writeVertexCoords()
+    {
+        if(mGeometry == nullptr)
+        {
+            return;
+        }
+
+        auto &tl = mData->vertexTopLeft;
+        auto &br = mData->vertexBottomRight;
+
+        odRender::ArrayAccessor<glm::vec3> vertexArray(mGeometry->getVertexArrayAccessHandler(), odRender::ArrayAccessMode::REPLACE);
+        vertexArray[0] = { tl.x, tl.y, 0.0 };
+        vertexArray[1] = { tl.x, br.y, 0.0 };
+        vertexArray[2] = { br.x, br.y, 0.0 };
+        vertexArray[3] = { br.x, tl.y, 0.0 };
+    }
+
+    void Quad::_writeTextureCoords()
+    {
+        if(mGeometry == nullptr)
+        {
+            return;
+        }
+
+        auto &tl = mData->uvTopLeft;
+        auto &br = mData->uvBottomRight;
+
+        odRender::ArrayAccessor<glm::vec2> uvArray(mGeometry->getTextureCoordArrayAccessHandler(), odRender::ArrayAccessMode::REPLACE);
+        uvArray[0] = { tl.x, tl.y };
+        uvArray[1] = { tl.x, br.y };
+        uvArray[2] = { br.x, br.y };
+        uvArray[3] = { br.x, tl.y };
+    }
+
+    void Quad::_writeColor()
+    {
+        if(mGeometry == nullptr)
+        {
+            return;
+        }
+
+        odRender::ArrayAccessor<glm::vec4> colorArray(mGeometry->getColorArrayAccessHandler(), odRender::ArrayAccessMode::REPLACE);
+        colorArray[0] = mData->color;
+        colorArray[1] = mData->color;
+        colorArray[2] = mData->color;
+        colorArray[3] = mData->color;
+    }
+
 }
@@ -0,0 +1,221 @@
+/*
+ * QuadBatcher.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: zal
+ */
+
+#include <odCore/gui/QuadBatcher.h>
+
+#include <algorithm>
+
+#include <glm/vec4.hpp>
+#include <glm/mat4x4.hpp>
+
+#include <odCore/gui/Widget.h>
+
+#include <odCore/render/Renderer.h>
+#include <odCore/render/Handle.h>
+#include <odCore/render/Model.h>
+#include <odCore/render/Geometry.h>
+
+namespace odGui
+{
+
+    QuadBatcher::QuadBatcher(odRender::Renderer &renderer)
+    : mRenderer(renderer)
+    {
+    }
+
+    QuadBatcher::~QuadBatcher()
+    {
+        for(auto &b : mBatches)
+        {
+            mRenderer.moveToRenderSpace(b.second.handle, odRender::RenderSpace::NONE);
+        }
+    }
+
+    void QuadBatcher::addQuad(Widget &widget, std::shared_ptr<Quad::Data> quad)
+    {
+        if(quad == nullptr)
+        {
+            return;
+        }
+
+        Member member;
+        member.widget = &widget;
+        member.texture = quad->texture;
+        member.seenVersion = quad->version;
+        member.quad = std::move(quad);
+        _markTextureDirty(member.texture);
+        mMembers.push_back(std::move(member));
+    }
+
+    void QuadBatcher::removeQuad(Widget &widget, const std::shared_ptr<Quad::Data> &quad)
+    {
+        auto it = std::find_if(mMembers.begin(), mMembers.end(), [&](const Member &m){ return m.widget == &widget && m.quad == quad; });
+        if(it != mMembers.end())
+        {
+            _markTextureDirty(it->texture);
+            mMembers.erase(it);
+        }
+    }
+
+    void QuadBatcher::removeWidget(Widget &widget)
+    {
+        auto newEnd = std::remove_if(mMembers.begin(), mMembers.end(), [&](const Member &m){ return m.widget == &widget; });
+        for(auto it = newEnd; it != mMembers.end(); ++it)
+        {
+            _markTextureDirty(it->texture);
+        }
+        mMembers.erase(newEnd, mMembers.end());
+    }
+
+    void QuadBatcher::sync()
+    {
+        for(auto &member : mMembers)
+        {
+            if(member.seenVersion != member.quad->version || member.texture != member.quad->texture)
+            {
+                // a quad whose texture changed leaves a gap in it's old batch, too
+                _markTextureDirty(member.texture);
+                member.texture = member.quad->texture;
+                member.seenVersion = member.quad->version;
+                _markTextureDirty(member.texture);
+            }
+        }
+
+        if(mDirtyTextures.empty())
+        {
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(mSyncedBatchesMutex);
+
+        for(auto &texture : mDirtyTextures)
+        {
+            SyncedBatch &synced = mSyncedBatches[texture.first];
+            synced.texture = texture.second;
+            synced.quads.clear();
+        }
+
+        for(auto &member : mMembers)
+        {
+            if(!member.widget->isVisible() || mDirtyTextures.find(member.texture.get()) == mDirtyTextures.end())
+            {
+                continue;
+            }
+
+            const Quad::Data &quad = *member.quad;
+            const glm::mat4 &toGui = member.widget->getMySpaceToGuiSpace();
+
+            const glm::vec2 &tl = quad.vertexTopLeft;
+            const glm::vec2 &br = quad.vertexBottomRight;
+            const glm::vec2 &uvTl = quad.uvTopLeft;
+            const glm::vec2 &uvBr = quad.uvBottomRight;
+
+            QuadState state;
+            state.corners[0] = glm::vec3(toGui * glm::vec4(tl.x, tl.y, 0.0, 1.0));
+            state.corners[1] = glm::vec3(toGui * glm::vec4(tl.x, br.y, 0.0, 1.0));
+            state.corners[2] = glm::vec3(toGui * glm::vec4(br.x, br.y, 0.0, 1.0));
+            state.corners[3] = glm::vec3(toGui * glm::vec4(br.x, tl.y, 0.0, 1.0));
+            state.uvs[0] = { uvTl.x, uvTl.y };
+            state.uvs[1] = { uvTl.x, uvBr.y };
+            state.uvs[2] = { uvBr.x, uvBr.y };
+            state.uvs[3] = { uvBr.x, uvTl.y };
+            state.color = quad.color;
+            state.depth = (toGui * glm::vec4((tl + br) * 0.5f, 0.0, 1.0)).z;
+
+            mSyncedBatches[member.texture.get()].quads.push_back(state);
+        }
+
+        mDirtyTextures.clear();
+    }
+
+    void QuadBatcher::update()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mSyncedBatchesMutex);
+            mBatchesToRebuild.swap(mSyncedBatches);
+        }
+
+        for(auto &synced : mBatchesToRebuild)
+        {
+            auto it = mBatches.find(synced.first);
+            if(synced.second.quads.empty())
+            {
+                if(it != mBatches.end())
+                {
+                    mRenderer.moveToRenderSpace(it->second.handle, odRender::RenderSpace::NONE);
+                    mBatches.erase(it);
+                }
+
+                continue;
+            }
+
+            Batch &batch = (it != mBatches.end()) ? it->second : _getOrCreateBatch(synced.second.texture);
+            _rebuildBatch(batch, synced.second.quads);
+        }
+
+        mBatchesToRebuild.clear();
+    }
+
+    void QuadBatcher::_markTextureDirty(const std::shared_ptr<odRender::Texture> &texture)
+    {
+        mDirtyTextures.insert(std::make_pair(texture.get(), texture));
+    }
+
+    QuadBatcher::Batch &QuadBatcher::_getOrCreateBatch(const std::shared_ptr<odRender::Texture> &texture)
+    {
+        auto it = mBatches.find(texture.get());
+        if(it != mBatches.end())
+        {
+            return it->second;
+        }
+
+        Batch &batch = mBatches[texture.get()];
+
+        batch.handle = mRenderer.createHandle(odRender::RenderSpace::GUI);
+        batch.handle->setRenderBin(odRender::RenderBin::TRANSPARENT);
+
+        batch.model = mRenderer.createModel();
+        batch.handle->setModel(batch.model);
+
+        batch.geometry = mRenderer.createGeometry(odRender::PrimitiveType::TRIANGLES, false);
+        batch.geometry->setTexture(texture);
+        batch.model->addGeometry(batch.geometry);
+
+        return batch;
+    }
+
+    void QuadBatcher::_rebuildBatch(Batch &batch, std::vector<QuadState> &quads)
+    {
+        // sort back to front. the widget space Z axis points into the screen, so greater Z means further back
+        std::stable_sort(quads.begin(), quads.end(), [](const QuadState &a, const QuadState &b){ return a.depth > b.depth; });
+
+        size_t vertexCount = quads.size() * 6;
+        odRender::ArrayAccessor<glm::vec3> vertexArray(batch.geometry->getVertexArrayAccessHandler(), odRender::ArrayAccessMode::REPLACE);
+        odRender::ArrayAccessor<glm::vec2> uvArray(batch.geometry->getTextureCoordArrayAccessHandler(), odRender::ArrayAccessMode::REPLACE);
+        odRender::ArrayAccessor<glm::vec4> colorArray(batch.geometry->getColorArrayAccessHandler(), odRender::ArrayAccessMode::REPLACE);
+        vertexArray.resize(vertexCount);
+        uvArray.resize(vertexCount);
+        colorArray.resize(vertexCount);
+
+        // the corners are stored in triangle fan order (top-left, bottom-left, bottom-right, top-right), so split
+        //  them into two triangles
+        static const int CORNER_ORDER[6] = { 0, 1, 2, 0, 2, 3 };
+
+        int v = 0;
+        for(auto &quad : quads)
+        {
+            for(int corner : CORNER_ORDER)
+            {
+                vertexArray[v] = quad.corners[corner];
+                uvArray[v] = quad.uvs[corner];
+                colorArray[v] = quad.color;
+                ++v;
+            }
+        }
+    }
+
+}
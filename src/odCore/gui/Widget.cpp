@@ -9,12 +9,15 @@
 
 #include <algorithm>
 
+#include <glm/common.hpp>
 #include <glm/matrix.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 
 #include <odCore/Panic.h>
 
 #include <odCore/gui/Gui.h>
+#include <odCore/gui/QuadBatcher.h>
+#include <odCore/gui/HitTestGrid.h>
 
 #include <odCore/render/Renderer.h>
 #include <odCore/render/Handle.h>
@@ -33,22 +36,36 @@ namespace odGui
     , mVisible(true)
     , mParentWidget(nullptr)
     , mNeedsUpdate(false)
+    , mMeasureDirty(true)
+    , mFlattenDirty(true)
+    , mChildNeedsRebuild(false)
     , mMatrixDirty(true)
+    , mAttachedToGui(false)
     , mMouseOver(false)
+    , mHitTestOrder(0)
+    , mBoundsMinInGuiSpace(0.0, 0.0)
+    , mBoundsMaxInGuiSpace(0.0, 0.0)
+    , mHitTestCells({0, 0, 0, 0})
+    , mInHitTestGrid(false)
+    , mHitTestQuery(0)
+    , mHitTestResult(false)
     {
     }
 
     Widget::~Widget()
     {
+        if(mAttachedToGui && !mQuads.empty())
+        {
+            mGui.mQuadBatcher.removeWidget(*this);
+        }
     }
 
     void Widget::setPosition(const glm::vec2 &pos)
     {
-        // TODO: handle edge cases where we have no children and could directly apply the change from a stored, previously flattened matrix
         mPositionInParentSpace = pos;
         mMatrixDirty = true;
 
-        mGui.markNeedsFlattening();
+        _markDirty(false);
     }
 
     void Widget::setDimensions(const glm::vec2 &dim)
@@ -56,8 +73,7 @@ namespace odGui
         mDimensions = dim;
         mMatrixDirty = true;
 
-        mGui.markMeasurementsDirty();
-        mGui.markNeedsFlattening();
+        _markDirty(true);
     }
 
     void Widget::setDimensions(const glm::vec2 &dim, WidgetDimensionType type)
@@ -66,8 +82,7 @@ namespace odGui
         mDimensionType = type;
         mMatrixDirty = true;
 
-        mGui.markMeasurementsDirty();
-        mGui.markNeedsFlattening();
+        _markDirty(true);
     }
 
     void Widget::setDimensionType(WidgetDimensionType type)
@@ -75,8 +90,7 @@ namespace odGui
         mDimensionType = type;
         mMatrixDirty = true;
 
-        mGui.markMeasurementsDirty();
-        mGui.markNeedsFlattening();
+        _markDirty(true);
     }
 
     void Widget::setOrigin(WidgetOrigin origin)
@@ -84,7 +98,7 @@ namespace odGui
         mOrigin = origin;
         mMatrixDirty = true;
 
-        mGui.markNeedsFlattening();
+        _markDirty(false);
     }
 
     void Widget::setDepth(float d)
@@ -92,7 +106,7 @@ namespace odGui
         mDepthInParentSpace = d;
         mMatrixDirty = true;
 
-        mGui.markNeedsFlattening();
+        _markDirty(false);
     }
 
     void Widget::setZPosition(float z)
@@ -100,7 +114,7 @@ namespace odGui
         mZPositionInParentSpace = z;
         mMatrixDirty = true;
 
-        mGui.markNeedsFlattening();
+        _markDirty(false);
     }
 
     bool Widget::liesWithinLogicalArea(const glm::vec2 &pos)
@@ -136,8 +150,8 @@ namespace odGui
         mChildWidgets.push_back(w);
         w->mParentWidget = this;
 
-        mGui.markMeasurementsDirty();
-        mGui.markNeedsFlattening();
+        w->_markDirty(true);
+        mGui.mHitTestGridStale = true;
     }
 
     void Widget::removeChild(std::shared_ptr<Widget> w)
@@ -148,11 +162,12 @@ namespace odGui
         if(it != mChildWidgets.end())
         {
             w->mParentWidget = nullptr;
-            w->_moveToNoneRenderSpaceRecursive();
+            w->_detachRecursive();
             mChildWidgets.erase(it);
-        }
 
-        // removing a widget from the tree does not invalidate the flattened hierarchy!
+            // removing a widget from the tree does not invalidate the flattened hierarchy, but the tree order of the grid
+            mGui.mHitTestGridStale = true;
+        }
     }
 
     void Widget::addRenderHandle(std::shared_ptr<odRender::Handle> r)
@@ -164,6 +179,8 @@ namespace odGui
             // create without renderspace. will be moved to GUI space once encountered during flattening
             mRenderGroup = mGui.getRenderer().createGroup(odRender::RenderSpace::NONE);
             mRenderGroup->setVisible(mVisible);
+
+            _markDirty(false);
         }
 
         mRenderGroup->addHandle(r);
@@ -179,6 +196,38 @@ namespace odGui
         }
     }
 
+    void Widget::addQuad(const Quad &quad)
+    {
+        auto data = quad.getData();
+        if(data == nullptr)
+        {
+            OD_PANIC() << "Tried to add empty Quad to Widget";
+        }
+
+        mQuads.push_back(data);
+
+        // if we are not attached yet, the quads get added to the batcher once we are
+        if(mAttachedToGui)
+        {
+            mGui.mQuadBatcher.addQuad(*this, data);
+        }
+    }
+
+    void Widget::removeQuad(const Quad &quad)
+    {
+        auto data = quad.getData();
+        auto it = std::find(mQuads.begin(), mQuads.end(), data);
+        if(it != mQuads.end())
+        {
+            mQuads.erase(it);
+
+            if(mAttachedToGui)
+            {
+                mGui.mQuadBatcher.removeQuad(*this, data);
+            }
+        }
+    }
+
     void Widget::intersect(const glm::vec2 &point, std::vector<HitWidgetInfo> &hitWidgets)
     {
         _intersectRecursive(point, hitWidgets);
@@ -193,6 +242,8 @@ namespace odGui
             mRenderGroup->setVisible(mVisible);
         }
 
+        _bumpQuadVersions();
+
         for(auto &child : mChildWidgets)
         {
             child->setVisible(b);
@@ -225,38 +276,47 @@ namespace odGui
         }
     }
 
-    void Widget::measure(glm::vec2 parentDimensionsPx)
+    void Widget::rebuild(glm::vec2 parentDimensionsPx)
     {
-        switch(mDimensionType)
-        {
-        case WidgetDimensionType::ParentRelative:
-            mMeasuredDimensionsPx = parentDimensionsPx * mDimensions;
-            break;
+        _rebuildRecursive(parentDimensionsPx, glm::mat4(1.0), false, false);
+    }
 
-        case WidgetDimensionType::Pixels:
-            mMeasuredDimensionsPx = mDimensions;
-            break;
-        }
+    void Widget::_markDirty(bool needsMeasure)
+    {
+        mFlattenDirty = true;
+        mMeasureDirty |= needsMeasure;
 
-        for(auto &child : mChildWidgets)
+        // if an ancestor already knows about a dirty child, all ancestors above it do, too
+        Widget *ancestor = mParentWidget;
+        while(ancestor != nullptr && !ancestor->mChildNeedsRebuild)
         {
-            child->measure(mMeasuredDimensionsPx);
+            ancestor->mChildNeedsRebuild = true;
+            ancestor = ancestor->mParentWidget;
         }
     }
 
-    void Widget::flatten()
-    {
-        glm::mat4 m(1.0);
-        _flattenRecursive(m);
-    }
-
-    void Widget::_moveToNoneRenderSpaceRecursive()
+    void Widget::_detachRecursive()
     {
         mGui.getRenderer().moveToRenderSpace(mRenderGroup, odRender::RenderSpace::NONE);
 
+        if(mAttachedToGui && !mQuads.empty())
+        {
+            mGui.mQuadBatcher.removeWidget(*this);
+        }
+
+        mAttachedToGui = false;
+
         for(auto &child : mChildWidgets)
         {
-            child->_moveToNoneRenderSpaceRecursive();
+            child->_detachRecursive();
+        }
+    }
+
+    void Widget::_bumpQuadVersions()
+    {
+        for(auto &quad : mQuads)
+        {
+            ++quad->version;
         }
     }
 
@@ -285,27 +345,80 @@ namespace odGui
         mMatrixDirty = false;
     }
 
-    void Widget::_flattenRecursive(const glm::mat4 &parentToRoot)
+    void Widget::_rebuildRecursive(const glm::vec2 &parentDimensionsPx, const glm::mat4 &parentToGui, bool forceMeasure, bool forceFlatten)
     {
-        if(mMatrixDirty)
+        bool measure = forceMeasure || mMeasureDirty;
+        if(measure)
         {
-            _recalculateMatrix();
+            switch(mDimensionType)
+            {
+            case WidgetDimensionType::ParentRelative:
+                mMeasuredDimensionsPx = parentDimensionsPx * mDimensions;
+                break;
+
+            case WidgetDimensionType::Pixels:
+                mMeasuredDimensionsPx = mDimensions;
+                mMatrixDirty = true; // our size in parent space depends on the parent's measurements
+                break;
+            }
         }
 
-        glm::mat4 thisToRoot = parentToRoot * mMySpaceToParentSpace;
-        if(mRenderGroup != nullptr)
+        bool flatten = forceFlatten || mFlattenDirty || measure;
+        if(flatten)
         {
-            mRenderGroup->setMatrix(thisToRoot);
+            if(mMatrixDirty)
+            {
+                _recalculateMatrix();
+            }
+
+            mMySpaceToGuiSpace = parentToGui * mMySpaceToParentSpace;
+            mGuiSpaceToMySpace = glm::inverse(mMySpaceToGuiSpace);
+
+            glm::vec2 a(mMySpaceToGuiSpace * glm::vec4(0.0, 0.0, 0.0, 1.0));
+            glm::vec2 b(mMySpaceToGuiSpace * glm::vec4(1.0, 1.0, 0.0, 1.0));
+            mBoundsMinInGuiSpace = glm::min(a, b);
+            mBoundsMaxInGuiSpace = glm::max(a, b);
 
-            // if this gets called, we are connected to the root widget and thus
-            //  can move our render group to the GUI space
-            mGui.getRenderer().moveToRenderSpace(mRenderGroup, odRender::RenderSpace::GUI);
+            if(mRenderGroup != nullptr)
+            {
+                mRenderGroup->setMatrix(mMySpaceToGuiSpace);
+
+                // if this gets called, we are connected to the root widget and thus
+                //  can move our render group to the GUI space
+                mGui.getRenderer().moveToRenderSpace(mRenderGroup, odRender::RenderSpace::GUI);
+            }
+
+            if(!mAttachedToGui)
+            {
+                for(auto &quad : mQuads)
+                {
+                    mGui.mQuadBatcher.addQuad(*this, quad);
+                }
+
+                mAttachedToGui = true;
+
+            }else
+            {
+                _bumpQuadVersions();
+            }
+
+            if(!mGui.mHitTestGridStale)
+            {
+                mGui.mHitTestGrid.update(*this);
+            }
         }
 
-        for(auto &child : mChildWidgets)
+        if(measure || flatten || mChildNeedsRebuild)
         {
-            child->_flattenRecursive(thisToRoot);
+            for(auto &child : mChildWidgets)
+            {
+                child->_rebuildRecursive(mMeasuredDimensionsPx, mMySpaceToGuiSpace, measure, flatten);
+            }
         }
+
+        mMeasureDirty = false;
+        mFlattenDirty = false;
+        mChildNeedsRebuild = false;
     }
 
     void Widget::_intersectRecursive(const glm::vec2 &pointInParent, std::vector<HitWidgetInfo> &hitWidgets)
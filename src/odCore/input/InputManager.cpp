@@ -10,6 +10,7 @@
 #include <algorithm>
 
 #include <odCore/Panic.h>
+#include <odCore/Logger.h>
 
 #include <odCore/gui/Gui.h>
 
@@ -20,8 +21,10 @@ namespace odInput
 {
 
     InputManager::InputManager()
-    : mMouseMoved(false)
+    : mDroppedInputEventCount(0)
+    , mCurrentEventTime(Clock::now())
     {
+        mDrainedInputEvents.reserve(INPUT_RING_CAPACITY);
     }
 
     InputManager::~InputManager()
@@ -30,27 +33,37 @@ namespace odInput
 
     void InputManager::injectMouseMovement(float absX, float absY)
     {
-        std::lock_guard<std::mutex> lock(mInputEventQueueMutex);
-        mMouseMoveTarget = {absX, absY};
-        mMouseMoved = true;
+        QueuedInputEvent event;
+        event.type = QueuedInputEvent::Type::MOUSE_MOVE;
+        event.axes = {absX, absY};
+        _queueInputEvent(event);
     }
 
     void InputManager::injectKey(Key key, bool pressed)
     {
-        std::lock_guard<std::mutex> lock(mInputEventQueueMutex);
-        mKeyQueue.push_back(std::make_pair(key, pressed));
+        QueuedInputEvent event;
+        event.type = QueuedInputEvent::Type::KEY;
+        event.key = key;
+        event.pressed = pressed;
+        _queueInputEvent(event);
     }
 
     void InputManager::injectAction(ActionCode actionCode, ActionState state)
     {
-        std::lock_guard<std::mutex> lock(mInputEventQueueMutex);
-        mInjectedActionQueue.push_back(std::make_pair(actionCode, state));
+        QueuedInputEvent event;
+        event.type = QueuedInputEvent::Type::ACTION;
+        event.actionCode = actionCode;
+        event.actionState = state;
+        _queueInputEvent(event);
     }
 
     void InputManager::injectAnalogAction(ActionCode actionCode, const glm::vec2 &axisData)
     {
-        std::lock_guard<std::mutex> lock(mInputEventQueueMutex);
-        mInjectedAnalogActionQueue.push_back(std::make_pair(actionCode, axisData));
+        QueuedInputEvent event;
+        event.type = QueuedInputEvent::Type::ANALOG_ACTION;
+        event.actionCode = actionCode;
+        event.axes = axisData;
+        _queueInputEvent(event);
     }
 
     std::shared_ptr<InputListener> InputManager::createInputListener()
@@ -69,44 +82,72 @@ namespace odInput
 
     void InputManager::update(float relTime)
     {
-        std::lock_guard<std::mutex> lock(mInputEventQueueMutex);
-
-        if(mMouseMoved)
+        size_t droppedCount = mDroppedInputEventCount.exchange(0, std::memory_order_relaxed);
+        if(droppedCount > 0)
         {
-            _processMouseMove(mMouseMoveTarget);
-            mMouseMoved = false;
+            Logger::warn() << "Input event queue overflowed. Dropped " << droppedCount << " input events";
         }
 
-        for(auto &key : mKeyQueue)
+        // take everything out of the ring first. callbacks might inject new events, which we don't want to see until next update
+        mDrainedInputEvents.clear();
+        QueuedInputEvent event;
+        while(mInputEventRing.pop(event))
         {
-            _processKey(key.first, key.second);
+            mDrainedInputEvents.push_back(event);
         }
-        mKeyQueue.clear();
 
-        for(auto &action : mInjectedActionQueue)
+        for(size_t i = 0; i < mDrainedInputEvents.size(); ++i)
         {
-            auto it = mActions.find(action.first);
-            if(it != mActions.end())
-            {
-                _triggerAction(*(it->second), action.second);
-            }
-        }
-        mInjectedActionQueue.clear();
+            auto &e = mDrainedInputEvents[i];
+            mCurrentEventTime = e.time;
 
-        for(auto &analogAction : mInjectedAnalogActionQueue)
-        {
-            auto it = mAnalogActions.find(analogAction.first);
-            if(it != mAnalogActions.end())
+            switch(e.type)
             {
-                _triggerAnalogAction(*(it->second), analogAction.second);
+            case QueuedInputEvent::Type::MOUSE_MOVE:
+                {
+                    // listeners get every sample. analog actions might end up as network messages, so they only get the
+                    //  last one of a series of moves. that still keeps them in order with the surrounding key events
+                    bool lastOfSeries = (i + 1 == mDrainedInputEvents.size()) || (mDrainedInputEvents[i + 1].type != QueuedInputEvent::Type::MOUSE_MOVE);
+                    _processMouseMove(e.axes, lastOfSeries);
+                }
+                break;
+
+            case QueuedInputEvent::Type::KEY:
+                _processKey(e.key, e.pressed);
+                break;
+
+            case QueuedInputEvent::Type::ACTION:
+                {
+                    auto it = mActions.find(e.actionCode);
+                    if(it != mActions.end())
+                    {
+                        _triggerAction(*(it->second), e.actionState);
+                    }
+                }
+                break;
+
+            case QueuedInputEvent::Type::ANALOG_ACTION:
+                {
+                    auto it = mAnalogActions.find(e.actionCode);
+                    if(it != mAnalogActions.end())
+                    {
+                        _triggerAnalogAction(*(it->second), e.axes);
+                    }
+                }
+                break;
             }
         }
-        mInjectedAnalogActionQueue.clear();
     }
 
     void InputManager::_bind(ActionHandleBase &action, Key key)
     {
-        KeyBinding &binding = mKeyBindings[key];
+        size_t slot = _getKeySlot(key);
+        if(slot == 0)
+        {
+            OD_PANIC() << "Can't bind action to key " << static_cast<int>(key);
+        }
+
+        KeyBinding &binding = mKeyBindings[slot];
         for(auto &a : binding.actions)
         {
             if(a == nullptr)
@@ -121,29 +162,13 @@ namespace odInput
 
     void InputManager::_unbind(ActionHandleBase &action, Key key)
     {
-        auto it = mKeyBindings.find(key);
-        if(it == mKeyBindings.end())
-        {
-            return;
-        }
-
-        bool inUse = false;
-        for(auto &a : it->second.actions)
+        for(auto &a : mKeyBindings[_getKeySlot(key)].actions)
         {
             if(a == &action)
             {
                 a = nullptr;
-
-            }else if(a != nullptr)
-            {
-                inUse = true;
             }
         }
-
-        if(!inUse)
-        {
-            mKeyBindings.erase(it);
-        }
     }
 
     void InputManager::_bind(AnalogActionHandleBase &action, AnalogSource source)
@@ -165,10 +190,15 @@ namespace odInput
         }
     }
 
-    void InputManager::_processMouseMove(glm::vec2 pos)
+    void InputManager::_processMouseMove(glm::vec2 pos, bool triggerAnalogActions)
     {
         _forEachInputListener([=](auto listener){ listener.mouseMoveEvent(pos); });
 
+        if(!triggerAnalogActions)
+        {
+            return;
+        }
+
         for(auto analogAction : mAnalogActionsBoundToMousePos)
         {
             glm::vec2 axis = pos;
@@ -181,40 +211,72 @@ namespace odInput
     {
         _forEachInputListener([=](auto listener){ listener.keyEvent(key, pressed); });
 
-        auto it = mKeyBindings.find(key);
-        if(it != mKeyBindings.end())
+        size_t slot = _getKeySlot(key);
+        if(slot == 0)
         {
-            ActionState state;
-            if(pressed)
-            {
-                state = it->second.down ? ActionState::REPEAT : ActionState::BEGIN;
-                it->second.down = true;
+            return;
+        }
 
-            }else
-            {
-                state = ActionState::END;
-                it->second.down = false;
-            }
+        KeyBinding &binding = mKeyBindings[slot];
+
+        ActionState state;
+        if(pressed)
+        {
+            state = binding.down ? ActionState::REPEAT : ActionState::BEGIN;
+            binding.down = true;
 
-            for(auto &boundAction : it->second.actions)
+        }else
+        {
+            state = ActionState::END;
+            binding.down = false;
+        }
+
+        for(auto &boundAction : binding.actions)
+        {
+            if(boundAction != nullptr)
             {
-                if(boundAction != nullptr)
+                if(state == ActionState::REPEAT && !boundAction->isRepeatable())
                 {
-                    if(state == ActionState::REPEAT && !boundAction->isRepeatable())
-                    {
-                        continue;
-
-                    }else if(state == ActionState::END && boundAction->ignoresUpEvents())
-                    {
-                        continue;
-                    }
+                    continue;
 
-                    _triggerAction(*boundAction, state);
+                }else if(state == ActionState::END && boundAction->ignoresUpEvents())
+                {
+                    continue;
                 }
+
+                _triggerAction(*boundAction, state);
             }
         }
     }
 
+    size_t InputManager::_getKeySlot(Key key)
+    {
+        // slot 0 (Key::Unknown) collects everything we can't map. nothing can be bound to it
+        auto code = static_cast<uint32_t>(key);
+        if(code < 0x100)
+        {
+            return code;
+
+        }else if((code & 0xff00) == 0xff00 && code <= 0xffff)
+        {
+            return 0x100 + (code & 0xff);
+        }
+
+        return 0;
+    }
+
+    void InputManager::_queueInputEvent(const QueuedInputEvent &event)
+    {
+        QueuedInputEvent timedEvent = event;
+        timedEvent.time = Clock::now();
+
+        // dropping is bad, but the ring holds way more than a frame's worth of input. if it runs full, the update loop is stuck anyway
+        if(!mInputEventRing.push(timedEvent))
+        {
+            mDroppedInputEventCount.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
     void InputManager::_triggerAction(ActionHandleBase &action, ActionState state)
     {
         for(auto &l : mRawActionListeners)
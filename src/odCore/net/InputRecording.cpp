@@ -0,0 +1,236 @@
+/*
+ * InputRecording.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: zal
+ */
+
+#include <odCore/net/InputRecording.h>
+
+#include <iomanip>
+#include <sstream>
+#include <string>
+
+#include <odCore/Panic.h>
+
+namespace odNet
+{
+
+    static const char *_stateToString(odInput::ActionState state)
+    {
+        switch(state)
+        {
+        case odInput::ActionState::BEGIN:
+            return "begin";
+
+        case odInput::ActionState::END:
+            return "end";
+
+        case odInput::ActionState::REPEAT:
+            return "repeat";
+        }
+
+        OD_UNREACHABLE();
+    }
+
+    static bool _stateFromString(const std::string &str, odInput::ActionState &state)
+    {
+        if(str == "begin")
+        {
+            state = odInput::ActionState::BEGIN;
+
+        }else if(str == "end")
+        {
+            state = odInput::ActionState::END;
+
+        }else if(str == "repeat")
+        {
+            state = odInput::ActionState::REPEAT;
+
+        }else
+        {
+            return false;
+        }
+
+        return true;
+    }
+
+
+    double InputRecording::getDuration() const
+    {
+        return mEntries.empty() ? 0.0 : mEntries.back().time;
+    }
+
+    void InputRecording::addAction(double time, odInput::ActionCode code, odInput::ActionState state)
+    {
+        _checkTime(time);
+
+        Entry entry;
+        entry.time = time;
+        entry.analog = false;
+        entry.code = code;
+        entry.state = state;
+        entry.axes = glm::vec2(0.0f);
+        mEntries.push_back(entry);
+    }
+
+    void InputRecording::addAnalogAction(double time, odInput::ActionCode code, const glm::vec2 &axes)
+    {
+        _checkTime(time);
+
+        Entry entry;
+        entry.time = time;
+        entry.analog = true;
+        entry.code = code;
+        entry.state = odInput::ActionState::BEGIN;
+        entry.axes = axes;
+        mEntries.push_back(entry);
+    }
+
+    void InputRecording::replayEntry(const Entry &entry, UplinkConnector &connector)
+    {
+        if(entry.analog)
+        {
+            connector.analogActionTriggered(entry.code, entry.axes);
+
+        }else
+        {
+            connector.actionTriggered(entry.code, entry.state);
+        }
+    }
+
+    void InputRecording::read(std::istream &in)
+    {
+        std::string line;
+        size_t lineNumber = 0;
+        while(std::getline(in, line))
+        {
+            ++lineNumber;
+
+            std::istringstream ls(line);
+            std::string first;
+            if(!(ls >> first) || first[0] == '#')
+            {
+                continue;
+            }
+
+            double time;
+            std::istringstream ts(first);
+            ts >> time;
+            if(ts.fail())
+            {
+                OD_PANIC() << "Invalid time in input recording, line " << lineNumber;
+            }
+
+            std::string type;
+            odInput::ActionCode code;
+            ls >> type >> code;
+
+            if(type == "action")
+            {
+                std::string stateStr;
+                odInput::ActionState state;
+                ls >> stateStr;
+                if(ls.fail() || !_stateFromString(stateStr, state))
+                {
+                    OD_PANIC() << "Malformed action in input recording, line " << lineNumber;
+                }
+
+                addAction(time, code, state);
+
+            }else if(type == "analog")
+            {
+                glm::vec2 axes;
+                ls >> axes.x >> axes.y;
+                if(ls.fail())
+                {
+                    OD_PANIC() << "Malformed analog action in input recording, line " << lineNumber;
+                }
+
+                addAnalogAction(time, code, axes);
+
+            }else
+            {
+                OD_PANIC() << "Unknown entry type '" << type << "' in input recording, line " << lineNumber;
+            }
+        }
+    }
+
+    void InputRecording::write(std::ostream &out) const
+    {
+        out << "# OpenDrakan input recording" << std::endl
+            << std::fixed << std::setprecision(4);
+
+        for(auto &entry : mEntries)
+        {
+            out << entry.time;
+            if(entry.analog)
+            {
+                out << " analog " << entry.code << " " << entry.axes.x << " " << entry.axes.y << std::endl;
+
+            }else
+            {
+                out << " action " << entry.code << " " << _stateToString(entry.state) << std::endl;
+            }
+        }
+    }
+
+    void InputRecording::_checkTime(double time)
+    {
+        if(time < getDuration())
+        {
+            OD_PANIC() << "Input recording entries must be in chronological order";
+        }
+    }
+
+
+    RecordingUplinkConnector::RecordingUplinkConnector(std::shared_ptr<UplinkConnector> output)
+    : mOutput(output)
+    , mHasStarted(false)
+    {
+    }
+
+    InputRecording RecordingUplinkConnector::getRecording()
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mRecording;
+    }
+
+    void RecordingUplinkConnector::actionTriggered(odInput::ActionCode code, odInput::ActionState state)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mRecording.addAction(_getTime(), code, state);
+        }
+
+        mOutput->actionTriggered(code, state);
+    }
+
+    void RecordingUplinkConnector::analogActionTriggered(odInput::ActionCode code, const glm::vec2 &axes)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mRecording.addAnalogAction(_getTime(), code, axes);
+        }
+
+        mOutput->analogActionTriggered(code, axes);
+    }
+
+    void RecordingUplinkConnector::acknowledgeSnapshot(odState::TickNumber tick)
+    {
+        mOutput->acknowledgeSnapshot(tick);
+    }
+
+    double RecordingUplinkConnector::_getTime()
+    {
+        auto now = std::chrono::steady_clock::now();
+        if(!mHasStarted)
+        {
+            mStartTime = now;
+            mHasStarted = true;
+        }
+
+        return std::chrono::duration<double>(now - mStartTime).count();
+    }
+
+}
@@ -4,6 +4,8 @@
 #include <algorithm>
 #include <type_traits>
 
+#include <odCore/Profiler.h>
+
 #include <odCore/anim/AnimModes.h>
 
 namespace odNet
@@ -45,6 +47,8 @@ namespace odNet
                 << id;
         states.serialize(mWriter, odState::StateSerializationPurpose::NETWORK);
         _endPacket(LinkType::UNRELIABLE);
+
+        OD_PROFILE_COUNT(SNAPSHOT_BYTES, mPacketBuffer.size());
     }
 
     void PacketBuilder::objectExtraStatesChanged(odState::TickNumber tick, od::LevelObjectId id, const char *data, size_t size)
@@ -54,6 +58,7 @@ namespace odNet
                 << id;
         mWriter.write(data, size);
         _endPacket(LinkType::UNRELIABLE);
+        OD_PROFILE_COUNT(SNAPSHOT_BYTES, mPacketBuffer.size());
     }
 
     void PacketBuilder::confirmSnapshot(odState::TickNumber tick, double realtime, size_t discreteChangeCount, odState::TickNumber referenceTick)
@@ -64,6 +69,7 @@ namespace odNet
                 << static_cast<uint32_t>(discreteChangeCount)
                 << referenceTick;
         _endPacket(LinkType::UNRELIABLE);
+        OD_PROFILE_COUNT(SNAPSHOT_BYTES, mPacketBuffer.size());
     }
 
     void PacketBuilder::globalMessage(MessageChannelCode code, const char *data, size_t size)
@@ -15,9 +15,11 @@
 #include <odCore/LevelObject.h>
 #include <odCore/Layer.h>
 #include <odCore/Panic.h>
+#include <odCore/Profiler.h>
 
 #include <odCore/physics/bullet/BulletAdapter.h>
 #include <odCore/physics/bullet/LayerHandleImpl.h>
+#include <odCore/physics/bullet/LayerShapeImpl.h>
 #include <odCore/physics/bullet/ObjectHandleImpl.h>
 #include <odCore/physics/bullet/LightHandleImpl.h>
 #include <odCore/physics/bullet/ModelShapeImpl.h>
@@ -51,6 +53,9 @@ namespace odBulletPhysics
 
     size_t BulletPhysicsSystem::rayTest(const glm::vec3 &from, const glm::vec3 &to, odPhysics::PhysicsTypeMasks::Mask typeMask, odPhysics::RayTestResultVector &resultsOut)
     {
+        OD_PROFILE_ZONE("Physics rayTest");
+        OD_PROFILE_COUNT(RAY_TESTS, 1);
+
         btVector3 bStart = BulletAdapter::toBullet(from);
         btVector3 bEnd =  BulletAdapter::toBullet(to);
 
@@ -62,6 +67,9 @@ namespace odBulletPhysics
 
     bool BulletPhysicsSystem::rayTestClosest(const glm::vec3 &from, const glm::vec3 &to, odPhysics::PhysicsTypeMasks::Mask typeMask, std::shared_ptr<odPhysics::Handle> exclude, odPhysics::RayTestResult &resultOut)
     {
+        OD_PROFILE_ZONE("Physics rayTestClosest");
+        OD_PROFILE_COUNT(RAY_TESTS, 1);
+
         btVector3 bStart = BulletAdapter::toBullet(from);
         btVector3 bEnd =  BulletAdapter::toBullet(to);
 
@@ -73,6 +81,9 @@ namespace odBulletPhysics
 
     size_t BulletPhysicsSystem::contactTest(std::shared_ptr<odPhysics::Handle> handle, odPhysics::PhysicsTypeMasks::Mask typeMask, odPhysics::ContactTestResultVector &resultsOut)
     {
+        OD_PROFILE_ZONE("Physics contactTest");
+        OD_PROFILE_COUNT(CONTACT_TESTS, 1);
+
         btCollisionObject *bulletObject;
         switch(handle->getHandleType())
         {
@@ -105,6 +116,9 @@ namespace odBulletPhysics
 
     void BulletPhysicsSystem::sphereTest(const glm::vec3 &position, float radius, odPhysics::PhysicsTypeMasks::Mask typeMask, odPhysics::ContactTestResultVector &resultsOut)
     {
+        OD_PROFILE_ZONE("Physics sphereTest");
+        OD_PROFILE_COUNT(CONTACT_TESTS, 1);
+
         if(mSphereObject == nullptr || mSphereShape == nullptr)
         {
             mSphereObject = std::make_unique<btCollisionObject>();
@@ -127,9 +141,15 @@ namespace odBulletPhysics
         return std::make_shared<ObjectHandle>(*this, obj, mCollisionWorld.get(), isDetector);
     }
 
-    std::shared_ptr<odPhysics::LayerHandle> BulletPhysicsSystem::createLayerHandle(od::Layer &layer)
+    std::shared_ptr<odPhysics::LayerHandle> BulletPhysicsSystem::createLayerHandle(od::Layer &layer, std::shared_ptr<odPhysics::LayerShape> shape)
     {
-        return std::make_shared<LayerHandle>(layer, mCollisionWorld.get());
+        auto bulletShape = od::downcast<LayerShape>(shape);
+        if(bulletShape == nullptr)
+        {
+            bulletShape = std::make_shared<LayerShape>(layer);
+        }
+
+        return std::make_shared<LayerHandle>(layer, bulletShape, mCollisionWorld.get());
     }
 
     std::shared_ptr<odPhysics::LightHandle> BulletPhysicsSystem::createLightHandle(const od::Light &light)
@@ -144,6 +164,11 @@ namespace odBulletPhysics
         return std::make_shared<ModelShape>(model);
     }
 
+    std::shared_ptr<odPhysics::LayerShape> BulletPhysicsSystem::createLayerShape(od::Layer &layer)
+    {
+        return std::make_shared<LayerShape>(layer);
+    }
+
     void BulletPhysicsSystem::setEnableDebugDrawing(bool enable)
     {
         if(mDebugDrawer == nullptr)
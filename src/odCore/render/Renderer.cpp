@@ -33,6 +33,13 @@ namespace odRender
         return newRenderModel;
     }
 
+    std::shared_ptr<Model> Renderer::createModelFromLayer(od::Layer *layer)
+    {
+        OD_CHECK_ARG_NONNULL(layer);
+
+        return this->createModelFromPreparedLayer(this->prepareModelFromLayer(layer));
+    }
+
     std::shared_ptr<Image> Renderer::getOrCreateImageFromDb(std::shared_ptr<odDb::Texture> dbTexture)
     {
         OD_CHECK_ARG_NONNULL(dbTexture);
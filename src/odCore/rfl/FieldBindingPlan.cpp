@@ -0,0 +1,51 @@
+/*
+ * FieldBindingPlan.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: zal
+ */
+
+#include <odCore/rfl/FieldBindingPlan.h>
+
+#include <odCore/rfl/Class.h>
+#include <odCore/rfl/FieldProbe.h>
+#include <odCore/rfl/FieldLoaderProbe.h>
+
+namespace odRfl
+{
+
+    namespace
+    {
+        class SlotRecorderProbe final : public FieldProbe
+        {
+        public:
+
+            SlotRecorderProbe(std::vector<FieldBindingPlan::Slot> &slots)
+            : mSlots(slots)
+            {
+            }
+
+            virtual void registerField(Field &field, const char *fieldName) override
+            {
+                FieldBindingPlan::Slot slot;
+                slot.fieldType = field.getFieldType();
+                slot.isArray = field.isArray();
+                slot.fieldName = FieldNameTable::intern(fieldName);
+                mSlots.push_back(slot);
+            }
+
+
+        private:
+
+            std::vector<FieldBindingPlan::Slot> &mSlots;
+        };
+    }
+
+
+    FieldBindingPlan::FieldBindingPlan(FieldBundle &fieldBundle)
+    {
+        SlotRecorderProbe probe(mSlots);
+        fieldBundle.probeFields(probe);
+    }
+
+}
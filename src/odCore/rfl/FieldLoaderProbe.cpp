@@ -2,16 +2,107 @@
 #include <odCore/rfl/FieldLoaderProbe.h>
 
 #include <algorithm>
+#include <cstring>
+#include <mutex>
+#include <unordered_set>
 
 #include <odCore/Panic.h>
+#include <odCore/DataStream.h>
 
 #include <odCore/rfl/Field.h>
+#include <odCore/rfl/FieldBindingPlan.h>
 
 namespace odRfl
 {
 
+    const char *FieldNameTable::intern(const std::string &name)
+    {
+        // every object record repeats the names of its fields. interning them avoids an allocation per field and lets
+        //  caches and binding plans refer to names by pointer
+        static std::mutex internMutex;
+        static std::unordered_set<std::string> internedNames;
+
+        std::lock_guard<std::mutex> lock(internMutex);
+        return internedNames.insert(name).first->c_str();
+    }
+
+    uint32_t FieldNameTable::getIndex(const char *name)
+    {
+        auto it = mIndices.find(name);
+        if(it != mIndices.end())
+        {
+            return it->second;
+        }
+
+        uint32_t index = mNames.size();
+        mNames.push_back(name);
+        mIndices.insert(std::make_pair(name, index));
+
+        return index;
+    }
+
+    const char *FieldNameTable::getName(uint32_t index) const
+    {
+        if(index >= mNames.size())
+        {
+            OD_PANIC() << "Field name index " << index << " out of bounds";
+        }
+
+        return mNames[index];
+    }
+
+    void FieldNameTable::write(od::DataWriter &dw) const
+    {
+        dw << static_cast<uint32_t>(mNames.size());
+        for(auto name : mNames)
+        {
+            size_t length = std::strlen(name);
+            dw << static_cast<uint16_t>(length);
+            dw.write(name, length);
+        }
+    }
+
+    bool FieldNameTable::read(od::DataReader &dr, size_t end)
+    {
+        mNames.clear();
+        mIndices.clear();
+
+        if(dr.tell() + sizeof(uint32_t) > end)
+        {
+            return false;
+        }
+
+        uint32_t nameCount;
+        dr >> nameCount;
+
+        std::string name;
+        for(size_t i = 0; i < nameCount; ++i)
+        {
+            uint16_t length;
+            if(dr.tell() + sizeof(length) > end)
+            {
+                return false;
+            }
+            dr >> length;
+
+            if(dr.tell() + length > end)
+            {
+                return false;
+            }
+            name.resize(length);
+            dr.read(&name[0], length);
+
+            getIndex(intern(name));
+        }
+
+        return true;
+    }
+
+
     FieldLoaderProbe::FieldLoaderProbe()
     : mRegistrationIndex(0)
+    , mEntryCursor(0)
+    , mBindingPlan(nullptr)
     {
     }
 
@@ -60,7 +151,7 @@ namespace odRfl
             }
 
             mFieldEntries[i].fieldType = type & 0xff;
-            mFieldEntries[i].fieldName = std::move(name);
+            mFieldEntries[i].fieldName = FieldNameTable::intern(name);
             mFieldEntries[i].dataOffset = i*4;
             mFieldEntries[i].isArray = (type & 0x1000) || (mFieldEntries[i].fieldType == static_cast<uint32_t>(Field::Type::STRING)); // strings are stored exactly like arrays
         }
@@ -70,9 +161,89 @@ namespace odRfl
         std::sort(mFieldEntries.begin(), mFieldEntries.end(), pred);
     }
 
-    void FieldLoaderProbe::reset()
+    bool FieldLoaderProbe::loadFromCache(od::DataReader &dr, size_t end, const FieldNameTable &names)
+    {
+        // index, type, isArray, data offset, name index
+        static constexpr size_t ENTRY_SIZE = 2 + 1 + 1 + 4 + 4;
+
+        uint32_t fieldCount;
+        uint32_t dataSize;
+        if(dr.tell() + 2*sizeof(uint32_t) > end)
+        {
+            return false;
+        }
+        dr >> fieldCount
+           >> dataSize;
+
+        if(dr.tell() + dataSize + static_cast<uint64_t>(fieldCount)*ENTRY_SIZE > end)
+        {
+            return false;
+        }
+
+        mFieldData.resize(dataSize);
+        dr.read(mFieldData.data(), mFieldData.size());
+
+        mFieldEntries.resize(fieldCount);
+        for(auto &entry : mFieldEntries)
+        {
+            uint8_t type;
+            uint8_t isArray;
+            uint32_t dataOffset;
+            uint32_t nameIndex;
+            dr >> entry.index
+               >> type
+               >> isArray
+               >> dataOffset
+               >> nameIndex;
+
+            // every field occupies one dword. for arrays, that holds the dword offset and length of the array data
+            if(static_cast<uint64_t>(dataOffset) + 4 > dataSize || nameIndex >= names.getNameCount())
+            {
+                return false;
+            }
+
+            if(isArray)
+            {
+                uint16_t arrayOffset = static_cast<uint8_t>(mFieldData[dataOffset]) | (static_cast<uint8_t>(mFieldData[dataOffset + 1]) << 8);
+                uint16_t arrayLength = static_cast<uint8_t>(mFieldData[dataOffset + 2]) | (static_cast<uint8_t>(mFieldData[dataOffset + 3]) << 8);
+                if((static_cast<uint64_t>(arrayOffset) + arrayLength)*4 > dataSize)
+                {
+                    return false;
+                }
+            }
+
+            entry.fieldType = type;
+            entry.isArray = isArray;
+            entry.dataOffset = dataOffset;
+            entry.fieldName = names.getName(nameIndex);
+        }
+
+        return true;
+    }
+
+    void FieldLoaderProbe::writeToCache(od::DataWriter &dw, FieldNameTable &names) const
+    {
+        dw << static_cast<uint32_t>(mFieldEntries.size())
+           << static_cast<uint32_t>(mFieldData.size());
+
+        dw.write(mFieldData.data(), mFieldData.size());
+
+        for(auto &entry : mFieldEntries)
+        {
+            // the type is already masked to the lower byte when loading from a record
+            dw << entry.index
+               << static_cast<uint8_t>(entry.fieldType)
+               << static_cast<uint8_t>(entry.isArray)
+               << static_cast<uint32_t>(entry.dataOffset)
+               << names.getIndex(entry.fieldName);
+        }
+    }
+
+    void FieldLoaderProbe::reset(const FieldBindingPlan *plan)
     {
         mRegistrationIndex = 0;
+        mEntryCursor = 0;
+        mBindingPlan = plan;
     }
 
     void FieldLoaderProbe::beginCategory(const char *categoryName)
@@ -83,29 +254,46 @@ namespace odRfl
     {
         auto currentFieldIndex = mRegistrationIndex++;
 
-        auto pred = [](const FieldEntry &field, size_t index ){ return field.index < index; };
-        auto it = std::lower_bound(mFieldEntries.begin(), mFieldEntries.end(), currentFieldIndex, pred);
-        if(it == mFieldEntries.end() || it->index != currentFieldIndex)
+        // fields are registered in ascending index order and our entries are sorted, so we never have to search backwards
+        while(mEntryCursor < mFieldEntries.size() && mFieldEntries[mEntryCursor].index < currentFieldIndex)
+        {
+            ++mEntryCursor;
+        }
+
+        if(mEntryCursor >= mFieldEntries.size() || mFieldEntries[mEntryCursor].index != currentFieldIndex)
         {
             // the field we are looking for does not exist in this record. for object records, we can ignore this. for class records, this would be an error TODO: report it
             return;
         }
 
-        FieldEntry &entry = *it;
+        FieldEntry &entry = mFieldEntries[mEntryCursor];
 
-        if(entry.fieldType != static_cast<uint32_t>(field.getFieldType()))
+        // with a plan, a matching entry needs no further checks. names are interned on both sides, so comparing pointers is enough
+        bool matchesPlan = false;
+        if(mBindingPlan != nullptr && currentFieldIndex < mBindingPlan->getSlotCount())
         {
-            OD_PANIC() << "Type mismatch in class record. Field type as defined in RflClass does not match the one found in record.";
+            auto &slot = mBindingPlan->getSlot(currentFieldIndex);
+            matchesPlan = (entry.fieldName == slot.fieldName)
+                    && (entry.fieldType == static_cast<uint32_t>(slot.fieldType))
+                    && (entry.isArray == slot.isArray);
         }
 
-        if(entry.fieldName != fieldName) // TODO: costly comparison. might want to make this optional
+        if(!matchesPlan)
         {
-            OD_PANIC() << "Field name mismatch: Field in RflClass was named '" << fieldName << "' where field in record was named '" << entry.fieldName << "'";
-        }
+            if(entry.fieldType != static_cast<uint32_t>(field.getFieldType()))
+            {
+                OD_PANIC() << "Type mismatch in class record. Field type as defined in RflClass does not match the one found in record.";
+            }
 
-        if(entry.isArray != field.isArray())
-        {
-            OD_PANIC() << "Field array flag mismatch: Field '" << fieldName << "' was array in RFL or file while in the other it was not.";
+            if(std::strcmp(entry.fieldName, fieldName) != 0) // TODO: costly comparison. might want to make this optional
+            {
+                OD_PANIC() << "Field name mismatch: Field in RflClass was named '" << fieldName << "' where field in record was named '" << entry.fieldName << "'";
+            }
+
+            if(entry.isArray != field.isArray())
+            {
+                OD_PANIC() << "Field array flag mismatch: Field '" << fieldName << "' was array in RFL or file while in the other it was not.";
+            }
         }
 
         // field seems reasonable. let's fill it
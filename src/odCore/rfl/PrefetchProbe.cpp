@@ -7,6 +7,7 @@
 
 #include <odCore/rfl/PrefetchProbe.h>
 
+#include <odCore/Logger.h>
 #include <odCore/Panic.h>
 
 #include <odCore/rfl/AssetRefField.h>
@@ -15,16 +16,102 @@ namespace odRfl
 {
 
 
-    PrefetchProbe::PrefetchProbe(std::shared_ptr<odDb::DependencyTable> dt, bool ignoreMissing)
+    PrefetchProbe::PrefetchProbe(std::shared_ptr<odDb::DependencyTable> dt, bool ignoreMissing, odDb::AssetPrefetcher *prefetcher)
     : mDependencyTable(dt)
     , mIgnoreMissing(ignoreMissing)
+    , mPrefetcher(prefetcher)
     {
     }
 
+    PrefetchProbe::~PrefetchProbe()
+    {
+        // the queued loads reference the fields, so they must be done before the fields can go away. we might be
+        //  unwinding from a failed probe here, so errors are only logged
+        std::exception_ptr firstError;
+        std::vector<const char*> failedFields;
+        _waitForAll(firstError, failedFields);
+
+        if(firstError != nullptr)
+        {
+            try
+            {
+                std::rethrow_exception(firstError);
+
+            }catch(std::exception &e)
+            {
+                Logger::error() << "Prefetching assets failed: " << e.what();
+
+            }catch(...)
+            {
+                Logger::error() << "Prefetching assets failed with unknown exception";
+            }
+        }
+
+        if(!mIgnoreMissing)
+        {
+            for(auto fieldName : failedFields)
+            {
+                Logger::error() << "Field '" << fieldName << "' contains invalid asset reference";
+            }
+        }
+    }
+
     void PrefetchProbe::registerField(AssetRefField &field, const char *fieldName)
     {
-        bool success = field.fetchAssets(*mDependencyTable);
+        if(mPrefetcher == nullptr)
+        {
+            _checkResult(field.fetchAssets(*mDependencyTable), fieldName);
+            return;
+        }
+
+        // probe users need their assets right away, so these go before anything queued with a later deadline
+        std::function<bool()> loader = [&field, dt = mDependencyTable](){ return field.fetchAssets(*dt); };
+        mPendingFields.push_back({fieldName, mPrefetcher->prefetch(0.0, std::move(loader))});
+    }
 
+    void PrefetchProbe::wait()
+    {
+        std::exception_ptr firstError;
+        std::vector<const char*> failedFields;
+        _waitForAll(firstError, failedFields);
+
+        if(firstError != nullptr)
+        {
+            std::rethrow_exception(firstError);
+        }
+
+        for(auto fieldName : failedFields)
+        {
+            _checkResult(false, fieldName);
+        }
+    }
+
+    void PrefetchProbe::_waitForAll(std::exception_ptr &firstError, std::vector<const char*> &failedFields)
+    {
+        // nothing may be reported before every request is done, as the loaders still running hold references to their fields
+        for(auto &pending : mPendingFields)
+        {
+            try
+            {
+                if(!pending.request.get())
+                {
+                    failedFields.push_back(pending.fieldName);
+                }
+
+            }catch(...)
+            {
+                if(firstError == nullptr)
+                {
+                    firstError = std::current_exception();
+                }
+            }
+        }
+
+        mPendingFields.clear();
+    }
+
+    void PrefetchProbe::_checkResult(bool success, const char *fieldName)
+    {
         if(!success)
         {
             if(!mIgnoreMissing)
@@ -1,8 +1,13 @@
 
 #include <odCore/state/EventQueue.h>
 
+#include <algorithm>
+#include <functional>
+
 #include <odCore/Level.h>
 #include <odCore/LevelObject.h>
+#include <odCore/Logger.h>
+#include <odCore/Profiler.h>
 
 #include <odCore/db/DbManager.h>
 #include <odCore/db/Database.h>
@@ -56,22 +61,34 @@ namespace odState
     };
 
 
+    /**
+     * Starts loading the assets an event needs and returns a function that waits for them and puts them into the event.
+     */
     struct PrefetchVisitor
     {
+        using Completion = std::function<void(EventVariant&)>;
+
         odDb::DbManager &dbManager;
+        double deadline;
 
-        PrefetchVisitor(odDb::DbManager &d)
+        PrefetchVisitor(odDb::DbManager &d, double dl)
         : dbManager(d)
+        , deadline(dl)
         {
         }
 
-        void operator()(Event &event)
+        Completion operator()(const Event &event)
         {
+            return nullptr;
         }
 
-        void operator()(ObjectAnimEvent &event)
+        Completion operator()(const ObjectAnimEvent &event)
         {
-            event.anim = dbManager.loadAsset<odDb::Animation>(event.animRef);
+            auto request = dbManager.prefetchAsset<odDb::Animation>(event.animRef, deadline);
+            return [request](EventVariant &e) mutable
+            {
+                std::get<ObjectAnimEvent>(e).anim = request.get();
+            };
         }
     };
 
@@ -79,23 +96,29 @@ namespace odState
     EventQueue::EventQueue(odDb::DbManager &dbManager, od::Level &level)
     : mDbManager(dbManager)
     , mLevel(level)
+    , mCurrentTime(0.0)
+    , mFrontCursor(0)
+    , mDispatchCursor(0)
+    , mSentCursor(0)
+    , mStatistics{}
     {
     }
 
     void EventQueue::addIncomingEvent(double realtime, const EventVariant &event)
     {
-        auto it = _getEventInsertPoint(realtime);
-        auto inserted = mEvents.emplace(it, EventData{event, realtime, false, true});
+        EventData eventData{event, realtime, false, true};
 
-        // prefetch assets. this should later happen asynchronously
-        PrefetchVisitor pv(mDbManager);
-        std::visit(pv, inserted->event);
+        // the assets are loaded in the background while the event waits for its time. dispatch only blocks on them
+        //  if they are not done by then
+        PrefetchVisitor pv(mDbManager, realtime);
+        eventData.prefetchCompletion = std::visit(pv, eventData.event);
+
+        _insertEvent(std::move(eventData));
     }
 
     void EventQueue::logEvent(double realtime, const EventVariant &event)
     {
-        auto it = _getEventInsertPoint(realtime);
-        mEvents.emplace(it, EventData{event, realtime, true, false});
+        _insertEvent(EventData{event, realtime, true, false});
     }
 
     void EventQueue::logEvent(const EventVariant &event)
@@ -105,63 +128,244 @@ namespace odState
 
     void EventQueue::dispatch(double realtime)
     {
-        for(auto &eventData : mEvents)
+        OD_PROFILE_ZONE("EventQueue::dispatch");
+
+        // deferred events go first so events for the same object keep their order
+        if(!mRetryEvents.empty())
         {
-            if(eventData.realtime <= realtime)
+            std::vector<EventData> retryEvents;
+            retryEvents.swap(mRetryEvents);
+
+            // dispatching has side effects, so keep this a plain loop that compacts the list as it goes
+            size_t keepCount = 0;
+            for(size_t i = 0; i < retryEvents.size(); ++i)
             {
-                if(!eventData.dispatched)
+                auto &eventData = retryEvents[i];
+                if(_tryDispatch(eventData, realtime))
                 {
-                    // the dispatch functor returns false if dispatch should be retried later.
-                    //  this might happen if an object is stopped and thus can not process events
-                    DispatchVisitor visitor(mLevel, realtime - eventData.realtime);
-                    eventData.dispatched = std::visit(visitor, eventData.event);
+                    continue;
                 }
 
-            }else
+                auto &stats = mStatistics[eventData.event.index()];
+                if(realtime - eventData.realtime > MAX_RETRY_AGE)
+                {
+                    ++stats.dropped;
+                    Logger::warn() << "Dropping event that could not be dispatched for " << (realtime - eventData.realtime) << "s";
+                    continue;
+                }
+
+                ++stats.retried;
+                if(keepCount != i)
+                {
+                    retryEvents[keepCount] = std::move(eventData);
+                }
+                ++keepCount;
+            }
+
+            retryEvents.erase(retryEvents.begin() + keepCount, retryEvents.end());
+
+            // dispatching might have added events to the retry list
+            retryEvents.insert(retryEvents.end(), mRetryEvents.begin(), mRetryEvents.end());
+            mRetryEvents = std::move(retryEvents);
+        }
+
+        // dispatching may add events to the queue, so don't hold on to iterators or references here
+        while(mDispatchCursor < _getEndCursor())
+        {
+            auto &eventData = _getEvent(mDispatchCursor);
+            if(eventData.realtime > realtime)
             {
                 break; // event queue is sorted, so the next events won't be relevant either. we are done
             }
+
+            ++mDispatchCursor;
+
+            if(!eventData.dispatched)
+            {
+                eventData.dispatched = true;
+                _completePrefetch(eventData);
+
+                // the dispatch functor returns false if dispatch should be retried later.
+                //  this might happen if an object is stopped and thus can not process events
+                if(!_tryDispatch(eventData, realtime))
+                {
+                    // inserting in front of the cursor moves it along, so this still is the event we just tried
+                    auto &failedEvent = _getEvent(mDispatchCursor - 1);
+                    ++mStatistics[failedEvent.event.index()].retried;
+                    mRetryEvents.push_back(failedEvent);
+                }
+            }
+        }
+
+        if(mRetryEvents.size() > MAX_RETRY_EVENTS)
+        {
+            size_t dropCount = mRetryEvents.size() - MAX_RETRY_EVENTS;
+            for(size_t i = 0; i < dropCount; ++i)
+            {
+                ++mStatistics[mRetryEvents[i].event.index()].dropped;
+            }
+
+            mRetryEvents.erase(mRetryEvents.begin(), mRetryEvents.begin() + dropCount);
+            Logger::warn() << "Too many events waiting for dispatch. Dropped " << dropCount << " of them";
         }
     }
 
     void EventQueue::sendEventsToClient(odNet::DownlinkConnector &connector, double realtime)
     {
-        for(auto &eventData : mEvents)
+        auto it = mConnectors.find(&connector);
+        if(it == mConnectors.end())
         {
-            if(eventData.realtime <= realtime)
-            {
-                if(!eventData.sent)
-                {
-                    connector.event(eventData.event, eventData.realtime);
-                }
+            it = mConnectors.insert(std::make_pair(&connector, ConnectorState{mSentCursor, true, {}})).first;
+        }
 
-            }else
+        auto &state = it->second;
+        state.active = true;
+
+        // these are older than anything still ahead of the cursor, so they go first
+        for(auto &lateEvent : state.lateEvents)
+        {
+            connector.event(lateEvent.second, lateEvent.first);
+            ++mStatistics[lateEvent.second.index()].sent;
+        }
+        state.lateEvents.clear();
+
+        Cursor cursor = std::max(mSentCursor, state.cursor);
+        Cursor end = _getEndCursor();
+        for(; cursor < end; ++cursor)
+        {
+            auto &eventData = _getEvent(cursor);
+            if(eventData.realtime > realtime)
             {
                 break;
             }
+
+            if(!eventData.sent)
+            {
+                connector.event(eventData.event, eventData.realtime);
+                ++mStatistics[eventData.event.index()].sent;
+            }
         }
+
+        state.cursor = cursor;
     }
 
     void EventQueue::markAsSent(double realtime)
     {
-        for(auto &eventData : mEvents)
+        Cursor end = _getEndCursor();
+        while(mSentCursor < end && _getEvent(mSentCursor).realtime <= realtime)
         {
-            if(eventData.realtime <= realtime)
+            _getEvent(mSentCursor).sent = true;
+            ++mSentCursor;
+        }
+
+        // forget connectors that are gone
+        for(auto it = mConnectors.begin(); it != mConnectors.end(); )
+        {
+            if(!it->second.active)
             {
-                eventData.sent = true;
+                it = mConnectors.erase(it);
 
             }else
             {
-                break;
+                it->second.active = false;
+                ++it;
             }
         }
     }
 
     void EventQueue::cleanup()
     {
+        // the flags are set as the cursors pass events, so this never removes an event a cursor still has to visit
         while(!mEvents.empty() && mEvents.front().dispatched && mEvents.front().sent)
         {
             mEvents.pop_front();
+            ++mFrontCursor;
+        }
+
+        // cursors may lag behind events that never needed their attention
+        mDispatchCursor = std::max(mDispatchCursor, mFrontCursor);
+        mSentCursor = std::max(mSentCursor, mFrontCursor);
+    }
+
+    void EventQueue::_insertEvent(EventData &&eventData)
+    {
+        ++mStatistics[eventData.event.index()].queued;
+
+        Cursor insertCursor = mFrontCursor + (_getEventInsertPoint(eventData.realtime) - mEvents.begin());
+
+        // the queue has to stay sorted, but connectors whose cursor is already past the insertion point would never see
+        //  an unsent event there. they get it through their late list instead
+        if(!eventData.sent)
+        {
+            for(auto &connector : mConnectors)
+            {
+                if(insertCursor < std::max(mSentCursor, connector.second.cursor))
+                {
+                    connector.second.lateEvents.emplace_back(eventData.realtime, eventData.event);
+                }
+            }
+
+            // every connector that is still around has passed mSentCursor, so nothing left to send in the queue
+            if(insertCursor < mSentCursor)
+            {
+                eventData.sent = true;
+            }
+        }
+
+        if(insertCursor < mDispatchCursor)
+        {
+            // dispatch() has already passed this point in time. hand the event straight to the retry list so it gets
+            //  dispatched on the next call, with the delay it accumulated
+            if(!eventData.dispatched)
+            {
+                _completePrefetch(eventData);
+                mRetryEvents.push_back(eventData);
+                eventData.dispatched = true;
+            }
+
+            ++mDispatchCursor;
+        }
+
+        // keep cursors that are past the insertion point on the event they pointed to
+        if(insertCursor < mSentCursor)
+        {
+            ++mSentCursor;
+        }
+
+        for(auto &connector : mConnectors)
+        {
+            if(insertCursor < connector.second.cursor)
+            {
+                ++connector.second.cursor;
+            }
+        }
+
+        mEvents.emplace(mEvents.begin() + (insertCursor - mFrontCursor), std::move(eventData));
+    }
+
+    bool EventQueue::_tryDispatch(const EventData &eventData, double realtime)
+    {
+        // the event might be moved around by events added during dispatch. don't touch it afterwards
+        auto &stats = mStatistics[eventData.event.index()];
+
+        DispatchVisitor visitor(mLevel, realtime - eventData.realtime);
+        bool dispatched = std::visit(visitor, eventData.event);
+        if(dispatched)
+        {
+            ++stats.dispatched;
+            OD_PROFILE_COUNT(EVENTS_DISPATCHED, 1);
+        }
+
+        return dispatched;
+    }
+
+    void EventQueue::_completePrefetch(EventData &eventData)
+    {
+        if(eventData.prefetchCompletion)
+        {
+            auto completion = std::move(eventData.prefetchCompletion);
+            eventData.prefetchCompletion = nullptr;
+            completion(eventData.event);
         }
     }
 
@@ -6,6 +6,7 @@
 #include <odCore/Level.h>
 #include <odCore/LevelObject.h>
 #include <odCore/Panic.h>
+#include <odCore/Profiler.h>
 
 #include <odCore/net/DownlinkConnector.h>
 #include <odCore/net/UplinkConnector.h>
@@ -140,6 +141,8 @@ namespace odState
 
     void StateManager::commit(double realtime)
     {
+        OD_PROFILE_ZONE("StateManager::commit");
+
         TickNumber nextTick = mSnapshots.empty() ? FIRST_TICK : mSnapshots.back().tick + 1;
 
         if(mSnapshots.size() >= TICK_CAPACITY)
@@ -163,6 +166,8 @@ namespace odState
 
     void StateManager::apply(double realtime)
     {
+        OD_PROFILE_ZONE("StateManager::apply");
+
         ApplyGuard applyGuard(*this);
 
         // TODO: not all states change everytime! we should remember the last tick we applied and only process states that changed between the two.
@@ -237,6 +242,8 @@ namespace odState
 
     void StateManager::sendSnapshotToClient(TickNumber tickToSend, odNet::DownlinkConnector &c, TickNumber referenceSnapshot)
     {
+        OD_PROFILE_ZONE("StateManager::sendSnapshotToClient");
+
         auto toSend = _getSnapshot(tickToSend, mSnapshots, false);
         if(toSend == mSnapshots.end())
         {
@@ -11,17 +11,21 @@
 #include <memory>
 #include <thread>
 #include <exception>
+#include <fstream>
 
 #include <odCore/Logger.h>
 #include <odCore/Client.h>
 #include <odCore/Server.h>
 #include <odCore/Panic.h>
 #include <odCore/FilePath.h>
+#include <odCore/Engine.h>
 #include <odCore/Version.h>
 #include <odCore/ThreadUtils.h>
+#include <odCore/Profiler.h>
 
 #include <odCore/net/UplinkConnector.h>
 #include <odCore/net/DownlinkConnector.h>
+#include <odCore/net/InputRecording.h>
 #include <odCore/net/LocalTunnel.h>
 
 #include <odCore/physics/PhysicsSystem.h>
@@ -59,34 +63,18 @@ static void printUsage()
         << "    -h  Display this message and exit" << std::endl
         << "    -c  Use free look trackball view and ignore in-game camera controllers" << std::endl
         << "    -p  Force enable physics debug drawing" << std::endl
+        << "    -n  Disable instanced rendering of repeated models" << std::endl
+        << "    -s  Log draw call and state change counts once per second" << std::endl
         << "    -t  Use a simulated network tunnel to connect client and server" << std::endl
         << "    -d <drop rate>  Simulate packet drops (implies -t, range 0-1)" << std::endl
         << "    -l <min>:<max>  Simulate packet latency (implies -t, min/max are seconds)" << std::endl
+        << "    -P <file>  Profile server, client and renderer and write a Chrome trace to file on exit" << std::endl
+        << "    -R <file>  Record the client's input actions and write them to file on exit (can be replayed by odServer)" << std::endl
         << "If no level file and no options are given, the default intro level is loaded." << std::endl
         << "The latter assumes the current directory to be the game root." << std::endl
         << std::endl;
 }
 
-static od::FilePath findEngineRoot(const od::FilePath &dir, const std::string &rrcFileName)
-{
-    // ascend in the passed directory until we find a Dragon.rrc
-    od::FilePath path = od::FilePath(rrcFileName, dir).adjustCase();
-    while(!path.exists() && path.depth() > 1)
-    {
-        path = od::FilePath(rrcFileName, path.dir().dir()).adjustCase();
-    }
-
-    if(!path.exists())
-    {
-        OD_PANIC() << "Could not find engine root in passed level path. "
-                << "Make sure your level is located in the same directory or a subdirectory of " << rrcFileName;
-    }
-
-    od::FilePath root = path.dir();
-    Logger::verbose() << "Found engine root here: " << root;
-    return root;
-}
-
 int main(int argc, char **argv)
 {
     signal(SIGINT, &handleSignal);
@@ -98,11 +86,15 @@ int main(int argc, char **argv)
     int c;
     bool freeLook = false;
     bool physicsDebug = false;
+    bool disableInstancing = false;
+    bool renderStatistics = false;
     bool useLocalTunnel = false;
     float dropRate = 0;
     double latencyMin = 0;
     double latencyMax = 0;
-    while((c = getopt(argc, argv, "vhcptd:l:")) != -1)
+    std::string profileOutputPath;
+    std::string inputRecordingPath;
+    while((c = getopt(argc, argv, "vhcpnstd:l:P:R:")) != -1)
     {
         switch(c)
         {
@@ -122,6 +114,14 @@ int main(int argc, char **argv)
             physicsDebug = true;
             break;
 
+        case 'n':
+            disableInstancing = true;
+            break;
+
+        case 's':
+            renderStatistics = true;
+            break;
+
         case 't':
             useLocalTunnel = true;
             break;
@@ -154,6 +154,14 @@ int main(int argc, char **argv)
             }
             break;
 
+        case 'P':
+            profileOutputPath = optarg;
+            break;
+
+        case 'R':
+            inputRecordingPath = optarg;
+            break;
+
         case '?':
             std::cout << "Unknown option -" << optopt << std::endl;
             printUsage();
@@ -177,10 +185,11 @@ int main(int argc, char **argv)
     sServer = &server;
 
     std::unique_ptr<odNet::LocalTunnel> localTunnel;
+    std::shared_ptr<odNet::UplinkConnector> clientUplinkConnector;
     if(!useLocalTunnel)
     {
         server.setClientDownlinkConnector(clientId, client.getDownlinkConnector());
-        client.setUplinkConnector(server.getUplinkConnectorForClient(clientId));
+        clientUplinkConnector = server.getUplinkConnectorForClient(clientId);
 
     }else
     {
@@ -188,9 +197,18 @@ int main(int argc, char **argv)
         localTunnel->setDropRate(dropRate);
         localTunnel->setLatency(latencyMin, latencyMax);
         server.setClientDownlinkConnector(clientId, localTunnel->getDownlinkInput());
-        client.setUplinkConnector(localTunnel->getUplinkInput());
+        clientUplinkConnector = localTunnel->getUplinkInput();
     }
 
+    std::shared_ptr<odNet::RecordingUplinkConnector> inputRecorder;
+    if(!inputRecordingPath.empty())
+    {
+        inputRecorder = std::make_shared<odNet::RecordingUplinkConnector>(clientUplinkConnector);
+        clientUplinkConnector = inputRecorder;
+    }
+
+    client.setUplinkConnector(clientUplinkConnector);
+
     od::FilePath engineRoot(".");
     od::FilePath initialLevelOverride;
     bool hasInitialLevelOverride = false;
@@ -208,13 +226,15 @@ int main(int argc, char **argv)
 
         // if we have been passed a level override, we need to find the engine root in that path.
         //  if not, assume the engine root is the current working directory. TODO: add option to explicitly specify engine root
-        engineRoot = findEngineRoot(initialLevelOverride, "dragon.rrc");
+        engineRoot = od::findEngineRoot(initialLevelOverride, "dragon.rrc");
     }
 
     client.setEngineRootDir(engineRoot);
     server.setEngineRootDir(engineRoot);
 
     osgRenderer.setFreeLook(freeLook);
+    osgRenderer.setEnableInstancing(!disableInstancing);
+    osgRenderer.setEnableRenderStatistics(renderStatistics);
 
     std::unique_ptr<odOsg::InputListener> inputListener;
     // if we use freelook mode, the input listener should not consume it's input events so the trackball can handle them, too
@@ -262,6 +282,11 @@ int main(int argc, char **argv)
         server.setIsDone(true);
     };
 
+    if(!profileOutputPath.empty())
+    {
+        od::Profiler::getInstance().setEnabled(true);
+    }
+
     std::thread serverThread(serverThreadFunc);
     od::ThreadUtils::setThreadName(serverThread, "server");
 
@@ -274,5 +299,33 @@ int main(int argc, char **argv)
     sClient = nullptr;
     sServer = nullptr;
 
+    if(inputRecorder != nullptr)
+    {
+        std::ofstream out(inputRecordingPath);
+        if(!out.good())
+        {
+            Logger::error() << "Could not open " << inputRecordingPath << " for writing input recording";
+
+        }else
+        {
+            inputRecorder->getRecording().write(out);
+        }
+    }
+
+    if(!profileOutputPath.empty())
+    {
+        od::Profiler::getInstance().setEnabled(false);
+
+        std::ofstream out(profileOutputPath);
+        if(!out.good())
+        {
+            Logger::error() << "Could not open " << profileOutputPath << " for writing profiler trace";
+
+        }else
+        {
+            od::Profiler::getInstance().writeChromeTrace(out);
+        }
+    }
+
     return 0;
 }
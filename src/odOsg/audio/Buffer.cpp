@@ -29,40 +29,48 @@ namespace odOsg
     {
         mSound = sound;
 
-        uint32_t bitsPerChannel = mSound->getBitsPerChannel();
-        uint32_t channelCount = mSound->getChannelCount();
-        ALenum format;
+        // the decoded data only lives until it is uploaded. AL keeps it's own copy
+        auto data = mSound->decodeAll();
+        setData(getFormatForSound(*mSound), data.data(), data.size(), mSound->getSamplingFrequency());
+    }
+
+    Buffer::~Buffer()
+    {
+        alDeleteBuffers(1, &mBufferId);
+        SoundSystem::doErrorCheck("Could not delete buffer");
+    }
+
+    void Buffer::setData(ALenum format, const void *data, size_t size, uint32_t frequency)
+    {
+        alBufferData(mBufferId, format, data, size, frequency);
+        SoundSystem::doErrorCheck("Could not fill buffer with data");
+    }
+
+    ALenum Buffer::getFormatForSound(const odDb::Sound &sound)
+    {
+        uint32_t bitsPerChannel = sound.getBitsPerChannel();
+        uint32_t channelCount = sound.getChannelCount();
         if(bitsPerChannel == 8 && channelCount == 1)
         {
-            format = AL_FORMAT_MONO8;
+            return AL_FORMAT_MONO8;
 
         }else if(bitsPerChannel == 8 && channelCount == 2)
         {
-            format = AL_FORMAT_STEREO8;
+            return AL_FORMAT_STEREO8;
 
         }else if(bitsPerChannel ==  16 && channelCount == 1)
         {
-            format = AL_FORMAT_MONO16;
+            return AL_FORMAT_MONO16;
 
         }else if(bitsPerChannel ==  16 && channelCount == 2)
         {
-            format = AL_FORMAT_STEREO16;
+            return AL_FORMAT_STEREO16;
 
         }else
         {
-            OD_PANIC() << "Sound '" << sound->getName() << "' has unsupported format (bits/channel=" << bitsPerChannel
+            OD_PANIC() << "Sound '" << sound.getName() << "' has unsupported format (bits/channel=" << bitsPerChannel
                     << ", channels=" << channelCount << ")";
         }
-
-        const auto &data = mSound->getDataBuffer();
-        alBufferData(mBufferId, format, data.data(), data.size(), mSound->getSamplingFrequency());
-        SoundSystem::doErrorCheck("Could not fill buffer with data");
-    }
-
-    Buffer::~Buffer()
-    {
-        alDeleteBuffers(1, &mBufferId);
-        SoundSystem::doErrorCheck("Could not delete buffer");
     }
 
 }
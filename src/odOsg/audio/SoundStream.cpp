@@ -0,0 +1,171 @@
+/*
+ * SoundStream.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: zal
+ */
+
+#include <odOsg/audio/SoundStream.h>
+
+#include <odCore/Logger.h>
+
+#include <odOsg/audio/SoundSystem.h>
+#include <odOsg/audio/Buffer.h>
+
+namespace odOsg
+{
+
+    SoundStream::SoundStream(SoundSystem &ss, std::shared_ptr<odDb::Sound> sound, ALuint sourceId)
+    : mSourceId(sourceId)
+    , mSound(sound)
+    , mDecoder(*sound, BUFFER_SIZE)
+    , mFormat(Buffer::getFormatForSound(*sound))
+    , mLooping(false)
+    , mPlaying(false)
+    , mChunk(BUFFER_SIZE)
+    {
+        for(size_t i = 0; i < BUFFER_COUNT; ++i)
+        {
+            mFreeBuffers.push_back(std::make_shared<Buffer>(ss));
+        }
+
+        restart();
+    }
+
+    SoundStream::~SoundStream()
+    {
+        alSourceStop(mSourceId);
+        SoundSystem::doErrorCheck("Could not stop source to delete sound stream");
+
+        _unqueueAll();
+    }
+
+    void SoundStream::play()
+    {
+        ALint state;
+        alGetSourcei(mSourceId, AL_SOURCE_STATE, &state);
+        SoundSystem::doErrorCheck("Failed to query state of streaming source");
+
+        if(state == AL_STOPPED)
+        {
+            // the source played all of the queued data or was stopped. since AL would start over with whatever
+            //  is still queued, we have to start decoding from the beginning
+            restart();
+        }
+
+        mPlaying = true;
+    }
+
+    void SoundStream::stop()
+    {
+        mPlaying = false;
+    }
+
+    void SoundStream::restart()
+    {
+        _unqueueAll();
+
+        mDecoder.rewind();
+
+        while(!mFreeBuffers.empty())
+        {
+            auto buffer = mFreeBuffers.back();
+            if(!_fillBuffer(*buffer))
+            {
+                break;
+            }
+
+            ALuint bufferId = buffer->getBufferId();
+            alSourceQueueBuffers(mSourceId, 1, &bufferId);
+            SoundSystem::doErrorCheck("Could not queue buffer into source");
+
+            mFreeBuffers.pop_back();
+            mQueuedBuffers.push_back(buffer);
+        }
+    }
+
+    void SoundStream::update()
+    {
+        ALint processedBuffers;
+        alGetSourcei(mSourceId, AL_BUFFERS_PROCESSED, &processedBuffers);
+        SoundSystem::doErrorCheck("Failed to query number of processed buffers of streaming source");
+
+        // AL unqueues buffers in the order they were queued, so the ones we need are always at the front
+        for(ALint i = 0; i < processedBuffers && !mQueuedBuffers.empty(); ++i)
+        {
+            auto buffer = mQueuedBuffers.front();
+            mQueuedBuffers.pop_front();
+
+            ALuint bufferId = buffer->getBufferId();
+            alSourceUnqueueBuffers(mSourceId, 1, &bufferId);
+            SoundSystem::doErrorCheck("Could not unqueue buffer from streaming source");
+
+            if(_fillBuffer(*buffer))
+            {
+                alSourceQueueBuffers(mSourceId, 1, &bufferId);
+                SoundSystem::doErrorCheck("Could not queue buffer into streaming source");
+                mQueuedBuffers.push_back(buffer);
+
+            }else
+            {
+                mFreeBuffers.push_back(buffer);
+            }
+        }
+
+        if(!mPlaying)
+        {
+            return;
+        }
+
+        ALint state;
+        alGetSourcei(mSourceId, AL_SOURCE_STATE, &state);
+        SoundSystem::doErrorCheck("Failed to query state of streaming source");
+
+        if(state == AL_STOPPED)
+        {
+            if(mQueuedBuffers.empty())
+            {
+                // regular end of a non-looping sound
+                mPlaying = false;
+
+            }else
+            {
+                Logger::warn() << "Sound stream underrun while playing '" << mSound->getName() << "'. Resuming";
+                alSourcePlay(mSourceId);
+                SoundSystem::doErrorCheck("Could not resume streaming source after underrun");
+            }
+        }
+    }
+
+    bool SoundStream::_fillBuffer(Buffer &buffer)
+    {
+        size_t chunkSize = mDecoder.read(mChunk.data(), mChunk.size());
+        while(chunkSize < mChunk.size() && mLooping && mSound->getDecompressedSize() > 0)
+        {
+            mDecoder.rewind();
+            chunkSize += mDecoder.read(mChunk.data() + chunkSize, mChunk.size() - chunkSize);
+        }
+
+        if(chunkSize == 0)
+        {
+            return false;
+        }
+
+        buffer.setData(mFormat, mChunk.data(), chunkSize, mSound->getSamplingFrequency());
+
+        return true;
+    }
+
+    void SoundStream::_unqueueAll()
+    {
+        alSourcei(mSourceId, AL_BUFFER, AL_NONE); // only allowed on stopped sources. unqueues everything
+        SoundSystem::doErrorCheck("Could not unqueue buffers from streaming source");
+
+        for(auto &buffer : mQueuedBuffers)
+        {
+            mFreeBuffers.push_back(buffer);
+        }
+        mQueuedBuffers.clear();
+    }
+
+}
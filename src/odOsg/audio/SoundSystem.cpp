@@ -8,6 +8,7 @@
 #include <odOsg/audio/SoundSystem.h>
 
 #include <exception>
+#include <cassert>
 
 #include <AL/al.h>
 
@@ -19,6 +20,7 @@
 #include <odCore/db/Segment.h>
 
 #include <odCore/audio/music/SegmentPlayer.h>
+#include <odCore/audio/music/MusicRenderer.h>
 
 #include <odOsg/audio/Source.h>
 #include <odOsg/audio/StreamingSource.h>
@@ -38,6 +40,7 @@ namespace odOsg
     : mContext() // only support default device for now
     , mTerminateFlag(false)
     , mSegmentPlayer(nullptr)
+    , mMusicRenderTerminateFlag(false)
     {
         mContext.makeCurrent();
 
@@ -47,6 +50,8 @@ namespace odOsg
 
     SoundSystem::~SoundSystem()
     {
+        _stopMusicRenderThread();
+
         if(mMusicSource != nullptr)
         {
             mMusicSource->setBufferFillCallback(nullptr);
@@ -99,29 +104,22 @@ namespace odOsg
 
     void SoundSystem::loadMusicContainer(const od::FilePath &rrcPath)
     {
+        // the render thread uses the container and the cache we are about to replace
+        _stopMusicRenderThread();
+
         mMusicContainer = std::make_unique<odDb::MusicContainer>(rrcPath);
 
-#ifdef USE_FLUIDSYNTH
-        auto fluidSynth = std::make_unique<FluidSynth>();
-        fluidSynth->setMusicContainer(mMusicContainer.get());
-        mSynth = std::move(fluidSynth);
-#else
-        mSynth = std::make_unique<DummySynth>();
-        //mSynth = std::make_unique<StupidSineSynth>(5);
-#endif
+        mSynth = _createSynth();
         mSegmentPlayer = std::make_unique<odAudio::SegmentPlayer>(*mSynth);
 
-        auto musicSource = std::make_shared<StreamingSource>(*this, 128, 64, true);
-        auto fillCallback = [this](int16_t *buffer, size_t size)
-        {
-            assert(size % 2 == 0);
+        // rendered music is cached next to the container, so caches of different installs and mods don't mix
+        mMusicCache = std::make_unique<odAudio::MusicCache>(rrcPath.dir(), rrcPath.fileStrNoExt(), mSynth->getSettingsKey(), mContext.getOutputFrequency());
 
-            mSynth->fillInterleavedStereoBuffer(buffer, size);
+        mMusicRenderTerminateFlag = false;
+        mMusicRenderThread = std::thread(&SoundSystem::_doMusicRenderStuff, this);
+        od::ThreadUtils::setThreadName(mMusicRenderThread, "music render");
 
-            float passedTime = size/(2.0*mContext.getOutputFrequency());
-            mSegmentPlayer->update(passedTime);
-        };
-        musicSource->setBufferFillCallback(fillCallback);
+        auto musicSource = std::make_shared<StreamingSource>(*this, 128, 64, true);
         mMusicSource = musicSource;
 
         std::lock_guard<std::mutex> lock(mWorkerMutex);
@@ -140,10 +138,24 @@ namespace odOsg
             OD_PANIC() << "No segment player present. Seems like the music thread died";
         }
 
-        auto segment = mMusicContainer->loadSegment(musicId);
+        uint32_t segmentHash = mMusicContainer->getSegmentDataHash(musicId);
+        std::shared_ptr<odAudio::MusicCache::Stream> cachedMusic = mMusicCache->open(musicId, segmentHash);
+        if(cachedMusic != nullptr)
+        {
+            mSegmentPlayer->pause();
 
-        mSegmentPlayer->setSegment(segment);
-        mSegmentPlayer->play();
+            auto fillCallback = [cachedMusic](int16_t *buffer, size_t size)
+            {
+                cachedMusic->read(buffer, size);
+            };
+            mMusicSource->setBufferFillCallback(fillCallback);
+
+        }else
+        {
+            // synthesize this playback live. once the render is done, the next one comes from the cache
+            _requestMusicRender(musicId, segmentHash);
+            _playLiveSynthesizedMusic(musicId);
+        }
 
         mMusicSource->play(0.0);
     }
@@ -151,6 +163,7 @@ namespace odOsg
     void SoundSystem::stopMusic()
     {
         mSegmentPlayer->pause();
+        mMusicSource->setBufferFillCallback(nullptr);
     }
 
     void SoundSystem::doErrorCheck(const std::string &failmsg)
@@ -190,6 +203,147 @@ namespace odOsg
         OD_PANIC() << failmsg << alErrorMsg;
     }
 
+    std::unique_ptr<odAudio::MidiSynth> SoundSystem::_createSynth()
+    {
+#ifdef USE_FLUIDSYNTH
+        auto fluidSynth = std::make_unique<FluidSynth>();
+        fluidSynth->setMusicContainer(mMusicContainer.get());
+        return fluidSynth;
+#else
+        return std::make_unique<DummySynth>();
+        //return std::make_unique<StupidSineSynth>(5);
+#endif
+    }
+
+    void SoundSystem::_requestMusicRender(odAudio::MusicId musicId, uint32_t segmentHash)
+    {
+        if(!mRequestedMusicRenders.insert(musicId).second)
+        {
+            return;
+        }
+
+        Logger::info() << "Music " << std::hex << musicId << std::dec << " not yet rendered. Rendering it in the background";
+
+        // the container is not thread-safe, so the segment has to be loaded here
+        MusicRenderJob job{musicId, segmentHash, mMusicContainer->loadSegment(musicId)};
+
+        {
+            std::lock_guard<std::mutex> lock(mMusicRenderMutex);
+            mMusicRenderJobs.push_back(std::move(job));
+        }
+
+        mMusicRenderCondition.notify_one();
+    }
+
+    void SoundSystem::_renderMusic(odAudio::MidiSynth &synth, const MusicRenderJob &job)
+    {
+        auto writer = mMusicCache->beginStore(job.musicId, job.segmentHash);
+        if(writer == nullptr)
+        {
+            Logger::warn() << "Could not cache rendered music. It will keep being synthesized in realtime";
+            return;
+        }
+
+        // PCM goes into the cache file chunk by chunk, so a whole segment is never held in memory
+        auto consumer = [this, &writer](const int16_t *samples, size_t size)
+        {
+            return !mMusicRenderTerminateFlag && writer->write(samples, size);
+        };
+
+        odAudio::MusicRenderer renderer(synth, mContext.getOutputFrequency());
+        if(!renderer.render(job.segment, consumer))
+        {
+            if(!mMusicRenderTerminateFlag)
+            {
+                Logger::warn() << "Could not cache rendered music. It will keep being synthesized in realtime";
+            }
+
+            return;
+        }
+
+        if(!writer->commit())
+        {
+            Logger::warn() << "Could not cache rendered music. It will keep being synthesized in realtime";
+            return;
+        }
+
+        Logger::verbose() << "Rendered music " << std::hex << job.musicId << std::dec << ". It will be played from cache from now on";
+    }
+
+    void SoundSystem::_stopMusicRenderThread()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mMusicRenderMutex);
+            mMusicRenderTerminateFlag = true;
+            mMusicRenderJobs.clear();
+        }
+
+        mMusicRenderCondition.notify_all();
+        if(mMusicRenderThread.joinable()) mMusicRenderThread.join();
+
+        mRequestedMusicRenders.clear();
+    }
+
+    void SoundSystem::_playLiveSynthesizedMusic(odAudio::MusicId musicId)
+    {
+        auto segment = mMusicContainer->loadSegment(musicId);
+
+        mSegmentPlayer->setSegment(segment);
+        mSegmentPlayer->play();
+
+        auto fillCallback = [this](int16_t *buffer, size_t size)
+        {
+            assert(size % 2 == 0);
+
+            mSynth->fillInterleavedStereoBuffer(buffer, size);
+
+            float passedTime = size/(2.0*mContext.getOutputFrequency());
+            mSegmentPlayer->update(passedTime);
+        };
+        mMusicSource->setBufferFillCallback(fillCallback);
+    }
+
+    void SoundSystem::_doMusicRenderStuff()
+    {
+        Logger::verbose() << "Started music render thread";
+
+        // use a separate synth so we don't mess with the state of the one used for live playback. it is created
+        //  on first use, as loading instruments can take a while, too
+        std::unique_ptr<odAudio::MidiSynth> renderSynth;
+
+        while(true)
+        {
+            MusicRenderJob job;
+            {
+                std::unique_lock<std::mutex> lock(mMusicRenderMutex);
+                mMusicRenderCondition.wait(lock, [this](){ return mMusicRenderTerminateFlag || !mMusicRenderJobs.empty(); });
+                if(mMusicRenderTerminateFlag)
+                {
+                    break;
+                }
+
+                job = std::move(mMusicRenderJobs.front());
+                mMusicRenderJobs.pop_front();
+            }
+
+            try
+            {
+                if(renderSynth == nullptr)
+                {
+                    renderSynth = _createSynth();
+                }
+
+                _renderMusic(*renderSynth, job);
+
+            }catch(std::exception &e)
+            {
+                Logger::error() << "Error while rendering music " << std::hex << job.musicId << std::dec << ": " << e.what();
+            }
+        }
+
+        Logger::verbose() << "Terminated music render thread";
+    }
+
     void SoundSystem::_doWorkerStuff()
     {
         Logger::verbose() << "Started sound worker thread";
@@ -209,6 +363,7 @@ namespace odOsg
                     auto source = weakSource.lock();
                     if(source != nullptr)
                     {
+                        std::lock_guard<std::mutex> sourceLock(source->getMutex());
                         source->update(relTime);
                     }
 
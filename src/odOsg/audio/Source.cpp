@@ -14,6 +14,7 @@
 
 #include <odOsg/audio/SoundSystem.h>
 #include <odOsg/audio/Buffer.h>
+#include <odOsg/audio/SoundStream.h>
 
 namespace odOsg
 {
@@ -44,6 +45,7 @@ namespace odOsg
     Source::Source(SoundSystem &ss)
     : mSoundSystem(ss)
     , mSourceId(0)
+    , mLooping(false)
     , mSourceGain(1.0)
     , mSoundGain(1.0)
     , mFadingValue(1.0)
@@ -59,6 +61,8 @@ namespace odOsg
     {
         std::lock_guard<std::mutex> lock(getMutex());
 
+        mCurrentStream = nullptr;
+
         alSourceStop(mSourceId);
         SoundSystem::doErrorCheck("Could not stop source to delete it");
 
@@ -128,7 +132,18 @@ namespace odOsg
     void Source::setLooping(bool looping)
     {
         std::lock_guard<std::mutex> lock(getMutex());
-        _setProperty(AL_LOOPING, looping, "Could not set source looping state");
+
+        mLooping = looping;
+
+        if(mCurrentStream != nullptr)
+        {
+            // AL would loop over the queued buffers only. the stream has to handle looping itself
+            mCurrentStream->setLooping(looping);
+
+        }else
+        {
+            _setProperty(AL_LOOPING, looping, "Could not set source looping state");
+        }
     }
 
     void Source::setGain(float gain)
@@ -144,22 +159,37 @@ namespace odOsg
 
         mCurrentSound = s;
 
-        if(mCurrentBuffer != nullptr)
+        if(mCurrentBuffer != nullptr || mCurrentStream != nullptr)
         {
             alSourceStop(mSourceId);
             SoundSystem::doErrorCheck("Could not stop source to unqueue buffer");
 
             alSourcei(mSourceId, AL_BUFFER, AL_NONE); // unqueue any buffers
             SoundSystem::doErrorCheck("Could not unqueue buffer");
+
+            mCurrentBuffer = nullptr;
+            mCurrentStream = nullptr;
         }
 
         if(mCurrentSound != nullptr)
         {
-            auto buffer = mSoundSystem.getOrCreateBuffer(mCurrentSound);
-            mCurrentBuffer = od::confident_downcast<Buffer>(buffer);
+            if(mCurrentSound->shouldStream())
+            {
+                _setProperty(AL_LOOPING, false, "Could not disable looping for streamed sound");
+
+                mCurrentStream = std::make_unique<SoundStream>(mSoundSystem, mCurrentSound, mSourceId);
+                mCurrentStream->setLooping(mLooping);
+
+            }else
+            {
+                auto buffer = mSoundSystem.getOrCreateBuffer(mCurrentSound);
+                mCurrentBuffer = od::confident_downcast<Buffer>(buffer);
 
-            alSourcei(mSourceId, AL_BUFFER, mCurrentBuffer->getBufferId());
-            SoundSystem::doErrorCheck("Could not attach sound buffer to source");
+                _setProperty(AL_LOOPING, mLooping, "Could not set source looping state");
+
+                alSourcei(mSourceId, AL_BUFFER, mCurrentBuffer->getBufferId());
+                SoundSystem::doErrorCheck("Could not attach sound buffer to source");
+            }
 
             // sounds with a lower-than-output sampling rate seem to have a higher volume than indicated by their
             //  volume field. amplitudes seems to be scaled by the resampling factor.
@@ -168,10 +198,6 @@ namespace odOsg
 
             mSoundGain = resamplingGain * mCurrentSound->getLinearGain();
             _updateSourceGain_locked();
-
-        }else
-        {
-            mCurrentBuffer = nullptr;
         }
     }
 
@@ -189,6 +215,11 @@ namespace odOsg
         }
         _updateSourceGain_locked();
 
+        if(mCurrentStream != nullptr)
+        {
+            mCurrentStream->play();
+        }
+
         alSourcePlay(mSourceId);
         SoundSystem::doErrorCheck("Could not play source");
     }
@@ -202,6 +233,11 @@ namespace odOsg
             alSourceStop(mSourceId);
             SoundSystem::doErrorCheck("Could not stop source");
 
+            if(mCurrentStream != nullptr)
+            {
+                mCurrentStream->stop();
+            }
+
         }else
         {
             mFadingValue.move(0.0f, fadeOutTime);
@@ -215,6 +251,11 @@ namespace odOsg
         {
             _updateSourceGain_locked();
         }
+
+        if(mCurrentStream != nullptr)
+        {
+            mCurrentStream->update();
+        }
     }
 
     void Source::_updateSourceGain_locked()
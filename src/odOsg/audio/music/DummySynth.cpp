@@ -72,6 +72,11 @@ namespace odOsg
         Logger::debug() << "Dummy synth: (assign preset) channel=" << (int)channel << " bank=" << bank << " patch=" << patch
                 << " dls=" << dlsGuid;
     }
+
+    std::string DummySynth::getSettingsKey() const
+    {
+        return "dummy";
+    }
 }
 
 
@@ -9,6 +9,7 @@
 
 #include <sstream>
 #include <cstdio>
+#include <cstring>
 
 #include <odCore/Logger.h>
 #include <odCore/Panic.h>
@@ -18,49 +19,68 @@
 namespace odOsg
 {
 
+    /**
+     * @brief Lets fluidsynth read a DLS straight from the memory-mapped music container.
+     */
     class DlsLoaderWrapper
     {
     public:
 
         DlsLoaderWrapper(odDb::MusicContainer &container, const od::Guid &guid)
-        : mContainer(container)
-        , mGuid(guid)
-        , mInputCursor(mContainer.getCursorForDls(guid))
-        , mReader(mInputCursor.getReader())
-        , mDataOffset(mInputCursor.getDirIterator()->dataOffset)
-        , mDataSize(mInputCursor.getDirIterator()->dataSize)
+        : mGuid(guid)
+        , mData(container.getDlsData(guid))
+        , mPosition(0)
         {
         }
 
-        void read(void *buf, int count)
+        int read(void *buf, int count)
         {
-            mReader.read(reinterpret_cast<char*>(buf), count);
+            if(count < 0 || mPosition + count > mData.size)
+            {
+                Logger::error() << "Tried to read past end of DLS " << mGuid;
+                return FLUID_FAILED;
+            }
+
+            std::memcpy(buf, mData.data + mPosition, count);
+            mPosition += count;
+
+            return FLUID_OK;
         }
 
-        void seek(long offset, int origin)
+        int seek(long offset, int origin)
         {
+            long newPosition;
             switch(origin)
             {
             case SEEK_SET:
-                mReader.seek(offset + mDataOffset);
+                newPosition = offset;
                 break;
 
             case SEEK_CUR:
-                mReader.seek(offset + mReader.tell());
+                newPosition = mPosition + offset;
                 break;
 
             case SEEK_END:
-                mReader.seek(offset + mDataOffset + mDataSize);
+                newPosition = mData.size + offset;
                 break;
 
             default:
                 OD_PANIC() << "Unsupported seek offset";
             }
+
+            if(newPosition < 0 || static_cast<size_t>(newPosition) > mData.size)
+            {
+                return FLUID_FAILED;
+            }
+
+            mPosition = newPosition;
+
+            return FLUID_OK;
         }
 
         long tell()
         {
-            return mReader.tell() - mDataOffset;
+            return mPosition;
         }
 
         static void *_dlsLoader_open(const char *filename)
@@ -90,9 +110,7 @@ namespace odOsg
             if(handle == nullptr) return FLUID_FAILED;
 
             DlsLoaderWrapper *loader = reinterpret_cast<DlsLoaderWrapper*>(handle);
-            loader->read(buf, count);
-
-            return FLUID_OK;
+            return loader->read(buf, count);
         }
 
         static int _dlsLoader_seek(void *handle, long offset, int origin)
@@ -100,9 +118,7 @@ namespace odOsg
             if(handle == nullptr) return FLUID_FAILED;
 
             DlsLoaderWrapper *loader = reinterpret_cast<DlsLoaderWrapper*>(handle);
-            loader->seek(offset, origin);
-
-            return FLUID_OK;
+            return loader->seek(offset, origin);
         }
 
         static int _dlsLoader_close(void *handle)
@@ -121,12 +137,9 @@ namespace odOsg
 
     private:
 
-        odDb::MusicContainer &mContainer;
         od::Guid mGuid;
-        od::SrscFile::RecordInputCursor mInputCursor;
-        od::DataReader mReader;
-        size_t mDataOffset;
-        size_t mDataSize;
+        odDb::MusicContainer::RecordData mData;
+        size_t mPosition;
 
     };
 
@@ -245,6 +258,12 @@ namespace odOsg
         _errorCheck(result, "Failed to select program");
     }
 
+    std::string FluidSynth::getSettingsKey() const
+    {
+        // the only setting we change is the timing source, which does not affect the output. the version might, though
+        return std::string("fluidsynth") + FLUIDSYNTH_VERSION;
+    }
+
     int FluidSynth::_getOrLoadDls(const od::Guid &dlsGuid)
     {
         auto it = mSoundFontIdMap.find(dlsGuid);
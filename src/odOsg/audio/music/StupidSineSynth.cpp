@@ -100,6 +100,11 @@ namespace odOsg
     {
     }
 
+    std::string StupidSineSynth::getSettingsKey() const
+    {
+        return "sine" + std::to_string(mChannel);
+    }
+
     void StupidSineSynth::setChannel(uint8_t channel)
     {
         mChannel = channel;
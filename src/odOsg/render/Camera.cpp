@@ -10,26 +10,33 @@
 #include <odCore/Panic.h>
 
 #include <odOsg/GlmAdapter.h>
+#include <odOsg/render/Renderer.h>
 
 namespace odOsg
 {
 
-    Camera::Camera(osg::Camera *osgCam)
-    : mOsgCamera(osgCam)
+    Camera::Camera(Renderer &renderer, osg::Camera *osgCam)
+    : mRenderer(renderer)
+    , mOsgCamera(osgCam)
     , mIgnoreViewChanges(false)
+    , mHasEyePoint(false)
+    , mEyePoint(0.0)
+    , mViewMatrixEyePoint(0.0)
     {
         OD_CHECK_ARG_NONNULL(osgCam);
+
+        publishViewMatrixEyePoint();
     }
 
     glm::vec3 Camera::getEyePoint()
     {
-        osg::Vec3 eye;
-        osg::Vec3 up;
-        osg::Vec3 front;
-        osg::Matrix viewMatrix = mOsgCamera->getViewMatrix();
-        viewMatrix.getLookAt(eye, front, up, 1);
+        if(mHasEyePoint && !mIgnoreViewChanges)
+        {
+            return mEyePoint;
+        }
 
-        return GlmAdapter::toGlm(eye);
+        std::lock_guard<std::mutex> lock(mViewMatrixEyePointMutex);
+        return mViewMatrixEyePoint;
     }
 
     void Camera::lookAt(const glm::vec3 &eye, const glm::vec3 &center, const glm::vec3 &up)
@@ -39,11 +46,30 @@ namespace odOsg
             return;
         }
 
+        mEyePoint = eye;
+        mHasEyePoint = true;
+
         osg::Vec3 osgEye = GlmAdapter::toOsg(eye);
         osg::Vec3 osgUp = GlmAdapter::toOsg(up);
         osg::Vec3 osgCenter = GlmAdapter::toOsg(center);
 
-        mOsgCamera->setViewMatrixAsLookAt(osgEye, osgCenter, osgUp);
+        osg::ref_ptr<osg::Camera> osgCamera = mOsgCamera;
+        mRenderer.applyOrStageSceneChange([osgCamera, osgEye, osgCenter, osgUp]()
+        {
+            osgCamera->setViewMatrixAsLookAt(osgEye, osgCenter, osgUp);
+        });
+    }
+
+    void Camera::publishViewMatrixEyePoint()
+    {
+        osg::Vec3 eye;
+        osg::Vec3 up;
+        osg::Vec3 front;
+        osg::Matrix viewMatrix = mOsgCamera->getViewMatrix();
+        viewMatrix.getLookAt(eye, front, up, 1);
+
+        std::lock_guard<std::mutex> lock(mViewMatrixEyePointMutex);
+        mViewMatrixEyePoint = GlmAdapter::toGlm(eye);
     }
 
 
@@ -0,0 +1,77 @@
+/*
+ * DrawCounter.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: zal
+ */
+
+#include <odOsg/render/DrawCounter.h>
+
+#include <algorithm>
+
+#include <osg/Geometry>
+#include <osg/State>
+
+namespace odOsg
+{
+
+    DrawCounter::DrawCounter()
+    : mEnabled(false)
+    , mDrawCalls(0)
+    , mStateChanges(0)
+    , mInstancedDrawCalls(0)
+    , mInstances(0)
+    {
+    }
+
+    void DrawCounter::drawImplementation(osg::RenderInfo &renderInfo, const osg::Drawable *drawable) const
+    {
+        if(isEnabled())
+        {
+            // the stack holds the StateSets above the drawable's state graph leaf. the leaf itself is the drawable's own StateSet
+            const osg::State::StateSetStack &stack = renderInfo.getState()->getStateSetStack();
+            bool pathChanged = (mLastStatePath.size() != stack.size() + 1)
+                    || !std::equal(stack.begin(), stack.end(), mLastStatePath.begin())
+                    || mLastStatePath.back() != drawable->getStateSet();
+            if(pathChanged)
+            {
+                mLastStatePath.assign(stack.begin(), stack.end());
+                mLastStatePath.push_back(drawable->getStateSet());
+                mStateChanges.fetch_add(1, std::memory_order_relaxed);
+            }
+
+            const osg::Geometry *geometry = drawable->asGeometry();
+            if(geometry != nullptr)
+            {
+                for(unsigned int i = 0; i < geometry->getNumPrimitiveSets(); ++i)
+                {
+                    const osg::PrimitiveSet *ps = geometry->getPrimitiveSet(i);
+                    mDrawCalls.fetch_add(1, std::memory_order_relaxed);
+
+                    if(ps->getNumInstances() > 0)
+                    {
+                        mInstancedDrawCalls.fetch_add(1, std::memory_order_relaxed);
+                        mInstances.fetch_add(ps->getNumInstances(), std::memory_order_relaxed);
+                    }
+                }
+
+            }else
+            {
+                mDrawCalls.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        drawable->drawImplementation(renderInfo);
+    }
+
+    RenderStatistics DrawCounter::takeStatistics()
+    {
+        RenderStatistics stats;
+        stats.drawCalls = mDrawCalls.exchange(0, std::memory_order_relaxed);
+        stats.stateChanges = mStateChanges.exchange(0, std::memory_order_relaxed);
+        stats.instancedDrawCalls = mInstancedDrawCalls.exchange(0, std::memory_order_relaxed);
+        stats.instances = mInstances.exchange(0, std::memory_order_relaxed);
+        return stats;
+    }
+
+}
@@ -8,13 +8,15 @@
 #include <odCore/Downcast.h>
 
 #include <odOsg/render/Handle.h>
+#include <odOsg/render/Renderer.h>
 #include <odOsg/GlmAdapter.h>
 
 namespace odOsg
 {
 
-    Group::Group()
-    : mParentGroup(nullptr)
+    Group::Group(Renderer &renderer)
+    : mRenderer(renderer)
+    , mParentGroup(nullptr)
     , mTransform(new osg::MatrixTransform())
     {
     }
@@ -23,7 +25,9 @@ namespace odOsg
     {
         if(mParentGroup != nullptr)
         {
-            mParentGroup->removeChild(mTransform);
+            osg::ref_ptr<osg::Group> parent = mParentGroup;
+            osg::ref_ptr<osg::MatrixTransform> transform = mTransform;
+            mRenderer.applyOrStageSceneChange([parent, transform](){ parent->removeChild(transform); });
         }
     }
 
@@ -34,7 +38,9 @@ namespace odOsg
         auto myHandle = od::confident_downcast<Handle>(handle);
         mHandles.push_back(myHandle);
 
-        mTransform->addChild(myHandle->getOsgNode());
+        osg::ref_ptr<osg::MatrixTransform> transform = mTransform;
+        osg::ref_ptr<osg::Node> node = myHandle->getOsgNode();
+        mRenderer.applyOrStageSceneChange([transform, node](){ transform->addChild(node); });
     }
 
     void Group::removeHandle(std::shared_ptr<odRender::Handle> handle)
@@ -46,7 +52,10 @@ namespace odOsg
         auto it = std::find(mHandles.begin(), mHandles.end(), myHandle);
         if(it != mHandles.end())
         {
-            mTransform->removeChild(myHandle->getOsgNode());
+            osg::ref_ptr<osg::MatrixTransform> transform = mTransform;
+            osg::ref_ptr<osg::Node> node = myHandle->getOsgNode();
+            mRenderer.applyOrStageSceneChange([transform, node](){ transform->removeChild(node); });
+
             mHandles.erase(it);
         }
     }
@@ -64,13 +73,15 @@ namespace odOsg
     void Group::setMatrix(const glm::mat4 &m)
     {
         osg::Matrix osgMatrix = GlmAdapter::toOsg(glm::transpose(m)); // FIXME: this transpose is suspicios...
-        mTransform->setMatrix(osgMatrix);
+        osg::ref_ptr<osg::MatrixTransform> transform = mTransform;
+        mRenderer.applyOrStageSceneChange([transform, osgMatrix](){ transform->setMatrix(osgMatrix); });
     }
 
     void Group::setVisible(bool visible)
     {
         int mask = visible ? -1 : 0;
-        mTransform->setNodeMask(mask);
+        osg::ref_ptr<osg::MatrixTransform> transform = mTransform;
+        mRenderer.applyOrStageSceneChange([transform, mask](){ transform->setNodeMask(mask); });
     }
 
 }
@@ -18,6 +18,7 @@
 #include <odOsg/Constants.h>
 #include <odOsg/render/Model.h>
 #include <odOsg/render/Rig.h>
+#include <odOsg/render/Renderer.h>
 
 namespace odOsg
 {
@@ -72,50 +73,77 @@ namespace odOsg
 
 
     Handle::Handle(Renderer &renderer)
-    : mParentGroup(nullptr)
+    : mRenderer(renderer)
+    , mState({glm::vec3(0.0), glm::quat(1.0, 0.0, 0.0, 0.0), glm::vec3(1.0), true})
+    , mIsDirty(false)
+    , mParentGroup(nullptr)
+    , mRenderBin(odRender::RenderBin::NORMAL)
     , mFrameListener(nullptr)
+    , mAttachedInstanced(false)
     , mTransform(new osg::PositionAttitudeTransform)
     , mLightStateAttribute(new LightStateAttribute(renderer, Constants::MAX_LIGHTS))
     {
+        // the transform is not part of the scene yet, so this is safe from any thread
         mTransform->getOrCreateStateSet()->setAttribute(mLightStateAttribute, osg::StateAttribute::ON);
     }
 
     Handle::~Handle()
     {
+        if(mIsDirty)
+        {
+            mRenderer.unmarkHandleDirty(this);
+        }
+
+        // the rig has to be gone before we stage our removal, since it stages changes to our transform, too
+        mRig = nullptr;
+
+        if(mAttachedInstanced)
+        {
+            Renderer *renderer = &mRenderer;
+            auto model = mAttachedModel;
+            osg::ref_ptr<osg::PositionAttitudeTransform> transform = mTransform;
+            mRenderer.applyOrStageSceneChange([renderer, model, transform](){ renderer->removeInstance(model.get(), transform); });
+        }
+
         if(mParentGroup != nullptr)
         {
-            mParentGroup->removeChild(mTransform);
+            osg::ref_ptr<osg::Group> parent = mParentGroup;
+            osg::ref_ptr<osg::PositionAttitudeTransform> transform = mTransform;
+            mRenderer.applyOrStageSceneChange([parent, transform](){ parent->removeChild(transform); });
         }
     }
 
     glm::vec3 Handle::getPosition()
     {
-        return GlmAdapter::toGlm(mTransform->getPosition());
+        return mState.position;
     }
 
     glm::quat Handle::getOrientation()
     {
-        return GlmAdapter::toGlm(mTransform->getAttitude());
+        return mState.orientation;
     }
 
     glm::vec3 Handle::getScale()
     {
-        return GlmAdapter::toGlm(mTransform->getScale());
+        return mState.scale;
     }
 
     void Handle::setPosition(const glm::vec3 &pos)
     {
-        mTransform->setPosition(GlmAdapter::toOsg(pos));
+        mState.position = pos;
+        _stateChanged();
     }
 
     void Handle::setOrientation(const glm::quat &orientation)
     {
-        mTransform->setAttitude(GlmAdapter::toOsg(orientation));
+        mState.orientation = orientation;
+        _stateChanged();
     }
 
     void Handle::setScale(const glm::vec3 &scale)
     {
-        mTransform->setScale(GlmAdapter::toOsg(scale));
+        mState.scale = scale;
+        _stateChanged();
     }
 
     odRender::Model *Handle::getModel()
@@ -125,25 +153,15 @@ namespace odOsg
 
     void Handle::setModel(std::shared_ptr<odRender::Model> model)
     {
-        auto osgModel = od::confident_downcast<Model>(model);
+        mModel = od::confident_downcast<Model>(model);
 
-        if(mModel != nullptr)
-        {
-            mTransform->removeChild(mModel->getGeode());
-        }
-
-        mModel = osgModel;
-
-        if(mModel != nullptr)
-        {
-            mTransform->addChild(mModel->getGeode());
-        }
+        updateModelAttachment();
     }
 
     void Handle::setVisible(bool visible)
     {
-        int mask = visible ? -1 : 0;
-        mTransform->setNodeMask(mask);
+        mState.visible = visible;
+        _stateChanged();
     }
 
     void Handle::setModelPartVisible(size_t partIndex, bool visible)
@@ -153,44 +171,52 @@ namespace odOsg
 
     void Handle::setRenderBin(odRender::RenderBin rb)
     {
-        osg::StateSet *ss = mTransform->getOrCreateStateSet();
+        mRenderBin = rb;
 
-        switch(rb)
+        if(rb == odRender::RenderBin::SKY && mDepth == nullptr)
         {
-        case odRender::RenderBin::NORMAL:
-            if(mDepth != nullptr)
-            {
-                ss->removeAttribute(mDepth);
-                mDepth = nullptr;
-            }
-            ss->setRenderBinDetails(0, "RenderBin");
-            ss->setMode(GL_BLEND, osg::StateAttribute::OFF);
-            break;
+            mDepth = new osg::Depth;
+            mDepth->setWriteMask(false);
+        }
 
-        case odRender::RenderBin::SKY:
-            if(mDepth == nullptr)
-            {
-                mDepth = new osg::Depth;
-                mDepth->setWriteMask(false);
-            }
-            ss->setAttribute(mDepth, osg::StateAttribute::ON);
-            ss->setRenderBinDetails(-1, "RenderBin");
-            ss->setMode(GL_BLEND, osg::StateAttribute::OFF);
-            break;
+        osg::ref_ptr<osg::PositionAttitudeTransform> transform = mTransform;
+        osg::ref_ptr<osg::Depth> depth = mDepth;
+        mRenderer.applyOrStageSceneChange([transform, depth, rb]()
+        {
+            osg::StateSet *ss = transform->getOrCreateStateSet();
 
-        case odRender::RenderBin::TRANSPARENT:
-            if(mDepth != nullptr)
+            switch(rb)
             {
-                ss->removeAttribute(mDepth);
-                mDepth = nullptr;
+            case odRender::RenderBin::NORMAL:
+                if(depth != nullptr)
+                {
+                    ss->removeAttribute(depth);
+                }
+                ss->setRenderBinDetails(0, "RenderBin");
+                ss->setMode(GL_BLEND, osg::StateAttribute::OFF);
+                break;
+
+            case odRender::RenderBin::SKY:
+                ss->setAttribute(depth, osg::StateAttribute::ON);
+                ss->setRenderBinDetails(-1, "RenderBin");
+                ss->setMode(GL_BLEND, osg::StateAttribute::OFF);
+                break;
+
+            case odRender::RenderBin::TRANSPARENT:
+                if(depth != nullptr)
+                {
+                    ss->removeAttribute(depth);
+                }
+                ss->setRenderBinDetails(1, "DepthSortedBin");
+                ss->setMode(GL_BLEND, osg::StateAttribute::ON);
+                break;
+
+            default:
+                break;
             }
-            ss->setRenderBinDetails(1, "DepthSortedBin");
-            ss->setMode(GL_BLEND, osg::StateAttribute::ON);
-            break;
+        });
 
-        default:
-            break;
-        }
+        updateModelAttachment();
     }
 
     void Handle::addFrameListener(odRender::FrameListener *listener)
@@ -204,29 +230,43 @@ namespace odOsg
 
     void Handle::setEnableColorModifier(bool enable)
     {
+        osg::ref_ptr<osg::PositionAttitudeTransform> transform = mTransform;
+
         if(enable && mColorModifierUniform == nullptr)
         {
             mColorModifierUniform = new osg::Uniform("colorModifier", osg::Vec4(1.0, 1.0, 1.0, 1.0));
 
-            osg::StateSet *ss = mTransform->getOrCreateStateSet();
-            ss->setDefine("COLOR_MODIFIER");
-            ss->addUniform(mColorModifierUniform);
+            osg::ref_ptr<osg::Uniform> uniform = mColorModifierUniform;
+            mRenderer.applyOrStageSceneChange([transform, uniform]()
+            {
+                osg::StateSet *ss = transform->getOrCreateStateSet();
+                ss->setDefine("COLOR_MODIFIER");
+                ss->addUniform(uniform);
+            });
 
         }else if(!enable && mColorModifierUniform != nullptr)
         {
-            osg::StateSet *ss = mTransform->getOrCreateStateSet();
-            ss->removeDefine("COLOR_MODIFIER");
-            ss->removeUniform(mColorModifierUniform);
+            osg::ref_ptr<osg::Uniform> uniform = mColorModifierUniform;
+            mRenderer.applyOrStageSceneChange([transform, uniform]()
+            {
+                osg::StateSet *ss = transform->getOrCreateStateSet();
+                ss->removeDefine("COLOR_MODIFIER");
+                ss->removeUniform(uniform);
+            });
 
             mColorModifierUniform = nullptr;
         }
+
+        updateModelAttachment();
     }
 
     void Handle::setColorModifier(const glm::vec4 &cm)
     {
         if(mColorModifierUniform != nullptr)
         {
-            mColorModifierUniform->set(GlmAdapter::toOsg(cm));
+            osg::ref_ptr<osg::Uniform> uniform = mColorModifierUniform;
+            osg::Vec4 osgCm = GlmAdapter::toOsg(cm);
+            mRenderer.applyOrStageSceneChange([uniform, osgCm](){ uniform->set(osgCm); });
 
         }else
         {
@@ -236,11 +276,12 @@ namespace odOsg
 
     odRender::Rig *Handle::getRig()
     {
-        // FIXME: should we enforce the mutex to be locked here?
-
         if(mRig == nullptr)
         {
-            mRig = std::make_unique<Rig>(mTransform);
+            mRig = std::make_unique<Rig>(mRenderer, *this, mTransform);
+
+            // the bones live in our transform's state, so the model must be drawn there
+            updateModelAttachment();
         }
 
         return mRig.get();
@@ -248,17 +289,22 @@ namespace odOsg
 
     void Handle::addLight(std::shared_ptr<od::Light> light)
     {
-        mLightStateAttribute->addLight(light);
+        osg::ref_ptr<LightStateAttribute> lightState = mLightStateAttribute;
+        std::shared_ptr<LightSnapshot> snapshot = mRenderer.getLightSnapshot(light);
+        mRenderer.applyOrStageSceneChange([lightState, snapshot](){ lightState->addLight(snapshot); });
     }
 
     void Handle::removeLight(std::shared_ptr<od::Light> light)
     {
-        mLightStateAttribute->removeLight(light);
+        osg::ref_ptr<LightStateAttribute> lightState = mLightStateAttribute;
+        std::shared_ptr<LightSnapshot> snapshot = mRenderer.getLightSnapshot(light);
+        mRenderer.applyOrStageSceneChange([lightState, snapshot](){ lightState->removeLight(snapshot); });
     }
 
     void Handle::clearLightList()
     {
-        mLightStateAttribute->clearLightList();
+        osg::ref_ptr<LightStateAttribute> lightState = mLightStateAttribute;
+        mRenderer.applyOrStageSceneChange([lightState](){ lightState->clearLightList(); });
     }
 
     void Handle::setGlobalLight(const glm::vec3 &direction, const glm::vec3 &diffuse, const glm::vec3 &ambient)
@@ -267,7 +313,113 @@ namespace odOsg
         osg::Vec3f amb = GlmAdapter::toOsg(ambient);
         osg::Vec3f dir = GlmAdapter::toOsg(direction);
 
-        mLightStateAttribute->setLayerLight(dif, amb, dir);
+        osg::ref_ptr<LightStateAttribute> lightState = mLightStateAttribute;
+        mRenderer.applyOrStageSceneChange([lightState, dif, amb, dir](){ lightState->setLayerLight(dif, amb, dir); });
+    }
+
+    void Handle::rigChanged()
+    {
+        if(!mIsDirty)
+        {
+            mIsDirty = true;
+            mRenderer.markHandleDirty(this);
+        }
+    }
+
+    void Handle::updateModelAttachment()
+    {
+        bool instanced = (mModel != nullptr) && _canBeInstanced();
+        if(mAttachedModel == mModel && mAttachedInstanced == instanced)
+        {
+            return;
+        }
+
+        Renderer *renderer = &mRenderer;
+        auto oldModel = mAttachedModel;
+        bool oldInstanced = mAttachedInstanced;
+        auto newModel = mModel;
+        osg::ref_ptr<osg::PositionAttitudeTransform> transform = mTransform;
+        osg::ref_ptr<LightStateAttribute> lightState = mLightStateAttribute;
+        mRenderer.applyOrStageSceneChange([=]()
+        {
+            if(oldModel != nullptr)
+            {
+                if(oldInstanced)
+                {
+                    renderer->removeInstance(oldModel.get(), transform);
+
+                }else
+                {
+                    transform->removeChild(oldModel->getGeode());
+                }
+            }
+
+            if(newModel != nullptr)
+            {
+                if(instanced)
+                {
+                    renderer->addInstance(newModel, transform, lightState);
+
+                }else
+                {
+                    transform->addChild(newModel->getGeode());
+                }
+            }
+        });
+
+        mAttachedModel = mModel;
+        mAttachedInstanced = instanced;
+    }
+
+    std::function<void()> Handle::makeStateUpdate()
+    {
+        mIsDirty = false;
+
+        osg::ref_ptr<osg::PositionAttitudeTransform> transform = mTransform;
+        StagedState state = mState;
+        std::function<void()> rigUpdate = (mRig != nullptr) ? mRig->makeUpdate() : nullptr;
+
+        return [transform, state, rigUpdate]()
+        {
+            _applyState(*transform, state);
+
+            if(rigUpdate)
+            {
+                rigUpdate();
+            }
+        };
+    }
+
+    void Handle::_applyState(osg::PositionAttitudeTransform &transform, const StagedState &state)
+    {
+        transform.setPosition(GlmAdapter::toOsg(state.position));
+        transform.setAttitude(GlmAdapter::toOsg(state.orientation));
+        transform.setScale(GlmAdapter::toOsg(state.scale));
+        transform.setNodeMask(state.visible ? -1 : 0);
+    }
+
+    bool Handle::_canBeInstanced()
+    {
+        // anything that needs state of its own can't share a draw call. transparent objects need to be sorted individually
+        return mRenderer.isInstancingEnabled()
+                && mModel->isInstanceable()
+                && mRig == nullptr
+                && mColorModifierUniform == nullptr
+                && mRenderBin == odRender::RenderBin::NORMAL
+                && mParentGroup == mRenderer.getLevelRoot();
+    }
+
+    void Handle::_stateChanged()
+    {
+        if(mRenderer.isRenderThread())
+        {
+            _applyState(*mTransform, mState);
+
+        }else if(!mIsDirty)
+        {
+            mIsDirty = true;
+            mRenderer.markHandleDirty(this);
+        }
     }
 
 }
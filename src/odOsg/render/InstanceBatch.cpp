@@ -0,0 +1,355 @@
+/*
+ * InstanceBatch.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: zal
+ */
+
+#include <odOsg/render/InstanceBatch.h>
+
+#include <algorithm>
+
+#include <osg/VertexAttribDivisor>
+
+#include <odCore/Panic.h>
+
+#include <odOsg/Constants.h>
+#include <odOsg/render/Model.h>
+#include <odOsg/render/DrawCounter.h>
+
+namespace odOsg
+{
+
+    /**
+     * @brief Makes a drawable's bounding box consist of only its initial bound.
+     *
+     * The vertices of an instanced geometry are in model space, so the box OSG would compute from them is meaningless.
+     */
+    class InitialBoundOnlyCallback : public osg::Drawable::ComputeBoundingBoxCallback
+    {
+    public:
+
+        virtual osg::BoundingBox computeBound(const osg::Drawable &drawable) const override
+        {
+            return osg::BoundingBox();
+        }
+    };
+
+
+    InstanceBatch::InstanceBatch(std::shared_ptr<Model> model, DrawCounter *drawCounter)
+    : mModel(model)
+    , mRoot(new osg::Group)
+    , mGeode(new osg::Geode)
+    , mDrawnInstanceCount(0)
+    , mLayerLightDiffuseArray(new osg::Vec3Array)
+    , mLayerLightAmbientArray(new osg::Vec3Array)
+    , mLayerLightDirectionArray(new osg::Vec3Array)
+    {
+        OD_CHECK_ARG_NONNULL(model);
+
+        osg::StateSet *ss = mRoot->getOrCreateStateSet();
+        ss->setDefine("INSTANCED");
+
+        mLightColorUniform     = new osg::Uniform(osg::Uniform::FLOAT_VEC3, "instanceLightDiffuse", Constants::MAX_INSTANCE_LIGHTS);
+        mLightIntensityUniform = new osg::Uniform(osg::Uniform::FLOAT, "instanceLightIntensity", Constants::MAX_INSTANCE_LIGHTS);
+        mLightRadiusUniform    = new osg::Uniform(osg::Uniform::FLOAT, "instanceLightRadius", Constants::MAX_INSTANCE_LIGHTS);
+        mLightPositionUniform  = new osg::Uniform(osg::Uniform::FLOAT_VEC3, "instanceLightPosition", Constants::MAX_INSTANCE_LIGHTS);
+        ss->addUniform(mLightColorUniform);
+        ss->addUniform(mLightIntensityUniform);
+        ss->addUniform(mLightRadiusUniform);
+        ss->addUniform(mLightPositionUniform);
+
+        for(size_t i = 0; i < 4; ++i)
+        {
+            mMatrixRowArrays[i] = new osg::Vec4Array;
+            ss->setAttribute(new osg::VertexAttribDivisor(Constants::ATTRIB_INSTANCE_MATRIX_LOCATION + i, 1));
+        }
+
+        for(size_t i = 0; i < 2; ++i)
+        {
+            mLightIndexArrays[i] = new osg::Vec4Array;
+            ss->setAttribute(new osg::VertexAttribDivisor(Constants::ATTRIB_INSTANCE_LIGHTS_LOCATION + i, 1));
+        }
+
+        ss->setAttribute(new osg::VertexAttribDivisor(Constants::ATTRIB_INSTANCE_LAYER_LIGHT_DIFFUSE_LOCATION, 1));
+        ss->setAttribute(new osg::VertexAttribDivisor(Constants::ATTRIB_INSTANCE_LAYER_LIGHT_AMBIENT_LOCATION, 1));
+        ss->setAttribute(new osg::VertexAttribDivisor(Constants::ATTRIB_INSTANCE_LAYER_LIGHT_DIRECTION_LOCATION, 1));
+
+        // share the model's state (program, lighting mode) and the geometries' arrays and state (textures). only the
+        //  primitive sets are copied, since they carry the instance count
+        mGeode->setStateSet(mModel->getGeode()->getStateSet());
+        mRoot->addChild(mGeode);
+
+        osg::ref_ptr<InitialBoundOnlyCallback> boundCallback = new InitialBoundOnlyCallback;
+
+        osg::Geode *modelGeode = mModel->getGeode();
+        for(unsigned int i = 0; i < modelGeode->getNumDrawables(); ++i)
+        {
+            osg::Geometry *sourceGeometry = modelGeode->getDrawable(i)->asGeometry();
+            if(sourceGeometry == nullptr)
+            {
+                continue;
+            }
+
+            osg::ref_ptr<osg::Geometry> geometry = new osg::Geometry(*sourceGeometry, osg::CopyOp::SHALLOW_COPY);
+            geometry->removePrimitiveSet(0, geometry->getNumPrimitiveSets());
+            for(unsigned int p = 0; p < sourceGeometry->getNumPrimitiveSets(); ++p)
+            {
+                osg::PrimitiveSet *sourcePs = sourceGeometry->getPrimitiveSet(p);
+                osg::ref_ptr<osg::PrimitiveSet> ps = static_cast<osg::PrimitiveSet*>(sourcePs->clone(osg::CopyOp::SHALLOW_COPY));
+                ps->setNumInstances(0);
+                geometry->addPrimitiveSet(ps);
+            }
+
+            for(size_t row = 0; row < 4; ++row)
+            {
+                geometry->setVertexAttribArray(Constants::ATTRIB_INSTANCE_MATRIX_LOCATION + row, mMatrixRowArrays[row], osg::Array::BIND_PER_VERTEX);
+            }
+            geometry->setVertexAttribArray(Constants::ATTRIB_INSTANCE_LIGHTS_LOCATION, mLightIndexArrays[0], osg::Array::BIND_PER_VERTEX);
+            geometry->setVertexAttribArray(Constants::ATTRIB_INSTANCE_LIGHTS_LOCATION + 1, mLightIndexArrays[1], osg::Array::BIND_PER_VERTEX);
+            geometry->setVertexAttribArray(Constants::ATTRIB_INSTANCE_LAYER_LIGHT_DIFFUSE_LOCATION, mLayerLightDiffuseArray, osg::Array::BIND_PER_VERTEX);
+            geometry->setVertexAttribArray(Constants::ATTRIB_INSTANCE_LAYER_LIGHT_AMBIENT_LOCATION, mLayerLightAmbientArray, osg::Array::BIND_PER_VERTEX);
+            geometry->setVertexAttribArray(Constants::ATTRIB_INSTANCE_LAYER_LIGHT_DIRECTION_LOCATION, mLayerLightDirectionArray, osg::Array::BIND_PER_VERTEX);
+
+            geometry->setUseDisplayList(false);
+            geometry->setUseVertexBufferObjects(true);
+            geometry->setDataVariance(osg::Object::DYNAMIC);
+            geometry->setComputeBoundingBoxCallback(boundCallback);
+            geometry->setDrawCallback(drawCounter);
+
+            mGeode->addDrawable(geometry);
+            mGeometries.push_back(geometry);
+        }
+
+        mRoot->setNodeMask(0);
+    }
+
+    InstanceBatch::~InstanceBatch()
+    {
+    }
+
+    void InstanceBatch::addInstance(osg::PositionAttitudeTransform *transform, LightStateAttribute *lightState)
+    {
+        OD_CHECK_ARG_NONNULL(transform);
+        OD_CHECK_ARG_NONNULL(lightState);
+
+        Instance instance;
+        instance.transform = transform;
+        instance.lightState = lightState;
+        mInstances.push_back(instance);
+    }
+
+    void InstanceBatch::removeInstance(osg::PositionAttitudeTransform *transform)
+    {
+        auto pred = [transform](Instance &i){ return i.transform == transform; };
+        auto it = std::find_if(mInstances.begin(), mInstances.end(), pred);
+        if(it != mInstances.end())
+        {
+            // order does not matter, so avoid shifting the whole list
+            std::swap(*it, mInstances.back());
+            mInstances.pop_back();
+        }
+    }
+
+    void InstanceBatch::update(bool lightingEnabled)
+    {
+        mLightTable.clear();
+        mLightTableIndices.clear();
+
+        bool matricesChanged = false;
+        bool lightsChanged = false;
+
+        size_t drawnCount = 0;
+        for(auto &instance : mInstances)
+        {
+            if(instance.transform->getNodeMask() == 0)
+            {
+                continue;
+            }
+
+            size_t slot = drawnCount++;
+            if(slot >= mMatrixRowArrays[0]->size())
+            {
+                _resizeInstanceArrays(slot + 1);
+                matricesChanged = true;
+                lightsChanged = true;
+            }
+
+            osg::Matrix m;
+            instance.transform->computeLocalToWorldMatrix(m, nullptr);
+            for(size_t row = 0; row < 4; ++row)
+            {
+                osg::Vec4 rowVector(m(row, 0), m(row, 1), m(row, 2), m(row, 3));
+                osg::Vec4 &current = (*mMatrixRowArrays[row])[slot];
+                if(current != rowVector)
+                {
+                    current = rowVector;
+                    matricesChanged = true;
+                }
+            }
+
+            osg::Vec4 lightIndices[2] = { osg::Vec4(-1, -1, -1, -1), osg::Vec4(-1, -1, -1, -1) };
+            osg::Vec3 layerDiffuse(0.0, 0.0, 0.0);
+            osg::Vec3 layerAmbient(1.0, 1.0, 1.0);
+            osg::Vec3 layerDirection(0.0, 1.0, 0.0);
+            if(lightingEnabled)
+            {
+                const LightStateAttribute &lightState = *instance.lightState;
+
+                auto &lights = lightState.getLights();
+                for(size_t i = 0; i < lights.size() && i < Constants::MAX_LIGHTS; ++i)
+                {
+                    auto light = lights[i].lock();
+                    if(light != nullptr)
+                    {
+                        lightIndices[i/4][i%4] = _getLightTableIndex(light);
+                    }
+                }
+
+                layerDiffuse = lightState.getLayerLightDiffuse();
+                layerAmbient = lightState.getLayerLightAmbient();
+                layerDirection = lightState.getLayerLightDirection();
+            }
+
+            for(size_t i = 0; i < 2; ++i)
+            {
+                osg::Vec4 &current = (*mLightIndexArrays[i])[slot];
+                if(current != lightIndices[i])
+                {
+                    current = lightIndices[i];
+                    lightsChanged = true;
+                }
+            }
+
+            if((*mLayerLightDiffuseArray)[slot] != layerDiffuse
+                    || (*mLayerLightAmbientArray)[slot] != layerAmbient
+                    || (*mLayerLightDirectionArray)[slot] != layerDirection)
+            {
+                (*mLayerLightDiffuseArray)[slot] = layerDiffuse;
+                (*mLayerLightAmbientArray)[slot] = layerAmbient;
+                (*mLayerLightDirectionArray)[slot] = layerDirection;
+                lightsChanged = true;
+            }
+        }
+
+        if(drawnCount < mMatrixRowArrays[0]->size())
+        {
+            _resizeInstanceArrays(drawnCount);
+            matricesChanged = true;
+            lightsChanged = true;
+        }
+
+        if(matricesChanged)
+        {
+            for(auto &array : mMatrixRowArrays)
+            {
+                array->dirty();
+            }
+
+            _updateBound();
+        }
+
+        if(lightsChanged)
+        {
+            mLightIndexArrays[0]->dirty();
+            mLightIndexArrays[1]->dirty();
+            mLayerLightDiffuseArray->dirty();
+            mLayerLightAmbientArray->dirty();
+            mLayerLightDirectionArray->dirty();
+        }
+
+        // light parameters are not tracked for changes. they are cheap to upload and change often (flickering etc.)
+        for(size_t i = 0; i < mLightTable.size(); ++i)
+        {
+            const LightSnapshot &light = *mLightTable[i];
+            mLightColorUniform->setElement(i, light.color);
+            mLightIntensityUniform->setElement(i, light.intensityScaling);
+            mLightRadiusUniform->setElement(i, light.radius);
+            mLightPositionUniform->setElement(i, light.position);
+        }
+
+        if(drawnCount != mDrawnInstanceCount)
+        {
+            for(auto &geometry : mGeometries)
+            {
+                for(unsigned int p = 0; p < geometry->getNumPrimitiveSets(); ++p)
+                {
+                    geometry->getPrimitiveSet(p)->setNumInstances(drawnCount);
+                }
+            }
+
+            mRoot->setNodeMask((drawnCount > 0) ? -1 : 0);
+
+            mDrawnInstanceCount = drawnCount;
+        }
+    }
+
+    float InstanceBatch::_getLightTableIndex(const std::shared_ptr<LightSnapshot> &light)
+    {
+        auto it = mLightTableIndices.find(light.get());
+        if(it != mLightTableIndices.end())
+        {
+            return it->second;
+        }
+
+        // like LightStateAttribute, we ignore excess lights
+        if(mLightTable.size() >= Constants::MAX_INSTANCE_LIGHTS)
+        {
+            return -1;
+        }
+
+        float index = mLightTable.size();
+        mLightTable.push_back(light);
+        mLightTableIndices.insert(std::make_pair(light.get(), index));
+
+        return index;
+    }
+
+    void InstanceBatch::_resizeInstanceArrays(size_t count)
+    {
+        for(auto &array : mMatrixRowArrays)
+        {
+            array->resize(count);
+        }
+
+        mLightIndexArrays[0]->resize(count, osg::Vec4(-1, -1, -1, -1));
+        mLightIndexArrays[1]->resize(count, osg::Vec4(-1, -1, -1, -1));
+        mLayerLightDiffuseArray->resize(count);
+        mLayerLightAmbientArray->resize(count);
+        mLayerLightDirectionArray->resize(count);
+    }
+
+    void InstanceBatch::_updateBound()
+    {
+        const osg::BoundingSphere &modelBound = mModel->getGeode()->getBound();
+
+        osg::BoundingBox bb;
+        for(size_t slot = 0; slot < mMatrixRowArrays[0]->size(); ++slot)
+        {
+            const osg::Vec4 &xRow = (*mMatrixRowArrays[0])[slot];
+            const osg::Vec4 &yRow = (*mMatrixRowArrays[1])[slot];
+            const osg::Vec4 &zRow = (*mMatrixRowArrays[2])[slot];
+            const osg::Vec4 &tRow = (*mMatrixRowArrays[3])[slot];
+
+            const osg::Vec3 &c = modelBound.center();
+            osg::Vec3 center = osg::Vec3(xRow.x(), xRow.y(), xRow.z())*c.x()
+                    + osg::Vec3(yRow.x(), yRow.y(), yRow.z())*c.y()
+                    + osg::Vec3(zRow.x(), zRow.y(), zRow.z())*c.z()
+                    + osg::Vec3(tRow.x(), tRow.y(), tRow.z());
+
+            // the length of the longest basis vector is the largest scale the instance has
+            float maxScale = std::max({ osg::Vec3(xRow.x(), xRow.y(), xRow.z()).length(),
+                                        osg::Vec3(yRow.x(), yRow.y(), yRow.z()).length(),
+                                        osg::Vec3(zRow.x(), zRow.y(), zRow.z()).length() });
+
+            bb.expandBy(osg::BoundingSphere(center, modelBound.radius()*maxScale));
+        }
+
+        for(auto &geometry : mGeometries)
+        {
+            geometry->setInitialBound(bb);
+            geometry->dirtyBound();
+        }
+    }
+
+}
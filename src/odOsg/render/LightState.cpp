@@ -65,7 +65,7 @@ namespace odOsg
         mLights.clear();
     }
 
-    void LightStateAttribute::addLight(std::shared_ptr<od::Light> light)
+    void LightStateAttribute::addLight(std::shared_ptr<LightSnapshot> light)
     {
         // TODO: replace light if the new one fits better (like is closer or something)
         if(mLights.size() < mMaxLightCount)
@@ -74,9 +74,9 @@ namespace odOsg
         }
     }
 
-    void LightStateAttribute::removeLight(std::shared_ptr<od::Light> light)
+    void LightStateAttribute::removeLight(std::shared_ptr<LightSnapshot> light)
     {
-        auto pred = [&light](std::weak_ptr<od::Light> &p){ return p.lock() == light; };
+        auto pred = [&light](std::weak_ptr<LightSnapshot> &p){ return p.lock() == light; };
         auto it = std::find_if(mLights.begin(), mLights.end(), pred);
         if(it != mLights.end())
         {
@@ -18,6 +18,7 @@ namespace odOsg
     Model::Model()
     : mGeode(new osg::Geode)
     , mHasSharedVertexArrays(false)
+    , mInstanceable(false)
     {
     }
 
@@ -42,6 +42,7 @@ namespace odOsg
     , mCWPolys(false)
     , mUseClampedTextures(false)
     , mHasBoneInfo(false)
+    , mPrepared(false)
     {
     }
 
@@ -174,8 +175,13 @@ namespace odOsg
         return model;
     }
 
-    void ModelBuilder::buildAndAppend(Model *model)
+    void ModelBuilder::prepare()
     {
+        if(mPrepared)
+        {
+            return;
+        }
+
         if(mSmoothNormals)
         {
             _buildNormals();
@@ -191,6 +197,13 @@ namespace odOsg
         auto pred = [](Triangle &left, Triangle &right){ return (left.texture.dbIndex << 16 | left.texture.assetId) < (right.texture.dbIndex << 16 | right.texture.assetId); };
         std::sort(mTriangles.begin(), mTriangles.end(), pred);
 
+        mPrepared = true;
+    }
+
+    void ModelBuilder::buildAndAppend(Model *model)
+    {
+        prepare();
+
         // count number of unique textures
         odDb::AssetRef lastTexture = odDb::AssetRef::NULL_REF;
         size_t textureCount = 0;
@@ -261,6 +274,7 @@ namespace odOsg
                 }
 
                 osgGeometry = new osg::Geometry;
+                osgGeometry->setDrawCallback(mRenderer.getDrawCounter());
                 osgGeometry->setVertexArray(osgVertexArray);
                 osgGeometry->setNormalArray(osgNormalArray, osg::Array::BIND_PER_VERTEX);
                 osgGeometry->setTexCoordArray(0, osgTextureCoordArray, osg::Array::BIND_PER_VERTEX);
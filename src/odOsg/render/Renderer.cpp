@@ -8,6 +8,8 @@
 
 #include <odOsg/render/Renderer.h>
 
+#include <algorithm>
+
 #include <osgGA/TrackballManipulator>
 #include <osgViewer/ViewerEventHandlers>
 
@@ -17,9 +19,11 @@
 #include <odCore/Layer.h>
 #include <odCore/Level.h>
 #include <odCore/Downcast.h>
+#include <odCore/Profiler.h>
 
 #include <odCore/render/RendererEventListener.h>
 #include <odCore/render/GuiCallback.h>
+#include <odCore/render/PreparedLayerModel.h>
 
 #include <odCore/db/Model.h>
 
@@ -32,12 +36,39 @@
 #include <odOsg/render/Camera.h>
 #include <odOsg/render/Group.h>
 #include <odOsg/render/Handle.h>
+#include <odOsg/render/InstanceBatch.h>
+#include <odOsg/render/LightState.h>
 #include <odOsg/render/Model.h>
 #include <odOsg/render/ModelBuilder.h>
 
 namespace odOsg
 {
 
+    namespace
+    {
+        class PreparedLayerModel final : public odRender::PreparedLayerModel
+        {
+        public:
+
+            PreparedLayerModel(Renderer &renderer, od::Layer *layer)
+            : builder(renderer, "layer " + layer->getName(), layer->getLevel().getDependencyTable())
+            {
+            }
+
+            ModelBuilder builder;
+        };
+
+        LightSnapshot _makeLightSnapshot(const od::Light &light)
+        {
+            LightSnapshot snapshot;
+            snapshot.color = GlmAdapter::toOsg(light.getColor());
+            snapshot.intensityScaling = light.getIntensityScaling();
+            snapshot.radius = light.getRadius();
+            snapshot.position = GlmAdapter::toOsg(light.getPosition());
+            return snapshot;
+        }
+    }
+
 
     Renderer::Renderer()
     : mShaderFactory("resources/shader_src")
@@ -45,10 +76,15 @@ namespace odOsg
     , mFreeLook(false)
     , mLightingEnabled(true)
     , mSimTime(0.0)
+    , mRenderThreadKnown(false)
+    , mInstancingEnabled(true)
+    , mDrawCounter(new DrawCounter)
+    , mLastFrameStatistics({0, 0, 0, 0})
+    , mStatisticsLogTimer(0.0)
     {
         mViewer = new osgViewer::Viewer;
 
-        mCamera = std::make_shared<Camera>(mViewer->getCamera());
+        mCamera = std::make_shared<Camera>(*this, mViewer->getCamera());
 
         osg::ref_ptr<osgViewer::StatsHandler> statsHandler(new osgViewer::StatsHandler);
         statsHandler->setKeyEventPrintsOutStats(0);
@@ -67,6 +103,7 @@ namespace odOsg
 
         ss->setDefine("MAX_LIGHTS", std::to_string(Constants::MAX_LIGHTS));
         ss->setDefine("MAX_BONES", std::to_string(Constants::MAX_BONES));
+        ss->setDefine("MAX_INSTANCE_LIGHTS", std::to_string(Constants::MAX_INSTANCE_LIGHTS));
 
         mGlobalLightDiffuse   = new osg::Uniform("layerLightDiffuse",   osg::Vec3(0.0, 0.0, 0.0));
         mGlobalLightAmbient   = new osg::Uniform("layerLightAmbient",   osg::Vec3(0.0, 0.0, 0.0));
@@ -86,6 +123,23 @@ namespace odOsg
 
         ss->setAttribute(mShaderFactory.getProgram("default"), osg::StateAttribute::ON);
 
+        // models and layers are built on the simulation thread. the programs they use are set up here, once, so nothing
+        //  but the render thread ever touches the shader factory or changes a program that might be in use
+        mModelProgram = mShaderFactory.getProgram("model");
+        mModelProgram->addBindAttribLocation("influencingBones", Constants::ATTRIB_INFLUENCE_LOCATION);
+        mModelProgram->addBindAttribLocation("vertexWeights", Constants::ATTRIB_WEIGHT_LOCATION);
+        mModelProgram->addBindAttribLocation("instanceMatrix0", Constants::ATTRIB_INSTANCE_MATRIX_LOCATION);
+        mModelProgram->addBindAttribLocation("instanceMatrix1", Constants::ATTRIB_INSTANCE_MATRIX_LOCATION + 1);
+        mModelProgram->addBindAttribLocation("instanceMatrix2", Constants::ATTRIB_INSTANCE_MATRIX_LOCATION + 2);
+        mModelProgram->addBindAttribLocation("instanceMatrix3", Constants::ATTRIB_INSTANCE_MATRIX_LOCATION + 3);
+        mModelProgram->addBindAttribLocation("instanceLights0", Constants::ATTRIB_INSTANCE_LIGHTS_LOCATION);
+        mModelProgram->addBindAttribLocation("instanceLights1", Constants::ATTRIB_INSTANCE_LIGHTS_LOCATION + 1);
+        mModelProgram->addBindAttribLocation("instanceLayerLightDiffuse", Constants::ATTRIB_INSTANCE_LAYER_LIGHT_DIFFUSE_LOCATION);
+        mModelProgram->addBindAttribLocation("instanceLayerLightAmbient", Constants::ATTRIB_INSTANCE_LAYER_LIGHT_AMBIENT_LOCATION);
+        mModelProgram->addBindAttribLocation("instanceLayerLightDirection", Constants::ATTRIB_INSTANCE_LAYER_LIGHT_DIRECTION_LOCATION);
+
+        mLayerProgram = mShaderFactory.getProgram("layer");
+
         mLevelRoot = new osg::Group;
         mSceneRoot->addChild(mLevelRoot);
 
@@ -136,12 +190,14 @@ namespace odOsg
 
     std::shared_ptr<odRender::Geometry> Renderer::createGeometry(odRender::PrimitiveType primitiveType, bool indexed)
     {
-        return std::make_shared<Geometry>(primitiveType, indexed);
+        auto geometry = std::make_shared<Geometry>(primitiveType, indexed);
+        geometry->getOsgGeometry()->setDrawCallback(mDrawCounter);
+        return geometry;
     }
 
     std::shared_ptr<odRender::Group> Renderer::createGroup(odRender::RenderSpace space)
     {
-        auto newGroup = std::make_shared<Group>();
+        auto newGroup = std::make_shared<Group>(*this);
 
         moveToRenderSpace(newGroup, space);
 
@@ -176,17 +232,20 @@ namespace odOsg
             renderModel->setLightingMode(odRender::LightingMode::AMBIENT_DIFFUSE_SPECULAR);
         }
 
-        osg::ref_ptr<osg::Program> modelProgram = getShaderFactory().getProgram("model");
-        modelProgram->addBindAttribLocation("influencingBones", Constants::ATTRIB_INFLUENCE_LOCATION);
-        modelProgram->addBindAttribLocation("vertexWeights", Constants::ATTRIB_WEIGHT_LOCATION);
-        renderModel->getGeode()->getOrCreateStateSet()->setAttribute(modelProgram, osg::StateAttribute::ON);
+        renderModel->getGeode()->getOrCreateStateSet()->setAttribute(mModelProgram, osg::StateAttribute::ON);
+
+        renderModel->setInstanceable(true);
 
         return renderModel;
     }
 
-    std::shared_ptr<odRender::Model> Renderer::createModelFromLayer(od::Layer *layer)
+    std::shared_ptr<odRender::PreparedLayerModel> Renderer::prepareModelFromLayer(od::Layer *layer)
     {
-        ModelBuilder mb(*this, "layer " + layer->getName(), layer->getLevel().getDependencyTable());
+        OD_CHECK_ARG_NONNULL(layer);
+
+        // must not touch any of our state here, as this might be called from any thread
+        auto preparedModel = std::make_shared<PreparedLayerModel>(*this, layer);
+        ModelBuilder &mb = preparedModel->builder;
         mb.setCWPolygonFlag(false);
         mb.setUseClampedTextures(true);
 
@@ -293,11 +352,20 @@ namespace odOsg
             polygons.push_back(poly);
         }
         mb.setPolygonVector(polygons.begin(), polygons.end());
+        mb.prepare();
+
+        return preparedModel;
+    }
+
+    std::shared_ptr<odRender::Model> Renderer::createModelFromPreparedLayer(std::shared_ptr<odRender::PreparedLayerModel> preparedModel)
+    {
+        OD_CHECK_ARG_NONNULL(preparedModel);
+
+        auto osgPreparedModel = od::downcast<PreparedLayerModel>(preparedModel);
 
-        std::shared_ptr<Model> builtModel = mb.build();
+        std::shared_ptr<Model> builtModel = osgPreparedModel->builder.build();
 
-        osg::ref_ptr<osg::Program> layerProg = getShaderFactory().getProgram("layer");
-        builtModel->getGeode()->getOrCreateStateSet()->setAttribute(layerProg, osg::StateAttribute::ON);
+        builtModel->getGeode()->getOrCreateStateSet()->setAttribute(mLayerProgram, osg::StateAttribute::ON);
 
         return builtModel;
     }
@@ -350,17 +418,25 @@ namespace odOsg
 
         auto myHandle = od::confident_downcast<Handle>(handle);
 
-        if(myHandle->getParentOsgGroup() != nullptr)
-        {
-            myHandle->getParentOsgGroup()->removeChild(myHandle->getOsgNode());
-        }
-
-        auto newParentGroup = _getOsgGroupForRenderSpace(space);
+        osg::ref_ptr<osg::Group> oldParentGroup = myHandle->getParentOsgGroup();
+        osg::ref_ptr<osg::Group> newParentGroup = _getOsgGroupForRenderSpace(space);
+        osg::ref_ptr<osg::Node> node = myHandle->getOsgNode();
         myHandle->setParentOsgGroup(newParentGroup);
-        if(newParentGroup != nullptr)
+
+        applyOrStageSceneChange([oldParentGroup, newParentGroup, node]()
         {
-            newParentGroup->addChild(myHandle->getOsgNode());
-        }
+            if(oldParentGroup != nullptr)
+            {
+                oldParentGroup->removeChild(node);
+            }
+
+            if(newParentGroup != nullptr)
+            {
+                newParentGroup->addChild(node);
+            }
+        });
+
+        myHandle->updateModelAttachment();
     }
 
     void Renderer::moveToRenderSpace(std::shared_ptr<odRender::Group> group, odRender::RenderSpace space)
@@ -369,17 +445,23 @@ namespace odOsg
 
         auto myGroup = od::confident_downcast<Group>(group);
 
-        if(myGroup->getParentOsgGroup() != nullptr)
-        {
-            myGroup->getParentOsgGroup()->removeChild(myGroup->getOsgNode());
-        }
-
-        auto newParentGroup = _getOsgGroupForRenderSpace(space);
+        osg::ref_ptr<osg::Group> oldParentGroup = myGroup->getParentOsgGroup();
+        osg::ref_ptr<osg::Group> newParentGroup = _getOsgGroupForRenderSpace(space);
+        osg::ref_ptr<osg::Node> node = myGroup->getOsgNode();
         myGroup->setParentOsgGroup(newParentGroup);
-        if(newParentGroup != nullptr)
+
+        applyOrStageSceneChange([oldParentGroup, newParentGroup, node]()
         {
-            newParentGroup->addChild(myGroup->getOsgNode());
-        }
+            if(oldParentGroup != nullptr)
+            {
+                oldParentGroup->removeChild(node);
+            }
+
+            if(newParentGroup != nullptr)
+            {
+                newParentGroup->addChild(node);
+            }
+        });
     }
 
     void Renderer::addGuiCallback(odRender::GuiCallback *callback)
@@ -422,6 +504,9 @@ namespace odOsg
 
     void Renderer::setup()
     {
+        mRenderThreadId = std::this_thread::get_id();
+        mRenderThreadKnown = true;
+
         mViewer->realize();
 
         osgViewer::Viewer::Windows windows;
@@ -461,16 +546,231 @@ namespace odOsg
     {
         mSimTime += relTime;
 
+        {
+            OD_PROFILE_ZONE("Apply published changes");
+
+            {
+                std::lock_guard<std::mutex> lock(mPublishMutex);
+                mChangesToApply.swap(mPublishedChanges);
+            }
+
+            for(auto &change : mChangesToApply)
+            {
+                change();
+            }
+            mChangesToApply.clear();
+        }
+
         // TODO: frame rate limiter ("timeUntilNextFrame" or smth)
 
         mViewer->advance(mSimTime);
-        mViewer->eventTraversal();
-        mViewer->updateTraversal();
-        for(auto guiCallback : mGuiCallbacks)
+
+        {
+            OD_PROFILE_ZONE("Event and update traversal");
+            mViewer->eventTraversal();
+            mViewer->updateTraversal();
+        }
+
+        if(mFreeLook)
+        {
+            // the manipulator moved the camera. the simulation needs the eye point for streaming, but must not read the view matrix
+            mCamera->publishViewMatrixEyePoint();
+        }
+
+        {
+            OD_PROFILE_ZONE("GUI update");
+            for(auto guiCallback : mGuiCallbacks)
+            {
+                guiCallback->onUpdate(relTime);
+            }
+        }
+
+        {
+            OD_PROFILE_ZONE("Instance batches");
+            for(auto &batch : mInstanceBatches)
+            {
+                batch.second->update(mLightingEnabled);
+            }
+        }
+
+        {
+            OD_PROFILE_ZONE("Rendering traversals");
+            mViewer->renderingTraversals();
+        }
+
+        if(mDrawCounter->isEnabled())
+        {
+            mLastFrameStatistics = mDrawCounter->takeStatistics();
+
+            mStatisticsLogTimer += relTime;
+            if(mStatisticsLogTimer >= 1.0)
+            {
+                mStatisticsLogTimer = 0.0;
+
+                Logger::info() << "Render statistics: " << mLastFrameStatistics.drawCalls << " draw calls, "
+                        << mLastFrameStatistics.stateChanges << " state changes, "
+                        << mLastFrameStatistics.instancedDrawCalls << " instanced draws covering "
+                        << mLastFrameStatistics.instances << " instances, "
+                        << mInstanceBatches.size() << " batches";
+            }
+        }
+    }
+
+    void Renderer::publishSceneState()
+    {
+        std::vector<std::function<void()>> changes;
+
+        {
+            std::lock_guard<std::mutex> lock(mStagingMutex);
+
+            changes.swap(mStagedChanges);
+
+            // transforms and rigs are collected here instead of per call, so a handle moved many times in a tick only
+            //  produces one change
+            for(auto handle : mDirtyHandles)
+            {
+                changes.push_back(handle->makeStateUpdate());
+            }
+            mDirtyHandles.clear();
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mTrackedLightsMutex);
+
+            // light parameters are copied by value here, so the render thread never reads a light the simulation is changing
+            std::vector<std::pair<std::shared_ptr<LightSnapshot>, LightSnapshot>> lightUpdates;
+            lightUpdates.reserve(mTrackedLights.size());
+            for(auto it = mTrackedLights.begin(); it != mTrackedLights.end(); )
+            {
+                auto light = it->second.light.lock();
+                if(light == nullptr)
+                {
+                    it = mTrackedLights.erase(it);
+                    continue;
+                }
+
+                lightUpdates.emplace_back(it->second.snapshot, _makeLightSnapshot(*light));
+                ++it;
+            }
+
+            if(!lightUpdates.empty())
+            {
+                changes.push_back([lightUpdates = std::move(lightUpdates)]()
+                {
+                    for(auto &update : lightUpdates)
+                    {
+                        *update.first = update.second;
+                    }
+                });
+            }
+        }
+
+        if(changes.empty())
+        {
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(mPublishMutex);
+
+        // if the renderer did not pick up the last publish yet, append to it. dropping it would lose structural changes
+        if(mPublishedChanges.empty())
+        {
+            mPublishedChanges.swap(changes);
+
+        }else
+        {
+            mPublishedChanges.insert(mPublishedChanges.end(), std::make_move_iterator(changes.begin()), std::make_move_iterator(changes.end()));
+        }
+    }
+
+    bool Renderer::isRenderThread() const
+    {
+        return !mRenderThreadKnown || std::this_thread::get_id() == mRenderThreadId;
+    }
+
+    void Renderer::applyOrStageSceneChange(std::function<void()> change)
+    {
+        if(isRenderThread())
+        {
+            change();
+
+        }else
+        {
+            std::lock_guard<std::mutex> lock(mStagingMutex);
+            mStagedChanges.push_back(std::move(change));
+        }
+    }
+
+    void Renderer::markHandleDirty(Handle *handle)
+    {
+        std::lock_guard<std::mutex> lock(mStagingMutex);
+        mDirtyHandles.push_back(handle);
+    }
+
+    void Renderer::unmarkHandleDirty(Handle *handle)
+    {
+        std::lock_guard<std::mutex> lock(mStagingMutex);
+
+        auto it = std::find(mDirtyHandles.begin(), mDirtyHandles.end(), handle);
+        if(it != mDirtyHandles.end())
+        {
+            mDirtyHandles.erase(it);
+        }
+    }
+
+    std::shared_ptr<LightSnapshot> Renderer::getLightSnapshot(const std::shared_ptr<od::Light> &light)
+    {
+        OD_CHECK_ARG_NONNULL(light);
+
+        std::lock_guard<std::mutex> lock(mTrackedLightsMutex);
+
+        // a light that died since the last publish might have left its entry behind at the same address
+        TrackedLight &tracked = mTrackedLights[light.get()];
+        if(tracked.snapshot == nullptr || tracked.light.lock() != light)
+        {
+            tracked.light = light;
+            tracked.snapshot = std::make_shared<LightSnapshot>(_makeLightSnapshot(*light));
+        }
+
+        return tracked.snapshot;
+    }
+
+    void Renderer::setEnableRenderStatistics(bool b)
+    {
+        mDrawCounter->setEnabled(b);
+        mStatisticsLogTimer = 0.0;
+    }
+
+    void Renderer::addInstance(std::shared_ptr<Model> model, osg::PositionAttitudeTransform *transform, LightStateAttribute *lightState)
+    {
+        OD_CHECK_ARG_NONNULL(model);
+
+        auto it = mInstanceBatches.find(model.get());
+        if(it == mInstanceBatches.end())
+        {
+            auto batch = std::make_unique<InstanceBatch>(model, mDrawCounter);
+            mLevelRoot->addChild(batch->getOsgNode());
+            it = mInstanceBatches.insert(std::make_pair(model.get(), std::move(batch))).first;
+        }
+
+        it->second->addInstance(transform, lightState);
+    }
+
+    void Renderer::removeInstance(Model *model, osg::PositionAttitudeTransform *transform)
+    {
+        auto it = mInstanceBatches.find(model);
+        if(it == mInstanceBatches.end())
+        {
+            return;
+        }
+
+        it->second->removeInstance(transform);
+
+        if(it->second->getInstanceCount() == 0)
         {
-            guiCallback->onUpdate(relTime);
+            mLevelRoot->removeChild(it->second->getOsgNode());
+            mInstanceBatches.erase(it);
         }
-        mViewer->renderingTraversals();
     }
 
     void Renderer::applyLayerLight(const osg::Matrix &viewMatrix, const osg::Vec3 &diffuse, const osg::Vec3 &ambient, const osg::Vec3 &direction)
@@ -487,7 +787,7 @@ namespace odOsg
         mGlobalLightDirection->set(osg::Vec3(dirCs.x(), dirCs.y(), dirCs.z()));
     }
 
-    void Renderer::applyToLightUniform(const osg::Matrix &viewMatrix, od::Light &light, size_t index)
+    void Renderer::applyToLightUniform(const osg::Matrix &viewMatrix, const LightSnapshot &light, size_t index)
     {
         if(index >= mLocalLightsColor->getNumElements())
         {
@@ -499,12 +799,11 @@ namespace odOsg
             return;
         }
 
-        mLocalLightsColor->setElement(index, GlmAdapter::toOsg(light.getColor()));
-        mLocalLightsIntensity->setElement(index, light.getIntensityScaling());
-        mLocalLightsRadius->setElement(index, light.getRadius());
+        mLocalLightsColor->setElement(index, light.color);
+        mLocalLightsIntensity->setElement(index, light.intensityScaling);
+        mLocalLightsRadius->setElement(index, light.radius);
 
-        osg::Vec3 posWs = GlmAdapter::toOsg(light.getPosition());
-        osg::Vec4 dirCs = osg::Vec4(posWs, 1.0) * viewMatrix;
+        osg::Vec4 dirCs = osg::Vec4(light.position, 1.0) * viewMatrix;
         mLocalLightsPosition->setElement(index, osg::Vec3(dirCs.x(), dirCs.y(), dirCs.z()));
     }
 
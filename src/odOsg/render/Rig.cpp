@@ -7,42 +7,143 @@
 
 #include <odOsg/render/Rig.h>
 
+#include <algorithm>
+
 #include <odCore/Panic.h>
 
 #include <odOsg/GlmAdapter.h>
 #include <odOsg/Constants.h>
+#include <odOsg/render/Handle.h>
+#include <odOsg/render/Renderer.h>
 
 namespace odOsg
 {
 
-    Rig::Rig(osg::Node *riggedModelRoot)
-    : mRiggedModelRoot(riggedModelRoot)
-    , mBoneMatrixUniform(new osg::Uniform(osg::Uniform::FLOAT_MAT4, "bones", Constants::MAX_BONES))
+    Rig::Rig(Renderer &renderer, Handle &handle, osg::Node *riggedModelRoot)
+    : mRenderer(renderer)
+    , mHandle(handle)
+    , mBonesDirty(false)
+    , mRiggedModelRoot(riggedModelRoot)
+    , mBoneRowUniform(new osg::Uniform(osg::Uniform::FLOAT_VEC4, "bones", Constants::MAX_BONES*3))
     {
-        osg::StateSet *ss = mRiggedModelRoot->getOrCreateStateSet();
+        mBoneRows.reserve(Constants::MAX_BONES*3);
+        for(size_t i = 0; i < Constants::MAX_BONES; ++i)
+        {
+            mBoneRows.emplace_back(1.0, 0.0, 0.0, 0.0);
+            mBoneRows.emplace_back(0.0, 1.0, 0.0, 0.0);
+            mBoneRows.emplace_back(0.0, 0.0, 1.0, 0.0);
+        }
 
-        ss->addUniform(mBoneMatrixUniform);
-        ss->setDefine("RIGGING");
+        _uploadBoneRows(*mBoneRowUniform, mBoneRows);
 
-        for(size_t i = 0; i < mBoneMatrixUniform->getNumElements(); ++i)
+        osg::ref_ptr<osg::Node> root = mRiggedModelRoot;
+        osg::ref_ptr<osg::Uniform> uniform = mBoneRowUniform;
+        mRenderer.applyOrStageSceneChange([root, uniform]()
         {
-            mBoneMatrixUniform->setElement(i, osg::Matrix::identity());
-        }
+            osg::StateSet *ss = root->getOrCreateStateSet();
+            ss->addUniform(uniform);
+            ss->setDefine("RIGGING");
+        });
     }
 
     Rig::~Rig()
     {
-        mRiggedModelRoot->getOrCreateStateSet()->removeUniform(mBoneMatrixUniform);
+        osg::ref_ptr<osg::Node> root = mRiggedModelRoot;
+        osg::ref_ptr<osg::Uniform> uniform = mBoneRowUniform;
+        mRenderer.applyOrStageSceneChange([root, uniform](){ root->getOrCreateStateSet()->removeUniform(uniform); });
     }
 
     void Rig::setBoneTransform(size_t boneIndex, glm::mat4 &transform)
     {
-        if(boneIndex >= mBoneMatrixUniform->getNumElements())
+        if(boneIndex >= Constants::MAX_BONES)
+        {
+            OD_PANIC() << "Bone index passed to renderer exceeds supported number of bones: index=" << boneIndex << " size=" << Constants::MAX_BONES;
+        }
+
+        if(_storeBone(boneIndex, transform))
+        {
+            _bonesChanged();
+        }
+    }
+
+    void Rig::setBoneTransforms(const glm::mat4 *transforms, size_t count)
+    {
+        if(count > Constants::MAX_BONES)
+        {
+            OD_PANIC() << "Bone count passed to renderer exceeds supported number of bones: count=" << count << " size=" << Constants::MAX_BONES;
+        }
+
+        bool changed = false;
+        for(size_t i = 0; i < count; ++i)
+        {
+            changed |= _storeBone(i, transforms[i]);
+        }
+
+        // a pose that did not change (paused or finished animations, objects standing still) costs no upload at all
+        if(changed)
+        {
+            _bonesChanged();
+        }
+    }
+
+    std::function<void()> Rig::makeUpdate()
+    {
+        if(!mBonesDirty)
+        {
+            return nullptr;
+        }
+
+        mBonesDirty = false;
+
+        osg::ref_ptr<osg::Uniform> uniform = mBoneRowUniform;
+        std::vector<osg::Vec4f> boneRows = mBoneRows;
+        return [uniform, boneRows]()
         {
-            OD_PANIC() << "Bone index passed to renderer exceeds supported number of bones: index=" << boneIndex << " size=" << mBoneMatrixUniform->getNumElements();
+            _uploadBoneRows(*uniform, boneRows);
+        };
+    }
+
+    bool Rig::_storeBone(size_t boneIndex, const glm::mat4 &transform)
+    {
+        // the shader used to multiply with the full matrix and then force w to 1, so the 4th row never mattered.
+        //  the i-th row of the matrix as the shader sees it is the i-th column of the glm matrix (see GlmAdapter::toOsg)
+        bool changed = false;
+        for(size_t row = 0; row < 3; ++row)
+        {
+            const glm::vec4 &column = transform[row];
+            osg::Vec4f rowVector(column.x, column.y, column.z, column.w);
+
+            osg::Vec4f &current = mBoneRows[boneIndex*3 + row];
+            if(current != rowVector)
+            {
+                current = rowVector;
+                changed = true;
+            }
         }
 
-        mBoneMatrixUniform->setElement(boneIndex, GlmAdapter::toOsg(transform));
+        return changed;
+    }
+
+    void Rig::_bonesChanged()
+    {
+        if(mRenderer.isRenderThread())
+        {
+            _uploadBoneRows(*mBoneRowUniform, mBoneRows);
+
+        }else if(!mBonesDirty)
+        {
+            mBonesDirty = true;
+            mHandle.rigChanged();
+        }
+    }
+
+    void Rig::_uploadBoneRows(osg::Uniform &uniform, const std::vector<osg::Vec4f> &boneRows)
+    {
+        // write the whole array at once instead of going through setElement() per bone, then dirty the uniform once
+        osg::FloatArray *array = uniform.getFloatArray();
+        const float *rowData = boneRows.front().ptr();
+        std::copy(rowData, rowData + boneRows.size()*4, array->begin());
+        uniform.dirty();
     }
 
 }
@@ -0,0 +1,194 @@
+/*
+ * LoadDriver.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: zal
+ */
+
+#include <odServer/LoadDriver.h>
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <thread>
+
+#include <odCore/Logger.h>
+#include <odCore/Server.h>
+
+namespace odServer
+{
+
+    template <typename T>
+    static T _percentile(const std::vector<T> &sortedValues, double p)
+    {
+        if(sortedValues.empty())
+        {
+            return T(0);
+        }
+
+        size_t index = static_cast<size_t>(p * sortedValues.size());
+        return sortedValues[std::min(index, sortedValues.size() - 1)];
+    }
+
+    template <typename T>
+    static void _printDistribution(std::ostream &out, const char *title, std::vector<T> values, double scale)
+    {
+        std::sort(values.begin(), values.end());
+
+        double sum = 0.0;
+        for(auto v : values)
+        {
+            sum += v;
+        }
+        double mean = values.empty() ? 0.0 : sum/values.size();
+
+        out << std::left << std::setw(20) << title << std::right
+            << std::setw(10) << "mean"
+            << std::setw(10) << "p50"
+            << std::setw(10) << "p90"
+            << std::setw(10) << "p99"
+            << std::setw(10) << "max" << std::endl;
+
+        out << std::setw(20) << ""
+            << std::setw(10) << (mean * scale)
+            << std::setw(10) << (_percentile(values, 0.5) * scale)
+            << std::setw(10) << (_percentile(values, 0.9) * scale)
+            << std::setw(10) << (_percentile(values, 0.99) * scale)
+            << std::setw(10) << (_percentile(values, 1.0) * scale) << std::endl;
+    }
+
+
+    LoadDriver::LoadDriver(od::Server &server)
+    : mServer(server)
+    , mIsDone(false)
+    , mRealtime(true)
+    , mSlowTickCount(0)
+    , mSimulatedTime(0.0)
+    , mWallTime(0.0)
+    {
+    }
+
+    LoadDriver::~LoadDriver()
+    {
+    }
+
+    void LoadDriver::addClients(size_t count, const odNet::InputRecording *recording)
+    {
+        double duration = (recording != nullptr) ? recording->getDuration() : 0.0;
+
+        for(size_t i = 0; i < count; ++i)
+        {
+            double offset = duration * i / count;
+            mClients.push_back(std::make_unique<SyntheticClient>(mServer, recording, offset));
+        }
+    }
+
+    void LoadDriver::run(double duration)
+    {
+        Logger::info() << "Running server with " << mClients.size() << " synthetic clients";
+
+        using clock = std::chrono::steady_clock;
+
+        auto tickInterval = std::chrono::duration_cast<clock::duration>(std::chrono::duration<double>(TICK_INTERVAL));
+        auto runStart = clock::now();
+        auto nextTickStart = runStart;
+        while(!mIsDone.load(std::memory_order_relaxed))
+        {
+            if(duration > 0.0 && mSimulatedTime >= duration)
+            {
+                break;
+            }
+
+            for(auto &client : mClients)
+            {
+                client->replayInput(TICK_INTERVAL);
+            }
+
+            auto tickStart = clock::now();
+            mServer.tick(TICK_INTERVAL);
+            auto tickEnd = clock::now();
+
+            double tickTime = std::chrono::duration<double>(tickEnd - tickStart).count();
+            mTickTimes.push_back(tickTime);
+            mSimulatedTime += TICK_INTERVAL;
+            if(tickTime > TICK_INTERVAL)
+            {
+                ++mSlowTickCount;
+            }
+
+            for(auto &client : mClients)
+            {
+                client->flushDownlink();
+            }
+
+            if(mRealtime)
+            {
+                // pace by absolute deadlines, so a single slow tick does not delay everything after it
+                nextTickStart += tickInterval;
+                auto now = clock::now();
+                if(now < nextTickStart)
+                {
+                    std::this_thread::sleep_until(nextTickStart);
+
+                }else if(now - nextTickStart > tickInterval)
+                {
+                    // we are lagging by more than a whole tick. don't try to catch up
+                    nextTickStart = now;
+                }
+            }
+        }
+
+        mWallTime = std::chrono::duration<double>(clock::now() - runStart).count();
+    }
+
+    void LoadDriver::printReport(std::ostream &out) const
+    {
+        size_t tickCount = mTickTimes.size();
+        double simulatedTime = std::max(mSimulatedTime, TICK_INTERVAL);
+        double clientSeconds = simulatedTime * std::max<size_t>(mClients.size(), 1);
+
+        out << std::fixed << std::setprecision(1)
+            << "Synthetic clients: " << mClients.size() << ", ticks: " << tickCount
+            << " (" << mSimulatedTime << " s simulated, " << mWallTime << " s wall clock)" << std::endl
+            << std::endl;
+
+        out << std::setprecision(3);
+        _printDistribution(out, "Tick time [ms]", mTickTimes, 1e3);
+        out << std::setprecision(1)
+            << "Ticks over budget: " << mSlowTickCount
+            << " (" << (tickCount > 0 ? 100.0 * mSlowTickCount / tickCount : 0.0) << "%)" << std::endl
+            << std::endl;
+
+        if(mClients.empty())
+        {
+            return;
+        }
+
+        std::vector<size_t> snapshotSizes;
+        size_t receivedBytes = 0;
+        size_t objectStatesCount = 0;
+        size_t eventCount = 0;
+        size_t replayedActionCount = 0;
+        for(auto &client : mClients)
+        {
+            auto &sizes = client->getSnapshotSizes();
+            snapshotSizes.insert(snapshotSizes.end(), sizes.begin(), sizes.end());
+            receivedBytes += client->getReceivedBytes();
+            objectStatesCount += client->getObjectStatesCount();
+            eventCount += client->getEventCount();
+            replayedActionCount += client->getReplayedActionCount();
+        }
+
+        _printDistribution(out, "Snapshot size [B]", snapshotSizes, 1.0);
+        out << "Snapshots: " << snapshotSizes.size()
+            << " (" << (snapshotSizes.size() / clientSeconds) << " per client per second)" << std::endl
+            << "Downlink: " << (receivedBytes / 1024.0) << " KiB"
+            << " (" << (receivedBytes / 1024.0 / clientSeconds) << " KiB/s per client)" << std::endl
+            << "Object state updates: " << objectStatesCount
+            << " (" << (objectStatesCount / clientSeconds) << " per client per second)" << std::endl
+            << "Events: " << eventCount
+            << " (" << (eventCount / clientSeconds) << " per client per second)" << std::endl
+            << "Replayed input actions: " << replayedActionCount << std::endl;
+    }
+
+}
@@ -0,0 +1,211 @@
+/*
+ * Main.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: zal
+ */
+
+#include <signal.h>
+#include <unistd.h>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <exception>
+
+#include <odCore/Logger.h>
+#include <odCore/Server.h>
+#include <odCore/Panic.h>
+#include <odCore/FilePath.h>
+#include <odCore/Engine.h>
+#include <odCore/Version.h>
+#include <odCore/Profiler.h>
+
+#include <odCore/net/InputRecording.h>
+
+#include <odCore/rfl/RflManager.h>
+
+#include <odCore/db/DbManager.h>
+
+#include <dragonRfl/RflDragon.h>
+
+#include <odServer/LoadDriver.h>
+
+static odServer::LoadDriver *sLoadDriver = nullptr;
+static void handleSignal(int signal)
+{
+    if(signal == SIGINT)
+    {
+        Logger::info() << "Caught SIGINT. Terminating server";
+
+        if(sLoadDriver != nullptr) sLoadDriver->setIsDone(true);
+    }
+}
+
+static void printUsage()
+{
+    std::cout
+        << "Usage: odServer [options] <level file>" << std::endl
+        << "Headless OpenDrakan server with synthetic clients for load testing" << std::endl
+        << "Options:" << std::endl
+        << "    -v  Increase verbosity of logger" << std::endl
+        << "    -h  Display this message and exit" << std::endl
+        << "    -c <count>  Number of synthetic clients to connect (default 0)" << std::endl
+        << "    -i <file>  Input recording the synthetic clients replay in a loop (see odOsg -R)" << std::endl
+        << "    -d <seconds>  Stop after this much simulated time (default is to run until interrupted)" << std::endl
+        << "    -f  Run ticks back-to-back instead of pacing them to 60 Hz" << std::endl
+        << "    -P <file>  Profile server and write a Chrome trace to file on exit" << std::endl
+        << "On exit, tick times, snapshot sizes and event throughput are reported." << std::endl
+        << std::endl;
+}
+
+int main(int argc, char **argv)
+{
+    signal(SIGINT, &handleSignal);
+
+    od::Logger::getDefaultLogger().setOutputLogLevel(od::LogLevel::Info);
+
+    od::Logger::info() << "Starting OpenDrakan server version " << OD_VERSION_TAG << " (" << OD_VERSION_BRANCH << " " << OD_VERSION_COMMIT << ")";
+
+    int c;
+    size_t clientCount = 0;
+    std::string inputRecordingPath;
+    double duration = 0.0;
+    bool realtime = true;
+    std::string profileOutputPath;
+    while((c = getopt(argc, argv, "vhc:i:d:fP:")) != -1)
+    {
+        switch(c)
+        {
+        case 'v':
+            od::Logger::getDefaultLogger().increaseOutputLogLevel();
+            break;
+
+        case 'h':
+            printUsage();
+            return 0;
+
+        case 'c':
+            {
+                std::istringstream in(optarg);
+                in >> clientCount;
+                if(in.fail())
+                {
+                    std::cout << "-c option needs a non-negative integer as argument" << std::endl;
+                    return 1;
+                }
+            }
+            break;
+
+        case 'i':
+            inputRecordingPath = optarg;
+            break;
+
+        case 'd':
+            {
+                std::istringstream in(optarg);
+                in >> duration;
+                if(in.fail() || duration <= 0)
+                {
+                    std::cout << "-d option needs a positive real number as argument" << std::endl;
+                    return 1;
+                }
+            }
+            break;
+
+        case 'f':
+            realtime = false;
+            break;
+
+        case 'P':
+            profileOutputPath = optarg;
+            break;
+
+        case '?':
+            std::cout << "Unknown option -" << optopt << std::endl;
+            printUsage();
+            return 1;
+        }
+    }
+
+    if(optind >= argc)
+    {
+        std::cout << "No level file given" << std::endl;
+        printUsage();
+        return 1;
+    }
+
+    od::FilePath levelPath(argv[optind]);
+    if(!levelPath.exists())
+    {
+        std::cerr << "Level file " << levelPath << " does not exist" << std::endl;
+        return 1;
+    }
+
+    odNet::InputRecording inputRecording;
+    if(!inputRecordingPath.empty())
+    {
+        std::ifstream in(inputRecordingPath);
+        if(!in.good())
+        {
+            std::cerr << "Could not open input recording " << inputRecordingPath << std::endl;
+            return 1;
+        }
+
+        inputRecording.read(in);
+        Logger::info() << "Loaded input recording with " << inputRecording.getEntries().size() << " actions over " << inputRecording.getDuration() << "s";
+    }
+
+    odDb::DbManager dbManager;
+
+    odRfl::RflManager rflManager;
+    rflManager.loadStaticRfl<dragonRfl::DragonRfl>(); // TODO: add option to specify dynamic RFL
+
+    // unlike the client, the server needs no renderer or sound system. the RFL's game startup
+    //  hook is skipped, as it sets up the local client's GUI and input, so the level has to be given explicitly
+    od::Server server(dbManager, rflManager);
+    server.setEngineRootDir(od::findEngineRoot(levelPath, "dragon.rrc"));
+
+    odServer::LoadDriver loadDriver(server);
+    loadDriver.setRealtime(realtime);
+    loadDriver.addClients(clientCount, inputRecording.empty() ? nullptr : &inputRecording);
+    sLoadDriver = &loadDriver;
+
+    server.loadLevel(levelPath);
+
+    if(!profileOutputPath.empty())
+    {
+        od::Profiler::getInstance().setEnabled(true);
+    }
+
+    int exitCode = 0;
+    try
+    {
+        loadDriver.run(duration);
+
+    }catch(std::exception &e)
+    {
+        Logger::error() << "Terminating server due to fatal error: " << e.what();
+        exitCode = 1;
+    }
+
+    sLoadDriver = nullptr;
+
+    loadDriver.printReport(std::cout);
+
+    if(!profileOutputPath.empty())
+    {
+        od::Profiler::getInstance().setEnabled(false);
+
+        std::ofstream out(profileOutputPath);
+        if(!out.good())
+        {
+            Logger::error() << "Could not open " << profileOutputPath << " for writing profiler trace";
+
+        }else
+        {
+            od::Profiler::getInstance().writeChromeTrace(out);
+        }
+    }
+
+    return exitCode;
+}
@@ -0,0 +1,123 @@
+/*
+ * SyntheticClient.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: zal
+ */
+
+#include <odServer/SyntheticClient.h>
+
+#include <odCore/Server.h>
+
+namespace odServer
+{
+
+    SyntheticClient::SyntheticClient(od::Server &server, const odNet::InputRecording *recording, double replayOffset)
+    : mDownlinkQueue(std::make_shared<odNet::QueuedDownlinkConnector>())
+    , mPacketBuilder([this](const char *data, size_t size, odNet::PacketBuilder::LinkType linkType){ mReceivedBytes += size; })
+    , mRecording(recording)
+    , mReplayTime(replayOffset)
+    , mReplayCursor(0)
+    , mReceivedBytes(0)
+    , mPendingSnapshotBytes(0)
+    , mObjectStatesCount(0)
+    , mEventCount(0)
+    , mReplayedActionCount(0)
+    {
+        mClientId = server.addClient();
+        server.setClientDownlinkConnector(mClientId, mDownlinkQueue);
+        mUplinkConnector = server.getUplinkConnectorForClient(mClientId);
+
+        // skip what lies before our offset instead of sending it all in the first tick
+        if(mRecording != nullptr)
+        {
+            auto &entries = mRecording->getEntries();
+            while(mReplayCursor < entries.size() && entries[mReplayCursor].time < mReplayTime)
+            {
+                ++mReplayCursor;
+            }
+        }
+    }
+
+    void SyntheticClient::replayInput(double relTime)
+    {
+        if(mRecording == nullptr || mRecording->empty())
+        {
+            return;
+        }
+
+        mReplayTime += relTime;
+
+        auto &entries = mRecording->getEntries();
+        while(mReplayCursor < entries.size() && entries[mReplayCursor].time <= mReplayTime)
+        {
+            odNet::InputRecording::replayEntry(entries[mReplayCursor], *mUplinkConnector);
+            ++mReplayCursor;
+            ++mReplayedActionCount;
+        }
+
+        // a recording without duration is replayed only once, as looping it would send everything every tick
+        double duration = mRecording->getDuration();
+        if(mReplayCursor >= entries.size() && duration > 0.0)
+        {
+            mReplayCursor = 0;
+            mReplayTime -= duration;
+        }
+    }
+
+    void SyntheticClient::flushDownlink()
+    {
+        mDownlinkQueue->flushQueue(*this);
+    }
+
+    void SyntheticClient::globalDatabaseTableEntry(odDb::GlobalDatabaseIndex dbIndex, const std::string &path)
+    {
+        mPacketBuilder.globalDatabaseTableEntry(dbIndex, path);
+    }
+
+    void SyntheticClient::loadLevel(const std::string &path, size_t loadedDatabaseCount)
+    {
+        mPacketBuilder.loadLevel(path, loadedDatabaseCount);
+    }
+
+    void SyntheticClient::objectStatesChanged(odState::TickNumber tick, od::LevelObjectId id, const od::ObjectStates &states)
+    {
+        size_t bytesBefore = mReceivedBytes;
+        mPacketBuilder.objectStatesChanged(tick, id, states);
+        mPendingSnapshotBytes += mReceivedBytes - bytesBefore;
+
+        ++mObjectStatesCount;
+    }
+
+    void SyntheticClient::objectExtraStatesChanged(odState::TickNumber tick, od::LevelObjectId id, const char *data, size_t size)
+    {
+        size_t bytesBefore = mReceivedBytes;
+        mPacketBuilder.objectExtraStatesChanged(tick, id, data, size);
+        mPendingSnapshotBytes += mReceivedBytes - bytesBefore;
+    }
+
+    void SyntheticClient::confirmSnapshot(odState::TickNumber tick, double realtime, size_t discreteChangeCount, odState::TickNumber referenceTick)
+    {
+        size_t bytesBefore = mReceivedBytes;
+        mPacketBuilder.confirmSnapshot(tick, realtime, discreteChangeCount, referenceTick);
+        mPendingSnapshotBytes += mReceivedBytes - bytesBefore;
+
+        mSnapshotSizes.push_back(mPendingSnapshotBytes);
+        mPendingSnapshotBytes = 0;
+
+        mUplinkConnector->acknowledgeSnapshot(tick);
+    }
+
+    void SyntheticClient::globalMessage(odNet::MessageChannelCode code, const char *data, size_t size)
+    {
+        mPacketBuilder.globalMessage(code, data, size);
+    }
+
+    void SyntheticClient::event(const odState::EventVariant &e, double realtime)
+    {
+        mPacketBuilder.event(e, realtime);
+
+        ++mEventCount;
+    }
+
+}
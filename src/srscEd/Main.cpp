@@ -7,10 +7,24 @@
 
 #include <iostream>
 #include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <map>
 #include <unistd.h>
 
 #include <odCore/SrscFile.h>
 #include <odCore/FilePath.h>
+#include <odCore/MappedFile.h>
+#include <odCore/ThreadUtils.h>
+#include <odCore/Panic.h>
+
+#include <srscEd/ZlibScanner.h>
+
+struct RecordScanResult
+{
+    bool outOfBounds;
+    std::vector<srscEd::ZlibStreamInfo> streams;
+};
 
 static void srscStat(od::SrscFile &file, size_t dataByteCount)
 {
@@ -25,6 +39,7 @@ static void srscStat(od::SrscFile &file, size_t dataByteCount)
               << std::setw(24) << "Data"
               << std::endl;
 
+    std::vector<char> data;
     auto begin = file.getDirectoryBegin();
     auto it = begin;
     while(it != file.getDirectoryEnd())
@@ -39,26 +54,202 @@ static void srscStat(od::SrscFile &file, size_t dataByteCount)
 
         std::cout << "  ";
 
-        od::DataReader dr(file.getStreamForRecord(it));
+        size_t bytesToPrint = std::min(dataByteCount, static_cast<size_t>(it->dataSize));
+        data.resize(bytesToPrint);
+        file.getStreamForRecord(it).read(data.data(), bytesToPrint);
+
+        for(size_t i = 0; i < bytesToPrint; ++i)
+        {
+            printf("%02x ", static_cast<uint8_t>(data[i]));
+        }
 
-        for(size_t i = 0; i < it->dataSize; ++i)
+        if(bytesToPrint < it->dataSize)
         {
-            if(i >= dataByteCount)
+            std::cout << "[...]";
+        }
+
+        std::cout << std::endl;
+
+        ++it;
+    }
+}
+
+static std::string rawRecordFilename(const od::FilePath &outputDir, const od::SrscFile::DirEntry &entry, const std::string &suffix)
+{
+    // same naming scheme as SrscFile::decompressRecord()
+    std::ostringstream ss;
+    ss << outputDir.str() << "/rawrecord" << entry.index << "-" << std::hex << entry.type << "-" << entry.recordId << "-" << entry.groupId << std::dec << suffix << ".dat";
+    return ss.str();
+}
+
+static void writeFile(const std::string &path, const char *data, size_t size)
+{
+    std::ofstream out(path, std::ios::out | std::ios::binary);
+    out.write(data, size);
+    if(out.fail())
+    {
+        OD_PANIC() << "Failed to write " << path;
+    }
+}
+
+/**
+ * Scans all given records for zlib streams on as many threads as there are cores. If outputDir is not nullptr,
+ * the raw records are extracted there, and if extractInflated is also set, the inflated streams are, too.
+ */
+static std::vector<RecordScanResult> scanRecords(od::MappedFile &mappedFile, const std::vector<od::SrscFile::DirEntry> &entries,
+        const od::FilePath *outputDir, bool extractInflated)
+{
+    std::vector<RecordScanResult> results(entries.size());
+
+    od::ThreadUtils::parallelFor(entries.size(), [&](size_t i)
+    {
+        const od::SrscFile::DirEntry &entry = entries[i];
+        RecordScanResult &result = results[i];
+
+        result.outOfBounds = (static_cast<size_t>(entry.dataOffset) + entry.dataSize > mappedFile.size());
+        if(result.outOfBounds)
+        {
+            return;
+        }
+
+        const char *data = mappedFile.data() + entry.dataOffset;
+
+        if(outputDir != nullptr)
+        {
+            writeFile(rawRecordFilename(*outputDir, entry, ""), data, entry.dataSize);
+        }
+
+        std::vector<std::vector<char>> inflatedData;
+        bool keepInflated = (outputDir != nullptr && extractInflated);
+
+        // scanners are cheap compared to scanning, so there's no use in keeping one per thread around
+        srscEd::ZlibScanner scanner;
+        scanner.scan(entry.type, data, entry.dataSize, result.streams, keepInflated ? &inflatedData : nullptr);
+
+        if(keepInflated)
+        {
+            for(size_t s = 0; s < result.streams.size(); ++s)
             {
-                std::cout << "[...]";
-                break;
+                if(!result.streams[s].corrupt)
+                {
+                    writeFile(rawRecordFilename(*outputDir, entry, "-z" + std::to_string(s)), inflatedData[s].data(), inflatedData[s].size());
+                }
             }
+        }
+    });
+
+    return results;
+}
 
-            uint8_t b;
-            dr >> b;
+static void srscRecordStats(const std::vector<od::SrscFile::DirEntry> &entries, const std::vector<RecordScanResult> &results)
+{
+    struct TypeStats
+    {
+        size_t recordCount = 0;
+        size_t storedBytes = 0;
+        size_t streamCount = 0;
+        size_t compressedBytes = 0;
+        size_t inflatedBytes = 0;
+    };
+
+    std::map<od::RecordType, TypeStats> statsPerType;
+    TypeStats total;
+    for(size_t i = 0; i < entries.size(); ++i)
+    {
+        TypeStats &stats = statsPerType[entries[i].type];
+        for(TypeStats *s : { &stats, &total })
+        {
+            s->recordCount++;
+            s->storedBytes += entries[i].dataSize;
+            for(auto &stream : results[i].streams)
+            {
+                if(stream.corrupt) continue;
 
-            printf("%02x ", b);
+                s->streamCount++;
+                s->compressedBytes += stream.compressedSize;
+                s->inflatedBytes += stream.inflatedSize;
+            }
+        }
+    }
+
+    auto printRow = [](const std::string &type, const TypeStats &s)
+    {
+        std::cout
+            << std::setw(6) << type
+            << std::setw(8) << s.recordCount
+            << std::setw(12) << s.storedBytes
+            << std::setw(8) << s.streamCount
+            << std::setw(12) << s.compressedBytes
+            << std::setw(12) << s.inflatedBytes;
+
+        if(s.compressedBytes > 0)
+        {
+            std::cout << std::setw(8) << std::fixed << std::setprecision(2) << (static_cast<double>(s.inflatedBytes)/s.compressedBytes);
+
+        }else
+        {
+            std::cout << std::setw(8) << "-";
         }
 
         std::cout << std::endl;
+    };
+
+    std::cout << std::setw(6) << "Type"
+              << std::setw(8) << "Records"
+              << std::setw(12) << "Stored"
+              << std::setw(8) << "ZStrms"
+              << std::setw(12) << "Compressed"
+              << std::setw(12) << "Inflated"
+              << std::setw(8) << "Ratio"
+              << std::endl;
 
-        ++it;
+    for(auto &typeStats : statsPerType)
+    {
+        std::ostringstream type;
+        type << std::hex << typeStats.first;
+        printRow(type.str(), typeStats.second);
+    }
+
+    printRow("total", total);
+}
+
+/**
+ * @return The number of problems found.
+ */
+static size_t srscVerify(const std::vector<od::SrscFile::DirEntry> &entries, const std::vector<RecordScanResult> &results)
+{
+    size_t problemCount = 0;
+    size_t streamCount = 0;
+    for(size_t i = 0; i < entries.size(); ++i)
+    {
+        auto &entry = entries[i];
+        auto &result = results[i];
+
+        if(result.outOfBounds)
+        {
+            std::cout << "Record " << entry.index << " (type " << std::hex << entry.type << ", ID " << entry.recordId << std::dec
+                      << "): data exceeds end of file" << std::endl;
+            ++problemCount;
+            continue;
+        }
+
+        for(auto &stream : result.streams)
+        {
+            ++streamCount;
+
+            if(stream.corrupt)
+            {
+                std::cout << "Record " << entry.index << " (type " << std::hex << entry.type << ", ID " << entry.recordId << std::dec
+                          << "): corrupt zlib stream at offset " << stream.offset << ": " << stream.error << std::endl;
+                ++problemCount;
+            }
+        }
     }
+
+    std::cout << "Checked " << entries.size() << " records with " << streamCount << " zlib streams. "
+              << problemCount << " problems found" << std::endl;
+
+    return problemCount;
 }
 
 static void printUsage()
@@ -70,10 +261,14 @@ static void printUsage()
         << "Options:" << std::endl
         << "    -o <path>  Output directory (default '.')" << std::endl
         << "    -x         Extract raw records" << std::endl
-        << "    -i <id>    Limit extraction to records with ID <id>" << std::endl
+        << "    -z         When extracting, also extract the inflated contents of all zlib streams found in records" << std::endl
+        << "    -s         Print record counts, sizes and compression ratios per record type" << std::endl
+        << "    -v         Verify that all records lie within the file and that all zlib streams in them inflate" << std::endl
+        << "    -i <id>    Limit extraction, statistics and verification to records with ID <id>" << std::endl
         << "    -c <count> Sets count of data bytes to print (default 10)" << std::endl
         << "    -h         Display this message and exit" << std::endl << std::endl
-        << "If no option is given, the file's directory is printed" << std::endl
+        << "If no option is given, the file's directory is printed. -x, -s and -v can be combined and" << std::endl
+        << "process records in parallel. -v makes srsced exit with status 2 if any problems are found" << std::endl
         << std::endl;
 }
 
@@ -83,11 +278,14 @@ int main(int argc, char **argv)
     std::string filename;
     od::FilePath outputPath(".");
     bool extract = false;
+    bool extractInflated = false;
+    bool printStats = false;
+    bool verify = false;
     bool limitExtractionIds = false;
     uint16_t extractRecordId = 0;
     size_t dataByteCount = 10;
     int c;
-    while((c = getopt(argc, argv, "i:o:xthc:")) != -1)
+    while((c = getopt(argc, argv, "i:o:xzsvthc:")) != -1)
     {
         switch(c)
         {
@@ -121,6 +319,18 @@ int main(int argc, char **argv)
             extract = true;
             break;
 
+        case 'z':
+            extractInflated = true;
+            break;
+
+        case 's':
+            printStats = true;
+            break;
+
+        case 'v':
+            verify = true;
+            break;
+
         case 'o':
             outputPath = od::FilePath(optarg);
             break;
@@ -160,24 +370,34 @@ int main(int argc, char **argv)
     {
         od::SrscFile srscFile(filename);
 
-        if(extract)
+        if(extract || printStats || verify)
         {
-            if(limitExtractionIds)
+            std::vector<od::SrscFile::DirEntry> entries;
+            for(auto &entry : srscFile.getDirectory())
             {
-                std::cout << "Extracting all records with ID " << std::hex << extractRecordId << std::dec << " to " << outputPath << std::endl;
-
-                auto cursor = srscFile.getFirstRecordOfId(extractRecordId);
-                while(cursor.isValid())
+                if(!limitExtractionIds || entry.recordId == extractRecordId)
                 {
-                    srscFile.decompressRecord(outputPath, cursor.getDirIterator(), true);
-                    cursor.nextOfId(extractRecordId);
+                    entries.push_back(entry);
                 }
+            }
 
-            }else
+            if(extract)
             {
-                std::cout << "Extracting all records to " << outputPath << std::endl;
+                std::cout << "Extracting " << entries.size() << " records to " << outputPath << std::endl;
+            }
 
-                srscFile.decompressAll(outputPath, true);
+            // workers read straight from the mapping, so they don't have to take turns seeking in the SrscFile's stream
+            od::MappedFile mappedFile(srscFile.getFilePath());
+            auto results = scanRecords(mappedFile, entries, extract ? &outputPath : nullptr, extractInflated);
+
+            if(printStats)
+            {
+                srscRecordStats(entries, results);
+            }
+
+            if(verify && srscVerify(entries, results) > 0)
+            {
+                return 2;
             }
 
         }else
@@ -0,0 +1,335 @@
+/*
+ * ZlibScanner.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: zal
+ */
+
+#include <srscEd/ZlibScanner.h>
+
+#include <algorithm>
+#include <cstring>
+
+#include <odCore/Panic.h>
+#include <odCore/SrscRecordTypes.h>
+
+namespace srscEd
+{
+
+    static bool _readU16(const char *data, size_t size, size_t offset, uint16_t &v)
+    {
+        if(offset + 2 > size)
+        {
+            return false;
+        }
+
+        auto p = reinterpret_cast<const unsigned char*>(data + offset);
+        v = p[0] | (p[1] << 8);
+        return true;
+    }
+
+    static bool _readU32(const char *data, size_t size, size_t offset, uint32_t &v)
+    {
+        if(offset + 4 > size)
+        {
+            return false;
+        }
+
+        auto p = reinterpret_cast<const unsigned char*>(data + offset);
+        v = static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) | (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+        return true;
+    }
+
+    // strings are stored with a 16 bit length prefix. returns the offset after the string
+    static bool _skipString(const char *data, size_t size, size_t &offset)
+    {
+        uint16_t length;
+        if(!_readU16(data, size, offset, length))
+        {
+            return false;
+        }
+
+        offset += 2 + length;
+        return offset <= size;
+    }
+
+    ZlibScanner::ZlibScanner()
+    : mOutputBuffer(64*1024)
+    {
+        std::memset(&mStream, 0, sizeof(mStream));
+        mStream.zalloc = Z_NULL;
+        mStream.zfree = Z_NULL;
+        mStream.opaque = Z_NULL;
+
+        if(inflateInit(&mStream) != Z_OK)
+        {
+            OD_PANIC() << "Failed to initialize zlib stream";
+        }
+    }
+
+    ZlibScanner::~ZlibScanner()
+    {
+        inflateEnd(&mStream);
+    }
+
+    void ZlibScanner::scan(od::RecordType type, const char *data, size_t size, std::vector<ZlibStreamInfo> &streams, std::vector<std::vector<char>> *inflatedData)
+    {
+        std::vector<KnownStream> knownStreams;
+        if(!_findKnownStreams(type, data, size, knownStreams))
+        {
+            _scanForHeaders(data, size, streams, inflatedData);
+            return;
+        }
+
+        for(auto &known : knownStreams)
+        {
+            ZlibStreamInfo info;
+            info.offset = known.offset;
+            std::vector<char> inflated;
+
+            bool exceedsRecord = (known.offset > size || known.size > size - known.offset);
+            size_t available = exceedsRecord ? (size - std::min(known.offset, size)) : known.size;
+            if(!_looksLikeHeader(reinterpret_cast<const unsigned char*>(data + known.offset), available))
+            {
+                info.compressedSize = 0;
+                info.inflatedSize = 0;
+                info.corrupt = true;
+                info.error = "no valid zlib header where the record says a stream starts";
+
+            }else if(!_tryInflate(data + known.offset, available, info, (inflatedData != nullptr) ? &inflated : nullptr) && exceedsRecord)
+            {
+                info.error = "stored stream size exceeds record";
+            }
+
+            streams.push_back(info);
+            if(inflatedData != nullptr)
+            {
+                if(info.corrupt) inflated.clear();
+                inflatedData->push_back(std::move(inflated));
+            }
+        }
+    }
+
+    bool ZlibScanner::_findKnownStreams(od::RecordType type, const char *data, size_t size, std::vector<KnownStream> &knownStreams)
+    {
+        // layouts as read by odDb::Texture, odDb::Sound and od::Level/od::Layer. we only need the fields that
+        //  lead up to the streams. if anything does not fit, we don't know the layout after all
+        switch(static_cast<od::SrscRecordType>(type))
+        {
+        case od::SrscRecordType::TEXTURE:
+            {
+                uint32_t compressionLevel;
+                uint32_t compressedSize;
+                if(!_readU32(data, size, 46, compressionLevel) || !_readU32(data, size, 50, compressedSize))
+                {
+                    return false;
+                }
+
+                if(compressionLevel != 0)
+                {
+                    knownStreams.push_back({54, compressedSize});
+                }
+            }
+            return true;
+
+        case od::SrscRecordType::SOUND:
+            {
+                size_t offset = 0;
+                if(!_skipString(data, size, offset))
+                {
+                    return false;
+                }
+
+                // flags, channels, bits, frequency, volume, dropoff, priority, decompressed size
+                offset += 4 + 2 + 2 + 4 + 4 + 4 + 4 + 4;
+
+                uint32_t compressionLevel;
+                if(!_readU32(data, size, offset, compressionLevel))
+                {
+                    return false;
+                }
+                offset += 4;
+
+                if(compressionLevel != 0)
+                {
+                    uint32_t compressedSize;
+                    if(!_readU32(data, size, offset, compressedSize))
+                    {
+                        return false;
+                    }
+
+                    knownStreams.push_back({offset + 4, compressedSize});
+                }
+            }
+            return true;
+
+        case od::SrscRecordType::LEVEL_LAYERS:
+            {
+                uint32_t layerCount;
+                if(!_readU32(data, size, 0, layerCount))
+                {
+                    return false;
+                }
+
+                size_t offset = 4;
+                for(size_t i = 0; i < layerCount; ++i)
+                {
+                    // ID, width, height, type, origin X/Z, world height
+                    offset += 7*4;
+                    if(!_skipString(data, size, offset))
+                    {
+                        return false;
+                    }
+
+                    // flags, light direction and ascension, light and ambient color, light dropoff type
+                    offset += 6*4;
+
+                    uint32_t visibleLayerCount;
+                    if(!_readU32(data, size, offset, visibleLayerCount))
+                    {
+                        return false;
+                    }
+                    offset += 4 + static_cast<size_t>(visibleLayerCount)*4;
+                }
+
+                // poly data is preceded by a constant 1
+                offset += 4;
+
+                // a damaged size field throws off everything behind it, so stop at the first stream that exceeds the record
+                std::vector<KnownStream> layerStreams;
+                for(size_t i = 0; i < layerCount; ++i)
+                {
+                    uint32_t compressedSize;
+                    if(!_readU32(data, size, offset, compressedSize))
+                    {
+                        return false;
+                    }
+                    offset += 4;
+
+                    layerStreams.push_back({offset, compressedSize});
+                    if(compressedSize > size - offset)
+                    {
+                        break;
+                    }
+                    offset += compressedSize;
+                }
+
+                knownStreams.insert(knownStreams.end(), layerStreams.begin(), layerStreams.end());
+            }
+            return true;
+
+        default:
+            return false;
+        }
+    }
+
+    void ZlibScanner::_scanForHeaders(const char *data, size_t size, std::vector<ZlibStreamInfo> &streams, std::vector<std::vector<char>> *inflatedData)
+    {
+        size_t offset = 0;
+        while(offset + 2 <= size)
+        {
+            // everything the engine compresses uses zlib's default 32K window, so all headers start with 0x78
+            const void *next = std::memchr(data + offset, 0x78, size - offset - 1);
+            if(next == nullptr)
+            {
+                break;
+            }
+            offset = static_cast<const char*>(next) - data;
+
+            if(!_looksLikeHeader(reinterpret_cast<const unsigned char*>(data + offset), size - offset))
+            {
+                ++offset;
+                continue;
+            }
+
+            // without knowing a stream starts here, only a complete one is evidence enough
+            ZlibStreamInfo info;
+            info.offset = offset;
+            std::vector<char> inflated;
+            if(!_tryInflate(data + offset, size - offset, info, (inflatedData != nullptr) ? &inflated : nullptr))
+            {
+                ++offset;
+                continue;
+            }
+
+            streams.push_back(info);
+            if(inflatedData != nullptr)
+            {
+                inflatedData->push_back(std::move(inflated));
+            }
+
+            offset += std::max(info.compressedSize, size_t(1));
+        }
+    }
+
+    bool ZlibScanner::_looksLikeHeader(const unsigned char *p, size_t available)
+    {
+        if(available < 2)
+        {
+            return false;
+        }
+
+        uint8_t cmf = p[0];
+        uint8_t flg = p[1];
+
+        bool isDeflate = (cmf == 0x78);
+        bool checkValid = ((static_cast<uint32_t>(cmf) << 8 | flg) % 31) == 0;
+        bool hasPresetDict = flg & 0x20; // never used by the engine, and we couldn't inflate it anyway
+
+        return isDeflate && checkValid && !hasPresetDict;
+    }
+
+    bool ZlibScanner::_tryInflate(const char *data, size_t size, ZlibStreamInfo &info, std::vector<char> *inflated)
+    {
+        if(inflateReset(&mStream) != Z_OK)
+        {
+            OD_PANIC() << "Failed to reset zlib stream";
+        }
+
+        mStream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data));
+        mStream.avail_in = size;
+
+        int result;
+        do
+        {
+            mStream.next_out = reinterpret_cast<Bytef*>(mOutputBuffer.data());
+            mStream.avail_out = mOutputBuffer.size();
+
+            result = inflate(&mStream, Z_NO_FLUSH);
+
+            if(inflated != nullptr && (result == Z_OK || result == Z_STREAM_END))
+            {
+                size_t produced = mOutputBuffer.size() - mStream.avail_out;
+                inflated->insert(inflated->end(), mOutputBuffer.data(), mOutputBuffer.data() + produced);
+            }
+
+        }while(result == Z_OK);
+
+        info.compressedSize = mStream.total_in;
+        info.inflatedSize = mStream.total_out;
+
+        if(result == Z_STREAM_END)
+        {
+            info.corrupt = false;
+            return true;
+        }
+
+        info.corrupt = true;
+        if(result == Z_BUF_ERROR)
+        {
+            // inflate made no progress, which can only happen if it ran out of input
+            info.error = "stream is truncated";
+
+        }else if(mStream.msg != nullptr)
+        {
+            info.error = mStream.msg;
+
+        }else
+        {
+            info.error = "zlib error " + std::to_string(result);
+        }
+
+        return false;
+    }
+
+}